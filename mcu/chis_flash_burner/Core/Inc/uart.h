@@ -9,7 +9,7 @@ extern "C" {
 #include "stm32f1xx_hal.h"
 
 void uart_setControlLine(uint8_t rts, uint8_t dtr);
-void uart_cmdRecv(const uint8_t *buf, uint32_t len);
+uint8_t uart_cmdRecv(const uint8_t *buf, uint32_t len);
 void uart_cmdHandler(void);
 
 #ifdef __cplusplus
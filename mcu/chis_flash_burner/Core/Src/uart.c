@@ -20,6 +20,28 @@
 
 #define OPERATION_TIMEOUT 10000
 
+#define PROTOCOL_VERSION 2
+#define FIRMWARE_ID_STM32 1
+#define USB_PACKET_SIZE 64
+
+// v2 帧
+#define FRAME_CODE 0xc0
+#define SIZE_FRAME_HEADER 5         // 2B.帧大小 0xc0 1B.序号 1B.标志
+#define SIZE_FRAME_RESPON_HEADER 6  // 0xc0 1B.序号 1B.状态 1B.标志 2B.数据长度
+#define SIZE_FRAME_CRC 4
+#define FRAME_FLAG_CRC 0x01
+
+#define FRAME_STATUS_OK 0x00
+#define FRAME_STATUS_CRC_ERROR 0x01
+#define FRAME_STATUS_UNKNOWN_COMMAND 0x02
+#define FRAME_STATUS_BAD_LENGTH 0x03
+
+#define DEVICE_FLAG_FRAME 0x08        // 支持 v2 帧
+#define DEVICE_FLAG_FRAME_QUEUE 0x10  // 执行期间继续接收后续帧
+#define DEVICE_FLAG_FRAME_CRC 0x20    // 支持帧 crc32
+
+#define RLE_READ_MAX 4096  // 压缩读取单次上限，保证原始数据与编码结果可共用responBuf
+
 // 命令头
 typedef struct __attribute__((packed)) {
     uint16_t cmdSize;
@@ -46,6 +68,38 @@ typedef struct __attribute__((packed)) {
     uint8_t payload[];
 } Desc_respon_t;
 
+// v2 帧头，payload 是一个完整的 v1 命令，开启crc时其后紧跟 4B.crc32
+typedef struct __attribute__((packed)) {
+    uint16_t frameSize;
+    uint8_t frameCode;
+    uint8_t seq;
+    uint8_t flags;
+    uint8_t payload[];
+} Desc_frameHeader_t;
+
+// v2 响应头，其后紧跟 dataSize 字节数据，开启crc时再跟 4B.crc32
+typedef struct __attribute__((packed)) {
+    uint8_t frameCode;
+    uint8_t seq;
+    uint8_t status;
+    uint8_t flags;
+    uint16_t dataSize;
+} Desc_frameRespon_t;
+
+// 设备能力描述
+typedef struct __attribute__((packed)) {
+    uint8_t descSize;
+    uint8_t protocolVersion;
+    uint8_t firmwareId;
+    uint8_t flags;               // bit0.边收边执行 bit1.响应不受缓冲区限制 bit2.卡带电源控制
+    uint16_t maxCommandSize;     // 命令包上限，含包头和crc
+    uint16_t maxResponsePayload; // 单次响应数据上限，不含crc
+    uint16_t usbPacketSize;
+    uint16_t reserved;
+    uint32_t busClock;           // 主频 Hz
+    uint8_t opcodeBitmap[32];    // 支持的命令，bit(n) 对应命令码 n
+} Desc_deviceInfo_t;
+
 uint16_t cmdBuf_p = 0;
 uint8_t cmdBuf[5500];
 
@@ -57,6 +111,18 @@ Desc_respon_t *uart_respon = (Desc_respon_t *)responBuf;
 
 volatile uint8_t busy = 0;
 
+// 当前命令是否为 v2 帧
+volatile uint8_t framed = 0;
+uint8_t frameSeq = 0;
+uint8_t frameFlags = 0;
+uint16_t frameSize = 0;
+Desc_frameRespon_t frameRespon;
+uint32_t frameCrc;
+
+// 缓冲区满时挂起的 usb 数据包，处理完当前帧后再收入
+const uint8_t *pendingBuf = NULL;
+volatile uint32_t pendingLen = 0;
+
 extern USBD_HandleTypeDef hUsbDeviceFS;
 
 static void romGetID();
@@ -64,8 +130,10 @@ static void romEraseChip();
 static void romEraseBlock();
 static void romEraseSector();
 static void romProgram();
+static void romProgramRle();
 static void romWrite();
 static void romRead();
+static void romReadRle();
 static void ramWrite();
 static void ramRead();
 static void ramProgramFlash();
@@ -78,6 +146,11 @@ static void gbcRomProgram();
 static void gbcWrite_forFram();
 static void gbcRead_forFram();
 
+static void usbSink();
+static void usbSource();
+static void usbLoopback();
+static void deviceInfo();
+
 uint16_t modbusCRC16(const uint8_t *buf, uint16_t len)
 {
     uint16_t crc = 0xffff;
@@ -95,6 +168,87 @@ uint16_t modbusCRC16(const uint8_t *buf, uint16_t len)
     return crc;
 }
 
+// 硬件 crc32 (STM32 CRC 单元，多项式 0x04C11DB7，初值 0xffffffff)
+// 数据按小端 32 位字送入，末尾不足 4 字节补 0
+static uint32_t frameCRC32(const uint8_t *buf, uint16_t len)
+{
+    RCC->AHBENR |= RCC_AHBENR_CRCEN;
+    CRC->CR = CRC_CR_RESET;
+
+    uint16_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        uint32_t word;
+        memcpy(&word, buf + i, 4);
+        CRC->DR = word;
+    }
+    if (i < len) {
+        uint32_t word = 0;
+        memcpy(&word, buf + i, len - i);
+        CRC->DR = word;
+    }
+
+    return CRC->DR;
+}
+
+// PackBits 解码
+// 0-127: 其后 n+1 字节原样输出；129-255: 下一字节重复 257-n 次；128: 空操作
+// 返回解码长度，数据越界时返回0
+static uint16_t packBitsDecode(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t capacity)
+{
+    uint16_t i = 0;
+    uint16_t o = 0;
+
+    while (i < len) {
+        uint8_t header = src[i++];
+        if (header < 128) {
+            uint16_t count = header + 1;
+            if (i + count > len || o + count > capacity) return 0;
+            memcpy(dst + o, src + i, count);
+            i += count;
+            o += count;
+        } else if (header > 128) {
+            uint16_t count = 257 - header;
+            if (i >= len || o + count > capacity) return 0;
+            memset(dst + o, src[i++], count);
+            o += count;
+        }
+    }
+
+    return o;
+}
+
+// PackBits 编码，仅3字节以上的重复才编码为重复段，最坏每128字节多1字节
+// 允许原地编码：dst 在 src 之前且间隔不小于 len/128+2
+static uint16_t packBitsEncode(const uint8_t *src, uint16_t len, uint8_t *dst)
+{
+    uint16_t i = 0;
+    uint16_t o = 0;
+    uint16_t literalHead = 0;
+    uint8_t literalLen = 0;
+
+    while (i < len) {
+        uint8_t value = src[i];
+        uint16_t run = 1;
+        while (i + run < len && run < 128 && src[i + run] == value) run++;
+
+        if (run >= 3) {
+            literalLen = 0;
+            dst[o++] = (uint8_t)(257 - run);
+            dst[o++] = value;
+            i += run;
+        } else {
+            if (literalLen == 0) literalHead = o++;
+            dst[o++] = value;
+            dst[literalHead] = literalLen;
+            literalLen++;
+            if (literalLen == 128) literalLen = 0;
+            i++;
+        }
+    }
+
+    return o;
+}
+
 void uart_setControlLine(uint8_t rts, uint8_t dtr)
 {
     static uint8_t currentRts = 0;
@@ -105,6 +259,12 @@ void uart_setControlLine(uint8_t rts, uint8_t dtr)
         memset(cmdBuf, 0, sizeof(cmdBuf));
         memset(responBuf, 0, sizeof(responBuf));
         busy = 0;
+        framed = 0;
+        // 丢弃挂起的数据包并恢复接收
+        if (pendingLen != 0) {
+            pendingLen = 0;
+            USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+        }
         // 提示重置
         for (int i = 0; i < 3; i++) {
             HAL_GPIO_WritePin(led_GPIO_Port, led_Pin, 0);  // LED on
@@ -118,19 +278,14 @@ void uart_setControlLine(uint8_t rts, uint8_t dtr)
     currentDtr = dtr;
 }
 
-static void uart_responData(const uint8_t *dat, uint16_t len)
+// 分批发送
+static void uart_transmit(const uint8_t *buf, uint16_t len)
 {
-    // uart_respon->crc16 = modbusCRC16(dat, len); // 计算crc
-
-    if (dat != NULL) memcpy(uart_respon->payload, dat, len);  // 填充数据
-
     const USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef *)hUsbDeviceFS.pClassData;
 
-    // 分批发送
-    uint16_t packSize = SIZE_CRC + len;
     uint16_t transCount = 0;
-    while (transCount < packSize) {
-        uint16_t transLen = packSize - transCount;
+    while (transCount < len) {
+        uint16_t transLen = len - transCount;
         if (transLen > BATCH_SIZE_RESPON) transLen = BATCH_SIZE_RESPON;
 
         while (hcdc->TxState != 0) {
@@ -138,14 +293,61 @@ static void uart_responData(const uint8_t *dat, uint16_t len)
             __NOP();
         }
 
-        CDC_Transmit_FS(responBuf + transCount, transLen);
+        CDC_Transmit_FS((uint8_t *)buf + transCount, transLen);
 
         transCount += transLen;
     }
 }
 
+// v2 响应
+// o 0xc0 1B.序号 1B.状态 1B.标志 2B.数据长度 nB.数据 [4B.crc32]
+static void uart_responFrame(uint8_t status, const uint8_t *dat, uint16_t len)
+{
+    const USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef *)hUsbDeviceFS.pClassData;
+
+    // 上一帧的响应头或crc可能还在发送
+    while (hcdc->TxState != 0) {
+        __WFI();
+    }
+
+    frameRespon.frameCode = FRAME_CODE;
+    frameRespon.seq = frameSeq;
+    frameRespon.status = status;
+    frameRespon.flags = frameFlags;
+    frameRespon.dataSize = len;
+    if (frameFlags & FRAME_FLAG_CRC) frameCrc = frameCRC32(dat, len);
+
+    uart_transmit((const uint8_t *)&frameRespon, SIZE_FRAME_RESPON_HEADER);
+    if (len != 0) uart_transmit(dat, len);
+    if (frameFlags & FRAME_FLAG_CRC) uart_transmit((const uint8_t *)&frameCrc, SIZE_FRAME_CRC);
+
+    // 队列中的下一帧会复用responBuf，须等本帧发送完成
+    while (hcdc->TxState != 0) {
+        __WFI();
+    }
+}
+
+static void uart_responData(const uint8_t *dat, uint16_t len)
+{
+    // uart_respon->crc16 = modbusCRC16(dat, len); // 计算crc
+
+    if (dat != NULL) memcpy(uart_respon->payload, dat, len);  // 填充数据
+
+    if (framed) {
+        uart_responFrame(FRAME_STATUS_OK, uart_respon->payload, len);
+        return;
+    }
+
+    uart_transmit(responBuf, SIZE_CRC + len);
+}
+
 static void uart_responAck()
 {
+    if (framed) {
+        uart_responFrame(FRAME_STATUS_OK, NULL, 0);
+        return;
+    }
+
     const USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef *)hUsbDeviceFS.pClassData;
 
     while (hcdc->TxState != 0) {
@@ -157,27 +359,81 @@ static void uart_responAck()
 }
 
 // usb 接收回调
-void uart_cmdRecv(const uint8_t *buf, uint32_t len)
+// 返回0表示缓冲区已满，数据包暂不收入，此时不重新开启接收，主机端被NAK阻塞
+uint8_t uart_cmdRecv(const uint8_t *buf, uint32_t len)
 {
-    if (busy) return;
+    // v1 命令执行期间丢弃新数据；v2 帧执行期间继续接收后续帧
+    if (busy && !framed) return 1;
 
     uint16_t remainSize = sizeof(cmdBuf) - cmdBuf_p;
-    if (len > remainSize) return;
+    if (len > remainSize) {
+        if (!framed) return 1;
+        pendingBuf = buf;
+        pendingLen = len;
+        return 0;
+    }
 
     memcpy(cmdBuf + cmdBuf_p, buf, len);
     cmdBuf_p += len;
+    return 1;
 }
 
 static void uart_clearRecvBuf()
 {
-    cmdBuf_p = 0;
-    memset(cmdBuf, 0, sizeof(cmdBuf));
+    if (!framed) {
+        cmdBuf_p = 0;
+        memset(cmdBuf, 0, sizeof(cmdBuf));
+        busy = 0;
+        return;
+    }
+
+    // v2: 只移除当前帧，保留已收到的后续帧
+    __disable_irq();
+    uint16_t remain = cmdBuf_p > frameSize ? cmdBuf_p - frameSize : 0;
+    if (remain != 0) memmove(cmdBuf, cmdBuf + frameSize, remain);
+    cmdBuf_p = remain;
+
+    if (pendingLen != 0 && pendingLen <= sizeof(cmdBuf) - cmdBuf_p) {
+        memcpy(cmdBuf + cmdBuf_p, pendingBuf, pendingLen);
+        cmdBuf_p += pendingLen;
+        pendingLen = 0;
+        USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+    }
     busy = 0;
+    __enable_irq();
+}
+
+// 解析 v2 帧头，uart_cmd 指向帧内的 v1 命令
+// i 2B.帧大小 0xc0 1B.序号 1B.标志 nB.v1命令 [4B.crc32]
+static uint8_t uart_openFrame()
+{
+    const Desc_frameHeader_t *frame = (Desc_frameHeader_t *)cmdBuf;
+
+    frameSeq = frame->seq;
+    frameFlags = frame->flags & FRAME_FLAG_CRC;
+    uart_cmd = (Desc_cmdHeader_t *)frame->payload;
+
+    uint16_t crcSize = (frameFlags & FRAME_FLAG_CRC) ? SIZE_FRAME_CRC : 0;
+    if (frameSize < SIZE_FRAME_HEADER + SIZE_CMD_HEADER + SIZE_CRC + crcSize ||
+        uart_cmd->cmdSize != frameSize - SIZE_FRAME_HEADER - crcSize) {
+        return FRAME_STATUS_BAD_LENGTH;
+    }
+
+    if (crcSize != 0) {
+        uint32_t cmdCrc;
+        memcpy(&cmdCrc, frame->payload + uart_cmd->cmdSize, SIZE_FRAME_CRC);
+        if (cmdCrc != frameCRC32(frame->payload, uart_cmd->cmdSize)) {
+            return FRAME_STATUS_CRC_ERROR;
+        }
+    }
+
+    return FRAME_STATUS_OK;
 }
 
 void uart_cmdHandler()
 {
-    if (cmdBuf_p <= 2 || cmdBuf_p < uart_cmd->cmdSize) {
+    const Desc_cmdHeader_t *header = (Desc_cmdHeader_t *)cmdBuf;
+    if (cmdBuf_p <= 2 || cmdBuf_p < header->cmdSize) {
         return;  // 命令不完整，等待继续接收
     }
 
@@ -188,9 +444,26 @@ void uart_cmdHandler()
     // if (cmdCrc != localCrc)
     //     uart_clearRecvBuf();
 
+    // 先于busy置位，接收回调据此决定执行期间是否继续收包
+    uart_cmd = (Desc_cmdHeader_t *)cmdBuf;
+    frameSize = header->cmdSize;
+    framed = header->cmdCode == FRAME_CODE;
+
     busy = 1;
     HAL_GPIO_WritePin(led_GPIO_Port, led_Pin, 0);
 
+    if (framed) {
+        uint8_t status = uart_openFrame();
+        if (status != FRAME_STATUS_OK) {
+            // 帧长度异常时无法定位下一帧，整个缓冲区丢弃
+            if (status == FRAME_STATUS_BAD_LENGTH) frameSize = cmdBuf_p;
+            uart_clearRecvBuf();
+            uart_responFrame(status, NULL, 0);
+            HAL_GPIO_WritePin(led_GPIO_Port, led_Pin, 1);
+            return;
+        }
+    }
+
     // execute cmd
     switch (uart_cmd->cmdCode) {
         case 0xf0:  // rom id获取
@@ -221,6 +494,14 @@ void uart_cmdHandler()
             romRead();
             break;
 
+        case 0xe4:  // rom program RLE
+            romProgramRle();
+            break;
+
+        case 0xe6:  // rom 读取 RLE
+            romReadRle();
+            break;
+
         case 0xf7:  // ram 写入透传
             ramWrite();
             break;
@@ -261,9 +542,26 @@ void uart_cmdHandler()
             gbcRead_forFram();
             break;
 
+        case 0xd0:  // usb 自检 接收丢弃
+            usbSink();
+            break;
+
+        case 0xd1:  // usb 自检 发送测试数据
+            usbSource();
+            break;
+
+        case 0xd2:  // usb 自检 回环
+            usbLoopback();
+            break;
+
+        case 0xd3:  // 设备能力描述
+            deviceInfo();
+            break;
+
         default:
             // 未知命令，清除缓冲区避免busy死锁
             uart_clearRecvBuf();
+            if (framed) uart_responFrame(FRAME_STATUS_UNKNOWN_COMMAND, NULL, 0);
             break;
     }
 
@@ -405,25 +703,10 @@ static void romEraseSector()
     uart_responAck();
 }
 
-// rom program
-// i 2B.包大小 0xf4 4B.始地址 nB.数据 2B.CRC
-// o 0xaa
-static void romProgram()
+// 按字编程，返回0表示被DTR复位中断
+static uint8_t romProgramWords(uint32_t wordAddress, const uint16_t *dataBuf, uint16_t wordCount,
+                               uint16_t bufferWriteBytes)
 {
-    Desc_cmdBody_write_t *desc_write = (Desc_cmdBody_write_t *)(uart_cmd->payload);
-
-    // 基地址
-    uint32_t baseAddress = desc_write->baseAddress;
-    uint32_t wordAddress = baseAddress >> 1;
-    // 写入总数量
-    uint16_t byteCount =
-        uart_cmd->cmdSize - SIZE_CMD_HEADER - SIZE_BASE_ADDRESS - SIZE_BUFF_SIZE - SIZE_CRC;
-    uint16_t wordCount = byteCount / 2;
-    // 编程buff大小
-    uint16_t bufferWriteBytes = *((uint16_t *)(desc_write->payload));
-    // 数据
-    uint16_t *dataBuf = (uint16_t *)(desc_write->payload + SIZE_BUFF_SIZE);
-
     uint32_t writtenCount = 0;
 
     while (writtenCount < wordCount) {
@@ -445,10 +728,7 @@ static void romProgram()
             cart_romWrite(startingAddress, dataBuf + writtenCount, 1);
 
             romWaitForDone(startingAddress, *(dataBuf + writtenCount));
-            if (cmdBuf_p == 0) {
-                uart_clearRecvBuf();
-                return;
-            }
+            if (cmdBuf_p == 0) return 0;
 
             writtenCount++;
         } else {  // 可以多字节编程
@@ -480,15 +760,76 @@ static void romProgram()
             cart_romWrite(startingAddress, &cmd, 1);
 
             romWaitForDone(startingAddress + writeLen - 1, *(dataBuf + writtenCount + writeLen - 1));
-            if (cmdBuf_p == 0) {
-                uart_clearRecvBuf();
-                return;
-            }
+            if (cmdBuf_p == 0) return 0;
 
             writtenCount += writeLen;
         }
     }
 
+    return 1;
+}
+
+// rom program
+// i 2B.包大小 0xf4 4B.始地址 nB.数据 2B.CRC
+// o 0xaa
+static void romProgram()
+{
+    Desc_cmdBody_write_t *desc_write = (Desc_cmdBody_write_t *)(uart_cmd->payload);
+
+    // 基地址
+    uint32_t baseAddress = desc_write->baseAddress;
+    // 写入总数量
+    uint16_t byteCount =
+        uart_cmd->cmdSize - SIZE_CMD_HEADER - SIZE_BASE_ADDRESS - SIZE_BUFF_SIZE - SIZE_CRC;
+    // 编程buff大小
+    uint16_t bufferWriteBytes = *((uint16_t *)(desc_write->payload));
+    // 数据
+    uint16_t *dataBuf = (uint16_t *)(desc_write->payload + SIZE_BUFF_SIZE);
+
+    if (!romProgramWords(baseAddress >> 1, dataBuf, byteCount / 2, bufferWriteBytes)) {
+        uart_clearRecvBuf();
+        return;
+    }
+
+    uart_clearRecvBuf();
+    uart_responAck();
+}
+
+// rom program RLE
+// i 2B.包大小 0xe4 4B.始地址 2B.buff大小 2B.原始长度 nB.PackBits数据 2B.CRC
+// o 0xaa
+static void romProgramRle()
+{
+    // 过短的包会让编码长度回绕，解码越过cmdBuf
+    if (uart_cmd->cmdSize < SIZE_CMD_HEADER + SIZE_BASE_ADDRESS + SIZE_BUFF_SIZE + SIZE_BYTE_COUNT + SIZE_CRC ||
+        uart_cmd->cmdSize > sizeof(cmdBuf)) {
+        uart_clearRecvBuf();
+        if (framed) uart_responFrame(FRAME_STATUS_BAD_LENGTH, NULL, 0);
+        return;
+    }
+
+    Desc_cmdBody_write_t *desc_write = (Desc_cmdBody_write_t *)(uart_cmd->payload);
+
+    uint32_t baseAddress = desc_write->baseAddress;
+    uint16_t bufferWriteBytes = *((uint16_t *)(desc_write->payload));
+    uint16_t rawSize = *((uint16_t *)(desc_write->payload + SIZE_BUFF_SIZE));
+    uint16_t encodedSize = uart_cmd->cmdSize - SIZE_CMD_HEADER - SIZE_BASE_ADDRESS - SIZE_BUFF_SIZE -
+                           SIZE_BYTE_COUNT - SIZE_CRC;
+    const uint8_t *encoded = desc_write->payload + SIZE_BUFF_SIZE + SIZE_BYTE_COUNT;
+
+    // 解码到responBuf，编程期间不需要响应缓冲
+    uint8_t *dataBuf = responBuf;
+    if (rawSize > sizeof(responBuf) || packBitsDecode(encoded, encodedSize, dataBuf, rawSize) != rawSize) {
+        uart_clearRecvBuf();
+        if (framed) uart_responFrame(FRAME_STATUS_BAD_LENGTH, NULL, 0);
+        return;
+    }
+
+    if (!romProgramWords(baseAddress >> 1, (const uint16_t *)dataBuf, rawSize / 2, bufferWriteBytes)) {
+        uart_clearRecvBuf();
+        return;
+    }
+
     uart_clearRecvBuf();
     uart_responAck();
 }
@@ -537,6 +878,27 @@ static void romRead()
     uart_responData(NULL, byteCount);
 }
 
+// rom 读取 RLE
+// i 2B.包大小 0xe6 4B.始地址 2B.读取数量 2B.CRC
+// o 2B.CRC nB.PackBits数据
+// 响应长度不定，主机需通过 v2 帧头获取长度
+static void romReadRle()
+{
+    const Desc_cmdBody_read_t *desc_read = (Desc_cmdBody_read_t *)(uart_cmd->payload);
+
+    uint32_t wordAddress = desc_read->baseAddress >> 1;
+    uint16_t byteCount = desc_read->readSize & 0xfffe;
+    if (byteCount > RLE_READ_MAX) byteCount = RLE_READ_MAX;
+
+    // 原始数据读到responBuf尾部，编码结果从头写入，写指针追不上读指针
+    uint8_t *rawBuf = uart_respon->payload + (sizeof(responBuf) - SIZE_CRC - byteCount);
+    cart_romRead(wordAddress, (uint16_t *)rawBuf, byteCount / 2);
+    uint16_t encodedSize = packBitsEncode(rawBuf, byteCount, uart_respon->payload);
+
+    uart_clearRecvBuf();
+    uart_responData(NULL, encodedSize);
+}
+
 // ram写入
 // i 2B.包大小 0xf7 4B.基地址 nB.写入数据 2B.CRC
 // o 0xaa
@@ -855,3 +1217,91 @@ void gbcRead_forFram()
     uart_clearRecvBuf();
     uart_responData(NULL, byteCount);
 }
+
+////////////////////////////////////////////////////////////
+// usb 自检命令，不访问卡带总线，用于测量链路吞吐与延迟
+////////////////////////////////////////////////////////////
+
+// usb 接收丢弃
+// i 2B.包大小 0xd0 nB.数据 2B.CRC
+// o 0xaa
+static void usbSink()
+{
+    // 数据已经完整收入cmdBuf，直接丢弃
+    uart_clearRecvBuf();
+    uart_responAck();
+}
+
+// usb 发送测试数据
+// i 2B.包大小 0xd1 4B.种子 2B.数量 2B.CRC
+// o 2B.CRC nB.数据 (种子+i)&0xff
+static void usbSource()
+{
+    const Desc_cmdBody_read_t *desc_read = (Desc_cmdBody_read_t *)(uart_cmd->payload);
+
+    uint8_t seed = (uint8_t)desc_read->baseAddress;
+    uint16_t byteCount = desc_read->readSize;
+    if (byteCount > sizeof(responBuf) - SIZE_CRC) byteCount = sizeof(responBuf) - SIZE_CRC;
+
+    uint8_t *dataBuf = uart_respon->payload;
+    for (uint16_t i = 0; i < byteCount; i++) {
+        dataBuf[i] = (uint8_t)(seed + i);
+    }
+
+    uart_clearRecvBuf();
+    uart_responData(NULL, byteCount);
+}
+
+// usb 回环
+// i 2B.包大小 0xd2 nB.数据 2B.CRC
+// o 2B.CRC nB.数据
+static void usbLoopback()
+{
+    // 过短的包会让长度回绕，过长的包放不进响应缓冲
+    if (uart_cmd->cmdSize < SIZE_CMD_HEADER + SIZE_CRC ||
+        uart_cmd->cmdSize - SIZE_CMD_HEADER - SIZE_CRC > sizeof(responBuf) - SIZE_CRC) {
+        uart_clearRecvBuf();
+        if (framed) uart_responFrame(FRAME_STATUS_BAD_LENGTH, NULL, 0);
+        return;
+    }
+
+    uint16_t byteCount = uart_cmd->cmdSize - SIZE_CMD_HEADER - SIZE_CRC;
+    memcpy(uart_respon->payload, uart_cmd->payload, byteCount);
+
+    uart_clearRecvBuf();
+    uart_responData(NULL, byteCount);
+}
+
+// 设备能力描述
+// i 2B.包大小 0xd3 2B.CRC
+// o 2B.CRC 48B.描述符 Desc_deviceInfo_t
+static void deviceInfo()
+{
+    static const uint8_t opcodes[] = {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xe7, 0xe8,
+        0xe4, 0xe6,
+        0xfa, 0xfb, 0xfc, 0xea, 0xeb,
+        0xd0, 0xd1, 0xd2, 0xd3,
+        FRAME_CODE,
+    };
+
+    Desc_deviceInfo_t *desc = (Desc_deviceInfo_t *)uart_respon->payload;
+    memset(desc, 0, sizeof(Desc_deviceInfo_t));
+
+    desc->descSize = sizeof(Desc_deviceInfo_t);
+    desc->protocolVersion = PROTOCOL_VERSION;
+    desc->firmwareId = FIRMWARE_ID_STM32;
+    // 整包收完才执行，响应从responBuf发出
+    desc->flags = DEVICE_FLAG_FRAME | DEVICE_FLAG_FRAME_QUEUE | DEVICE_FLAG_FRAME_CRC;
+    desc->maxCommandSize = sizeof(cmdBuf);
+    desc->maxResponsePayload = sizeof(responBuf) - SIZE_CRC;
+    desc->usbPacketSize = USB_PACKET_SIZE;
+    desc->busClock = SystemCoreClock;
+
+    for (uint16_t i = 0; i < sizeof(opcodes); i++) {
+        desc->opcodeBitmap[opcodes[i] >> 3] |= 1 << (opcodes[i] & 0x07);
+    }
+
+    uart_clearRecvBuf();
+    uart_responData(NULL, sizeof(Desc_deviceInfo_t));
+}
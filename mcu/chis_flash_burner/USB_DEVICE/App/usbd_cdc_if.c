@@ -268,10 +268,11 @@ static int8_t CDC_Receive_FS(uint8_t* Buf, uint32_t *Len)
 {
   /* USER CODE BEGIN 6 */
 
-	uart_cmdRecv(Buf, *Len);
-
   USBD_CDC_SetRxBuffer(&hUsbDeviceFS, &Buf[0]);
-  USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+	// 命令缓冲区已满时先不接收下一包，由 uart 处理完当前帧后恢复
+	if (uart_cmdRecv(Buf, *Len)) {
+	  USBD_CDC_ReceivePacket(&hUsbDeviceFS);
+	}
   return (USBD_OK);
   /* USER CODE END 6 */
 }
@@ -12,6 +12,11 @@
 #define SIZE_BUFF_SIZE 2
 #define SIZE_LATENCY 1
 
+#define PROTOCOL_VERSION 1
+#define FIRMWARE_ID_STC8 2
+#define SIZE_DEVICE_INFO 48
+#define SYS_CLOCK_HZ 44236800UL // 需与 ISP 下载时设置的 IRC 频率一致
+
 // // 命令头
 // typedef struct
 // {
@@ -78,6 +83,11 @@ void gbcRead_forFram();
 void cart_power();
 void cart_phi();
 
+void usbSink();
+void usbSource();
+void usbLoopback();
+void deviceInfo();
+
 // 流控回调
 void uart_setControlLine(BOOL rts, BOOL dtr)
 {
@@ -282,6 +292,22 @@ void uart_cmdHandler()
             cart_phi();
             break;
 
+        case 0xd0: // usb 自检 接收丢弃
+            usbSink();
+            break;
+
+        case 0xd1: // usb 自检 发送测试数据
+            usbSource();
+            break;
+
+        case 0xd2: // usb 自检 回环
+            usbLoopback();
+            break;
+
+        case 0xd3: // 设备能力描述
+            deviceInfo();
+            break;
+
         default:
             break;
         }
@@ -1239,4 +1265,173 @@ void cart_phi()
 
     uart_clearRecvBuf();
     endpointClear();
-}
\ No newline at end of file
+}
+
+// usb 接收丢弃，不访问卡带总线，用于测量下行吞吐
+// i 2B.包大小 0xd0 nB.数据 2B.CRC
+// o 0xaa
+void usbSink()
+{
+    uint16_t packSize;
+
+    ((uint8_t *)&packSize)[0] = *(cmdBuf + 1);
+    ((uint8_t *)&packSize)[1] = *(cmdBuf + 0);
+
+    // 等待命令接收完成
+    while (cmdBuf_i_wr < packSize)
+    {
+        // 被主机复位了
+        if (cmdEnd)
+        {
+            cmdEnd = 0;
+            return;
+        }
+    }
+
+    uart_responAck();
+    uart_clearRecvBuf();
+    endpointClear();
+}
+
+// usb 发送测试数据，不访问卡带总线，用于测量上行吞吐
+// i 2B.包大小 0xd1 4B.种子 2B.数量 2B.CRC
+// o 2B.CRC nB.数据 (种子+i)&0xff
+void usbSource()
+{
+    uint8_t seed;
+    uint16_t byteCount;
+    uint16_t rdLen, i, ii;
+    uint16_t packSize;
+
+    ((uint8_t *)&packSize)[0] = *(cmdBuf + 1);
+    ((uint8_t *)&packSize)[1] = *(cmdBuf + 0);
+
+    // 等待命令接收完成
+    while (cmdBuf_i_wr < packSize)
+        ;
+    uart_responData(responCrc, 2);
+
+    // 种子取小端最低字节
+    seed = cmdBuf[SIZE_CMD_HEADER];
+    // 发送总数量
+    byteCount = reverse2(*((uint16_t *)(cmdBuf + SIZE_CMD_HEADER + SIZE_BASE_ADDRESS)));
+
+    for (i = 0; i < byteCount;)
+    {
+        rdLen = byteCount - i;
+        rdLen = min(rdLen, (sizeof(responBuf) - 2)); // 把端点fifo写满会发不出去，原因未知
+
+        for (ii = 0; ii < rdLen; ii++)
+            responBuf[ii] = (uint8_t)(seed + i + ii);
+
+        uart_responData(responBuf, rdLen);
+
+        i += rdLen;
+    }
+
+    uart_clearRecvBuf();
+    endpointClear();
+}
+
+// usb 回环，不访问卡带总线，用于测量往返延迟
+// i 2B.包大小 0xd2 nB.数据 2B.CRC
+// o 2B.CRC nB.数据
+void usbLoopback()
+{
+    uint16_t byteCount;
+    uint16_t rdLen, i;
+    uint16_t packSize;
+
+    ((uint8_t *)&packSize)[0] = *(cmdBuf + 1);
+    ((uint8_t *)&packSize)[1] = *(cmdBuf + 0);
+
+    // 过短的包会让长度回绕，过长的包永远收不完，直接丢弃
+    if (packSize < SIZE_CMD_HEADER + SIZE_CRC || packSize > sizeof(cmdBuf))
+    {
+        uart_clearRecvBuf();
+        endpointClear();
+        return;
+    }
+
+    // 等待命令接收完成
+    while (cmdBuf_i_wr < packSize)
+    {
+        // 被主机复位了
+        if (cmdEnd)
+        {
+            cmdEnd = 0;
+            return;
+        }
+    }
+    uart_responData(responCrc, 2);
+
+    // 回环总数量
+    byteCount = packSize - SIZE_CMD_HEADER - SIZE_CRC;
+
+    for (i = 0; i < byteCount;)
+    {
+        rdLen = byteCount - i;
+        rdLen = min(rdLen, (sizeof(responBuf) - 2));
+
+        memcpy(responBuf, cmdBuf + SIZE_CMD_HEADER + i, rdLen);
+        uart_responData(responBuf, rdLen);
+
+        i += rdLen;
+    }
+
+    uart_clearRecvBuf();
+    endpointClear();
+}
+
+// 设备能力描述，多字节字段均为小端
+// i 2B.包大小 0xd3 2B.CRC
+// o 2B.CRC 48B.描述符
+//   0 1B.描述符大小 1 1B.协议版本 2 1B.固件id 3 1B.flags
+//   4 2B.命令包上限 6 2B.单次响应上限 8 2B.usb包大小 10 2B.保留
+//   12 4B.主频 16 32B.命令位图
+void deviceInfo()
+{
+    static uint8_t code opcodes[] = {
+        0xf0, 0xf1, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+        0xfa, 0xfb, 0xfc, 0xea, 0xeb,
+        0xa0, 0xa1,
+        0xd0, 0xd1, 0xd2, 0xd3};
+    uint16_t packSize;
+    uint8_t i;
+
+    ((uint8_t *)&packSize)[0] = *(cmdBuf + 1);
+    ((uint8_t *)&packSize)[1] = *(cmdBuf + 0);
+
+    // 等待命令接收完成
+    while (cmdBuf_i_wr < packSize)
+        ;
+    uart_responData(responCrc, 2);
+
+    memset(responBuf, 0, SIZE_DEVICE_INFO);
+    responBuf[0] = SIZE_DEVICE_INFO;
+    responBuf[1] = PROTOCOL_VERSION;
+    responBuf[2] = FIRMWARE_ID_STC8;
+    responBuf[3] = 0x07; // 边收边执行 | 响应分包流式发送 | 卡带电源控制
+    // 命令包上限
+    responBuf[4] = (uint8_t)(sizeof(cmdBuf));
+    responBuf[5] = (uint8_t)(sizeof(cmdBuf) >> 8);
+    // 响应按端点分包流式发送，只受2B长度字段限制
+    responBuf[6] = 0xff;
+    responBuf[7] = 0xff;
+    // usb包大小
+    responBuf[8] = EP1IN_SIZE;
+    responBuf[9] = 0;
+    // 主频
+    responBuf[12] = (uint8_t)(SYS_CLOCK_HZ);
+    responBuf[13] = (uint8_t)(SYS_CLOCK_HZ >> 8);
+    responBuf[14] = (uint8_t)(SYS_CLOCK_HZ >> 16);
+    responBuf[15] = (uint8_t)(SYS_CLOCK_HZ >> 24);
+
+    for (i = 0; i < sizeof(opcodes); i++)
+        responBuf[16 + (opcodes[i] >> 3)] |= 1 << (opcodes[i] & 0x07);
+
+    uart_responData(responBuf, SIZE_DEVICE_INFO);
+
+    uart_clearRecvBuf();
+    endpointClear();
+}
@@ -0,0 +1,93 @@
+use crate::native_platform::{header_str, header_value, raw_body};
+use std::{
+  fs::{self, File, OpenOptions},
+  io::{ErrorKind, Read, Write},
+  path::PathBuf,
+};
+use tauri::{
+  ipc::{Request, Response},
+  AppHandle, Manager,
+};
+
+const JOURNAL_DIR: &str = "transfer-journals";
+const JOURNAL_KEY_HEADER: &str = "x-journal-key";
+const JOURNAL_OFFSET_HEADER: &str = "x-journal-offset";
+
+/// 断点日志存放在应用数据目录：`<key>.json` 为进度，`<key>.bin` 为已读取的数据
+#[tauri::command]
+pub fn native_journal_load(app: AppHandle, key: String) -> Result<Option<String>, String> {
+  match fs::read_to_string(journal_path(&app, &key, "json")?) {
+    Ok(content) => Ok(Some(content)),
+    Err(error) if error.kind() == ErrorKind::NotFound => Ok(None),
+    Err(error) => Err(format!("Failed to load journal {key}: {error}")),
+  }
+}
+
+#[tauri::command]
+pub fn native_journal_save(app: AppHandle, key: String, content: String) -> Result<(), String> {
+  let path = journal_path(&app, &key, "json")?;
+  // 先写临时文件再替换，写到一半中断不会留下损坏的日志
+  let temp_path = path.with_extension("json.tmp");
+  fs::write(&temp_path, content)
+    .and_then(|_| fs::rename(&temp_path, &path))
+    .map_err(|error| format!("Failed to save journal {key}: {error}"))
+}
+
+#[tauri::command]
+pub fn native_journal_remove(app: AppHandle, key: String) -> Result<(), String> {
+  for extension in ["json", "bin"] {
+    match fs::remove_file(journal_path(&app, &key, extension)?) {
+      Ok(()) => {}
+      Err(error) if error.kind() == ErrorKind::NotFound => {}
+      Err(error) => return Err(format!("Failed to remove journal {key}: {error}")),
+    }
+  }
+  Ok(())
+}
+
+/// 数据为原始请求体，在 offset 处截断后追加
+#[tauri::command]
+pub fn native_journal_append(app: AppHandle, request: Request<'_>) -> Result<(), String> {
+  let key = header_str(&request, JOURNAL_KEY_HEADER)?;
+  let offset: u64 = header_value(&request, JOURNAL_OFFSET_HEADER)?;
+  let bytes = raw_body(&request)?;
+
+  let mut file = OpenOptions::new()
+    .create(true)
+    .append(true)
+    .open(journal_path(&app, key, "bin")?)
+    .map_err(|error| format!("Failed to open journal data {key}: {error}"))?;
+  file
+    .set_len(offset)
+    .and_then(|_| file.write_all(bytes))
+    .map_err(|error| format!("Failed to append journal data {key}: {error}"))
+}
+
+#[tauri::command]
+pub fn native_journal_read(app: AppHandle, key: String, length: u64) -> Result<Response, String> {
+  let file = File::open(journal_path(&app, &key, "bin")?)
+    .map_err(|error| format!("Failed to open journal data {key}: {error}"))?;
+  let mut data = Vec::new();
+  file
+    .take(length)
+    .read_to_end(&mut data)
+    .map_err(|error| format!("Failed to read journal data {key}: {error}"))?;
+  Ok(Response::new(data))
+}
+
+fn journal_path(app: &AppHandle, key: &str, extension: &str) -> Result<PathBuf, String> {
+  let directory = app
+    .path()
+    .app_data_dir()
+    .map_err(|error| format!("Failed to resolve app data directory: {error}"))?
+    .join(JOURNAL_DIR);
+  fs::create_dir_all(&directory)
+    .map_err(|error| format!("Failed to create {}: {error}", directory.to_string_lossy()))?;
+
+  // 日志键含 `:` 等字符，转成可作文件名的形式
+  let file_name: String = key
+    .chars()
+    .map(|c| if c.is_ascii_alphanumeric() || c == '-' { c } else { '_' })
+    .collect();
+  Ok(directory.join(format!("{file_name}.{extension}")))
+}
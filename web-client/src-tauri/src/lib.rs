@@ -1,4 +1,7 @@
+mod journal_store;
+mod native_jobs;
 mod native_platform;
+mod serial_reader;
 
 #[cfg_attr(mobile, tauri::mobile_entry_point)]
 pub fn run() {
@@ -8,11 +11,23 @@ pub fn run() {
       native_platform::native_list_serial_ports,
       native_platform::native_open_serial_port,
       native_platform::native_serial_write,
+      native_platform::native_serial_subscribe,
       native_platform::native_serial_read,
       native_platform::native_serial_set_signals,
       native_platform::native_serial_flush_input,
+      native_platform::native_serial_run_job,
+      native_platform::native_serial_cancel_job,
       native_platform::native_serial_close,
       native_platform::save_binary_file,
+      native_platform::native_open_dump_sink,
+      native_platform::native_dump_sink_write,
+      native_platform::native_dump_sink_resume,
+      native_platform::native_dump_sink_close,
+      journal_store::native_journal_load,
+      journal_store::native_journal_save,
+      journal_store::native_journal_remove,
+      journal_store::native_journal_append,
+      journal_store::native_journal_read,
       native_platform::native_runtime_metadata,
     ])
     .run(tauri::generate_context!())
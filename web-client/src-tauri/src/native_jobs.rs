@@ -0,0 +1,243 @@
+use serde::{Deserialize, Serialize};
+use std::{
+  sync::atomic::{AtomicBool, Ordering},
+  time::{Duration, Instant},
+};
+
+const PROTOCOL_ACK: u8 = 0xaa;
+const PACKET_SIZE_BYTES: usize = 2;
+const PACKET_CRC_BYTES: usize = 2;
+const RESPONSE_CRC_BYTES: usize = 2;
+/// 命令包除数据外的字节数：长度、操作码、地址、长度/缓冲区大小、CRC 占位
+const PACKET_OVERHEAD: usize = PACKET_SIZE_BYTES + 1 + 4 + 2 + PACKET_CRC_BYTES;
+const PROGRESS_INTERVAL: Duration = Duration::from_millis(100);
+
+/// 批处理任务使用的串口操作，由会话实现
+pub trait JobPort {
+  fn write_packet(&mut self, packet: &[u8], timeout_ms: u64) -> Result<(), String>;
+  fn read_exact(&mut self, buffer: &mut [u8], timeout_ms: u64) -> Result<(), String>;
+  fn discard_input(&mut self) -> Result<(), String>;
+}
+
+/// 在原生线程中整段执行的 v1 命令循环
+///
+/// 读/写命令的格式由前端协议层给出（操作码与超时），这里只负责按块重复。
+/// 编程数据不在描述中，作为原始请求体单独传入：
+/// 读：`[size:2] op [addr:4] [len:2] [crc:2]` -> `[crc:2] data`
+/// 写：`[size:2] op [addr:4] [buf:2] data [crc:2]` -> `0xaa`
+#[derive(Deserialize)]
+#[serde(tag = "kind", rename_all = "camelCase", rename_all_fields = "camelCase")]
+pub enum NativeJob {
+  Dump {
+    opcode: u8,
+    address: u32,
+    size: usize,
+    chunk_size: usize,
+    timeout_ms: u64,
+  },
+  Program {
+    opcode: u8,
+    address: u32,
+    chunk_size: usize,
+    buffer_size: u16,
+    timeout_ms: u64,
+    timeout_per_byte_ms: u64,
+    skip_erased: bool,
+    /// 设备上报的单包上限（0xd3），旧固件未上报时只受 16 位长度字段限制
+    #[serde(default)]
+    max_command_size: Option<usize>,
+  },
+}
+
+#[derive(Clone, Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct NativeJobProgress {
+  processed_bytes: usize,
+  total_bytes: usize,
+}
+
+#[derive(Default)]
+pub struct NativeJobResult {
+  /// 读取任务的数据
+  pub data: Vec<u8>,
+  /// 实际编程的字节数（跳过的 0xFF 页不计）
+  pub programmed_bytes: usize,
+}
+
+impl NativeJob {
+  fn total_bytes(&self, data: &[u8]) -> usize {
+    match self {
+      NativeJob::Dump { size, .. } => *size,
+      NativeJob::Program { .. } => data.len(),
+    }
+  }
+}
+
+/// 执行任务；`data` 为编程任务的数据，读取任务忽略
+pub fn run_job(
+  port: &mut impl JobPort,
+  job: &NativeJob,
+  data: &[u8],
+  cancelled: &AtomicBool,
+  mut on_progress: impl FnMut(NativeJobProgress),
+) -> Result<NativeJobResult, String> {
+  let total_bytes = job.total_bytes(data);
+  let mut reporter = ProgressThrottle::new(total_bytes);
+  let mut result = NativeJobResult::default();
+
+  match job {
+    NativeJob::Dump {
+      opcode,
+      address,
+      size,
+      chunk_size,
+      timeout_ms,
+    } => {
+      result.data = vec![0_u8; *size];
+      let mut response = vec![0_u8; chunk_size_of(*chunk_size)? + RESPONSE_CRC_BYTES];
+      for_each_chunk(*size, *chunk_size, cancelled, |offset, length| {
+        let chunk_address = address_at(*address, offset);
+        read_chunk(port, *opcode, chunk_address, &mut response[..length + RESPONSE_CRC_BYTES], *timeout_ms)?;
+        result.data[offset..offset + length].copy_from_slice(&response[RESPONSE_CRC_BYTES..length + RESPONSE_CRC_BYTES]);
+        reporter.report(offset + length, &mut on_progress);
+        Ok(())
+      })?;
+    }
+    NativeJob::Program {
+      opcode,
+      address,
+      chunk_size,
+      buffer_size,
+      timeout_ms,
+      timeout_per_byte_ms,
+      skip_erased,
+      max_command_size,
+    } => {
+      let limit = max_command_size.unwrap_or(u16::MAX as usize).min(u16::MAX as usize);
+      if chunk_size_of(*chunk_size)? + PACKET_OVERHEAD > limit {
+        return Err(format!(
+          "Program chunk size {chunk_size} exceeds the device command limit {limit}"
+        ));
+      }
+      for_each_chunk(data.len(), *chunk_size, cancelled, |offset, length| {
+        let page = &data[offset..offset + length];
+        if !(*skip_erased && page.iter().all(|&byte| byte == 0xff)) {
+          let chunk_address = address_at(*address, offset);
+          let packet = encode_packet(*opcode, chunk_address, *buffer_size, page)?;
+          let timeout = timeout_ms + length as u64 * timeout_per_byte_ms;
+          port.write_packet(&packet, timeout)?;
+          let mut ack = [0_u8; 1];
+          port.read_exact(&mut ack, timeout)?;
+          // 与前端 sendAndExpectAck 一致：ACK 之后不应再有字节
+          port.discard_input()?;
+          if ack[0] != PROTOCOL_ACK {
+            return Err(format!("Program failed (Address: 0x{chunk_address:08x}, Response: 0x{:02x})", ack[0]));
+          }
+          result.programmed_bytes += length;
+        }
+        reporter.report(offset + length, &mut on_progress);
+        Ok(())
+      })?;
+    }
+  }
+
+  reporter.finish(&mut on_progress);
+  Ok(result)
+}
+
+/// 按块遍历 [0, total)
+fn for_each_chunk(
+  total: usize,
+  chunk_size: usize,
+  cancelled: &AtomicBool,
+  mut operation: impl FnMut(usize, usize) -> Result<(), String>,
+) -> Result<(), String> {
+  let chunk_size = chunk_size_of(chunk_size)?;
+  let mut offset = 0;
+  while offset < total {
+    if cancelled.load(Ordering::Relaxed) {
+      return Err("Native job cancelled".to_string());
+    }
+    let length = chunk_size.min(total - offset);
+    operation(offset, length)?;
+    offset += length;
+  }
+  Ok(())
+}
+
+fn chunk_size_of(chunk_size: usize) -> Result<usize, String> {
+  if chunk_size == 0 || chunk_size > u16::MAX as usize {
+    return Err(format!("Invalid native job chunk size {chunk_size}"));
+  }
+  Ok(chunk_size)
+}
+
+fn address_at(base: u32, offset: usize) -> u32 {
+  base.wrapping_add(offset as u32)
+}
+
+fn read_chunk(
+  port: &mut impl JobPort,
+  opcode: u8,
+  address: u32,
+  response: &mut [u8],
+  timeout_ms: u64,
+) -> Result<(), String> {
+  let length = (response.len() - RESPONSE_CRC_BYTES) as u16;
+  let packet = encode_packet(opcode, address, length, &[])?;
+  port.write_packet(&packet, timeout_ms)?;
+  port
+    .read_exact(response, timeout_ms)
+    .map_err(|error| format!("Read failed (Address: 0x{address:08x}), Reason: {error}"))
+}
+
+/// 构建 v1 命令包，长度字段包含自身与末尾 2 字节 CRC 占位
+fn encode_packet(opcode: u8, address: u32, length: u16, data: &[u8]) -> Result<Vec<u8>, String> {
+  let size = PACKET_OVERHEAD + data.len();
+  let size_field =
+    u16::try_from(size).map_err(|_| format!("Command packet of {size} bytes exceeds the 16-bit length field"))?;
+  let mut packet = Vec::with_capacity(size);
+  packet.extend_from_slice(&size_field.to_le_bytes());
+  packet.push(opcode);
+  packet.extend_from_slice(&address.to_le_bytes());
+  packet.extend_from_slice(&length.to_le_bytes());
+  packet.extend_from_slice(data);
+  packet.extend_from_slice(&[0, 0]);
+  Ok(packet)
+}
+
+/// 进度事件限流，避免高速读取时向前端发送过多事件
+struct ProgressThrottle {
+  total_bytes: usize,
+  processed_bytes: usize,
+  last_emit: Instant,
+}
+
+impl ProgressThrottle {
+  fn new(total_bytes: usize) -> Self {
+    Self {
+      total_bytes,
+      processed_bytes: 0,
+      last_emit: Instant::now(),
+    }
+  }
+
+  fn report(&mut self, processed_bytes: usize, on_progress: &mut impl FnMut(NativeJobProgress)) {
+    self.processed_bytes = processed_bytes;
+    if self.last_emit.elapsed() >= PROGRESS_INTERVAL {
+      self.emit(on_progress);
+    }
+  }
+
+  fn finish(&mut self, on_progress: &mut impl FnMut(NativeJobProgress)) {
+    self.emit(on_progress);
+  }
+
+  fn emit(&mut self, on_progress: &mut impl FnMut(NativeJobProgress)) {
+    self.last_emit = Instant::now();
+    on_progress(NativeJobProgress {
+      processed_bytes: self.processed_bytes,
+      total_bytes: self.total_bytes,
+    });
+  }
+}
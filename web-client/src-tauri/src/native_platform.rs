@@ -1,22 +1,37 @@
+use crate::native_jobs::{self, JobPort, NativeJob, NativeJobProgress};
+use crate::serial_reader::SerialReader;
 use serde::Serialize;
 use serialport::{ClearBuffer, DataBits, FlowControl, Parity, SerialPort, SerialPortType, StopBits};
 use std::{
   collections::HashMap,
-  io::{ErrorKind, Read, Write},
+  fs::{File, OpenOptions},
+  io::{BufWriter, Seek, SeekFrom, Write},
   path::PathBuf,
+  str::FromStr,
   sync::{
-    atomic::{AtomicU64, Ordering},
-    Mutex,
+    atomic::{AtomicBool, AtomicU64, Ordering},
+    Arc, Mutex,
   },
-  time::{Duration, Instant},
+  time::Duration,
 };
+use tauri::ipc::{Channel, InvokeBody, JavaScriptChannelId, Request, Response};
 
 const DEFAULT_BAUD_RATE: u32 = 9_600;
 const DEFAULT_IO_TIMEOUT_MS: u64 = 1_000;
+const SESSION_ID_HEADER: &str = "x-session-id";
+const TIMEOUT_HEADER: &str = "x-timeout-ms";
+const JOB_HEADER: &str = "x-native-job";
+const PROGRESS_CHANNEL_HEADER: &str = "x-progress-channel";
+const SINK_ID_HEADER: &str = "x-sink-id";
+const DUMP_SINK_BUFFER_SIZE: usize = 1 << 20;
+/// 冒号分隔的虚拟烧录器路径（npm run virtual-burner 创建的 PTY 链接），追加到端口列表
+const VIRTUAL_PORTS_ENV: &str = "BEGGAR_SOCKET_VIRTUAL_PORTS";
 
 pub struct NativePlatformState {
   next_session_id: AtomicU64,
-  serial_sessions: Mutex<HashMap<u64, SerialSession>>,
+  serial_sessions: Mutex<HashMap<u64, SessionHandle>>,
+  next_sink_id: AtomicU64,
+  dump_sinks: Mutex<HashMap<u64, DumpSink>>,
 }
 
 impl Default for NativePlatformState {
@@ -24,13 +39,54 @@ impl Default for NativePlatformState {
     Self {
       next_session_id: AtomicU64::new(1),
       serial_sessions: Mutex::new(HashMap::new()),
+      next_sink_id: AtomicU64::new(1),
+      dump_sinks: Mutex::new(HashMap::new()),
     }
   }
 }
 
+/// 转储文件：分块顺序追加写入，前端不必持有完整镜像
+///
+/// 打开时不截断，第一次写入前才确定起点：续写上次保留的部分文件，或清空从头写入
+struct DumpSink {
+  path: PathBuf,
+  writer: BufWriter<File>,
+  started: bool,
+}
+
+impl DumpSink {
+  fn start_at(&mut self, offset: u64) -> std::io::Result<()> {
+    let file = self.writer.get_mut();
+    file.set_len(offset)?;
+    file.seek(SeekFrom::Start(offset))?;
+    self.started = true;
+    Ok(())
+  }
+
+  fn ensure_started(&mut self) -> Result<(), String> {
+    if self.started {
+      return Ok(());
+    }
+    self
+      .start_at(0)
+      .map_err(|error| format!("Failed to truncate {}: {error}", display_path(&self.path)))
+  }
+}
+
+/// `port` 只用于写入与控制信号，输入全部由 `reader` 的后台线程读取
 struct SerialSession {
   path: String,
   port: Box<dyn SerialPort>,
+  reader: SerialReader,
+  /// 伪终端没有调制解调器控制线，设置 DTR/RTS 时跳过
+  pseudo_terminal: bool,
+}
+
+/// 会话在任务线程与命令之间共享；取消标志独立于会话锁，任务运行中也能置位
+#[derive(Clone)]
+struct SessionHandle {
+  session: Arc<Mutex<SerialSession>>,
+  job_cancelled: Arc<AtomicBool>,
 }
 
 #[derive(Serialize)]
@@ -51,6 +107,13 @@ pub struct NativeSerialSessionInfo {
   session_id: u64,
 }
 
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct NativeDumpSinkInfo {
+  sink_id: u64,
+  path: String,
+}
+
 #[derive(Serialize)]
 #[serde(rename_all = "camelCase")]
 pub struct RuntimeMetadata {
@@ -65,7 +128,17 @@ pub struct RuntimeMetadata {
 #[tauri::command]
 pub fn native_list_serial_ports() -> Result<Vec<NativeSerialPortInfo>, String> {
   let ports = serialport::available_ports().map_err(|error| error.to_string())?;
-  Ok(ports.into_iter().map(NativeSerialPortInfo::from).collect())
+  let mut ports: Vec<NativeSerialPortInfo> = ports.into_iter().map(NativeSerialPortInfo::from).collect();
+  // available_ports 不枚举伪终端，虚拟烧录器通过环境变量登记
+  if let Ok(paths) = std::env::var(VIRTUAL_PORTS_ENV) {
+    ports.extend(
+      paths
+        .split(':')
+        .filter(|path| !path.is_empty() && std::path::Path::new(path).exists())
+        .map(|path| NativeSerialPortInfo::virtual_burner(path.to_string())),
+    );
+  }
+  Ok(ports)
 }
 
 #[tauri::command]
@@ -81,92 +154,119 @@ pub fn native_open_serial_port(
     .timeout(Duration::from_millis(DEFAULT_IO_TIMEOUT_MS))
     .open()
     .map_err(|error| format!("Failed to open serial port {path}: {error}"))?;
+  let reader_port = port
+    .try_clone()
+    .map_err(|error| format!("Failed to clone serial port {path}: {error}"))?;
+  let reader = SerialReader::spawn(reader_port, path.clone())?;
+  let pseudo_terminal = is_pseudo_terminal(&path);
 
   let session_id = state.next_session_id.fetch_add(1, Ordering::Relaxed);
   let mut sessions = lock_sessions(&state)?;
-  sessions.insert(session_id, SerialSession { path, port });
+  sessions.insert(
+    session_id,
+    SessionHandle {
+      session: Arc::new(Mutex::new(SerialSession {
+        path,
+        port,
+        reader,
+        pseudo_terminal,
+      })),
+      job_cancelled: Arc::new(AtomicBool::new(false)),
+    },
+  );
 
   Ok(NativeSerialSessionInfo { session_id })
 }
 
+/// 数据以原始请求体传入，会话与超时放在请求头中，避免数组序列化为 JSON
 #[tauri::command]
 pub fn native_serial_write(
   state: tauri::State<'_, NativePlatformState>,
-  session_id: u64,
-  bytes: Vec<u8>,
-  timeout_ms: Option<u64>,
+  request: Request<'_>,
 ) -> Result<(), String> {
-  with_session(&state, session_id, |session| {
-    session
-      .port
-      .set_timeout(Duration::from_millis(timeout_ms.unwrap_or(DEFAULT_IO_TIMEOUT_MS)))
-      .map_err(|error| format!("Failed to set serial timeout for {}: {error}", session.path))?;
-    session
-      .port
-      .write_all(&bytes)
-      .map_err(|error| format!("Failed to write serial data to {}: {error}", session.path))?;
-    session
-      .port
-      .flush()
-      .map_err(|error| format!("Failed to flush serial data to {}: {error}", session.path))
-  })
+  let session_id = header_value(&request, SESSION_ID_HEADER)?;
+  let timeout_ms = optional_header_value(&request, TIMEOUT_HEADER)?.unwrap_or(DEFAULT_IO_TIMEOUT_MS);
+  let bytes = raw_body(&request)?;
+  with_session(&state, session_id, |session| session.write_packet(bytes, timeout_ms))
 }
 
+/// 订阅会话的输入推送，返回当前 generation
+///
+/// 推送包为 `[generation:4 LE] data`，订阅后 `native_serial_read` 仅在推送暂停时有数据可读。
+#[tauri::command]
+pub fn native_serial_subscribe(
+  state: tauri::State<'_, NativePlatformState>,
+  session_id: u64,
+  on_data: Channel<Response>,
+) -> Result<u32, String> {
+  with_session(&state, session_id, |session| Ok(session.reader.subscribe(on_data)))
+}
+
+/// 从会话的接收缓冲读取，响应为原始字节，前端收到 ArrayBuffer
 #[tauri::command]
 pub fn native_serial_read(
   state: tauri::State<'_, NativePlatformState>,
   session_id: u64,
   length: usize,
   timeout_ms: Option<u64>,
-) -> Result<Vec<u8>, String> {
+) -> Result<Response, String> {
   with_session(&state, session_id, |session| {
-    let timeout_ms = timeout_ms.unwrap_or(DEFAULT_IO_TIMEOUT_MS);
-    let started_at = Instant::now();
     let mut buffer = vec![0_u8; length];
-    let mut offset = 0;
-
-    while offset < length {
-      let elapsed_ms = started_at.elapsed().as_millis() as u64;
-      if elapsed_ms >= timeout_ms {
-        return Err(format!(
-          "Read package timeout in {timeout_ms}ms for {}",
-          session.path
-        ));
-      }
-
-      let remaining_timeout = timeout_ms.saturating_sub(elapsed_ms).max(1);
-      session
-        .port
-        .set_timeout(Duration::from_millis(remaining_timeout))
-        .map_err(|error| format!("Failed to set serial timeout for {}: {error}", session.path))?;
-
-      match session.port.read(&mut buffer[offset..]) {
-        Ok(0) => {
-          return Err(format!(
-            "Read package returned no data for {}",
-            session.path
-          ));
-        }
-        Ok(bytes_read) => {
-          offset += bytes_read;
-        }
-        Err(error) if error.kind() == ErrorKind::TimedOut => {
-          return Err(format!(
-            "Read package timeout in {timeout_ms}ms for {}",
-            session.path
-          ));
-        }
-        Err(error) => {
-          return Err(format!(
-            "Failed to read serial data from {}: {error}",
-            session.path
-          ));
-        }
-      }
-    }
+    session.read_exact(&mut buffer, timeout_ms.unwrap_or(DEFAULT_IO_TIMEOUT_MS))?;
+    Ok(Response::new(buffer))
+  })
+}
 
-    Ok(buffer)
+/// 在原生线程中执行整段读取/编程，仅向前端推送进度与最终结果
+///
+/// 任务描述（JSON）与进度通道放在请求头中，编程数据为原始请求体。
+/// 响应为原始字节：读取任务为数据本身，编程任务为 4 字节小端的实际编程字节数。
+#[tauri::command]
+pub async fn native_serial_run_job(
+  webview: tauri::Webview,
+  state: tauri::State<'_, NativePlatformState>,
+  request: Request<'_>,
+) -> Result<Response, String> {
+  let session_id = header_value(&request, SESSION_ID_HEADER)?;
+  let job: NativeJob = serde_json::from_str(header_str(&request, JOB_HEADER)?)
+    .map_err(|error| format!("Invalid native job: {error}"))?;
+  let on_progress = JavaScriptChannelId::from_str(header_str(&request, PROGRESS_CHANNEL_HEADER)?)
+    .map_err(|_| "Invalid native job progress channel".to_string())?
+    .channel_on::<_, NativeJobProgress>(webview);
+  let data = raw_body(&request)?.to_vec();
+  let handle = session_handle(&state, session_id)?;
+  handle.job_cancelled.store(false, Ordering::Relaxed);
+
+  tauri::async_runtime::spawn_blocking(move || {
+    let mut session = handle
+      .session
+      .lock()
+      .map_err(|_| format!("Serial session {session_id} is poisoned"))?;
+    // 任务期间响应留在原生缓冲中由任务读取，不推送给前端
+    session.reader.set_forwarding_paused(true);
+    let result = native_jobs::run_job(&mut *session, &job, &data, &handle.job_cancelled, |progress| {
+      let _ = on_progress.send(progress);
+    });
+    session.reader.set_forwarding_paused(false);
+    let result = result?;
+    Ok(Response::new(match job {
+      NativeJob::Dump { .. } => result.data,
+      NativeJob::Program { .. } => (result.programmed_bytes as u32).to_le_bytes().to_vec(),
+    }))
   })
+  .await
+  .map_err(|error| format!("Native job thread failed: {error}"))?
+}
+
+#[tauri::command]
+pub fn native_serial_cancel_job(
+  state: tauri::State<'_, NativePlatformState>,
+  session_id: u64,
+) -> Result<(), String> {
+  session_handle(&state, session_id)?
+    .job_cancelled
+    .store(true, Ordering::Relaxed);
+  Ok(())
 }
 
 #[tauri::command]
@@ -177,6 +277,10 @@ pub fn native_serial_set_signals(
   request_to_send: Option<bool>,
 ) -> Result<(), String> {
   with_session(&state, session_id, |session| {
+    // 虚拟烧录器在每次打开时自行按 DTR 上升沿复位
+    if session.pseudo_terminal {
+      return Ok(());
+    }
     if let Some(value) = data_terminal_ready {
       session
         .port
@@ -193,17 +297,13 @@ pub fn native_serial_set_signals(
   })
 }
 
+/// 清空输入，返回新的 generation；前端丢弃 generation 更小的在途推送
 #[tauri::command]
 pub fn native_serial_flush_input(
   state: tauri::State<'_, NativePlatformState>,
   session_id: u64,
-) -> Result<(), String> {
-  with_session(&state, session_id, |session| {
-    session
-      .port
-      .clear(ClearBuffer::Input)
-      .map_err(|error| format!("Failed to clear input buffer for {}: {error}", session.path))
-  })
+) -> Result<u32, String> {
+  with_session(&state, session_id, |session| session.clear_input())
 }
 
 #[tauri::command]
@@ -212,20 +312,17 @@ pub fn native_serial_close(
   session_id: u64,
 ) -> Result<(), String> {
   let mut sessions = lock_sessions(&state)?;
-  sessions
+  let handle = sessions
     .remove(&session_id)
-    .map(|_| ())
-    .ok_or_else(|| format!("Serial session {session_id} is not open"))
+    .ok_or_else(|| format!("Serial session {session_id} is not open"))?;
+  // 运行中的任务持有会话，端口在任务退出后释放
+  handle.job_cancelled.store(true, Ordering::Relaxed);
+  Ok(())
 }
 
 #[tauri::command]
 pub fn save_binary_file(suggested_filename: String, bytes: Vec<u8>) -> Result<Option<String>, String> {
-  let mut dialog = rfd::FileDialog::new();
-  if !suggested_filename.trim().is_empty() {
-    dialog = dialog.set_file_name(&suggested_filename);
-  }
-
-  let Some(target_path) = dialog.save_file() else {
+  let Some(target_path) = pick_save_path(&suggested_filename) else {
     return Ok(None);
   };
 
@@ -235,6 +332,110 @@ pub fn save_binary_file(suggested_filename: String, bytes: Vec<u8>) -> Result<Op
   Ok(Some(display_path(&target_path)))
 }
 
+/// 选择保存位置并创建转储文件；用户取消时返回 None
+#[tauri::command]
+pub fn native_open_dump_sink(
+  state: tauri::State<'_, NativePlatformState>,
+  suggested_filename: String,
+) -> Result<Option<NativeDumpSinkInfo>, String> {
+  let Some(path) = pick_save_path(&suggested_filename) else {
+    return Ok(None);
+  };
+  let file = OpenOptions::new()
+    .write(true)
+    .create(true)
+    .open(&path)
+    .map_err(|error| format!("Failed to create {}: {error}", display_path(&path)))?;
+
+  let sink_id = state.next_sink_id.fetch_add(1, Ordering::Relaxed);
+  let info = NativeDumpSinkInfo {
+    sink_id,
+    path: display_path(&path),
+  };
+  lock_dump_sinks(&state)?.insert(
+    sink_id,
+    DumpSink {
+      path,
+      writer: BufWriter::with_capacity(DUMP_SINK_BUFFER_SIZE, file),
+      started: false,
+    },
+  );
+  Ok(Some(info))
+}
+
+/// 续写上次保留的部分文件：已有内容不短于 `offset` 时截断到 `offset` 并返回 true，否则从头写入
+#[tauri::command]
+pub fn native_dump_sink_resume(
+  state: tauri::State<'_, NativePlatformState>,
+  sink_id: u64,
+  offset: u64,
+) -> Result<bool, String> {
+  let mut sinks = lock_dump_sinks(&state)?;
+  let sink = sinks
+    .get_mut(&sink_id)
+    .ok_or_else(|| format!("Dump sink {sink_id} is not open"))?;
+  if sink.started {
+    return Ok(false);
+  }
+
+  let existing = sink
+    .writer
+    .get_ref()
+    .metadata()
+    .map_err(|error| format!("Failed to inspect {}: {error}", display_path(&sink.path)))?
+    .len();
+  let resumed = existing >= offset;
+  sink
+    .start_at(if resumed { offset } else { 0 })
+    .map_err(|error| format!("Failed to truncate {}: {error}", display_path(&sink.path)))?;
+  Ok(resumed)
+}
+
+/// 数据为原始请求体，转储 ID 在请求头中
+#[tauri::command]
+pub fn native_dump_sink_write(
+  state: tauri::State<'_, NativePlatformState>,
+  request: Request<'_>,
+) -> Result<(), String> {
+  let sink_id: u64 = header_value(&request, SINK_ID_HEADER)?;
+  let bytes = raw_body(&request)?;
+  let mut sinks = lock_dump_sinks(&state)?;
+  let sink = sinks
+    .get_mut(&sink_id)
+    .ok_or_else(|| format!("Dump sink {sink_id} is not open"))?;
+  sink.ensure_started()?;
+  sink
+    .writer
+    .write_all(bytes)
+    .map_err(|error| format!("Failed to write {}: {error}", display_path(&sink.path)))
+}
+
+/// 完成或放弃转储；放弃时删除已写入的部分文件，完成或保留续写时落盘
+#[tauri::command]
+pub fn native_dump_sink_close(
+  state: tauri::State<'_, NativePlatformState>,
+  sink_id: u64,
+  discard: bool,
+) -> Result<(), String> {
+  let mut sink = lock_dump_sinks(&state)?
+    .remove(&sink_id)
+    .ok_or_else(|| format!("Dump sink {sink_id} is not open"))?;
+
+  if discard {
+    let DumpSink { path, writer, .. } = sink;
+    drop(writer);
+    return std::fs::remove_file(&path)
+      .map_err(|error| format!("Failed to remove {}: {error}", display_path(&path)));
+  }
+
+  sink.ensure_started()?;
+  let DumpSink { path, mut writer, .. } = sink;
+  writer
+    .flush()
+    .and_then(|_| writer.get_ref().sync_all())
+    .map_err(|error| format!("Failed to finish {}: {error}", display_path(&path)))
+}
+
 #[tauri::command]
 pub fn native_runtime_metadata(app: tauri::AppHandle) -> RuntimeMetadata {
   let package_info = app.package_info();
@@ -250,23 +451,117 @@ pub fn native_runtime_metadata(app: tauri::AppHandle) -> RuntimeMetadata {
 
 fn lock_sessions<'a>(
   state: &'a tauri::State<'_, NativePlatformState>,
-) -> Result<std::sync::MutexGuard<'a, HashMap<u64, SerialSession>>, String> {
+) -> Result<std::sync::MutexGuard<'a, HashMap<u64, SessionHandle>>, String> {
   state
     .serial_sessions
     .lock()
     .map_err(|_| "Native serial session state is poisoned".to_string())
 }
 
+fn lock_dump_sinks<'a>(
+  state: &'a tauri::State<'_, NativePlatformState>,
+) -> Result<std::sync::MutexGuard<'a, HashMap<u64, DumpSink>>, String> {
+  state
+    .dump_sinks
+    .lock()
+    .map_err(|_| "Native dump sink state is poisoned".to_string())
+}
+
+fn pick_save_path(suggested_filename: &str) -> Option<PathBuf> {
+  let mut dialog = rfd::FileDialog::new();
+  if !suggested_filename.trim().is_empty() {
+    dialog = dialog.set_file_name(suggested_filename);
+  }
+  dialog.save_file()
+}
+
+pub(crate) fn header_str<'a>(request: &'a Request<'_>, name: &str) -> Result<&'a str, String> {
+  request
+    .headers()
+    .get(name)
+    .ok_or_else(|| format!("Missing {name} header"))?
+    .to_str()
+    .map_err(|_| format!("Invalid {name} header"))
+}
+
+pub(crate) fn header_value<T: FromStr>(request: &Request<'_>, name: &str) -> Result<T, String> {
+  header_str(request, name)?
+    .parse()
+    .map_err(|_| format!("Invalid {name} header"))
+}
+
+fn optional_header_value<T: FromStr>(request: &Request<'_>, name: &str) -> Result<Option<T>, String> {
+  if request.headers().contains_key(name) {
+    header_value(request, name).map(Some)
+  } else {
+    Ok(None)
+  }
+}
+
+pub(crate) fn raw_body<'a>(request: &'a Request<'_>) -> Result<&'a [u8], String> {
+  match request.body() {
+    InvokeBody::Raw(bytes) => Ok(bytes),
+    _ => Err("Expected a binary request body".to_string()),
+  }
+}
+
+fn session_handle(
+  state: &tauri::State<'_, NativePlatformState>,
+  session_id: u64,
+) -> Result<SessionHandle, String> {
+  lock_sessions(state)?
+    .get(&session_id)
+    .cloned()
+    .ok_or_else(|| format!("Serial session {session_id} is not open"))
+}
+
 fn with_session<T>(
   state: &tauri::State<'_, NativePlatformState>,
   session_id: u64,
   operation: impl FnOnce(&mut SerialSession) -> Result<T, String>,
 ) -> Result<T, String> {
-  let mut sessions = lock_sessions(state)?;
-  let session = sessions
-    .get_mut(&session_id)
-    .ok_or_else(|| format!("Serial session {session_id} is not open"))?;
-  operation(session)
+  let handle = session_handle(state, session_id)?;
+  let mut session = handle
+    .session
+    .lock()
+    .map_err(|_| format!("Serial session {session_id} is poisoned"))?;
+  operation(&mut session)
+}
+
+impl JobPort for SerialSession {
+  fn write_packet(&mut self, packet: &[u8], timeout_ms: u64) -> Result<(), String> {
+    self
+      .port
+      .set_timeout(Duration::from_millis(timeout_ms))
+      .map_err(|error| format!("Failed to set serial timeout for {}: {error}", self.path))?;
+    self
+      .port
+      .write_all(packet)
+      .map_err(|error| format!("Failed to write serial data to {}: {error}", self.path))?;
+    self
+      .port
+      .flush()
+      .map_err(|error| format!("Failed to flush serial data to {}: {error}", self.path))
+  }
+
+  fn read_exact(&mut self, buffer: &mut [u8], timeout_ms: u64) -> Result<(), String> {
+    self.reader.read_exact(buffer, timeout_ms, &self.path)
+  }
+
+  fn discard_input(&mut self) -> Result<(), String> {
+    self.clear_input().map(|_| ())
+  }
+}
+
+impl SerialSession {
+  /// 先清空驱动缓冲，再清空读取线程的缓冲，避免线程已读出的旧字节残留
+  fn clear_input(&mut self) -> Result<u32, String> {
+    self
+      .port
+      .clear(ClearBuffer::Input)
+      .map_err(|error| format!("Failed to clear input buffer for {}: {error}", self.path))?;
+    Ok(self.reader.discard())
+  }
 }
 
 fn display_path(path: &PathBuf) -> String {
@@ -297,6 +592,18 @@ impl From<serialport::SerialPortInfo> for NativeSerialPortInfo {
 }
 
 impl NativeSerialPortInfo {
+  fn virtual_burner(path: String) -> Self {
+    Self {
+      path,
+      manufacturer: Some("Beggar Socket".to_string()),
+      product: Some("Virtual Burner".to_string()),
+      serial_number: None,
+      vendor_id: Some("0483".to_string()),
+      product_id: Some("0721".to_string()),
+      port_type: "Virtual".to_string(),
+    }
+  }
+
   fn simple(path: String, port_type: &str) -> Self {
     Self {
       path,
@@ -309,3 +616,15 @@ impl NativeSerialPortInfo {
     }
   }
 }
+
+#[cfg(target_os = "linux")]
+fn is_pseudo_terminal(path: &str) -> bool {
+  std::fs::canonicalize(path)
+    .map(|path| path.starts_with("/dev/pts"))
+    .unwrap_or(false)
+}
+
+#[cfg(not(target_os = "linux"))]
+fn is_pseudo_terminal(_path: &str) -> bool {
+  false
+}
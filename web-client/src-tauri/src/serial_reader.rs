@@ -0,0 +1,241 @@
+use serialport::SerialPort;
+use std::{
+  collections::VecDeque,
+  io::{ErrorKind, Read},
+  sync::{
+    atomic::{AtomicBool, AtomicU32, Ordering},
+    Arc, Condvar, Mutex, MutexGuard, PoisonError,
+  },
+  thread::{self, JoinHandle},
+  time::{Duration, Instant},
+};
+use tauri::ipc::{Channel, Response};
+
+/// 环形缓冲上限；写满后读取线程暂停，背压交给驱动缓冲与 USB 流控，不丢字节
+const RX_BUFFER_CAPACITY: usize = 1 << 20;
+const READ_CHUNK_SIZE: usize = 16 * 1024;
+/// 读取线程的空闲轮询间隔，同时决定关闭会话时的最长等待
+const IDLE_POLL: Duration = Duration::from_millis(20);
+const GENERATION_BYTES: usize = 4;
+
+/// 会话后台读取线程
+///
+/// 线程持续把驱动缓冲读入环形缓冲。前端订阅后数据直接推送，
+/// 推送包格式为 `[generation:4 LE] data`：每次清空输入 generation 加一，
+/// 前端据此丢弃清空前仍在途的数据。原生任务运行期间暂停推送，任务直接从缓冲读取。
+pub struct SerialReader {
+  shared: Arc<Shared>,
+  thread: Option<JoinHandle<()>>,
+}
+
+struct Shared {
+  state: Mutex<RxState>,
+  /// 与 `RxState::generation` 同步，读取线程在每次 `read` 前快照，识别清空前已读出的字节
+  generation: AtomicU32,
+  data_ready: Condvar,
+  space_ready: Condvar,
+  stop: AtomicBool,
+}
+
+struct RxState {
+  buffer: VecDeque<u8>,
+  generation: u32,
+  subscriber: Option<Channel<Response>>,
+  forwarding_paused: bool,
+  error: Option<String>,
+}
+
+impl SerialReader {
+  pub fn spawn(mut port: Box<dyn SerialPort>, path: String) -> Result<Self, String> {
+    port
+      .set_timeout(IDLE_POLL)
+      .map_err(|error| format!("Failed to set serial timeout for {path}: {error}"))?;
+
+    let shared = Arc::new(Shared {
+      state: Mutex::new(RxState {
+        buffer: VecDeque::with_capacity(READ_CHUNK_SIZE),
+        generation: 0,
+        subscriber: None,
+        forwarding_paused: false,
+        error: None,
+      }),
+      generation: AtomicU32::new(0),
+      data_ready: Condvar::new(),
+      space_ready: Condvar::new(),
+      stop: AtomicBool::new(false),
+    });
+
+    let thread_shared = Arc::clone(&shared);
+    let thread = thread::Builder::new()
+      .name(format!("serial-reader {path}"))
+      .spawn(move || read_loop(port, &path, &thread_shared))
+      .map_err(|error| format!("Failed to start serial reader: {error}"))?;
+
+    Ok(Self {
+      shared,
+      thread: Some(thread),
+    })
+  }
+
+  /// 从缓冲取出恰好 `target.len()` 字节，数据不足时等待读取线程
+  pub fn read_exact(&self, target: &mut [u8], timeout_ms: u64, path: &str) -> Result<(), String> {
+    let deadline = Instant::now() + Duration::from_millis(timeout_ms);
+    let mut state = self.shared.lock();
+
+    loop {
+      if state.buffer.len() >= target.len() {
+        take_front(&mut state.buffer, target);
+        self.shared.space_ready.notify_all();
+        return Ok(());
+      }
+      if let Some(error) = &state.error {
+        return Err(error.clone());
+      }
+
+      let now = Instant::now();
+      if now >= deadline {
+        return Err(format!("Read package timeout in {timeout_ms}ms for {path}"));
+      }
+      state = self
+        .shared
+        .data_ready
+        .wait_timeout(state, deadline - now)
+        .unwrap_or_else(PoisonError::into_inner)
+        .0;
+    }
+  }
+
+  /// 清空缓冲并进入新的 generation
+  pub fn discard(&self) -> u32 {
+    let mut state = self.shared.lock();
+    state.buffer.clear();
+    state.generation = state.generation.wrapping_add(1);
+    self.shared.generation.store(state.generation, Ordering::Release);
+    self.shared.space_ready.notify_all();
+    state.generation
+  }
+
+  /// 订阅推送；已缓冲的数据立即推送
+  pub fn subscribe(&self, channel: Channel<Response>) -> u32 {
+    let mut state = self.shared.lock();
+    state.subscriber = Some(channel);
+    forward(&mut state, &[]);
+    self.shared.space_ready.notify_all();
+    state.generation
+  }
+
+  pub fn set_forwarding_paused(&self, paused: bool) {
+    let mut state = self.shared.lock();
+    state.forwarding_paused = paused;
+    if !paused {
+      forward(&mut state, &[]);
+      self.shared.space_ready.notify_all();
+    }
+  }
+}
+
+impl Drop for SerialReader {
+  fn drop(&mut self) {
+    self.shared.stop.store(true, Ordering::Relaxed);
+    self.shared.space_ready.notify_all();
+    if let Some(thread) = self.thread.take() {
+      let _ = thread.join();
+    }
+  }
+}
+
+impl Shared {
+  fn lock(&self) -> MutexGuard<'_, RxState> {
+    self.state.lock().unwrap_or_else(PoisonError::into_inner)
+  }
+
+  fn accept(&self, bytes: &[u8], generation: u32) {
+    let mut state = self.lock();
+    if state.generation != generation {
+      return;
+    }
+    if forward(&mut state, bytes) {
+      return;
+    }
+
+    while state.buffer.len() + bytes.len() > RX_BUFFER_CAPACITY && !self.stop.load(Ordering::Relaxed) {
+      state = self
+        .space_ready
+        .wait_timeout(state, IDLE_POLL)
+        .unwrap_or_else(PoisonError::into_inner)
+        .0;
+      if state.generation != generation {
+        return;
+      }
+      // 等待期间前端可能已订阅或任务结束
+      if forward(&mut state, bytes) {
+        return;
+      }
+    }
+    state.buffer.extend(bytes);
+    self.data_ready.notify_all();
+  }
+
+  fn fail(&self, error: String) {
+    self.lock().error = Some(error);
+    self.data_ready.notify_all();
+  }
+}
+
+/// 有订阅者且未暂停时，把缓冲中剩余的数据与新数据按顺序推送，返回是否已推送
+fn forward(state: &mut RxState, bytes: &[u8]) -> bool {
+  if state.forwarding_paused {
+    return false;
+  }
+  let Some(subscriber) = &state.subscriber else {
+    return false;
+  };
+  if state.buffer.is_empty() && bytes.is_empty() {
+    return true;
+  }
+
+  let mut packet = Vec::with_capacity(GENERATION_BYTES + state.buffer.len() + bytes.len());
+  packet.extend_from_slice(&state.generation.to_le_bytes());
+  let (front, back) = state.buffer.as_slices();
+  packet.extend_from_slice(front);
+  packet.extend_from_slice(back);
+  packet.extend_from_slice(bytes);
+
+  if subscriber.send(Response::new(packet)).is_ok() {
+    state.buffer.clear();
+    true
+  } else {
+    // 前端已卸载，退回缓冲模式
+    state.subscriber = None;
+    false
+  }
+}
+
+fn take_front(queue: &mut VecDeque<u8>, target: &mut [u8]) {
+  let length = target.len();
+  let (front, back) = queue.as_slices();
+  let head = front.len().min(length);
+  target[..head].copy_from_slice(&front[..head]);
+  target[head..].copy_from_slice(&back[..length - head]);
+  queue.drain(..length);
+}
+
+fn read_loop(mut port: Box<dyn SerialPort>, path: &str, shared: &Shared) {
+  let mut chunk = vec![0_u8; READ_CHUNK_SIZE];
+
+  while !shared.stop.load(Ordering::Relaxed) {
+    // 读取阻塞期间可能发生清空，快照必须早于读取，读出的字节才不会记到新的 generation 上
+    let generation = shared.generation.load(Ordering::Acquire);
+    match port.read(&mut chunk) {
+      Ok(0) => {}
+      Ok(bytes_read) => {
+        shared.accept(&chunk[..bytes_read], generation);
+      }
+      Err(error) if matches!(error.kind(), ErrorKind::TimedOut | ErrorKind::Interrupted) => {}
+      Err(error) => {
+        shared.fail(format!("Failed to read serial data from {path}: {error}"));
+        return;
+      }
+    }
+  }
+}
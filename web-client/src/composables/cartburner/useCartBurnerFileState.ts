@@ -1,9 +1,13 @@
 import { ref } from 'vue';
 
-import { saveBinaryFile } from '@/platform/native';
+import { openDumpSink, type OpenDumpSinkResult, saveBinaryFile } from '@/platform/native';
+import { isTauriRuntime } from '@/platform/runtime';
 import type { FileInfo } from '@/types/file-info';
 import { formatBytes } from '@/utils/formatter-utils';
 
+/** 浏览器下超过该大小的 ROM 才改为流式写文件，小镜像仍走下载，免去保存对话框 */
+const WEB_STREAM_DUMP_THRESHOLD = 32 * 1024 * 1024;
+
 export function useCartBurnerFileState(log: (message: string) => void, translate: (key: string, params?: Record<string, unknown>) => string) {
   const romFileData = ref<Uint8Array | null>(null);
   const romFileName = ref('');
@@ -90,6 +94,21 @@ export function useCartBurnerFileState(log: (message: string) => void, translate
     return saveBinaryFile(data, filename);
   }
 
+  /**
+   * ROM 转储是否边读边写文件：Tauri 下总是如此，浏览器仅对大镜像且支持 File System Access 时启用
+   */
+  function shouldStreamRomDump(size: number): boolean {
+    return isTauriRuntime()
+      || (size > WEB_STREAM_DUMP_THRESHOLD && typeof window.showSaveFilePicker === 'function');
+  }
+
+  /**
+   * 为 ROM 转储打开流式写入目标；返回 supported: false 时由调用方读入内存后保存
+   */
+  async function openRomDumpSink(filename: string): Promise<OpenDumpSinkResult> {
+    return openDumpSink(filename);
+  }
+
   async function onFileNameSelected(fileName: string) {
     if (pendingRamData.value) {
       const fileExtension = fileName.includes('.') ? '' : '.sav';
@@ -127,5 +146,7 @@ export function useCartBurnerFileState(log: (message: string) => void, translate
     onRamTypeChange,
     onFileNameSelected,
     saveAsFile,
+    shouldStreamRomDump,
+    openRomDumpSink,
   };
 }
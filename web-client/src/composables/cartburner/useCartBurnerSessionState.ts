@@ -2,9 +2,17 @@ import { DateTime } from 'luxon';
 import { computed, onScopeDispose, ref } from 'vue';
 
 import { BurnerSession, runBurnerFlow } from '@/features/burner/application';
-import type { BurnerLogEntry, BurnerLogLevel } from '@/types/burner-log';
+import { openDumpSink } from '@/platform/native';
+import { beginCommandProfile } from '@/services/command-profiling';
+import type { BurnerLogLevel } from '@/types/burner-log';
 import { DEFAULT_PROGRESS, type ProgressInfo } from '@/types/progress-info';
-import { type BurnerLogInput, formatBurnerLogMessage } from '@/utils/burner-log';
+import { type BurnerLogInput, errorToBurnerLog, formatBurnerLogMessage } from '@/utils/burner-log';
+import { downloadBlob } from '@/utils/file-io';
+import { writeLogEntries } from '@/utils/log-store';
+import { FrameCoalescer } from '@/utils/progress/frame-coalescer';
+
+/** 界面只渲染可见行，可以保留比会话默认值更多的历史 */
+const BURNER_LOG_CAPACITY = 5000;
 
 interface ExecuteOperationOptions<TResult> {
   cancellable?: boolean;
@@ -14,15 +22,31 @@ interface ExecuteOperationOptions<TResult> {
   onError: (error: unknown) => void | Promise<void>;
 }
 
-export function useCartBurnerSessionState(translate: (key: string) => string) {
-  const burnerSession = new BurnerSession();
+export function useCartBurnerSessionState(translate: (key: string, params?: Record<string, unknown>) => string) {
+  const burnerSession = new BurnerSession(BURNER_LOG_CAPACITY);
   const busy = ref(false);
-  const logs = ref<BurnerLogEntry[]>([]);
+  // 日志留在会话的环形缓冲中，界面按版本号增量同步；logs 只在被读取时复制
+  const logRevision = ref(0);
+  const logs = computed(() => {
+    void logRevision.value;
+    return burnerSession.logStore.toArray();
+  });
+  const latestLog = computed(() => {
+    void logRevision.value;
+    const store = burnerSession.logStore;
+    return store.at(store.length - 1);
+  });
   const progressInfo = ref<ProgressInfo>({ ...DEFAULT_PROGRESS });
   const keepProgressModalOpen = ref(false);
+  // 传输循环的进度写入会话快照，界面每个动画帧最多同步一次
+  const progressFrame = new FrameCoalescer(() => { syncProgressState(); });
+  // 重试风暴等场景下日志同样按帧合并，日志量不再拖慢传输循环
+  const logFrame = new FrameCoalescer(() => { syncLogsState(); });
 
   // Abort any in-progress operation when the component scope is destroyed
   onScopeDispose(() => {
+    progressFrame.cancel();
+    logFrame.cancel();
     burnerSession.abortOperation();
   });
 
@@ -34,10 +58,12 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
   });
 
   function syncSessionState() {
+    progressFrame.cancel();
+    logFrame.cancel();
     const snapshot = burnerSession.snapshot;
     busy.value = snapshot.busy;
     progressInfo.value = { ...DEFAULT_PROGRESS, ...snapshot.progress };
-    logs.value = [...snapshot.logs];
+    logRevision.value++;
   }
 
   function syncProgressState() {
@@ -47,7 +73,7 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
   }
 
   function syncLogsState() {
-    logs.value = [...burnerSession.snapshot.logs];
+    logRevision.value++;
   }
 
   function updateProgress(info: ProgressInfo) {
@@ -56,7 +82,7 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
         return;
       }
       burnerSession.updateProgress(info);
-      syncProgressState();
+      progressFrame.schedule();
     }
   }
 
@@ -100,7 +126,7 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
       console.debug(`${consolePrefix}[details]`, consolePayload);
     }
     burnerSession.addLog(time, msg, level);
-    syncLogsState();
+    logFrame.schedule();
   }
 
   function clearLog() {
@@ -108,10 +134,47 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
     syncSessionState();
   }
 
+  /**
+   * 把保留的日志流式写入文件；不支持流式写文件时按块组装 Blob 下载
+   */
+  async function exportLogs() {
+    const filename = `burner-log-${DateTime.now().toFormat('yyyyLLdd-HHmmss')}.log`;
+    const store = burnerSession.logStore;
+    try {
+      const { supported, sink } = await openDumpSink(filename);
+      if (!supported) {
+        const parts: BlobPart[] = [];
+        const count = await writeLogEntries(store, (chunk) => {
+          parts.push(chunk as BlobPart);
+          return Promise.resolve();
+        });
+        downloadBlob(new Blob(parts, { type: 'text/plain' }), filename);
+        log(translate('messages.log.exportSuccess', { count, name: filename }), 'success');
+        return;
+      }
+      if (!sink) {
+        log(translate('messages.operation.cancelled'));
+        return;
+      }
+
+      try {
+        const count = await writeLogEntries(store, chunk => sink.write(chunk));
+        await sink.close();
+        log(translate('messages.log.exportSuccess', { count, name: sink.path ?? filename }), 'success');
+      } catch (error) {
+        await sink.abort().catch(() => undefined);
+        throw error;
+      }
+    } catch (error) {
+      log(errorToBurnerLog(translate('messages.log.exportFailed'), error), 'error');
+    }
+  }
+
   async function executeOperation<TResult>(options: ExecuteOperationOptions<TResult>) {
     keepProgressModalOpen.value = false;
     burnerSession.resetProgress();
     syncProgressState();
+    beginCommandProfile();
     return runBurnerFlow({
       session: burnerSession,
       cancellable: options.cancellable,
@@ -139,6 +202,8 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
     burnerSession,
     busy,
     logs,
+    logRevision,
+    latestLog,
     progressInfo,
     showProgressModal,
     updateProgress,
@@ -146,6 +211,7 @@ export function useCartBurnerSessionState(translate: (key: string) => string) {
     handleProgressClose,
     handleProgressStop,
     clearLog,
+    exportLogs,
     log,
     syncSessionState,
     executeOperation,
@@ -16,8 +16,8 @@ class CartridgeProtocolSessionAdapter implements BurnerProtocolSession {
     this.isActive = isActive;
   }
 
-  getCartInfo(enable5V?: boolean): Promise<CFIInfo | false> {
-    return this.adapter.getCartInfo(enable5V);
+  getCartInfo(enable5V?: boolean, refresh?: boolean): Promise<CFIInfo | false> {
+    return this.adapter.getCartInfo(enable5V, refresh);
   }
 
   eraseSectors(sectorInfo: SectorBlock[], options: CommandOptions, signal?: AbortSignal): Promise<CommandResult> {
@@ -74,8 +74,11 @@ async function wrapRuntimeCall<TData>(
 }
 
 export class CartridgeProtocolPortAdapter implements BurnerProtocolPort {
+  /**
+   * 用户主动读取卡带信息时可能刚换过卡带，总是重新识别芯片
+   */
   async readCartInfo(session: BurnerProtocolSession, enable5V: boolean): Promise<BurnerDomainResult<CFIInfo>> {
-    const result = await wrapRuntimeCall('protocol', 'Read cart info failed', () => session.getCartInfo(enable5V));
+    const result = await wrapRuntimeCall('protocol', 'Read cart info failed', () => session.getCartInfo(enable5V, true));
     if (!result.ok) {
       return result;
     }
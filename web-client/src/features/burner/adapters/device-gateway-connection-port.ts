@@ -46,9 +46,10 @@ async function withConnectionMapping<T>(
   }
 }
 
-export class DeviceGatewayConnectionPortAdapter implements BurnerConnectionPort {
-  private sequence = 0;
+/** 所有连接端口共用的序号，多台设备同时连接时句柄 id 也不会重复 */
+let connectionSequence = 0;
 
+export class DeviceGatewayConnectionPortAdapter implements BurnerConnectionPort {
   constructor(private readonly gateway: DeviceGateway) {}
 
   async list(): Promise<BurnerDomainResult<BurnerConnectionHandle['portInfo'][]>> {
@@ -67,8 +68,8 @@ export class DeviceGatewayConnectionPortAdapter implements BurnerConnectionPort
       return result;
     }
 
-    this.sequence += 1;
-    return successResult(toConnectionHandle(result.data, this.sequence));
+    connectionSequence += 1;
+    return successResult(toConnectionHandle(result.data, connectionSequence));
   }
 
   async init(handle: BurnerConnectionHandle): Promise<BurnerDomainResult<void>> {
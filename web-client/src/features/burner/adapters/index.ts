@@ -4,3 +4,5 @@ export {
 } from './cartridge-protocol-port';
 export { createConnectionOrchestrationUseCase } from './connection-orchestration-factory';
 export { DeviceGatewayConnectionPortAdapter } from './device-gateway-connection-port';
+export { createSectorDigestStore } from './sector-digest-store';
+export { createTransferJournalStore } from './transfer-journal-store';
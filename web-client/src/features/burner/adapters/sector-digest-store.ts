@@ -0,0 +1,61 @@
+import type { BurnerDigestCachePort } from '../application/domain/ports';
+import type { SectorDigestRecord } from '../application/domain/sector-digest';
+
+const STORAGE_PREFIX = 'sector_digests:';
+/** 最多保留的卡带记录数，超出时淘汰最久未写入的 */
+const MAX_RECORDS = 16;
+
+/**
+ * 扇区摘要保存在 localStorage，浏览器与 Tauri WebView 通用
+ * 单条记录只有几十 KB，存储不可用时视为没有缓存
+ */
+class LocalStorageSectorDigestStore implements BurnerDigestCachePort {
+  load(key: string): Promise<SectorDigestRecord | null> {
+    try {
+      const raw = localStorage.getItem(STORAGE_PREFIX + key);
+      return Promise.resolve(raw ? JSON.parse(raw) as SectorDigestRecord : null);
+    } catch {
+      return Promise.resolve(null);
+    }
+  }
+
+  save(record: SectorDigestRecord): Promise<void> {
+    try {
+      localStorage.setItem(STORAGE_PREFIX + record.key, JSON.stringify(record));
+      this.evictOldest();
+    } catch {
+      // localStorage might be unavailable or full. Ignore silently.
+    }
+    return Promise.resolve();
+  }
+
+  remove(key: string): Promise<void> {
+    try {
+      localStorage.removeItem(STORAGE_PREFIX + key);
+    } catch {
+      // Ignore silently.
+    }
+    return Promise.resolve();
+  }
+
+  private evictOldest(): void {
+    const records: { storageKey: string; updatedAt: number }[] = [];
+    for (let i = 0; i < localStorage.length; i++) {
+      const storageKey = localStorage.key(i);
+      if (!storageKey?.startsWith(STORAGE_PREFIX)) {
+        continue;
+      }
+      const record = JSON.parse(localStorage.getItem(storageKey) ?? '{}') as Partial<SectorDigestRecord>;
+      records.push({ storageKey, updatedAt: record.updatedAt ?? 0 });
+    }
+
+    records
+      .sort((a, b) => b.updatedAt - a.updatedAt)
+      .slice(MAX_RECORDS)
+      .forEach(({ storageKey }) => { localStorage.removeItem(storageKey); });
+  }
+}
+
+export function createSectorDigestStore(): BurnerDigestCachePort | undefined {
+  return typeof localStorage === 'undefined' ? undefined : new LocalStorageSectorDigestStore();
+}
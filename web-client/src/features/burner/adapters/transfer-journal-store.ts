@@ -0,0 +1,160 @@
+import {
+  appendNativeJournalData,
+  loadNativeJournal,
+  readNativeJournalData,
+  removeNativeJournal,
+  saveNativeJournal,
+} from '@/platform/native';
+import { isTauriRuntime } from '@/platform/runtime';
+
+import type { TransferJournal } from '../application/domain/journal';
+import type { BurnerJournalPort } from '../application/domain/ports';
+
+const DB_NAME = 'chisflash-transfer-journal';
+const DB_VERSION = 1;
+const JOURNAL_STORE = 'journals';
+const DATA_STORE = 'data';
+
+interface JournalDataRecord {
+  key: string;
+  offset: number;
+  data: Uint8Array;
+}
+
+function requestToPromise<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => { resolve(request.result); };
+    request.onerror = () => { reject(request.error ?? new Error('IndexedDB request failed')); };
+  });
+}
+
+function transactionDone(transaction: IDBTransaction): Promise<void> {
+  return new Promise((resolve, reject) => {
+    transaction.oncomplete = () => { resolve(); };
+    transaction.onerror = () => { reject(transaction.error ?? new Error('IndexedDB transaction failed')); };
+    transaction.onabort = () => { reject(transaction.error ?? new Error('IndexedDB transaction aborted')); };
+  });
+}
+
+/** 同一日志 offset 及之后的数据记录 */
+function dataRange(key: string, fromOffset = 0): IDBKeyRange {
+  return IDBKeyRange.bound([key, fromOffset], [key, Number.MAX_SAFE_INTEGER]);
+}
+
+/**
+ * 浏览器：日志与读取数据保存在 IndexedDB，数据按追加块分条存储
+ */
+class IndexedDbJournalStore implements BurnerJournalPort {
+  private database: Promise<IDBDatabase> | null = null;
+
+  async load(key: string): Promise<TransferJournal | null> {
+    const db = await this.open();
+    const journal = await requestToPromise(db.transaction(JOURNAL_STORE).objectStore(JOURNAL_STORE).get(key)) as TransferJournal | undefined;
+    return journal ?? null;
+  }
+
+  async save(journal: TransferJournal): Promise<void> {
+    const db = await this.open();
+    const transaction = db.transaction(JOURNAL_STORE, 'readwrite');
+    transaction.objectStore(JOURNAL_STORE).put(journal);
+    await transactionDone(transaction);
+  }
+
+  async remove(key: string): Promise<void> {
+    const db = await this.open();
+    const transaction = db.transaction([JOURNAL_STORE, DATA_STORE], 'readwrite');
+    transaction.objectStore(JOURNAL_STORE).delete(key);
+    transaction.objectStore(DATA_STORE).delete(dataRange(key));
+    await transactionDone(transaction);
+  }
+
+  async appendData(key: string, offset: number, data: Uint8Array): Promise<void> {
+    const db = await this.open();
+    const transaction = db.transaction(DATA_STORE, 'readwrite');
+    const store = transaction.objectStore(DATA_STORE);
+    store.delete(dataRange(key, offset));
+    store.put({ key, offset, data } satisfies JournalDataRecord);
+    await transactionDone(transaction);
+  }
+
+  /** 逐条游标读取直接填入结果，不经 getAll 在内存中再留一份全部记录 */
+  async readData(key: string, length: number): Promise<Uint8Array> {
+    const db = await this.open();
+    const request = db.transaction(DATA_STORE).objectStore(DATA_STORE).openCursor(dataRange(key));
+    const result = new Uint8Array(length);
+    let filled = 0;
+
+    await new Promise<void>((resolve, reject) => {
+      request.onsuccess = () => {
+        const cursor = request.result;
+        const record = cursor?.value as JournalDataRecord | undefined;
+        if (!cursor || !record || record.offset !== filled || filled >= length) {
+          resolve();
+          return;
+        }
+        const part = record.data.subarray(0, length - filled);
+        result.set(part, filled);
+        filled += part.byteLength;
+        cursor.continue();
+      };
+      request.onerror = () => { reject(request.error ?? new Error('IndexedDB request failed')); };
+    });
+    return filled === length ? result : result.subarray(0, filled);
+  }
+
+  private open(): Promise<IDBDatabase> {
+    this.database ??= new Promise<IDBDatabase>((resolve, reject) => {
+      const request = indexedDB.open(DB_NAME, DB_VERSION);
+      request.onupgradeneeded = () => {
+        const db = request.result;
+        db.createObjectStore(JOURNAL_STORE, { keyPath: 'key' });
+        db.createObjectStore(DATA_STORE, { keyPath: ['key', 'offset'] });
+      };
+      request.onsuccess = () => { resolve(request.result); };
+      request.onerror = () => { reject(request.error ?? new Error('Failed to open IndexedDB')); };
+    }).catch((error: unknown) => {
+      this.database = null;
+      throw error;
+    });
+    return this.database;
+  }
+}
+
+/**
+ * Tauri：日志与读取数据由后端保存在应用数据目录
+ */
+class NativeJournalStore implements BurnerJournalPort {
+  async load(key: string): Promise<TransferJournal | null> {
+    const content = await loadNativeJournal(key);
+    return content ? JSON.parse(content) as TransferJournal : null;
+  }
+
+  save(journal: TransferJournal): Promise<void> {
+    return saveNativeJournal(journal.key, JSON.stringify(journal));
+  }
+
+  remove(key: string): Promise<void> {
+    return removeNativeJournal(key);
+  }
+
+  appendData(key: string, offset: number, data: Uint8Array): Promise<void> {
+    return appendNativeJournalData(key, offset, data);
+  }
+
+  readData(key: string, length: number): Promise<Uint8Array> {
+    return readNativeJournalData(key, length);
+  }
+}
+
+/**
+ * 按运行环境创建断点日志存储；环境不支持时返回 undefined，读写不再记录断点
+ */
+export function createTransferJournalStore(): BurnerJournalPort | undefined {
+  if (isTauriRuntime()) {
+    return new NativeJournalStore();
+  }
+  if (typeof indexedDB !== 'undefined') {
+    return new IndexedDbJournalStore();
+  }
+  return undefined;
+}
@@ -1,16 +1,36 @@
 import { DEFAULT_PROGRESS, type ProgressInfo } from '@/types/progress-info';
 import type { BurnerLogInput } from '@/utils/burner-log';
+import { LogRingBuffer } from '@/utils/log-store';
 
 import type { BurnerSessionPort } from './domain/ports';
 import type { BurnerLogEntry, BurnerSessionState, LogLevel } from './types';
 
-export class BurnerSession implements BurnerSessionPort {
-  private readonly state: BurnerSessionState = {
+/** 默认保留的日志条数 */
+const DEFAULT_LOG_CAPACITY = 500;
+
+/**
+ * 会话状态快照；logs 在读取时才从环形缓冲复制，进度同步等热路径读取快照不会复制日志
+ */
+function createSessionState(logStore: LogRingBuffer<BurnerLogEntry>): BurnerSessionState {
+  return {
     busy: false,
     abortController: null,
     progress: { ...DEFAULT_PROGRESS },
-    logs: [],
+    get logs() {
+      return logStore.toArray();
+    },
   };
+}
+
+export class BurnerSession implements BurnerSessionPort {
+  /** 日志存放在定长环形缓冲中，长时间批量任务下追加仍是 O(1)、内存有上限 */
+  readonly logStore: LogRingBuffer<BurnerLogEntry>;
+  private readonly state: BurnerSessionState;
+
+  constructor(logCapacity = DEFAULT_LOG_CAPACITY) {
+    this.logStore = new LogRingBuffer(logCapacity);
+    this.state = createSessionState(this.logStore);
+  }
 
   get snapshot(): BurnerSessionState {
     return this.state;
@@ -73,10 +93,7 @@ export class BurnerSession implements BurnerSessionPort {
   }
 
   appendLog(entry: BurnerLogEntry) {
-    this.state.logs.push(entry);
-    if (this.state.logs.length > 500) {
-      this.state.logs.shift();
-    }
+    this.logStore.push(entry);
   }
 
   addLog(time: string, input: BurnerLogInput, level: LogLevel = 'info') {
@@ -84,6 +101,6 @@ export class BurnerSession implements BurnerSessionPort {
   }
 
   clearLogs() {
-    this.state.logs = [];
+    this.logStore.clear();
   }
 }
@@ -1,11 +1,15 @@
 import type { CommandOptions, MbcType } from '@/types/command-options';
 import type { CommandResult } from '@/types/command-result';
+import { formatBytes } from '@/utils/formatter-utils';
 import type { CFIInfo } from '@/utils/parsers/cfi-parser';
 import { parseRom, type RomInfo } from '@/utils/parsers/rom-parser';
 import { calcSectorUsage } from '@/utils/sector-utils';
 
-import type { BurnerProtocolPort, BurnerProtocolSession } from './domain/ports';
+import type { BurnerDigestCachePort, BurnerJournalPort, BurnerProtocolPort, BurnerProtocolSession } from './domain/ports';
 import type { BurnerDomainResult } from './domain/result';
+import { FINGERPRINT_SIZE, IncrementalWrite } from './incremental-write';
+import { DumpJournal, RESUMABLE_MIN_SIZE, WriteJournal } from './resumable-transfer';
+import type { LogLevel } from './types';
 
 export interface GameDetectionResult {
   startAddress: number;
@@ -45,6 +49,14 @@ export interface BurnerOperationContext {
   signal?: AbortSignal;
 }
 
+export interface BurnerUseCaseServices {
+  /** 断点日志存储，缺省时长任务不记录断点 */
+  journalPort?: BurnerJournalPort;
+  /** 扇区摘要缓存，缺省时每次整体写入 */
+  digestCachePort?: BurnerDigestCachePort;
+  log?: (message: string, level?: LogLevel) => void;
+}
+
 function toFailureResult(result: BurnerDomainResult<unknown>, fallbackMessage: string): CommandResult {
   if (result.ok) {
     return {
@@ -73,10 +85,15 @@ function toCommandResult(result: BurnerDomainResult<CommandResult>, fallbackMess
 export class BurnerUseCaseImpl implements BurnerUseCase {
   constructor(
     private readonly protocolPort: BurnerProtocolPort,
-    private readonly translate: (key: string) => string,
+    private readonly translate: (key: string, params?: Record<string, unknown>) => string,
     private readonly formatHex: (value: number, length?: number) => string,
+    private readonly services: BurnerUseCaseServices = {},
   ) {}
 
+  private log(message: string, level?: LogLevel): void {
+    this.services.log?.(message, level);
+  }
+
   private ensureSessionActive(session: BurnerProtocolSession): CommandResult | null {
     if (session.isActive && !session.isActive()) {
       return {
@@ -129,24 +146,79 @@ export class BurnerUseCaseImpl implements BurnerUseCase {
       return inactive;
     }
 
-    const result = await this.protocolPort.writeRom(context.session, context.data, context.options, context.signal);
+    const incremental = await this.planIncrementalWrite(context);
+    const options: CommandOptions = incremental
+      ? { ...context.options, unchangedSectors: incremental.unchangedSectors }
+      : context.options;
+
+    await incremental?.begin();
+    const result = await this.writeRomResumable({ ...context, options });
+    if (result.ok) {
+      await incremental?.complete();
+    }
     return toCommandResult(result, this.translate('messages.rom.writeFailed'));
   }
 
+  private async writeRomResumable(context: BurnerOperationContext & { data: Uint8Array }): Promise<BurnerDomainResult<CommandResult>> {
+    const { journalPort } = this.services;
+    const { session, data, options, signal } = context;
+    const size = options.size ?? data.byteLength;
+    if (!journalPort || size < RESUMABLE_MIN_SIZE) {
+      return this.protocolPort.writeRom(session, data, options, signal);
+    }
+
+    const journal = await WriteJournal.open(journalPort, context.cfiInfo, data, options);
+    const resumeOffset = await this.resolveWriteResume(journal, context);
+    const baseAddress = options.baseAddress ?? 0;
+    const result = await this.protocolPort.writeRom(
+      session,
+      data.subarray(resumeOffset),
+      { ...options, baseAddress: baseAddress + resumeOffset, size: size - resumeOffset, checkpoint: journal },
+      signal,
+    );
+    if (result.ok) {
+      await journal.discard();
+    }
+    return result;
+  }
+
   async readRom(context: BurnerOperationContext & { size: number; showProgress?: boolean }): Promise<CommandResult> {
     const inactive = this.ensureSessionActive(context.session);
     if (inactive) {
       return inactive;
     }
 
+    const { session, size, options, signal } = context;
+    const showProgress = context.showProgress ?? true;
+    const journal = await this.openDumpJournal(context);
+    if (!journal) {
+      const result = await this.protocolPort.readRom(session, size, options, signal, showProgress);
+      return toCommandResult(result, this.translate('messages.rom.readFailed'));
+    }
+
+    const { offset: resumeOffset, saved } = await this.resolveDumpResume(journal, context);
+    const baseAddress = options.baseAddress ?? 0;
     const result = await this.protocolPort.readRom(
-      context.session,
-      context.size,
-      context.options,
-      context.signal,
-      context.showProgress ?? true,
+      session,
+      size - resumeOffset,
+      { ...options, baseAddress: baseAddress + resumeOffset, checkpoint: journal },
+      signal,
+      showProgress,
     );
-    return toCommandResult(result, this.translate('messages.rom.readFailed'));
+    if (!result.ok) {
+      await journal.suspend();
+      return toCommandResult(result, this.translate('messages.rom.readFailed'));
+    }
+
+    await journal.discard();
+    const rest = result.data.data;
+    if (!saved || !rest) {
+      return result.data;
+    }
+    const data = new Uint8Array(size);
+    data.set(saved);
+    data.set(rest, resumeOffset);
+    return { ...result.data, data };
   }
 
   async verifyRom(context: BurnerOperationContext & { data: Uint8Array }): Promise<CommandResult> {
@@ -163,6 +235,153 @@ export class BurnerUseCaseImpl implements BurnerUseCase {
     return toCommandResult(result, this.translate('messages.rom.verifyFailed'));
   }
 
+  /**
+   * 读出卡带头部查找扇区摘要记录，并重读首尾两个未变化扇区确认记录属于这张卡带
+   */
+  private async planIncrementalWrite(context: BurnerOperationContext & { data: Uint8Array }): Promise<IncrementalWrite | null> {
+    const { digestCachePort } = this.services;
+    const { session, data, options } = context;
+    if (!digestCachePort || data.byteLength < FINGERPRINT_SIZE) {
+      return null;
+    }
+
+    const baseAddress = options.baseAddress ?? 0;
+    const signal = context.signal ?? new AbortController().signal;
+    const header = await this.protocolPort.readRom(session, FINGERPRINT_SIZE, { ...options, dumpSink: undefined }, signal, false);
+    const plan = await IncrementalWrite.plan(
+      digestCachePort,
+      context.cfiInfo,
+      data,
+      options,
+      header.ok ? header.data.data ?? null : null,
+    );
+    if (plan.unchangedSectors.size === 0) {
+      return plan;
+    }
+
+    for (const range of plan.checkRanges()) {
+      const result = await this.protocolPort.verifyRom(
+        session,
+        data.subarray(range.offset, range.offset + range.length),
+        { ...options, baseAddress: baseAddress + range.offset, size: range.length },
+        signal,
+      );
+      if (signal.aborted) {
+        return plan;
+      }
+      if (!result.ok) {
+        this.log(this.translate('messages.rom.incrementalMismatch'), 'warn');
+        plan.invalidate();
+        return plan;
+      }
+    }
+
+    this.log(this.translate('messages.rom.incrementalWrite', {
+      unchanged: plan.unchangedSectors.size,
+      total: plan.totalSectors,
+    }), 'info');
+    return plan;
+  }
+
+  /**
+   * 确定写入续传位置：断点之前首尾两个已完成扇区重读比对通过才续传，否则从头写入
+   */
+  private async resolveWriteResume(journal: WriteJournal, context: BurnerOperationContext & { data: Uint8Array }): Promise<number> {
+    const resumeOffset = journal.resumeOffset(context.data);
+    if (resumeOffset === 0) {
+      return 0;
+    }
+
+    const { session, data, options } = context;
+    const baseAddress = options.baseAddress ?? 0;
+    const signal = context.signal ?? new AbortController().signal;
+    for (const range of journal.checkRanges(resumeOffset)) {
+      const result = await this.protocolPort.verifyRom(
+        session,
+        data.subarray(range.offset, range.offset + range.length),
+        { ...options, baseAddress: baseAddress + range.offset, size: range.length },
+        signal,
+      );
+      if (signal.aborted) {
+        return resumeOffset;
+      }
+      if (!result.ok) {
+        this.log(this.translate('messages.rom.resumeMismatch'), 'warn');
+        journal.reset();
+        return 0;
+      }
+    }
+
+    this.log(this.translate('messages.rom.resumeWrite', {
+      address: this.formatHex(baseAddress + resumeOffset),
+      done: formatBytes(resumeOffset),
+    }), 'info');
+    return resumeOffset;
+  }
+
+  /**
+   * 打开读取断点：先读出卡带头部作为日志指纹
+   * 写入的文件不支持原地续写或读不出头部时不记录断点
+   */
+  private async openDumpJournal(context: BurnerOperationContext & { size: number }): Promise<DumpJournal | null> {
+    const { journalPort } = this.services;
+    const { session, size, options, signal } = context;
+    if (!journalPort || size < RESUMABLE_MIN_SIZE || (options.dumpSink && !options.dumpSink.resumeAt)) {
+      return null;
+    }
+
+    const header = await this.protocolPort.readRom(session, FINGERPRINT_SIZE, { ...options, dumpSink: undefined }, signal, false);
+    const data = header.ok ? header.data.data : undefined;
+    return data ? DumpJournal.open(journalPort, context.cfiInfo, options, size, data) : null;
+  }
+
+  /**
+   * 确定读取续传位置：重读断点前末尾一段与记录的摘要比对，不一致时从头读取
+   * 写入文件时在同一文件上原地续写，否则从日志存储读出已保存的数据
+   */
+  private async resolveDumpResume(
+    journal: DumpJournal,
+    context: BurnerOperationContext & { size: number },
+  ): Promise<{ offset: number; saved: Uint8Array | null }> {
+    const offset = journal.completedBytes;
+    if (offset === 0) {
+      return { offset: 0, saved: null };
+    }
+
+    const { session, options, signal } = context;
+    const baseAddress = options.baseAddress ?? 0;
+    const checkLength = journal.checkLength;
+    const result = await this.protocolPort.readRom(
+      session,
+      checkLength,
+      { ...options, baseAddress: baseAddress + offset - checkLength, dumpSink: undefined },
+      signal,
+      false,
+    );
+    const actual = result.ok ? result.data.data : undefined;
+    if (!actual || !(await journal.acceptTail(actual))) {
+      this.log(this.translate('messages.rom.resumeMismatch'), 'warn');
+      journal.reset();
+      return { offset: 0, saved: null };
+    }
+
+    const sink = options.dumpSink;
+    const saved = sink ? null : await journal.readSaved();
+    const resumed = sink
+      ? await sink.resumeAt?.(journal.sinkToken, offset).catch(() => false) ?? false
+      : saved !== null;
+    if (!resumed) {
+      journal.reset();
+      return { offset: 0, saved: null };
+    }
+
+    this.log(this.translate('messages.rom.resumeRead', {
+      address: this.formatHex(baseAddress + offset),
+      done: formatBytes(offset),
+    }), 'info');
+    return { offset, saved };
+  }
+
   async writeRam(context: BurnerOperationContext & { data: Uint8Array }): Promise<CommandResult> {
     const inactive = this.ensureSessionActive(context.session);
     if (inactive) {
@@ -0,0 +1,19 @@
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+export function toHexString(bytes: Uint8Array): string {
+  return Array.from(bytes, value => value.toString(16).padStart(2, '0')).join('');
+}
+
+export async function sha256Hex(data: Uint8Array): Promise<string> {
+  const digest = await crypto.subtle.digest('SHA-256', data as BufferSource);
+  return toHexString(new Uint8Array(digest));
+}
+
+/**
+ * 卡带标识：Flash ID 与容量
+ * 同型号的不同卡带无法区分，由使用方的重读比对兜底
+ */
+export function cartIdOf(cfi: CFIInfo): string {
+  const flashId = cfi.flashId ? toHexString(cfi.flashId) : 'unknown';
+  return `${flashId}-${cfi.deviceSize.toString(16)}`;
+}
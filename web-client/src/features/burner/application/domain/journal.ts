@@ -0,0 +1,26 @@
+export type TransferJournalKind = 'write' | 'dump';
+
+/**
+ * 长任务断点日志
+ *
+ * 写入按扇区记录完成情况；读取记录已保存的连续字节数，数据本身另行追加保存，
+ * 或已写入转储文件时只记录文件标识，续传时原地续写。
+ */
+export interface TransferJournal {
+  key: string;
+  kind: TransferJournalKind;
+  cartId: string;
+  /** 写入镜像的 SHA-256，读取时为空 */
+  imageHash?: string;
+  baseAddress: number;
+  size: number;
+  /** 写入：已编程完成的扇区起始地址 */
+  completedSectors: number[];
+  /** 读取：已保存的字节数 */
+  completedBytes: number;
+  /** 读取：已保存部分末尾一段的 SHA-256，续传前与卡带重读的数据比对 */
+  tailHash?: string;
+  /** 读取：数据写在转储文件中时的文件标识，见 DumpSink.resumeToken */
+  sinkToken?: unknown;
+  updatedAt: number;
+}
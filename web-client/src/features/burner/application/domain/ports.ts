@@ -1,10 +1,13 @@
 import type { CommandOptions } from '@/types/command-options';
 import type { CommandResult } from '@/types/command-result';
 import type { ProgressInfo } from '@/types/progress-info';
+import type { BurnerLogInput } from '@/utils/burner-log';
 import type { CFIInfo, SectorBlock } from '@/utils/parsers/cfi-parser';
 
-import type { BurnerSessionState } from '../types';
+import type { BurnerSessionState, LogLevel } from '../types';
+import type { TransferJournal } from './journal';
 import type { BurnerDomainResult } from './result';
+import type { SectorDigestRecord } from './sector-digest';
 
 export interface BurnerConnectionHandle {
   id: string;
@@ -35,7 +38,8 @@ export interface BurnerConnectionPort {
 export interface BurnerProtocolSession {
   readonly id: string;
   isActive?: () => boolean;
-  getCartInfo(enable5V?: boolean): Promise<CFIInfo | false>;
+  /** refresh 为 true 时忽略本次连接内缓存的卡带信息，重新识别芯片 */
+  getCartInfo(enable5V?: boolean, refresh?: boolean): Promise<CFIInfo | false>;
   eraseSectors(sectorInfo: SectorBlock[], options: CommandOptions, signal?: AbortSignal): Promise<CommandResult>;
   writeROM(data: Uint8Array, options: CommandOptions, signal?: AbortSignal): Promise<CommandResult>;
   readROM(size: number, options: CommandOptions, signal?: AbortSignal, showProgress?: boolean): Promise<CommandResult>;
@@ -87,3 +91,36 @@ export interface BurnerSessionPort {
   updateProgress(info: ProgressInfo): void;
   resetProgress(): void;
 }
+
+export type BurnerStationMode = 'gba' | 'mbc5';
+
+/**
+ * 工位中单台烧录器的日志与进度去向（每台设备一个 BurnerSession）
+ */
+export interface BurnerStationSink {
+  addLog(time: string, input: BurnerLogInput, level?: LogLevel): void;
+  updateProgress(info: ProgressInfo): void;
+}
+
+export interface BurnerStationDevicePort {
+  /** 每台烧录器使用独立的连接端口，连接状态互不影响 */
+  createConnectionPort(): BurnerConnectionPort;
+  /** 为已连接的设备创建协议会话，日志与进度写入 sink */
+  openSession(handle: BurnerConnectionHandle, mode: BurnerStationMode, sink: BurnerStationSink): Promise<BurnerProtocolSession>;
+}
+
+export interface BurnerJournalPort {
+  load(key: string): Promise<TransferJournal | null>;
+  save(journal: TransferJournal): Promise<void>;
+  /** 同时删除日志和已追加的数据 */
+  remove(key: string): Promise<void>;
+  /** 在 offset 处追加读取数据，offset 之后的旧数据被丢弃 */
+  appendData(key: string, offset: number, data: Uint8Array): Promise<void>;
+  readData(key: string, length: number): Promise<Uint8Array>;
+}
+
+export interface BurnerDigestCachePort {
+  load(key: string): Promise<SectorDigestRecord | null>;
+  save(record: SectorDigestRecord): Promise<void>;
+  remove(key: string): Promise<void>;
+}
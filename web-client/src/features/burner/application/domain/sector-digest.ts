@@ -0,0 +1,13 @@
+/**
+ * 卡带扇区摘要记录
+ *
+ * 保存上次写入后各扇区内容的摘要，再次写入同一卡带时只擦写内容变化的扇区。
+ */
+export interface SectorDigestRecord {
+  key: string;
+  cartId: string;
+  baseAddress: number;
+  /** 扇区起始地址（十六进制）到扇区内镜像数据 SHA-256 的映射 */
+  sectors: Record<string, string>;
+  updatedAt: number;
+}
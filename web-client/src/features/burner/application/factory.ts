@@ -1,13 +1,26 @@
 import { CartridgeProtocolPortAdapter } from '../adapters/cartridge-protocol-port';
+import { createSectorDigestStore } from '../adapters/sector-digest-store';
+import { createTransferJournalStore } from '../adapters/transfer-journal-store';
 import { type BurnerFacade, BurnerFacadeImpl, BurnerUseCaseImpl } from './burner-use-case';
+import type { LogLevel } from './types';
 
 export interface CreateBurnerFacadeOptions {
-  translate: (key: string) => string;
+  translate: (key: string, params?: Record<string, unknown>) => string;
   formatHex: (value: number, length?: number) => string;
+  log?: (message: string, level?: LogLevel) => void;
 }
 
 export function createBurnerFacade(options: CreateBurnerFacadeOptions): BurnerFacade {
   const protocolPort = new CartridgeProtocolPortAdapter();
-  const useCase = new BurnerUseCaseImpl(protocolPort, options.translate, options.formatHex);
+  const useCase = new BurnerUseCaseImpl(
+    protocolPort,
+    options.translate,
+    options.formatHex,
+    {
+      journalPort: createTransferJournalStore(),
+      digestCachePort: createSectorDigestStore(),
+      log: options.log,
+    },
+  );
   return new BurnerFacadeImpl(useCase);
 }
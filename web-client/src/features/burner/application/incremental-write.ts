@@ -0,0 +1,121 @@
+import type { CommandOptions } from '@/types/command-options';
+import type { SectorProgressInfo } from '@/types/progress-info';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+import { calcSectorUsage, createSectorProgressInfo } from '@/utils/sector-utils';
+
+import { cartIdOf, sha256Hex } from './cart-digest';
+import type { BurnerDigestCachePort } from './domain/ports';
+import type { SectorDigestRecord } from './domain/sector-digest';
+
+/** 卡带指纹取写入起始处的头部：GB 头部位于 0x100–0x14F，GBA 头部位于 0x00–0xBF */
+export const FINGERPRINT_SIZE = 0x150;
+
+async function recordKey(cfi: CFIInfo, baseAddress: number, header: Uint8Array): Promise<string> {
+  const fingerprint = await sha256Hex(header.subarray(0, FINGERPRINT_SIZE));
+  return `${cartIdOf(cfi)}:${baseAddress.toString(16)}:${fingerprint.slice(0, 16)}`;
+}
+
+/**
+ * 增量写入：按扇区比较新镜像与上次写入记录的摘要，只擦写内容变化的扇区
+ *
+ * 记录以卡带上现有头部为指纹查找，写入成功后改以新镜像的头部保存。
+ * 摘要缓存读写失败不影响写入本身，只是退回整体写入。
+ */
+export class IncrementalWrite {
+  private constructor(
+    private readonly port: BurnerDigestCachePort,
+    private readonly sectors: SectorProgressInfo[],
+    private readonly baseAddress: number,
+    private readonly size: number,
+    private readonly previous: SectorDigestRecord | null,
+    private readonly next: SectorDigestRecord,
+    readonly unchangedSectors: Set<number>,
+  ) {}
+
+  /**
+   * @param cartHeader - 从卡带写入起始处读出的头部，读取失败时为 null
+   */
+  static async plan(
+    port: BurnerDigestCachePort,
+    cfi: CFIInfo,
+    data: Uint8Array,
+    options: CommandOptions,
+    cartHeader: Uint8Array | null,
+  ): Promise<IncrementalWrite> {
+    const baseAddress = options.baseAddress ?? 0;
+    const size = options.size ?? data.byteLength;
+    const sectors = createSectorProgressInfo(calcSectorUsage(cfi.eraseSectorBlocks, size, baseAddress));
+
+    const digests: Record<string, string> = {};
+    for (const sector of sectors) {
+      const start = Math.max(0, sector.address - baseAddress);
+      const end = Math.min(size, sector.address + sector.size - baseAddress);
+      digests[sector.address.toString(16)] = await sha256Hex(data.subarray(start, end));
+    }
+
+    const previous = cartHeader
+      ? await port.load(await recordKey(cfi, baseAddress, cartHeader)).catch(() => null)
+      : null;
+    const unchangedSectors = new Set(
+      sectors
+        .filter((sector) => {
+          const key = sector.address.toString(16);
+          return previous?.sectors[key] === digests[key];
+        })
+        .map(sector => sector.address),
+    );
+    const next: SectorDigestRecord = {
+      key: await recordKey(cfi, baseAddress, data),
+      cartId: cartIdOf(cfi),
+      baseAddress,
+      sectors: digests,
+      updatedAt: Date.now(),
+    };
+    return new IncrementalWrite(port, sectors, baseAddress, size, previous, next, unchangedSectors);
+  }
+
+  get totalSectors(): number {
+    return this.sectors.length;
+  }
+
+  /** 写入前重读比对的扇区：首尾两个未变化扇区，防止同型号卡带误用记录 */
+  checkRanges(): { offset: number; length: number }[] {
+    const unchanged = this.sectors.filter(sector => this.unchangedSectors.has(sector.address));
+    const picked = unchanged.length > 1 ? [unchanged[0], unchanged[unchanged.length - 1]] : unchanged;
+
+    return picked.map((sector) => {
+      const offset = Math.max(0, sector.address - this.baseAddress);
+      return { offset, length: Math.min(this.size, sector.address + sector.size - this.baseAddress) - offset };
+    });
+  }
+
+  /** 比对不一致时放弃记录，整体写入 */
+  invalidate(): void {
+    this.unchangedSectors.clear();
+  }
+
+  /** 写入开始前：旧记录只保留未变化的扇区，写到一半失败时记录仍与卡带内容一致 */
+  async begin(): Promise<void> {
+    if (!this.previous) {
+      return;
+    }
+
+    if (this.unchangedSectors.size === 0) {
+      await this.port.remove(this.previous.key).catch(() => {});
+      return;
+    }
+    const sectors = Object.fromEntries([...this.unchangedSectors].map((address) => {
+      const key = address.toString(16);
+      return [key, this.next.sectors[key]];
+    }));
+    await this.port.save({ ...this.previous, sectors, updatedAt: Date.now() }).catch(() => {});
+  }
+
+  /** 写入成功后以新镜像的头部为指纹保存全部扇区摘要 */
+  async complete(): Promise<void> {
+    if (this.previous && this.previous.key !== this.next.key) {
+      await this.port.remove(this.previous.key).catch(() => {});
+    }
+    await this.port.save({ ...this.next, updatedAt: Date.now() }).catch(() => {});
+  }
+}
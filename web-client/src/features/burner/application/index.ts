@@ -4,6 +4,7 @@ export {
   BurnerFacadeImpl,
   type BurnerUseCase,
   BurnerUseCaseImpl,
+  type BurnerUseCaseServices,
   type GameDetectionResult,
 } from './burner-use-case';
 export { ConnectionOrchestrationUseCase } from './connection-use-case';
@@ -17,13 +18,19 @@ export type {
   ConnectionState,
   ConnectionUseCaseResult,
 } from './domain/connection';
+export type { TransferJournal, TransferJournalKind } from './domain/journal';
 export type {
   BurnerConnectionHandle,
   BurnerConnectionPort,
   BurnerConnectionSelection,
+  BurnerDigestCachePort,
+  BurnerJournalPort,
   BurnerProtocolPort,
   BurnerProtocolSession,
   BurnerSessionPort,
+  BurnerStationDevicePort,
+  BurnerStationMode,
+  BurnerStationSink,
 } from './domain/ports';
 export type {
   BurnerDomainError,
@@ -34,6 +41,17 @@ export type {
   BurnerErrorCode,
   BurnerErrorStage,
 } from './domain/result';
+export type { SectorDigestRecord } from './domain/sector-digest';
 export { createBurnerFacade, type CreateBurnerFacadeOptions } from './factory';
 export { type BurnerFlowContext, type BurnerFlowOptions, runBurnerFlow } from './flow-template';
+export {
+  BurnerStation,
+  type BurnerStationConnectResult,
+  type BurnerStationDevice,
+  type BurnerStationJob,
+  type BurnerStationJobContext,
+  type BurnerStationJobResult,
+  type BurnerStationRomWriteOptions,
+  type BurnerStationRunSummary,
+} from './station';
 export type { BurnerLogEntry, BurnerSessionState, LogLevel } from './types';
@@ -0,0 +1,298 @@
+import type { CommandOptions } from '@/types/command-options';
+import type { DumpSink } from '@/types/dump-sink';
+import type { TransferCheckpoint } from '@/types/transfer-checkpoint';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+import { calcSectorUsage, createSectorProgressInfo, isErasedData } from '@/utils/sector-utils';
+
+import { cartIdOf, sha256Hex } from './cart-digest';
+import type { TransferJournal } from './domain/journal';
+import type { BurnerJournalPort } from './domain/ports';
+import { FINGERPRINT_SIZE } from './incremental-write';
+
+/** 小于该大小的读写（如读取头部）不记录断点 */
+export const RESUMABLE_MIN_SIZE = 1 << 20;
+/** 超过该时长未更新的日志视为过期 */
+const JOURNAL_MAX_AGE_MS = 24 * 60 * 60 * 1000;
+/** 读取数据攒够该大小再追加保存，减少存储事务 */
+const DUMP_FLUSH_SIZE = 1 << 20;
+/** 读取续传前重读比对的末尾长度 */
+const DUMP_RESUME_CHECK_SIZE = 0x1000;
+
+interface SectorRange {
+  address: number;
+  size: number;
+}
+
+function isFresh(journal: TransferJournal): boolean {
+  return Date.now() - journal.updatedAt < JOURNAL_MAX_AGE_MS;
+}
+
+/**
+ * 写入断点：按扇区记录编程完成情况
+ *
+ * 日志保存失败不影响写入本身，只是之后无法续传。
+ */
+export class WriteJournal implements TransferCheckpoint {
+  private readonly completed: Set<number>;
+  private enabled = true;
+
+  private constructor(
+    private readonly port: BurnerJournalPort,
+    private readonly journal: TransferJournal,
+    private readonly sectors: SectorRange[],
+  ) {
+    this.completed = new Set(journal.completedSectors);
+  }
+
+  static async open(port: BurnerJournalPort, cfi: CFIInfo, data: Uint8Array, options: CommandOptions): Promise<WriteJournal> {
+    const baseAddress = options.baseAddress ?? 0;
+    const size = options.size ?? data.byteLength;
+    const cartId = cartIdOf(cfi);
+    const key = `write:${cartId}:${baseAddress.toString(16)}`;
+    const imageHash = await sha256Hex(data.subarray(0, size));
+    const sectors = createSectorProgressInfo(calcSectorUsage(cfi.eraseSectorBlocks, size, baseAddress));
+
+    const stored = await port.load(key).catch(() => null);
+    const reusable = stored?.kind === 'write'
+      && stored.imageHash === imageHash
+      && stored.size === size
+      && isFresh(stored);
+    const journal: TransferJournal = reusable
+      ? stored
+      : { key, kind: 'write', cartId, imageHash, baseAddress, size, completedSectors: [], completedBytes: 0, updatedAt: Date.now() };
+    return new WriteJournal(port, journal, sectors);
+  }
+
+  /**
+   * 第一个未完成扇区相对起始地址的偏移
+   * 镜像中全为 0xFF 的扇区无需编程，视为已完成；全部完成却没有成功结束时按新任务处理
+   */
+  resumeOffset(data: Uint8Array): number {
+    const { baseAddress, size } = this.journal;
+    if (this.completed.size === 0) {
+      return 0;
+    }
+
+    for (const sector of this.sectors) {
+      if (this.completed.has(sector.address)) {
+        continue;
+      }
+      const start = Math.max(0, sector.address - baseAddress);
+      const end = Math.min(size, sector.address + sector.size - baseAddress);
+      if (!isErasedData(data.subarray(start, end))) {
+        return start;
+      }
+    }
+    return 0;
+  }
+
+  /** 续传前需要重读比对的扇区：断点之前首尾两个已记录的扇区 */
+  checkRanges(resumeOffset: number): { offset: number; length: number }[] {
+    const { baseAddress, size } = this.journal;
+    const done = this.sectors.filter(sector => this.completed.has(sector.address) && sector.address - baseAddress < resumeOffset);
+    const picked = done.length > 1 ? [done[0], done[done.length - 1]] : done;
+
+    return picked.map((sector) => {
+      const offset = Math.max(0, sector.address - baseAddress);
+      return { offset, length: Math.min(size, sector.address + sector.size - baseAddress) - offset };
+    });
+  }
+
+  async commit(address: number): Promise<void> {
+    if (!this.enabled) {
+      return;
+    }
+
+    this.completed.add(address);
+    this.journal.completedSectors = [...this.completed];
+    this.journal.updatedAt = Date.now();
+    try {
+      await this.port.save(this.journal);
+    } catch {
+      this.enabled = false;
+    }
+  }
+
+  reset(): void {
+    this.completed.clear();
+    this.journal.completedSectors = [];
+  }
+
+  async discard(): Promise<void> {
+    this.reset();
+    await this.port.remove(this.journal.key).catch(() => {});
+  }
+}
+
+/**
+ * 读取断点
+ *
+ * 日志键包含卡带头部指纹，同型号的其他卡带不会接上这次的进度。
+ * 未指定写入目标时已读出的数据按顺序追加保存；写入转储文件时数据只在文件中，
+ * 失败后保留部分文件并记录其标识，续传时原地续写，不在日志存储中另存一份。
+ */
+export class DumpJournal implements TransferCheckpoint {
+  private pending: Uint8Array[] = [];
+  private pendingLength = 0;
+  private committedBytes: number;
+  private tail = new Uint8Array(0);
+  private enabled = true;
+
+  private constructor(
+    private readonly port: BurnerJournalPort,
+    private readonly journal: TransferJournal,
+    private readonly sink?: DumpSink,
+  ) {
+    this.committedBytes = journal.completedBytes;
+  }
+
+  static async open(port: BurnerJournalPort, cfi: CFIInfo, options: CommandOptions, size: number, header: Uint8Array): Promise<DumpJournal> {
+    const baseAddress = options.baseAddress ?? 0;
+    const cartId = cartIdOf(cfi);
+    const fingerprint = (await sha256Hex(header.subarray(0, FINGERPRINT_SIZE))).slice(0, 16);
+    const key = `dump:${cartId}:${baseAddress.toString(16)}:${size.toString(16)}:${fingerprint}`;
+    const sink = options.dumpSink;
+
+    const stored = await port.load(key).catch(() => null);
+    const reusable = stored?.kind === 'dump'
+      && stored.completedBytes < size
+      && stored.tailHash !== undefined
+      && (stored.sinkToken !== undefined) === (sink !== undefined)
+      && isFresh(stored);
+    if (stored && !reusable) {
+      await port.remove(key).catch(() => {});
+    }
+    const journal: TransferJournal = reusable
+      ? stored
+      : { key, kind: 'dump', cartId, baseAddress, size, completedSectors: [], completedBytes: 0, sinkToken: sink?.resumeToken, updatedAt: Date.now() };
+    return new DumpJournal(port, journal, sink);
+  }
+
+  get completedBytes(): number {
+    return this.journal.completedBytes;
+  }
+
+  get sinkToken(): unknown {
+    return this.journal.sinkToken;
+  }
+
+  /** 续传前重读比对的长度，从断点往前数 */
+  get checkLength(): number {
+    return Math.min(this.journal.completedBytes, DUMP_RESUME_CHECK_SIZE);
+  }
+
+  /** 比对卡带上断点前末尾一段与记录的摘要；一致时以它作为续传后摘要的起点 */
+  async acceptTail(actual: Uint8Array): Promise<boolean> {
+    if (actual.byteLength !== this.checkLength || await sha256Hex(actual) !== this.journal.tailHash) {
+      return false;
+    }
+    this.tail = actual.slice();
+    return true;
+  }
+
+  /** 读出日志存储中已保存的数据；存储中数据不完整时返回 null */
+  async readSaved(): Promise<Uint8Array | null> {
+    const length = this.journal.completedBytes;
+    if (length === 0) {
+      return null;
+    }
+
+    const data = await this.port.readData(this.journal.key, length).catch(() => null);
+    return data?.byteLength === length ? data : null;
+  }
+
+  async commit(_address: number, _length: number, data?: Uint8Array): Promise<void> {
+    if (!this.enabled || !data) {
+      return;
+    }
+
+    this.updateTail(data);
+    this.committedBytes += data.byteLength;
+    if (this.sink) {
+      // 数据已写入文件，失败时 suspend 再记录进度
+      return;
+    }
+
+    // 读取缓冲会被复用，这里必须拷贝
+    this.pending.push(data.slice());
+    this.pendingLength += data.byteLength;
+    if (this.pendingLength >= DUMP_FLUSH_SIZE) {
+      await this.flush();
+    }
+  }
+
+  /**
+   * 读取失败或取消后保存断点
+   * 写入文件时先关闭文件保留已写入的部分，成功后才记录进度；否则把尚未保存的数据落盘
+   */
+  async suspend(): Promise<void> {
+    if (!this.sink) {
+      await this.flush();
+      return;
+    }
+    if (!this.enabled || !this.sink.suspend || this.committedBytes === 0) {
+      return;
+    }
+
+    try {
+      await this.sink.suspend();
+      await this.saveProgress();
+    } catch {
+      this.enabled = false;
+    }
+  }
+
+  reset(): void {
+    this.pending = [];
+    this.pendingLength = 0;
+    this.committedBytes = 0;
+    this.tail = new Uint8Array(0);
+    this.journal.completedBytes = 0;
+    this.journal.tailHash = undefined;
+    this.journal.sinkToken = this.sink?.resumeToken;
+  }
+
+  async discard(): Promise<void> {
+    this.reset();
+    await this.port.remove(this.journal.key).catch(() => {});
+  }
+
+  private async flush(): Promise<void> {
+    if (!this.enabled || this.pendingLength === 0) {
+      return;
+    }
+
+    const chunk = new Uint8Array(this.pendingLength);
+    let offset = 0;
+    for (const part of this.pending) {
+      chunk.set(part, offset);
+      offset += part.byteLength;
+    }
+    this.pending = [];
+    this.pendingLength = 0;
+
+    try {
+      await this.port.appendData(this.journal.key, this.journal.completedBytes, chunk);
+      await this.saveProgress();
+    } catch {
+      this.enabled = false;
+    }
+  }
+
+  private async saveProgress(): Promise<void> {
+    this.journal.completedBytes = this.committedBytes;
+    this.journal.tailHash = await sha256Hex(this.tail);
+    this.journal.updatedAt = Date.now();
+    await this.port.save(this.journal);
+  }
+
+  /** 只保留已提交数据的末尾一段，用于计算续传比对的摘要 */
+  private updateTail(data: Uint8Array): void {
+    const length = Math.min(DUMP_RESUME_CHECK_SIZE, this.tail.byteLength + data.byteLength);
+    const fromData = Math.min(length, data.byteLength);
+    const next = new Uint8Array(length);
+    next.set(this.tail.subarray(this.tail.byteLength - (length - fromData)));
+    next.set(data.subarray(data.byteLength - fromData), length - fromData);
+    this.tail = next;
+  }
+}
@@ -0,0 +1,246 @@
+import type { CommandOptions, MbcType } from '@/types/command-options';
+import type { CommandResult } from '@/types/command-result';
+
+import { BurnerSession } from './burner-session';
+import type { BurnerUseCase } from './burner-use-case';
+import { ConnectionOrchestrationUseCase } from './connection-use-case';
+import type { ConnectionCommandResult } from './domain/connection';
+import type {
+  BurnerConnectionHandle,
+  BurnerConnectionSelection,
+  BurnerProtocolSession,
+  BurnerStationDevicePort,
+  BurnerStationMode,
+} from './domain/ports';
+
+/**
+ * 工位中的一台烧录器：独立的连接、会话状态（进度/日志）与协议会话
+ */
+export interface BurnerStationDevice {
+  readonly id: string;
+  readonly connection: ConnectionOrchestrationUseCase;
+  readonly session: BurnerSession;
+  readonly handle: BurnerConnectionHandle;
+}
+
+export interface BurnerStationJobContext {
+  deviceId: string;
+  session: BurnerProtocolSession;
+  useCase: BurnerUseCase;
+  signal?: AbortSignal;
+}
+
+export interface BurnerStationJob {
+  deviceId: string;
+  mode: BurnerStationMode;
+  run(context: BurnerStationJobContext): Promise<CommandResult>;
+}
+
+export interface BurnerStationJobResult extends CommandResult {
+  deviceId: string;
+  portPath?: string;
+  elapsedMs: number;
+}
+
+export interface BurnerStationRunSummary {
+  results: BurnerStationJobResult[];
+  succeeded: number;
+  failed: number;
+  elapsedMs: number;
+}
+
+export interface BurnerStationConnectResult extends ConnectionCommandResult {
+  deviceId?: string;
+}
+
+export interface BurnerStationRomWriteOptions {
+  enable5V?: boolean;
+  mbcType?: MbcType;
+  baseAddress?: number;
+  verify?: boolean;
+}
+
+function errorMessage(error: unknown): string {
+  return error instanceof Error ? error.message : String(error);
+}
+
+/**
+ * 多设备工位：同时连接多台烧录器，各自以独立的传输执行任务并汇总结果
+ *
+ * 同一台设备上的任务按顺序执行，不同设备之间并发；单台失败不影响其他设备。
+ * 生产线上同型号卡带的 Flash ID 相同，useCase 不应启用断点日志与扇区摘要缓存，
+ * 否则各设备会共用同一条记录。
+ */
+export class BurnerStation {
+  private readonly deviceMap = new Map<string, BurnerStationDevice>();
+  private readonly protocolSessions = new Map<string, BurnerProtocolSession>();
+  private nextDeviceNumber = 1;
+
+  constructor(
+    private readonly devicePort: BurnerStationDevicePort,
+    private readonly useCase: BurnerUseCase,
+    private readonly now: () => number = Date.now,
+  ) {}
+
+  get devices(): BurnerStationDevice[] {
+    return [...this.deviceMap.values()];
+  }
+
+  /**
+   * 列出可连接的端口（浏览器环境下只能通过 connect() 逐台授权）
+   */
+  async listAvailableSelections(): Promise<BurnerConnectionSelection[]> {
+    const connection = new ConnectionOrchestrationUseCase(this.devicePort.createConnectionPort());
+    const result = await connection.listAvailableSelections();
+    return (result.ports ?? []).filter((port): port is BurnerConnectionSelection => port !== null);
+  }
+
+  /**
+   * 连接一台烧录器；不传 selection 时走网关的选择流程（浏览器中弹出端口选择框）
+   */
+  async connect(selection?: BurnerConnectionSelection): Promise<BurnerStationConnectResult> {
+    const connection = new ConnectionOrchestrationUseCase(this.devicePort.createConnectionPort());
+    const result = selection
+      ? await connection.prepareConnectionWithSelection(selection)
+      : await connection.prepareConnection();
+    const handle = result.context.handle;
+    if (!result.success || !handle) {
+      return result;
+    }
+
+    const id = `burner-${this.nextDeviceNumber++}`;
+    this.deviceMap.set(id, { id, connection, session: new BurnerSession(), handle });
+    return { ...result, deviceId: id };
+  }
+
+  /**
+   * 并发连接多台烧录器，返回顺序与 selections 一致
+   */
+  connectAll(selections: BurnerConnectionSelection[]): Promise<BurnerStationConnectResult[]> {
+    return Promise.all(selections.map(selection => this.connect(selection)));
+  }
+
+  async disconnect(deviceId: string): Promise<void> {
+    const device = this.deviceMap.get(deviceId);
+    if (!device) {
+      return;
+    }
+    device.session.abortOperation();
+    this.deviceMap.delete(deviceId);
+    for (const key of [...this.protocolSessions.keys()]) {
+      if (key.startsWith(`${deviceId}:`)) {
+        this.protocolSessions.delete(key);
+      }
+    }
+    await device.connection.disconnect();
+  }
+
+  async disconnectAll(): Promise<void> {
+    await Promise.all(this.devices.map(device => this.disconnect(device.id)));
+  }
+
+  /**
+   * 中止一台或全部设备上正在执行的任务
+   */
+  abort(deviceId?: string): void {
+    const targets = deviceId ? [this.deviceMap.get(deviceId)] : this.devices;
+    targets.forEach(device => device?.session.abortOperation());
+  }
+
+  /**
+   * 执行任务：不同设备并发，同一设备按顺序
+   */
+  async run(jobs: BurnerStationJob[]): Promise<BurnerStationRunSummary> {
+    const startedAt = this.now();
+    const queues = new Map<string, BurnerStationJob[]>();
+    for (const job of jobs) {
+      queues.set(job.deviceId, [...(queues.get(job.deviceId) ?? []), job]);
+    }
+
+    const perDevice = await Promise.all([...queues.entries()].map(async ([deviceId, queue]) => {
+      const results: BurnerStationJobResult[] = [];
+      for (const job of queue) {
+        results.push(await this.runJob(deviceId, job));
+      }
+      return results;
+    }));
+
+    const results = perDevice.flat();
+    const succeeded = results.filter(result => result.success).length;
+    return {
+      results,
+      succeeded,
+      failed: results.length - succeeded,
+      elapsedMs: this.now() - startedAt,
+    };
+  }
+
+  /**
+   * 在所有已连接设备上执行同一任务
+   */
+  runOnAll(mode: BurnerStationMode, run: BurnerStationJob['run']): Promise<BurnerStationRunSummary> {
+    return this.run(this.devices.map(device => ({ deviceId: device.id, mode, run })));
+  }
+
+  /**
+   * 生产线常用任务：读取卡带信息后写入 ROM，可选写后校验
+   */
+  static romWriteJob(data: Uint8Array, options: BurnerStationRomWriteOptions = {}): BurnerStationJob['run'] {
+    return async ({ session, useCase, signal }) => {
+      const enable5V = options.enable5V ?? false;
+      const cart = await useCase.readCart(session, enable5V);
+      if (!cart.success || !cart.cfiInfo) {
+        return cart;
+      }
+
+      const commandOptions: CommandOptions = {
+        cfiInfo: cart.cfiInfo,
+        mbcType: options.mbcType,
+        enable5V,
+        baseAddress: options.baseAddress ?? 0,
+      };
+      const context = { session, cfiInfo: cart.cfiInfo, options: commandOptions, signal, data };
+      const written = await useCase.writeRom(context);
+      if (!written.success || !options.verify) {
+        return written;
+      }
+      return useCase.verifyRom(context);
+    };
+  }
+
+  private async runJob(deviceId: string, job: BurnerStationJob): Promise<BurnerStationJobResult> {
+    const startedAt = this.now();
+    const device = this.deviceMap.get(deviceId);
+    const portPath = device?.handle.portInfo?.path;
+    const finish = (result: CommandResult): BurnerStationJobResult => ({
+      ...result,
+      deviceId,
+      portPath,
+      elapsedMs: this.now() - startedAt,
+    });
+
+    if (!device) {
+      return finish({ success: false, message: `Unknown station device: ${deviceId}` });
+    }
+
+    const signal = device.session.startOperation(true);
+    try {
+      const session = await this.protocolSession(device, job.mode);
+      return finish(await job.run({ deviceId, session, useCase: this.useCase, signal }));
+    } catch (error) {
+      return finish({ success: false, message: errorMessage(error) });
+    } finally {
+      device.session.completeOperation();
+    }
+  }
+
+  private async protocolSession(device: BurnerStationDevice, mode: BurnerStationMode): Promise<BurnerProtocolSession> {
+    const key = `${device.id}:${mode}`;
+    let session = this.protocolSessions.get(key);
+    if (!session) {
+      session = await this.devicePort.openSession(device.handle, mode, device.session);
+      this.protocolSessions.set(key, session);
+    }
+    return session;
+  }
+}
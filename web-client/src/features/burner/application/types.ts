@@ -8,5 +8,6 @@ export interface BurnerSessionState {
   busy: boolean;
   abortController: AbortController | null;
   progress: ProgressInfo;
-  logs: BurnerLogEntry[];
+  /** 按时间顺序复制出的保留日志 */
+  readonly logs: BurnerLogEntry[];
 }
@@ -1,6 +1,8 @@
-import { invoke } from '@tauri-apps/api/core';
+import { Channel, invoke } from '@tauri-apps/api/core';
 
 import { isTauriRuntime, isWebRuntime } from '@/platform/runtime';
+import type { TransportJob, TransportJobProgress, TransportJobResult } from '@/platform/serial/types';
+import type { DumpSink } from '@/types/dump-sink';
 import type { SerialPortInfo } from '@/types/serial';
 
 export interface NativeRuntimeMetadata {
@@ -16,6 +18,18 @@ export interface NativeSerialSessionInfo {
   sessionId: number;
 }
 
+export interface OpenDumpSinkResult {
+  /** 当前环境能否流式写入文件；不支持时调用方退回内存导出 */
+  supported: boolean;
+  /** 用户取消选择时为空 */
+  sink?: DumpSink;
+}
+
+interface NativeDumpSinkInfo {
+  sinkId: number;
+  path: string;
+}
+
 interface NativeSerialPortInfo {
   path: string;
   manufacturer?: string | null;
@@ -41,6 +55,44 @@ export async function saveBinaryFile(data: Uint8Array, filename: string): Promis
   };
 }
 
+/**
+ * 选择保存位置并打开可追加写入的转储文件
+ * Tauri 下由后端持有文件句柄；浏览器使用 File System Access 的可写流
+ */
+export async function openDumpSink(filename: string): Promise<OpenDumpSinkResult> {
+  if (!isTauriRuntime()) {
+    return openDumpSinkInBrowser(filename);
+  }
+
+  const info = await invoke<NativeDumpSinkInfo | null>('native_open_dump_sink', {
+    suggestedFilename: filename,
+  });
+  if (!info) {
+    return { supported: true };
+  }
+
+  const headers = { 'x-sink-id': String(info.sinkId) };
+  let closed = false;
+  const close = (discard: boolean) => {
+    closed = true;
+    return invoke<void>('native_dump_sink_close', { sinkId: info.sinkId, discard });
+  };
+  return {
+    supported: true,
+    sink: {
+      path: info.path,
+      resumeToken: info.path,
+      write: chunk => invoke('native_dump_sink_write', chunk, { headers }),
+      resumeAt: (token, offset) => token === info.path
+        ? invoke<boolean>('native_dump_sink_resume', { sinkId: info.sinkId, offset })
+        : Promise.resolve(false),
+      close: () => close(false),
+      suspend: () => close(false),
+      abort: () => closed ? Promise.resolve() : close(true),
+    },
+  };
+}
+
 export async function getNativeRuntimeMetadata(): Promise<NativeRuntimeMetadata> {
   if (!isTauriRuntime()) {
     return {
@@ -84,16 +136,33 @@ export function openNativeSerialPort(path: string): Promise<NativeSerialSessionI
   return invoke<NativeSerialSessionInfo>('native_open_serial_port', { path });
 }
 
+/**
+ * 串口数据走原始 IPC 请求体，会话与超时放在请求头中
+ */
 export function writeNativeSerial(sessionId: number, bytes: Uint8Array, timeoutMs?: number): Promise<void> {
-  return invoke('native_serial_write', {
-    sessionId,
-    bytes: Array.from(bytes),
-    timeoutMs,
+  return invoke('native_serial_write', bytes, {
+    headers: nativeSerialHeaders(sessionId, timeoutMs),
   });
 }
 
+/**
+ * 订阅会话输入推送，返回当前 generation
+ * 推送包为 `[generation:4 LE] data` 的原始字节
+ */
+export async function subscribeNativeSerial(
+  sessionId: number,
+  onPacket: (packet: ArrayBuffer) => void,
+): Promise<number> {
+  const channel = new Channel<ArrayBuffer>();
+  channel.onmessage = onPacket;
+  return invoke<number>('native_serial_subscribe', { sessionId, onData: channel });
+}
+
+/**
+ * 从后端接收缓冲读取，返回原始字节（ArrayBuffer），无需解析 JSON 数组
+ */
 export async function readNativeSerial(sessionId: number, length: number, timeoutMs?: number): Promise<Uint8Array> {
-  const data = await invoke<number[]>('native_serial_read', {
+  const data = await invoke<ArrayBuffer>('native_serial_read', {
     sessionId,
     length,
     timeoutMs,
@@ -101,6 +170,37 @@ export async function readNativeSerial(sessionId: number, length: number, timeou
   return new Uint8Array(data);
 }
 
+export async function runNativeSerialJob(
+  sessionId: number,
+  job: TransportJob,
+  onProgress?: (progress: TransportJobProgress) => void,
+): Promise<TransportJobResult> {
+  const channel = new Channel<TransportJobProgress>();
+  if (onProgress) {
+    channel.onmessage = onProgress;
+  }
+
+  // 任务描述与进度通道放在请求头中，编程数据作为原始请求体
+  const { data, ...descriptor } = job.kind === 'program' ? job : { ...job, data: new Uint8Array(0) };
+  const response = await invoke<ArrayBuffer>('native_serial_run_job', data, {
+    headers: {
+      ...nativeSerialHeaders(sessionId),
+      'x-native-job': JSON.stringify(descriptor),
+      'x-progress-channel': channel.toJSON(),
+    },
+  });
+
+  // 读取任务返回数据本身，编程任务返回 4 字节小端的实际编程字节数
+  if (job.kind === 'program') {
+    return { data: new Uint8Array(0), programmedBytes: new DataView(response).getUint32(0, true) };
+  }
+  return { data: new Uint8Array(response), programmedBytes: 0 };
+}
+
+export function cancelNativeSerialJob(sessionId: number): Promise<void> {
+  return invoke('native_serial_cancel_job', { sessionId });
+}
+
 export function setNativeSerialSignals(sessionId: number, signals: SerialOutputSignals): Promise<void> {
   return invoke('native_serial_set_signals', {
     sessionId,
@@ -109,7 +209,10 @@ export function setNativeSerialSignals(sessionId: number, signals: SerialOutputS
   });
 }
 
-export function flushNativeSerialInput(sessionId: number): Promise<void> {
+/**
+ * 清空输入，返回新的 generation
+ */
+export function flushNativeSerialInput(sessionId: number): Promise<number> {
   return invoke('native_serial_flush_input', { sessionId });
 }
 
@@ -117,6 +220,39 @@ export function closeNativeSerial(sessionId: number): Promise<void> {
   return invoke('native_serial_close', { sessionId });
 }
 
+/**
+ * 断点日志：JSON 内容与读取数据由后端保存在应用数据目录
+ */
+export function loadNativeJournal(key: string): Promise<string | null> {
+  return invoke<string | null>('native_journal_load', { key });
+}
+
+export function saveNativeJournal(key: string, content: string): Promise<void> {
+  return invoke('native_journal_save', { key, content });
+}
+
+export function removeNativeJournal(key: string): Promise<void> {
+  return invoke('native_journal_remove', { key });
+}
+
+export function appendNativeJournalData(key: string, offset: number, data: Uint8Array): Promise<void> {
+  return invoke('native_journal_append', data, {
+    headers: { 'x-journal-key': key, 'x-journal-offset': String(offset) },
+  });
+}
+
+export async function readNativeJournalData(key: string, length: number): Promise<Uint8Array> {
+  return new Uint8Array(await invoke<ArrayBuffer>('native_journal_read', { key, length }));
+}
+
+function nativeSerialHeaders(sessionId: number, timeoutMs?: number): Record<string, string> {
+  const headers: Record<string, string> = { 'x-session-id': String(sessionId) };
+  if (timeoutMs !== undefined) {
+    headers['x-timeout-ms'] = String(Math.ceil(timeoutMs));
+  }
+  return headers;
+}
+
 function saveBinaryFileInBrowser(data: Uint8Array, filename: string): Promise<{ saved: boolean; path?: string }> {
   let url: string | null = null;
   let anchor: HTMLAnchorElement | null = null;
@@ -141,6 +277,66 @@ function saveBinaryFileInBrowser(data: Uint8Array, filename: string): Promise<{
   return Promise.resolve({ saved: true });
 }
 
+async function openDumpSinkInBrowser(filename: string): Promise<OpenDumpSinkResult> {
+  if (typeof window.showSaveFilePicker !== 'function') {
+    return { supported: false };
+  }
+
+  let handle: FileSystemFileHandle;
+  try {
+    handle = await window.showSaveFilePicker({ suggestedName: filename });
+  } catch (error) {
+    if (error instanceof DOMException && error.name === 'AbortError') {
+      return { supported: true };
+    }
+    // 例如失去用户激活后调用被拒绝，交给调用方走内存导出
+    return { supported: false };
+  }
+
+  // 保留原有内容以便续写上次中断的转储，第一次写入前再决定截断到哪里
+  const stream = await handle.createWritable({ keepExistingData: true });
+  let started = false;
+  let closed = false;
+  const startAt = async (offset: number) => {
+    started = true;
+    await stream.truncate(offset);
+    await stream.seek(offset);
+  };
+  return {
+    supported: true,
+    sink: {
+      path: handle.name,
+      resumeToken: handle,
+      write: async (chunk) => {
+        if (!started) {
+          await startAt(0);
+        }
+        await stream.write(chunk as BufferSource);
+      },
+      resumeAt: async (token, offset) => {
+        const sameFile = token instanceof FileSystemFileHandle && await handle.isSameEntry(token);
+        if (started || !sameFile || (await handle.getFile()).size < offset) {
+          return false;
+        }
+        await startAt(offset);
+        return true;
+      },
+      close: async () => {
+        if (!started) {
+          await startAt(0);
+        }
+        closed = true;
+        await stream.close();
+      },
+      suspend: () => {
+        closed = true;
+        return stream.close();
+      },
+      abort: () => closed ? Promise.resolve() : stream.abort(),
+    },
+  };
+}
+
 function toSerialPortInfo(port: NativeSerialPortInfo): SerialPortInfo {
   return {
     path: port.path,
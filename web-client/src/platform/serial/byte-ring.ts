@@ -0,0 +1,88 @@
+const DEFAULT_CAPACITY = 1 << 20;
+
+/**
+ * 预分配的字节环形缓冲
+ *
+ * 串口输入按到达顺序写入，读取方直接拷贝到目标缓冲，中间不产生分块数组。
+ * 写入超过容量时按 2 倍扩容（只在一次性收到超大响应时发生）。
+ */
+export class ByteRing {
+  private storage: Uint8Array;
+  private head = 0;
+  private size = 0;
+
+  constructor(capacity = DEFAULT_CAPACITY) {
+    this.storage = new Uint8Array(Math.max(1, capacity));
+  }
+
+  get length(): number {
+    return this.size;
+  }
+
+  get capacity(): number {
+    return this.storage.byteLength;
+  }
+
+  write(source: Uint8Array): void {
+    if (this.size + source.byteLength > this.storage.byteLength) {
+      this.grow(this.size + source.byteLength);
+    }
+
+    const capacity = this.storage.byteLength;
+    const tail = (this.head + this.size) % capacity;
+    const firstLength = Math.min(source.byteLength, capacity - tail);
+    this.storage.set(source.subarray(0, firstLength), tail);
+    if (firstLength < source.byteLength) {
+      this.storage.set(source.subarray(firstLength), 0);
+    }
+    this.size += source.byteLength;
+  }
+
+  /**
+   * 取出至多 length 字节写入 target[offset..]，返回实际字节数
+   */
+  readInto(target: Uint8Array, offset: number, length: number): number {
+    const count = Math.min(length, this.size);
+    const capacity = this.storage.byteLength;
+    const firstLength = Math.min(count, capacity - this.head);
+
+    target.set(this.storage.subarray(this.head, this.head + firstLength), offset);
+    if (firstLength < count) {
+      target.set(this.storage.subarray(0, count - firstLength), offset + firstLength);
+    }
+    this.skip(count);
+    return count;
+  }
+
+  /**
+   * 丢弃至多 length 字节，返回实际字节数
+   */
+  skip(length: number): number {
+    const count = Math.min(length, this.size);
+    this.head = (this.head + count) % this.storage.byteLength;
+    this.size -= count;
+    if (this.size === 0) {
+      this.head = 0;
+    }
+    return count;
+  }
+
+  clear(): void {
+    this.head = 0;
+    this.size = 0;
+  }
+
+  private grow(required: number): void {
+    let capacity = this.storage.byteLength * 2;
+    while (capacity < required) {
+      capacity *= 2;
+    }
+
+    const next = new Uint8Array(capacity);
+    const size = this.size;
+    this.readInto(next, 0, size);
+    this.storage = next;
+    this.head = 0;
+    this.size = size;
+  }
+}
@@ -1,9 +1,16 @@
+export { initDeviceSignals } from './device-signals';
 export { getDeviceGateway, resetDeviceGatewayForTests } from './factory';
 export { Mutex } from './mutex';
+export { RecordingTransport } from './recording-transport';
+export type { SessionTrace, SessionTraceEvent, SessionTraceOptions } from './session-trace';
+export { decodeSessionTrace, sessionTraceRecorder } from './session-trace';
 export type {
   DeviceGateway,
   DeviceHandle,
   DeviceSelection,
   Transport,
+  TransportJob,
+  TransportJobProgress,
+  TransportJobResult,
   TransportReadMode,
 } from './types';
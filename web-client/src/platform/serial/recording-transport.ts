@@ -0,0 +1,112 @@
+import { sessionTraceRecorder, type SessionTraceRecorder } from './session-trace';
+import type { Transport, TransportJob, TransportJobResult, TransportReadMode } from './types';
+
+/**
+ * 在 Web Serial / Tauri / 模拟传输层之外记录会话轨迹，其余行为原样转发
+ *
+ * 位于帧传输层之下，记录的是线路上的原始字节；记录器未开始时只做一次判断。
+ * 原生任务（runJob）的命令循环在后端执行，只记录任务的起止。
+ */
+export class RecordingTransport implements Transport {
+  readonly readInto?: Transport['readInto'];
+  readonly sendAndReceiveInto?: Transport['sendAndReceiveInto'];
+  readonly flushInput?: Transport['flushInput'];
+  readonly drainInput?: Transport['drainInput'];
+  readonly close?: Transport['close'];
+  readonly runJob?: Transport['runJob'];
+
+  private readonly channel: number;
+
+  constructor(
+    readonly inner: Transport,
+    private readonly recorder: SessionTraceRecorder = sessionTraceRecorder,
+  ) {
+    this.channel = recorder.attach();
+
+    if (inner.readInto) {
+      const readInto = inner.readInto.bind(inner);
+      this.readInto = async (target, offset, length, timeoutMs) => {
+        await readInto(target, offset, length, timeoutMs);
+        this.recordRx(target.subarray(offset, offset + length));
+      };
+    }
+    if (inner.sendAndReceiveInto) {
+      const sendAndReceiveInto = inner.sendAndReceiveInto.bind(inner);
+      this.sendAndReceiveInto = async (payload, target, offset, length, skipLength, sendTimeoutMs, readTimeoutMs) => {
+        this.recordTx(payload);
+        await sendAndReceiveInto(payload, target, offset, length, skipLength, sendTimeoutMs, readTimeoutMs);
+        this.recordRx(target.subarray(offset, offset + length));
+      };
+    }
+    if (inner.flushInput) {
+      this.flushInput = inner.flushInput.bind(inner);
+    }
+    if (inner.drainInput) {
+      this.drainInput = inner.drainInput.bind(inner);
+    }
+    if (inner.close) {
+      this.close = inner.close.bind(inner);
+    }
+    if (inner.runJob) {
+      const runJob = inner.runJob.bind(inner);
+      this.runJob = (job, onProgress, signal) => this.recordJob(job, () => runJob(job, onProgress, signal));
+    }
+  }
+
+  send(payload: Uint8Array, timeoutMs?: number): Promise<boolean> {
+    this.recordTx(payload);
+    return this.inner.send(payload, timeoutMs);
+  }
+
+  async read(length: number, timeoutMs?: number, mode?: TransportReadMode): Promise<{ data: Uint8Array }> {
+    const result = await this.inner.read(length, timeoutMs, mode);
+    this.recordRx(result.data);
+    return result;
+  }
+
+  async sendAndReceive(
+    payload: Uint8Array,
+    readLength: number,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<{ data: Uint8Array }> {
+    this.recordTx(payload);
+    const result = await this.inner.sendAndReceive(payload, readLength, sendTimeoutMs, readTimeoutMs);
+    this.recordRx(result.data);
+    return result;
+  }
+
+  async setSignals(signals: SerialOutputSignals): Promise<void> {
+    if (this.recorder.active) {
+      this.recorder.recordSignals(this.channel, signals);
+    }
+    await this.inner.setSignals(signals);
+  }
+
+  private recordTx(payload: Uint8Array): void {
+    if (this.recorder.active) {
+      this.recorder.recordTx(this.channel, payload);
+    }
+  }
+
+  private recordRx(data: Uint8Array): void {
+    if (this.recorder.active) {
+      this.recorder.recordRx(this.channel, data);
+    }
+  }
+
+  private async recordJob(
+    job: TransportJob,
+    run: () => Promise<TransportJobResult>,
+  ): Promise<TransportJobResult> {
+    const size = job.kind === 'dump' ? job.size : job.data.byteLength;
+    if (this.recorder.active) {
+      this.recorder.recordJob(this.channel, job.opcode, size);
+    }
+    const result = await run();
+    if (this.recorder.active) {
+      this.recorder.recordJob(this.channel, job.opcode, size);
+    }
+    return result;
+  }
+}
@@ -0,0 +1,257 @@
+import { FRAME_CODE, FRAME_HEADER_SIZE } from '@/protocol/beggar_socket/constants';
+import { stm32CRC32 } from '@/utils/crc-utils';
+
+/**
+ * 会话轨迹：按时间顺序记录串口收发，供“写入变慢”一类问题离线复现与对比
+ *
+ * 二进制格式（小端）：
+ * - 文件头 16 字节：'BSTR'、版本、标志（bit0 含数据）、保留 2 字节、开始时间（epoch ms，float64）
+ * - 每个事件：类型、通道、距上一事件的时间 (µs, LEB128)、操作码、长度 (LEB128)、CRC32、[数据]
+ */
+
+export type SessionTraceEventKind = 'tx' | 'rx' | 'signals' | 'job';
+
+export interface SessionTraceEvent {
+  kind: SessionTraceEventKind;
+  /** 同一轨迹中的设备连接序号，多设备工位时区分各台设备 */
+  channel: number;
+  /** 距开始记录的时间 (ms) */
+  time: number;
+  /** tx 为命令操作码（v2 帧取帧内命令），rx 沿用最近一条 tx；signals 为 DTR(bit0)/RTS(bit1) */
+  opcode: number;
+  length: number;
+  hash: number;
+  payload?: Uint8Array;
+}
+
+export interface SessionTrace {
+  startedAt: number;
+  includesPayloads: boolean;
+  events: SessionTraceEvent[];
+}
+
+export interface SessionTraceOptions {
+  /** 记录完整数据；否则只记录长度与 CRC32，文件小且不含卡带内容 */
+  includePayloads?: boolean;
+}
+
+const TRACE_MAGIC = [0x42, 0x53, 0x54, 0x52];
+const TRACE_VERSION = 1;
+const TRACE_HEADER_SIZE = 16;
+const FLAG_PAYLOADS = 0x01;
+
+const EVENT_KIND_CODES: Record<SessionTraceEventKind, number> = { tx: 1, rx: 2, signals: 3, job: 4 };
+const EVENT_KINDS: Record<number, SessionTraceEventKind> = { 1: 'tx', 2: 'rx', 3: 'signals', 4: 'job' };
+
+/**
+ * 命令包的操作码；v2 帧取帧内 v1 命令的操作码
+ */
+export function commandOpcode(payload: Uint8Array): number {
+  if (payload[2] === FRAME_CODE && payload.byteLength > FRAME_HEADER_SIZE + 2) {
+    return payload[FRAME_HEADER_SIZE + 2];
+  }
+  return payload[2] ?? 0;
+}
+
+/**
+ * 会话轨迹记录器。未开始记录时各传输层只做一次判断，不产生额外开销
+ */
+export class SessionTraceRecorder {
+  private buffer = new Uint8Array(0);
+  private length = 0;
+  private startedAtMs = 0;
+  private startedAtClock = 0;
+  private lastEventUs = 0;
+  private includePayloads = false;
+  private recording = false;
+  private nextChannel = 0;
+  private readonly lastOpcodes = new Map<number, number>();
+
+  get active(): boolean {
+    return this.recording;
+  }
+
+  /** 已记录的字节数 */
+  get size(): number {
+    return this.length;
+  }
+
+  /** 为新连接分配通道号 */
+  attach(): number {
+    const channel = this.nextChannel;
+    this.nextChannel = (this.nextChannel + 1) & 0xff;
+    return channel;
+  }
+
+  start(options: SessionTraceOptions = {}): void {
+    this.includePayloads = options.includePayloads ?? false;
+    this.buffer = new Uint8Array(64 * 1024);
+    this.length = 0;
+    this.startedAtMs = Date.now();
+    this.startedAtClock = performance.now();
+    this.lastEventUs = 0;
+    this.lastOpcodes.clear();
+    this.recording = true;
+
+    this.writeBytes(TRACE_MAGIC);
+    this.writeBytes([TRACE_VERSION, this.includePayloads ? FLAG_PAYLOADS : 0, 0, 0]);
+    const startedAt = new Uint8Array(8);
+    new DataView(startedAt.buffer).setFloat64(0, this.startedAtMs, true);
+    this.writeBytes(startedAt);
+  }
+
+  /**
+   * 停止记录并返回完整轨迹文件；未开始记录时返回 null
+   */
+  stop(): Uint8Array | null {
+    if (!this.recording) {
+      return null;
+    }
+    this.recording = false;
+    const trace = this.buffer.slice(0, this.length);
+    this.buffer = new Uint8Array(0);
+    this.length = 0;
+    return trace;
+  }
+
+  /** 不中断记录，返回到目前为止的轨迹 */
+  snapshot(): Uint8Array | null {
+    return this.recording ? this.buffer.slice(0, this.length) : null;
+  }
+
+  recordTx(channel: number, payload: Uint8Array, time = performance.now()): void {
+    const opcode = commandOpcode(payload);
+    this.lastOpcodes.set(channel, opcode);
+    this.writeEvent('tx', channel, time, opcode, payload);
+  }
+
+  recordRx(channel: number, data: Uint8Array, time = performance.now()): void {
+    this.writeEvent('rx', channel, time, this.lastOpcodes.get(channel) ?? 0, data);
+  }
+
+  recordSignals(channel: number, signals: SerialOutputSignals, time = performance.now()): void {
+    const bits = (signals.dataTerminalReady ? 1 : 0) | (signals.requestToSend ? 2 : 0);
+    this.writeEvent('signals', channel, time, bits, null);
+  }
+
+  recordJob(channel: number, opcode: number, size: number, time = performance.now()): void {
+    this.writeEvent('job', channel, time, opcode, null, size);
+  }
+
+  private writeEvent(
+    kind: SessionTraceEventKind,
+    channel: number,
+    time: number,
+    opcode: number,
+    data: Uint8Array | null,
+    length = data?.byteLength ?? 0,
+  ): void {
+    const timeUs = Math.max(this.lastEventUs, Math.round((time - this.startedAtClock) * 1000));
+    const deltaUs = timeUs - this.lastEventUs;
+    this.lastEventUs = timeUs;
+
+    this.ensureCapacity(24 + (this.includePayloads && data ? data.byteLength : 0));
+    this.buffer[this.length++] = EVENT_KIND_CODES[kind];
+    this.buffer[this.length++] = channel;
+    this.writeVarint(deltaUs);
+    this.buffer[this.length++] = opcode & 0xff;
+    this.writeVarint(length);
+    const hash = data ? stm32CRC32(data) : 0;
+    new DataView(this.buffer.buffer).setUint32(this.length, hash, true);
+    this.length += 4;
+    if (this.includePayloads && data) {
+      this.buffer.set(data, this.length);
+      this.length += data.byteLength;
+    }
+  }
+
+  private writeBytes(bytes: ArrayLike<number>): void {
+    this.ensureCapacity(bytes.length);
+    this.buffer.set(bytes, this.length);
+    this.length += bytes.length;
+  }
+
+  private writeVarint(value: number): void {
+    let remaining = value;
+    while (remaining >= 0x80) {
+      this.buffer[this.length++] = (remaining % 0x80) | 0x80;
+      remaining = Math.floor(remaining / 0x80);
+    }
+    this.buffer[this.length++] = remaining;
+  }
+
+  private ensureCapacity(extra: number): void {
+    if (this.length + extra <= this.buffer.byteLength) {
+      return;
+    }
+    const grown = new Uint8Array(Math.max(this.buffer.byteLength * 2, this.length + extra));
+    grown.set(this.buffer.subarray(0, this.length));
+    this.buffer = grown;
+  }
+}
+
+/**
+ * 解析轨迹文件；格式不符时抛出异常
+ */
+export function decodeSessionTrace(bytes: Uint8Array): SessionTrace {
+  if (bytes.byteLength < TRACE_HEADER_SIZE || TRACE_MAGIC.some((byte, index) => bytes[index] !== byte)) {
+    throw new Error('Not a session trace file');
+  }
+  if (bytes[4] !== TRACE_VERSION) {
+    throw new Error(`Unsupported session trace version ${bytes[4]}`);
+  }
+
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const includesPayloads = (bytes[5] & FLAG_PAYLOADS) !== 0;
+  const events: SessionTraceEvent[] = [];
+  let offset = TRACE_HEADER_SIZE;
+  let timeUs = 0;
+
+  const readVarint = () => {
+    let value = 0;
+    let scale = 1;
+    for (;;) {
+      if (offset >= bytes.byteLength) {
+        throw new Error('Truncated session trace');
+      }
+      const byte = bytes[offset++];
+      value += (byte & 0x7f) * scale;
+      if ((byte & 0x80) === 0) {
+        return value;
+      }
+      scale *= 0x80;
+    }
+  };
+
+  while (offset < bytes.byteLength) {
+    const kind = EVENT_KINDS[bytes[offset]];
+    if (!kind) {
+      throw new Error(`Unknown session trace event ${bytes[offset]} at offset ${offset}`);
+    }
+    const channel = bytes[offset + 1];
+    offset += 2;
+    timeUs += readVarint();
+    const opcode = bytes[offset++];
+    const length = readVarint();
+    if (offset + 4 > bytes.byteLength) {
+      throw new Error('Truncated session trace');
+    }
+    const hash = view.getUint32(offset, true);
+    offset += 4;
+
+    const event: SessionTraceEvent = { kind, channel, time: timeUs / 1000, opcode, length, hash };
+    if (includesPayloads && (kind === 'tx' || kind === 'rx')) {
+      if (offset + length > bytes.byteLength) {
+        throw new Error('Truncated session trace');
+      }
+      event.payload = bytes.slice(offset, offset + length);
+      offset += length;
+    }
+    events.push(event);
+  }
+
+  return { startedAt: view.getFloat64(8, true), includesPayloads, events };
+}
+
+/** 全局记录器，所有连接的传输层共用 */
+export const sessionTraceRecorder = new SessionTraceRecorder();
@@ -3,10 +3,21 @@ import type { PortFilter } from '@/utils/port-filter';
 
 import { initDeviceSignals } from '../device-signals';
 import type { DeviceGateway, DeviceHandle, DeviceSelection } from '../types';
+import type { SimulatedFirmwareModel } from './firmware-model';
+import type { SimulatedCartFlash } from './flash-model';
 import { createSimulatedDeviceState, getSimulatedPortInfo } from './runtime';
 import { SimulatedTransport } from './transport';
 
 export class SimulatedDeviceGateway implements DeviceGateway {
+  /**
+   * @param firmware - 模拟的固件模型；提供时按其带宽、延迟与 Flash 忙碌时间推进，不再使用调试设置中的固定延迟
+   * @param flash - 卡带上的 Flash 芯片，决定 CFI 与忙碌时间；默认 S29GL256 / MX29LV640
+   */
+  constructor(
+    private readonly firmware?: SimulatedFirmwareModel,
+    private readonly flash?: SimulatedCartFlash,
+  ) {}
+
   list(filter?: PortFilter): Promise<SerialPortInfo[]> {
     const port = getSimulatedPortInfo();
     return Promise.resolve(filter && !filter(port) ? [] : [port]);
@@ -21,7 +32,7 @@ export class SimulatedDeviceGateway implements DeviceGateway {
     const portInfo = selection?.portInfo ?? getSimulatedPortInfo();
     return Promise.resolve({
       platform: 'simulated',
-      transport: new SimulatedTransport(createSimulatedDeviceState()),
+      transport: new SimulatedTransport(createSimulatedDeviceState(this.firmware, this.flash)),
       port: null,
       connection: null,
       portInfo,
@@ -0,0 +1,82 @@
+import { DiagnosticCommand, GBACommand, GBCCommand } from '@/protocol/beggar_socket/command';
+import { FRAME_CODE } from '@/protocol/beggar_socket/constants';
+
+/**
+ * 模拟固件：USB 链路与命令执行方式，以及通过 0xd3 上报的能力描述
+ *
+ * 卡带 Flash 的忙碌时间由芯片决定，见 flash-model.ts
+ */
+export interface SimulatedFirmwareModel {
+  id: 'stm' | 'stc';
+  /** USB 有效带宽（字节/秒），收发共用 */
+  usbBytesPerSecond: number;
+  /** 每条命令的固定开销 (ms)：USB 帧调度与固件解析、回包 */
+  commandLatencyMs: number;
+  /** 边接收边编程：编程时间与命令包传输重叠 */
+  streamingCommand: boolean;
+  descriptor: {
+    firmwareId: number;
+    flags: number;
+    maxCommandSize: number;
+    maxResponsePayload: number;
+    usbPacketSize: number;
+    busClockHz: number;
+    opcodes: readonly number[];
+  };
+}
+
+/**
+ * 丐中丐（STM32F103）：整包收完才执行，支持 v2 帧与执行期间排队
+ */
+export const STM_FIRMWARE_MODEL: SimulatedFirmwareModel = {
+  id: 'stm',
+  usbBytesPerSecond: 1_000_000,
+  commandLatencyMs: 1,
+  streamingCommand: false,
+  descriptor: {
+    firmwareId: 1,
+    flags: 0x38,
+    maxCommandSize: 5500,
+    maxResponsePayload: 5498,
+    usbPacketSize: 64,
+    busClockHz: 72_000_000,
+    opcodes: [
+      GBACommand.READ_ID, GBACommand.ERASE_CHIP, GBACommand.BLOCK_ERASE, GBACommand.SECTOR_ERASE,
+      GBACommand.PROGRAM, GBACommand.DIRECT_WRITE, GBACommand.READ, GBACommand.RAM_WRITE,
+      GBACommand.RAM_READ, GBACommand.RAM_WRITE_TO_FLASH, GBACommand.FRAM_WRITE, GBACommand.FRAM_READ,
+      GBACommand.PROGRAM_RLE, GBACommand.READ_RLE,
+      GBCCommand.DIRECT_WRITE, GBCCommand.READ, GBCCommand.ROM_PROGRAM, GBCCommand.FRAM_WRITE, GBCCommand.FRAM_READ,
+      DiagnosticCommand.USB_SINK, DiagnosticCommand.USB_SOURCE, DiagnosticCommand.USB_LOOPBACK, DiagnosticCommand.DEVICE_INFO,
+      FRAME_CODE,
+    ],
+  },
+};
+
+/**
+ * 碳酸丐（STC8H）：边收边执行，响应按端点分包流式发送，不支持 v2 帧
+ */
+export const STC_FIRMWARE_MODEL: SimulatedFirmwareModel = {
+  id: 'stc',
+  usbBytesPerSecond: 600_000,
+  commandLatencyMs: 1,
+  streamingCommand: true,
+  descriptor: {
+    firmwareId: 2,
+    flags: 0x07,
+    maxCommandSize: 5500,
+    maxResponsePayload: 0xffff,
+    usbPacketSize: 64,
+    busClockHz: 44_236_800,
+    opcodes: [
+      GBACommand.READ_ID, GBACommand.ERASE_CHIP, GBACommand.PROGRAM, GBACommand.DIRECT_WRITE,
+      GBACommand.READ, GBACommand.RAM_WRITE, GBACommand.RAM_READ, GBACommand.RAM_WRITE_TO_FLASH,
+      GBCCommand.DIRECT_WRITE, GBCCommand.READ, GBCCommand.ROM_PROGRAM, GBCCommand.FRAM_WRITE, GBCCommand.FRAM_READ,
+      GBCCommand.CART_POWER, GBCCommand.CART_PHI_DIV,
+      DiagnosticCommand.USB_SINK, DiagnosticCommand.USB_SOURCE, DiagnosticCommand.USB_LOOPBACK, DiagnosticCommand.DEVICE_INFO,
+    ],
+  },
+};
+
+export function getSimulatedFirmwareModel(id: SimulatedFirmwareModel['id']): SimulatedFirmwareModel {
+  return id === 'stc' ? STC_FIRMWARE_MODEL : STM_FIRMWARE_MODEL;
+}
@@ -0,0 +1,137 @@
+import { FRAME_CODE } from '@/protocol/beggar_socket/constants';
+
+import { executeSimulatedCommand, setSimulatedSignals, type SimulatedDeviceState } from './runtime';
+
+/**
+ * 固件发出的一段响应
+ */
+export interface SimulatedFirmwareOutput {
+  data: Uint8Array;
+  /** 最后一个字节离开设备的时间 (ms)，与 receive() 传入的 now 同一时间基准 */
+  at: number;
+}
+
+/** 命令头：2 字节总长 + 1 字节命令码 */
+const COMMAND_HEADER_SIZE = 3;
+
+/**
+ * 以字节流驱动模拟设备，复现固件 uart.c 的收包语义，供虚拟烧录器等直接收发字节的宿主使用：
+ * - 前 2 字节为命令（或 v2 帧）总长，收齐后执行
+ * - v1 命令执行期间到达的数据被丢弃，执行完清空整个接收缓冲；v2 帧只移除当前帧，后续帧继续排队
+ * - v1 命令超出 cmdBuf 的数据被丢弃；v2 下固件以 NAK 阻塞主机，这里按到达顺序继续排队
+ * - 固件不支持的命令不回包
+ * - DTR 或 RTS 上升沿清空接收缓冲与忙碌状态（uart_setControlLine）
+ *
+ * 配置固件模型时按其 USB 带宽、固定开销与 Flash 忙碌时间计算每段响应的发出时间，否则立即发出。
+ */
+export class SimulatedFirmwareStream {
+  private received = new Uint8Array(0);
+  /** 主机到设备、设备到主机方向的总线空闲时刻 (ms) */
+  private inboundFreeAt = 0;
+  private outboundFreeAt = 0;
+  private deviceFreeAt = 0;
+  /** v1 命令执行完毕前到达的数据被丢弃 */
+  private dropUntil = 0;
+
+  constructor(private readonly state: SimulatedDeviceState) {}
+
+  get deviceState(): SimulatedDeviceState {
+    return this.state;
+  }
+
+  receive(chunk: Uint8Array, now: number): SimulatedFirmwareOutput[] {
+    const arrivedAt = Math.max(now, this.inboundFreeAt) + this.transferMs(chunk.byteLength);
+    this.inboundFreeAt = arrivedAt;
+
+    if (arrivedAt < this.dropUntil) {
+      return [];
+    }
+
+    const merged = new Uint8Array(this.received.byteLength + chunk.byteLength);
+    merged.set(this.received);
+    merged.set(chunk, this.received.byteLength);
+    const maxCommandSize = this.state.firmware?.descriptor.maxCommandSize ?? 0xffff;
+    if (merged[2] !== FRAME_CODE && merged.byteLength > maxCommandSize) {
+      return [];
+    }
+    this.received = merged;
+
+    const outputs: SimulatedFirmwareOutput[] = [];
+    while (this.received.byteLength >= COMMAND_HEADER_SIZE) {
+      const size = this.received[0] | (this.received[1] << 8);
+      if (size < COMMAND_HEADER_SIZE) {
+        // 长度异常时无法定位下一条命令，整个缓冲区丢弃
+        this.received = new Uint8Array(0);
+        break;
+      }
+      if (this.received.byteLength < size) {
+        break;
+      }
+
+      const command = this.received.slice(0, size);
+      const isFrame = command[2] === FRAME_CODE;
+      this.received = isFrame ? this.received.slice(size) : new Uint8Array(0);
+
+      const output = this.execute(command, arrivedAt);
+      if (!isFrame) {
+        this.dropUntil = this.deviceFreeAt;
+      }
+      if (output) {
+        outputs.push(output);
+      }
+    }
+    return outputs;
+  }
+
+  /**
+   * 对应固件的 uart_setControlLine：DTR 或 RTS 上升沿复位命令通道，卡带与 Flash 状态保持不变
+   */
+  setSignals(signals: SerialOutputSignals): void {
+    const previous = this.state.signals;
+    const rising = (!previous.dataTerminalReady && signals.dataTerminalReady === true)
+      || (!previous.requestToSend && signals.requestToSend === true);
+    setSimulatedSignals(this.state, signals);
+
+    if (rising) {
+      this.received = new Uint8Array(0);
+      this.dropUntil = 0;
+    }
+  }
+
+  private execute(command: Uint8Array, arrivedAt: number): SimulatedFirmwareOutput | null {
+    const firmware = this.state.firmware;
+    if (firmware && !firmware.descriptor.opcodes.includes(command[2])) {
+      return null;
+    }
+
+    const clockMs = Math.max(
+      firmware?.streamingCommand ? arrivedAt - this.transferMs(command.byteLength) : arrivedAt,
+      this.deviceFreeAt,
+    );
+    this.state.clockMs = clockMs;
+
+    let result: ReturnType<typeof executeSimulatedCommand>;
+    try {
+      result = executeSimulatedCommand(this.state, command);
+    } catch {
+      return null;
+    }
+
+    const busyMs = result.busyMs ?? 0;
+    const doneAt = firmware?.streamingCommand ? Math.max(arrivedAt, clockMs + busyMs) : clockMs + busyMs;
+    this.deviceFreeAt = doneAt;
+
+    if (!result.response) {
+      return null;
+    }
+
+    const readyAt = doneAt + (firmware?.commandLatencyMs ?? 0);
+    this.outboundFreeAt = Math.max(readyAt, this.outboundFreeAt) + this.transferMs(result.response.byteLength);
+    return { data: result.response, at: this.outboundFreeAt };
+  }
+
+  private transferMs(byteLength: number): number {
+    const bytesPerSecond = this.state.firmware?.usbBytesPerSecond ?? 0;
+    return bytesPerSecond > 0 ? (byteLength / bytesPerSecond) * 1000 : 0;
+  }
+}
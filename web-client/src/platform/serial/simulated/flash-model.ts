@@ -0,0 +1,117 @@
+/**
+ * 数据手册标称的耗时：典型值与最大值
+ */
+export interface SimulatedTimingRange {
+  typical: number;
+  max: number;
+}
+
+/**
+ * 模拟的 NOR Flash 芯片
+ *
+ * CFI 表中的耗时字段只能表示 2 的幂，这里的典型值与最大值会按最接近的幂上报；
+ * 模拟的实际耗时仍按此处的数值计算。
+ */
+export interface SimulatedFlashChip {
+  name: string;
+  flashId: readonly number[];
+  /** CFI 上报的容量（字节） */
+  deviceSize: number;
+  sectorSize: number;
+  /** 数据总线宽度（字节）：GBA 卡 16 位，GBC 卡 8 位 */
+  busWidth: 1 | 2;
+  /** 写缓冲区大小（字节），0 表示只支持逐字编程 */
+  writeBufferSize: number;
+  /** 单字编程耗时 (µs) */
+  wordProgramUs: SimulatedTimingRange;
+  /** 写满整个缓冲区的编程耗时 (µs)，未写满时在单字与整块之间按比例折算 */
+  bufferProgramUs: SimulatedTimingRange;
+  sectorEraseMs: SimulatedTimingRange;
+  chipEraseMs: SimulatedTimingRange;
+  /** 扇区擦除命令之后继续接收扇区地址的窗口 (µs)，窗口结束后才开始擦除 */
+  sectorEraseWindowUs: number;
+  /** 实际擦除耗时在典型值与最大值之间的离散程度：0 恒为典型值，1 最坏可达最大值 */
+  spread: number;
+  /** 擦除总是按最大耗时的扇区序号，模拟磨损的扇区 */
+  slowSectors: readonly number[];
+}
+
+/**
+ * 卡带上的 Flash 配置
+ */
+export interface SimulatedCartFlash {
+  gbaRom: SimulatedFlashChip;
+  gbcRom: SimulatedFlashChip;
+}
+
+/** S29GL256 (16 位)：256 字节写缓冲，扇区擦除典型 0.5 s、最大 3.5 s */
+export const S29GL256_FLASH_CHIP: SimulatedFlashChip = {
+  name: 'S29GL256',
+  flashId: [0x01, 0x00, 0x7e, 0x22, 0x22, 0x22, 0x01, 0x22],
+  deviceSize: 32 * 1024 * 1024,
+  sectorSize: 64 * 1024,
+  busWidth: 2,
+  writeBufferSize: 256,
+  wordProgramUs: { typical: 64, max: 256 },
+  bufferProgramUs: { typical: 512, max: 2048 },
+  sectorEraseMs: { typical: 512, max: 4096 },
+  chipEraseMs: { typical: 65_536, max: 262_144 },
+  sectorEraseWindowUs: 50,
+  spread: 0.1,
+  slowSectors: [],
+};
+
+/** MBC5 烧录卡常用的 29LV 系列 (8 位)：128 字节写缓冲 */
+export const MX29LV_FLASH_CHIP: SimulatedFlashChip = {
+  name: 'MX29LV640',
+  flashId: [0xc2, 0xc2, 0xc9, 0xc9],
+  deviceSize: 8 * 1024 * 1024,
+  sectorSize: 64 * 1024,
+  busWidth: 1,
+  writeBufferSize: 128,
+  wordProgramUs: { typical: 16, max: 256 },
+  bufferProgramUs: { typical: 1024, max: 4096 },
+  sectorEraseMs: { typical: 512, max: 4096 },
+  chipEraseMs: { typical: 32_768, max: 131_072 },
+  sectorEraseWindowUs: 50,
+  spread: 0.1,
+  slowSectors: [],
+};
+
+export const DEFAULT_SIMULATED_CART_FLASH: SimulatedCartFlash = {
+  gbaRom: S29GL256_FLASH_CHIP,
+  gbcRom: MX29LV_FLASH_CHIP,
+};
+
+/**
+ * 某个扇区第 n 次擦除的耗时 (ms)
+ *
+ * 抖动由扇区序号与擦除次数确定，同一场景重复运行得到相同结果，基准可复现
+ */
+export function sectorEraseTimeMs(chip: SimulatedFlashChip, sectorIndex: number, eraseCount: number): number {
+  const { typical, max } = chip.sectorEraseMs;
+  if (chip.slowSectors.includes(sectorIndex)) {
+    return max;
+  }
+
+  let hash = Math.imul(sectorIndex + 1, 0x9e3779b1) ^ Math.imul(eraseCount + 1, 0x85ebca6b);
+  hash = Math.imul(hash ^ (hash >>> 15), 0x2c1b3c6d) >>> 0;
+  return typical + (max - typical) * chip.spread * (hash / 0xffffffff);
+}
+
+/**
+ * 固件按 bufferSize 分块编程（0 为逐字编程），每块等芯片就绪再写下一块；返回总耗时 (µs)
+ */
+export function programTimeUs(chip: SimulatedFlashChip, byteLength: number, bufferSize: number): number {
+  const word = chip.wordProgramUs.typical;
+  if (bufferSize <= 0 || chip.writeBufferSize <= 0) {
+    return Math.ceil(byteLength / chip.busWidth) * word;
+  }
+
+  let total = 0;
+  for (let offset = 0; offset < byteLength; offset += bufferSize) {
+    const fill = Math.min(bufferSize, byteLength - offset) / chip.writeBufferSize;
+    total += word + (chip.bufferProgramUs.typical - word) * Math.min(1, fill);
+  }
+  return total;
+}
@@ -1,8 +1,10 @@
-import { GBACommand, GBCCommand } from '@/protocol/beggar_socket/command';
+import { DiagnosticCommand, GBACommand, GBCCommand } from '@/protocol/beggar_socket/command';
 import {
+  DEVICE_INFO_SIZE,
   FLASH_CMD_AUTOSELECT,
   FLASH_CMD_CHIP_ERASE,
   FLASH_CMD_ERASE_SETUP,
+  FLASH_CMD_PROGRAM,
   FLASH_CMD_RESET,
   FLASH_CMD_SECTOR_ERASE,
   FLASH_CMD_UNLOCK_1,
@@ -13,14 +15,33 @@ import {
   GBA_RAM_FLASH_ADDR_2,
   GBC_FLASH_ADDR_1,
   GBC_FLASH_ADDR_2,
+  FRAME_CODE,
   PROTOCOL_ACK,
 } from '@/protocol/beggar_socket/constants';
+import { decodeFrame, encodeFrameResponse, FrameStatus } from '@/protocol/beggar_socket/framing';
 import { DebugSettings, type SimulatedMemorySlot } from '@/settings/debug-settings';
 import type { SerialPortInfo } from '@/types/serial';
 import { timeout } from '@/utils/async-utils';
+import { packBitsDecode, packBitsEncode } from '@/utils/compression-utils';
+
+import type { SimulatedFirmwareModel } from './firmware-model';
+import {
+  DEFAULT_SIMULATED_CART_FLASH,
+  programTimeUs,
+  type SimulatedCartFlash,
+  type SimulatedFlashChip,
+  sectorEraseTimeMs,
+} from './flash-model';
 
 export interface SimulatedDeviceState {
   closed: boolean;
+  /**
+   * 模拟的固件；未设置时命令瞬间完成，能力描述按全部命令上报，
+   * Flash 也不模拟忙碌状态与只能清零的编程语义
+   */
+  firmware?: SimulatedFirmwareModel;
+  /** 当前命令开始执行的设备时间 (ms)，由传输层按固件模型推进 */
+  clockMs: number;
   signals: {
     dataTerminalReady?: boolean;
     requestToSend?: boolean;
@@ -32,6 +53,8 @@ export interface SimulatedDeviceState {
 interface SimulatedGbaState {
   rom: Uint8Array;
   ram: Uint8Array;
+  romChip: SimulatedFlashChip;
+  romProfile: FlashProfile;
   romControl: FlashControlState;
   ramControl: FlashControlState;
   activeSramBank: 0 | 1;
@@ -42,6 +65,8 @@ interface SimulatedGbaState {
 interface SimulatedGbcState {
   rom: Uint8Array;
   ram: Uint8Array;
+  romChip: SimulatedFlashChip;
+  romProfile: FlashProfile;
   flashControl: FlashControlState;
   activeRomBank: number;
   activeRamBank: number;
@@ -52,6 +77,28 @@ interface SimulatedGbcState {
 interface FlashControlState {
   mode: 'normal' | 'cfi' | 'autoselect';
   recentWrites: FlashWrite[];
+  /** 正在执行的擦除/编程算法，期间读取阵列得到的是状态位而不是数据 */
+  busy: FlashBusyState | null;
+  /** 已收到解锁 + 0xa0，下一次写入为单字编程 */
+  programArmed: boolean;
+  /** 状态读取次数，DQ6 / DQ2 每次读取翻转 */
+  statusReads: number;
+  /** 各扇区的擦除次数，决定擦除耗时的抖动 */
+  eraseCounts: Map<number, number>;
+}
+
+interface FlashBusyState {
+  kind: 'erase' | 'program';
+  /** 内部算法开始执行的设备时间 (ms)；扇区擦除要等擦除窗口结束 */
+  startsAt: number;
+  /** 内部算法完成的设备时间 (ms) */
+  until: number;
+  /** 已排队擦除的扇区起始地址，null 表示整片擦除 */
+  sectors: number[] | null;
+  /** 已排队扇区的擦除总耗时 (ms) */
+  durationMs: number;
+  /** 正在编程的数据，忙碌期间 DQ7 读回其 bit7 的取反 */
+  data: number;
 }
 
 interface FlashWrite {
@@ -67,8 +114,15 @@ interface FlashProfile {
 
 interface CommandResult {
   response?: Uint8Array;
+  /** 实际执行的命令码（v2 帧为帧内命令） */
+  opcode?: number;
+  /** 固件回包前等待 Flash 完成的时间 (ms) */
+  busyMs?: number;
 }
 
+/** v1 命令包末尾的 CRC16 占位，固件计算数据长度时不计入 */
+const COMMAND_CRC_SIZE = 2;
+
 const DEFAULT_SIMULATED_PORT_INFO: SerialPortInfo = {
   path: 'simulated://beggar-socket',
   manufacturer: 'Beggar Socket',
@@ -78,31 +132,23 @@ const DEFAULT_SIMULATED_PORT_INFO: SerialPortInfo = {
   serialNumber: 'simulated-debug',
 };
 
-const GBA_ROM_SIZE = 32 * 1024 * 1024;
 const GBA_RAM_BANK_SIZE = 64 * 1024;
-const GBC_ROM_SIZE = 8 * 1024 * 1024;
 const GBC_RAM_BANK_SIZE = 8 * 1024;
 const GBC_RAM_BANK_COUNT = 16;
 const MAX_RECENT_FLASH_WRITES = 6;
 
-const GBA_FLASH_ID = Uint8Array.from([0x01, 0x00, 0x7e, 0x22, 0x22, 0x22, 0x01, 0x22]);
-const GBC_FLASH_ID = Uint8Array.from([0xc2, 0xc2, 0xc9, 0xc9]);
-
-const GBA_FLASH_PROFILE = createFlashProfile({
-  flashId: GBA_FLASH_ID,
-  deviceSize: GBA_ROM_SIZE,
-  bufferSize: 256,
-  eraseSectorSize: 64 * 1024,
-  eraseSectorCount: GBA_ROM_SIZE / (64 * 1024),
-});
-
-const GBC_FLASH_PROFILE = createFlashProfile({
-  flashId: GBC_FLASH_ID,
-  deviceSize: GBC_ROM_SIZE,
-  bufferSize: 128,
-  eraseSectorSize: 64 * 1024,
-  eraseSectorCount: GBC_ROM_SIZE / (64 * 1024),
-});
+const SIMULATED_OPCODES: readonly number[] = [
+  ...Object.values(GBACommand),
+  ...Object.values(GBCCommand),
+  ...Object.values(DiagnosticCommand),
+  FRAME_CODE,
+].filter((value): value is number => typeof value === 'number');
+
+/** GBA 存档 Flash 沿用卡带 ROM 芯片的 CFI，按 64KB 存档 bank 擦除 */
+const GBA_RAM_FLASH_PROFILE: FlashProfile = {
+  ...createFlashProfile(DEFAULT_SIMULATED_CART_FLASH.gbaRom),
+  eraseSectorSize: GBA_RAM_BANK_SIZE,
+};
 
 function createDeterministicData(size: number, seed: number): Uint8Array {
   const data = new Uint8Array(size);
@@ -116,12 +162,12 @@ function createDeterministicData(size: number, seed: number): Uint8Array {
   return data;
 }
 
-function createCfiImage(params: {
-  deviceSize: number;
-  bufferSize: number;
-  eraseSectorSize: number;
-  eraseSectorCount: number;
-}): Uint8Array {
+/** CFI 耗时字段以 2 的幂编码 */
+function cfiExponent(value: number): number {
+  return value > 0 ? Math.max(0, Math.round(Math.log2(value))) : 0;
+}
+
+function createCfiImage(chip: SimulatedFlashChip): Uint8Array {
   const image = new Uint8Array(0x100);
   image[0x20] = 0x51;
   image[0x22] = 0x52;
@@ -130,23 +176,23 @@ function createCfiImage(params: {
   image[0x2c] = 0x00;
   image[0x36] = 0x27;
   image[0x38] = 0x36;
-  image[0x3e] = 0x06;
-  image[0x40] = 0x05;
-  image[0x42] = 0x08;
-  image[0x44] = 0x0a;
-  image[0x46] = 0x02;
-  image[0x48] = 0x02;
-  image[0x4a] = 0x02;
-  image[0x4c] = 0x02;
-  image[0x4e] = Math.round(Math.log2(params.deviceSize));
-
-  const bufferExponent = Math.round(Math.log2(params.bufferSize));
+  image[0x3e] = cfiExponent(chip.wordProgramUs.typical);
+  image[0x40] = chip.writeBufferSize > 0 ? cfiExponent(chip.bufferProgramUs.typical) : 0;
+  image[0x42] = cfiExponent(chip.sectorEraseMs.typical);
+  image[0x44] = cfiExponent(chip.chipEraseMs.typical);
+  image[0x46] = cfiExponent(chip.wordProgramUs.max / chip.wordProgramUs.typical);
+  image[0x48] = cfiExponent(chip.bufferProgramUs.max / chip.bufferProgramUs.typical);
+  image[0x4a] = cfiExponent(chip.sectorEraseMs.max / chip.sectorEraseMs.typical);
+  image[0x4c] = cfiExponent(chip.chipEraseMs.max / chip.chipEraseMs.typical);
+  image[0x4e] = Math.round(Math.log2(chip.deviceSize));
+
+  const bufferExponent = cfiExponent(chip.writeBufferSize);
   image[0x54] = bufferExponent & 0xff;
   image[0x56] = (bufferExponent >> 8) & 0xff;
   image[0x58] = 1;
 
-  const sectorCountMinusOne = params.eraseSectorCount - 1;
-  const sectorSizeUnits = params.eraseSectorSize / 256;
+  const sectorCountMinusOne = chip.deviceSize / chip.sectorSize - 1;
+  const sectorSizeUnits = chip.sectorSize / 256;
   image[0x5a] = sectorCountMinusOne & 0xff;
   image[0x5c] = (sectorCountMinusOne >> 8) & 0xff;
   image[0x5e] = sectorSizeUnits & 0xff;
@@ -159,28 +205,22 @@ function createCfiImage(params: {
   return image;
 }
 
-function createFlashIdImage(flashId: Uint8Array): Uint8Array {
+function createFlashIdImage(flashId: readonly number[]): Uint8Array {
   const image = new Uint8Array(0x100);
-  image.set(flashId.subarray(0, Math.min(4, flashId.length)), 0);
+  image.set(flashId.slice(0, 4), 0);
 
   if (flashId.length > 4) {
-    image.set(flashId.subarray(4, 8), 0x1c);
+    image.set(flashId.slice(4, 8), 0x1c);
   }
 
   return image;
 }
 
-function createFlashProfile(params: {
-  flashId: Uint8Array;
-  deviceSize: number;
-  bufferSize: number;
-  eraseSectorSize: number;
-  eraseSectorCount: number;
-}): FlashProfile {
+function createFlashProfile(chip: SimulatedFlashChip): FlashProfile {
   return {
-    cfi: createCfiImage(params),
-    idImage: createFlashIdImage(params.flashId),
-    eraseSectorSize: params.eraseSectorSize,
+    cfi: createCfiImage(chip),
+    idImage: createFlashIdImage(chip.flashId),
+    eraseSectorSize: chip.sectorSize,
   };
 }
 
@@ -206,6 +246,10 @@ function createFlashControlState(): FlashControlState {
   return {
     mode: 'normal',
     recentWrites: [],
+    busy: null,
+    programArmed: false,
+    statusReads: 0,
+    eraseCounts: new Map(),
   };
 }
 
@@ -230,6 +274,36 @@ function makePayloadResponse(data: Uint8Array): Uint8Array {
   return response;
 }
 
+/**
+ * 模拟设备的能力描述符：配置了固件模型时按该固件上报，
+ * 否则支持全部命令，缓冲区按协议长度字段上限上报
+ */
+function createSimulatedDeviceInfo(firmware?: SimulatedFirmwareModel): Uint8Array {
+  const descriptor = firmware?.descriptor ?? {
+    firmwareId: 1,
+    flags: 0x3f,
+    maxCommandSize: 0xffff,
+    maxResponsePayload: 0xfffd,
+    usbPacketSize: 64,
+    busClockHz: 72_000_000,
+    opcodes: SIMULATED_OPCODES,
+  };
+  const desc = new Uint8Array(DEVICE_INFO_SIZE);
+  const view = new DataView(desc.buffer);
+  desc[0] = DEVICE_INFO_SIZE;
+  desc[1] = 2;
+  desc[2] = descriptor.firmwareId;
+  desc[3] = descriptor.flags;
+  view.setUint16(4, descriptor.maxCommandSize, true);
+  view.setUint16(6, descriptor.maxResponsePayload, true);
+  view.setUint16(8, descriptor.usbPacketSize, true);
+  view.setUint32(12, descriptor.busClockHz, true);
+  for (const opcode of descriptor.opcodes) {
+    desc[16 + (opcode >> 3)] |= 1 << (opcode & 0x07);
+  }
+  return desc;
+}
+
 function clampSlice(source: Uint8Array, start: number, length: number): Uint8Array {
   const safeStart = Math.max(0, start);
   const end = Math.min(source.byteLength, safeStart + length);
@@ -250,6 +324,88 @@ function pushRecentWrite(control: FlashControlState, address: number, value: num
 function resetFlashControl(control: FlashControlState): void {
   control.mode = 'normal';
   control.recentWrites = [];
+  control.programArmed = false;
+}
+
+/**
+ * 内部算法执行完毕则清除忙碌状态，返回仍在执行的算法
+ */
+function activeFlashBusy(control: FlashControlState, now: number): FlashBusyState | null {
+  if (control.busy && now >= control.busy.until) {
+    control.busy = null;
+  }
+  return control.busy;
+}
+
+/**
+ * 排队一个扇区擦除：擦除窗口内到达的扇区合并为一次擦除，窗口从最后一个扇区地址重新计时
+ */
+function queueSectorErase(control: FlashControlState, chip: SimulatedFlashChip, sectorStart: number, now: number): void {
+  const eraseCount = control.eraseCounts.get(sectorStart) ?? 0;
+  control.eraseCounts.set(sectorStart, eraseCount + 1);
+  const durationMs = sectorEraseTimeMs(chip, Math.floor(sectorStart / chip.sectorSize), eraseCount);
+  const startsAt = now + chip.sectorEraseWindowUs / 1000;
+
+  const busy = activeFlashBusy(control, now);
+  if (busy?.kind === 'erase' && busy.sectors && now < busy.startsAt) {
+    busy.sectors.push(sectorStart);
+    busy.durationMs += durationMs;
+    busy.startsAt = startsAt;
+    busy.until = startsAt + busy.durationMs;
+    return;
+  }
+
+  control.busy = { kind: 'erase', startsAt, until: startsAt + durationMs, sectors: [sectorStart], durationMs, data: 0 };
+}
+
+function startChipErase(control: FlashControlState, chip: SimulatedFlashChip, now: number): void {
+  const durationMs = chip.chipEraseMs.typical;
+  control.busy = { kind: 'erase', startsAt: now, until: now + durationMs, sectors: null, durationMs, data: 0 };
+}
+
+/**
+ * NOR 编程只能把 1 改写为 0，未擦除的位置写入得到新旧数据的按位与
+ */
+function programBits(memory: Uint8Array, offset: number, data: Uint8Array): void {
+  const end = Math.min(memory.byteLength, offset + data.byteLength);
+  for (let index = Math.max(0, offset); index < end; index += 1) {
+    memory[index] &= data[index - offset];
+  }
+}
+
+/**
+ * 编程命令的数据段：与固件一致去掉末尾 CRC，否则按只能清零的语义会把下一页开头两字节清零
+ */
+function programCommandData(payload: Uint8Array, offset: number): Uint8Array {
+  return payload.subarray(offset, Math.max(offset, payload.byteLength - COMMAND_CRC_SIZE));
+}
+
+/**
+ * 固件编程命令：按 bufferSize 分块写缓冲编程（0 为逐字编程），芯片完成才回 ACK，返回忙碌时间 (ms)
+ *
+ * 配置固件模型时按芯片语义执行：芯片仍在擦除时不接受编程；分块超过芯片写缓冲区时
+ * 芯片中止写缓冲编程，数据都不会写入
+ */
+function programFlashArray(
+  state: SimulatedDeviceState,
+  memory: Uint8Array,
+  control: FlashControlState,
+  chip: SimulatedFlashChip,
+  offset: number,
+  data: Uint8Array,
+  bufferSize: number,
+): number {
+  if (!state.firmware) {
+    writeClamped(memory, offset, data);
+    return 0;
+  }
+
+  if (activeFlashBusy(control, state.clockMs) || bufferSize > chip.writeBufferSize) {
+    return 0;
+  }
+
+  programBits(memory, offset, data);
+  return programTimeUs(chip, data.byteLength, bufferSize) / 1000;
 }
 
 function endsWithPattern(recentWrites: FlashWrite[], pattern: FlashWrite[]): boolean {
@@ -278,13 +434,57 @@ function writeClamped(memory: Uint8Array, offset: number, data: Uint8Array): voi
   memory.set(data.subarray(0, memory.byteLength - offset), offset);
 }
 
+/**
+ * 内部算法执行期间读取得到的状态位，每个总线周期一次：
+ * DQ7 擦除时为 0、编程时为写入数据 bit7 的取反；DQ6 每次读取翻转；
+ * DQ3 擦除窗口结束、擦除开始后为 1；DQ2 读取正在擦除的扇区时每次翻转。
+ * 16 位总线只模拟低字节的状态位，高字节读回 0
+ */
+function readFlashStatus(
+  control: FlashControlState,
+  busy: FlashBusyState,
+  sectorSize: number,
+  address: number,
+  length: number,
+  now: number,
+  busWidth: number,
+): Uint8Array {
+  const status = new Uint8Array(length);
+  for (let offset = 0; offset < length; offset += busWidth) {
+    const toggle = control.statusReads & 0x01;
+    control.statusReads += 1;
+
+    let value = toggle << 6;
+    if (busy.kind === 'program') {
+      value |= ~busy.data & 0x80;
+    } else {
+      const sectorStart = Math.floor((address + offset) / sectorSize) * sectorSize;
+      if (now >= busy.startsAt) {
+        value |= 0x08;
+      }
+      if (!busy.sectors || busy.sectors.includes(sectorStart)) {
+        value |= toggle << 2;
+      }
+    }
+    status[offset] = value;
+  }
+  return status;
+}
+
 function readFlashView(
   memory: Uint8Array,
   control: FlashControlState,
   profile: FlashProfile,
   address: number,
   length: number,
+  now = 0,
+  busWidth = 1,
 ): Uint8Array {
+  const busy = activeFlashBusy(control, now);
+  if (busy) {
+    return readFlashStatus(control, busy, profile.eraseSectorSize, address, length, now, busWidth);
+  }
+
   switch (control.mode) {
     case 'cfi':
       return clampSlice(profile.cfi, address, length);
@@ -328,6 +528,11 @@ function handleFlashControlWrite(params: {
   unlock2Address: number;
   targetAddressTransform?: (address: number) => number;
   onBankSwitch?: (bank: number) => void;
+  /** 写入的完整数据（16 位总线为 2 字节），单字编程时使用 */
+  data?: Uint8Array;
+  /** 按芯片模拟忙碌状态、擦除窗口与单字编程；未提供时擦除瞬间完成 */
+  chip?: SimulatedFlashChip;
+  now?: number;
 }): boolean {
   const {
     control,
@@ -340,8 +545,38 @@ function handleFlashControlWrite(params: {
     unlock2Address,
     targetAddressTransform = rawAddress => rawAddress,
     onBankSwitch,
+    data = Uint8Array.of(value),
+    chip,
+    now = 0,
   } = params;
 
+  const busy = activeFlashBusy(control, now);
+  if (busy) {
+    // 擦除窗口内追加的扇区地址；其余写入在内部算法执行期间被芯片忽略
+    if (chip && busy.kind === 'erase' && busy.sectors && now < busy.startsAt && value === FLASH_CMD_SECTOR_ERASE) {
+      const sectorStart = Math.floor(targetAddressTransform(address) / profile.eraseSectorSize) * profile.eraseSectorSize;
+      eraseRange(memory, sectorStart, profile.eraseSectorSize);
+      queueSectorErase(control, chip, sectorStart, now);
+      return true;
+    }
+    return false;
+  }
+
+  if (chip && control.programArmed) {
+    const targetAddress = targetAddressTransform(address);
+    programBits(memory, targetAddress, data);
+    control.programArmed = false;
+    control.busy = {
+      kind: 'program',
+      startsAt: now,
+      until: now + chip.wordProgramUs.typical / 1000,
+      sectors: [],
+      durationMs: chip.wordProgramUs.typical / 1000,
+      data: data[data.byteLength - 1] ?? value,
+    };
+    return true;
+  }
+
   if (value === 0x98 && address === cfiEntryAddress) {
     control.mode = 'cfi';
     control.recentWrites = [];
@@ -373,6 +608,16 @@ function handleFlashControlWrite(params: {
     return true;
   }
 
+  if (chip && endsWithPattern(control.recentWrites, [
+    { address: unlock1Address, value: FLASH_CMD_UNLOCK_1 },
+    { address: unlock2Address, value: FLASH_CMD_UNLOCK_2 },
+    { address: unlock1Address, value: FLASH_CMD_PROGRAM },
+  ])) {
+    control.programArmed = true;
+    control.recentWrites = [];
+    return true;
+  }
+
   if (onBankSwitch && endsWithPattern(control.recentWrites, [
     { address: unlock1Address, value: FLASH_CMD_UNLOCK_1 },
     { address: unlock2Address, value: FLASH_CMD_UNLOCK_2 },
@@ -400,12 +645,18 @@ function handleFlashControlWrite(params: {
       const sectorStart = Math.floor(targetAddress / profile.eraseSectorSize) * profile.eraseSectorSize;
       eraseRange(memory, sectorStart, profile.eraseSectorSize);
       resetFlashControl(control);
+      if (chip) {
+        queueSectorErase(control, chip, sectorStart, now);
+      }
       return true;
     }
 
     if (matchesCommonPrefix && recent[5]?.value === FLASH_CMD_CHIP_ERASE && recent[5].address === unlock1Address) {
       eraseRange(memory, 0, memory.byteLength);
       resetFlashControl(control);
+      if (chip) {
+        startChipErase(control, chip, now);
+      }
       return true;
     }
   }
@@ -419,13 +670,16 @@ function handleGbaRomDirectWrite(state: SimulatedDeviceState, address: number, d
   if (handleFlashControlWrite({
     control: state.gba.romControl,
     memory: state.gba.rom,
-    profile: GBA_FLASH_PROFILE,
+    profile: state.gba.romProfile,
     address,
     value: commandValue,
     cfiEntryAddress: 0x55,
     unlock1Address: GBA_FLASH_ADDR_1,
     unlock2Address: GBA_FLASH_ADDR_2,
     targetAddressTransform: rawAddress => rawAddress << 1,
+    data,
+    chip: state.firmware ? state.gba.romChip : undefined,
+    now: state.clockMs,
   })) {
     return;
   }
@@ -435,7 +689,10 @@ function handleGbaRomDirectWrite(state: SimulatedDeviceState, address: number, d
     return;
   }
 
-  writeClamped(state.gba.rom, address, data);
+  // 真实芯片忽略命令序列之外的写入，只有未配置固件模型时才直接改写 ROM
+  if (!state.firmware) {
+    writeClamped(state.gba.rom, address, data);
+  }
 }
 
 function handleGbaRamDirectWrite(state: SimulatedDeviceState, address: number, data: Uint8Array): void {
@@ -454,10 +711,7 @@ function handleGbaRamDirectWrite(state: SimulatedDeviceState, address: number, d
   if (handleFlashControlWrite({
     control: state.gba.ramControl,
     memory: state.gba.ram,
-    profile: {
-      ...GBA_FLASH_PROFILE,
-      eraseSectorSize: GBA_RAM_BANK_SIZE,
-    },
+    profile: GBA_RAM_FLASH_PROFILE,
     address,
     value: commandValue,
     cfiEntryAddress: 0x55,
@@ -480,12 +734,16 @@ function handleGbcDirectWrite(state: SimulatedDeviceState, address: number, data
   if (handleFlashControlWrite({
     control: state.gbc.flashControl,
     memory: state.gbc.rom,
-    profile: GBC_FLASH_PROFILE,
+    profile: state.gbc.romProfile,
     address,
     value: commandValue,
     cfiEntryAddress: 0xaa,
     unlock1Address: GBC_FLASH_ADDR_1,
     unlock2Address: GBC_FLASH_ADDR_2,
+    targetAddressTransform: rawAddress => currentGbcRomOffset(state.gbc, rawAddress),
+    data,
+    chip: state.firmware ? state.gbc.romChip : undefined,
+    now: state.clockMs,
   })) {
     return;
   }
@@ -518,21 +776,28 @@ function handleGbcDirectWrite(state: SimulatedDeviceState, address: number, data
     return;
   }
 
-  const offset = currentGbcRomOffset(state.gbc, address);
-  writeClamped(state.gbc.rom, offset, data);
+  if (!state.firmware) {
+    const offset = currentGbcRomOffset(state.gbc, address);
+    writeClamped(state.gbc.rom, offset, data);
+  }
 }
 
 function readGbaRom(state: SimulatedDeviceState, address: number, size: number): Uint8Array {
-  return readFlashView(state.gba.rom, state.gba.romControl, GBA_FLASH_PROFILE, address, size);
+  return readFlashView(
+    state.gba.rom,
+    state.gba.romControl,
+    state.gba.romProfile,
+    address,
+    size,
+    state.clockMs,
+    state.gba.romChip.busWidth,
+  );
 }
 
 function readGbaRam(state: SimulatedDeviceState, address: number, size: number, flashMode = false): Uint8Array {
   if (flashMode) {
     const offset = currentGbaFlashRamOffset(state.gba, address);
-    return readFlashView(state.gba.ram, state.gba.ramControl, {
-      ...GBA_FLASH_PROFILE,
-      eraseSectorSize: GBA_RAM_BANK_SIZE,
-    }, offset, size);
+    return readFlashView(state.gba.ram, state.gba.ramControl, GBA_RAM_FLASH_PROFILE, offset, size);
   }
 
   const offset = currentGbaRamOffset(state.gba, address);
@@ -550,7 +815,7 @@ function readGbcMemory(state: SimulatedDeviceState, address: number, size: numbe
   }
 
   const offset = currentGbcRomOffset(state.gbc, address);
-  return readFlashView(state.gbc.rom, state.gbc.flashControl, GBC_FLASH_PROFILE, offset, size);
+  return readFlashView(state.gbc.rom, state.gbc.flashControl, state.gbc.romProfile, offset, size, state.clockMs);
 }
 
 function ensureSessionOpen(state: SimulatedDeviceState): void {
@@ -563,9 +828,14 @@ export function getSimulatedPortInfo(): SerialPortInfo {
   return cloneSerialPortInfo(DEFAULT_SIMULATED_PORT_INFO);
 }
 
-export function createSimulatedDeviceState(): SimulatedDeviceState {
+export function createSimulatedDeviceState(
+  firmware?: SimulatedFirmwareModel,
+  flash: SimulatedCartFlash = DEFAULT_SIMULATED_CART_FLASH,
+): SimulatedDeviceState {
   return {
     closed: false,
+    firmware,
+    clockMs: 0,
     signals: {
       dataTerminalReady: false,
       requestToSend: false,
@@ -573,6 +843,8 @@ export function createSimulatedDeviceState(): SimulatedDeviceState {
     gba: {
       rom: createConfiguredMemory('gbaRom', 0x51a7c3),
       ram: createConfiguredMemory('gbaRam', 0xa55a12),
+      romChip: flash.gbaRom,
+      romProfile: createFlashProfile(flash.gbaRom),
       romControl: createFlashControlState(),
       ramControl: createFlashControlState(),
       activeSramBank: 0,
@@ -582,6 +854,8 @@ export function createSimulatedDeviceState(): SimulatedDeviceState {
     gbc: {
       rom: createConfiguredMemory('gbcRom', 0x0bc512),
       ram: createConfiguredMemory('gbcRam', 0x12cafe),
+      romChip: flash.gbcRom,
+      romProfile: createFlashProfile(flash.gbcRom),
       flashControl: createFlashControlState(),
       activeRomBank: 1,
       activeRamBank: 0,
@@ -635,25 +909,73 @@ export function closeSimulatedDeviceState(state: SimulatedDeviceState): void {
   state.closed = true;
 }
 
+/**
+ * 执行 v2 帧：解出帧内 v1 命令执行，再把 ACK / 数据响应装回带序号的响应帧
+ */
+function executeSimulatedFrame(state: SimulatedDeviceState, frame: Uint8Array): CommandResult {
+  const { seq, flags, status, command } = decodeFrame(frame);
+  if (status !== FrameStatus.OK) {
+    return { response: encodeFrameResponse(seq, status, new Uint8Array(0), flags) };
+  }
+  if (!SIMULATED_OPCODES.includes(command[2]) || command[2] === FRAME_CODE) {
+    return { response: encodeFrameResponse(seq, FrameStatus.UNKNOWN_COMMAND, new Uint8Array(0), flags) };
+  }
+
+  const result = executeSimulatedCommand(state, command);
+  if (!result.response) {
+    return result;
+  }
+
+  const isAck = result.response.byteLength === 1 && result.response[0] === PROTOCOL_ACK;
+  const data = isAck ? new Uint8Array(0) : result.response.subarray(2);
+  return { ...result, response: encodeFrameResponse(seq, FrameStatus.OK, data, flags) };
+}
+
 export function executeSimulatedCommand(state: SimulatedDeviceState, payload: Uint8Array): CommandResult {
   ensureSessionOpen(state);
 
-  const command = payload[2] as GBACommand | GBCCommand | undefined;
+  if (payload[2] === FRAME_CODE) {
+    return executeSimulatedFrame(state, payload);
+  }
+
+  const command = payload[2] as GBACommand | GBCCommand | DiagnosticCommand | undefined;
   if (command === undefined) {
     throw new Error('Invalid simulated command payload');
   }
 
+  return { opcode: command, ...executeCommand(state, command, payload) };
+}
+
+function executeCommand(
+  state: SimulatedDeviceState,
+  command: GBACommand | GBCCommand | DiagnosticCommand,
+  payload: Uint8Array,
+): CommandResult {
   switch (command) {
     case GBACommand.ERASE_CHIP:
+      // 固件发出整片擦除序列后立即回 ACK，由上位机轮询
       eraseRange(state.gba.rom, 0, state.gba.rom.byteLength);
       resetFlashControl(state.gba.romControl);
+      if (state.firmware) {
+        startChipErase(state.gba.romControl, state.gba.romChip, state.clockMs);
+      }
       return { response: makeAckResponse() };
 
     case GBACommand.PROGRAM: {
       const address = readUInt32(payload, 3);
-      const data = payload.subarray(9);
-      writeClamped(state.gba.rom, address, data);
-      return { response: makeAckResponse() };
+      const bufferSize = readUInt16(payload, 7);
+      const data = programCommandData(payload, 9);
+      const busyMs = programFlashArray(state, state.gba.rom, state.gba.romControl, state.gba.romChip, address, data, bufferSize);
+      return { response: makeAckResponse(), busyMs };
+    }
+
+    case GBACommand.PROGRAM_RLE: {
+      const address = readUInt32(payload, 3);
+      const bufferSize = readUInt16(payload, 7);
+      const rawSize = readUInt16(payload, 9);
+      const data = packBitsDecode(payload.subarray(11), rawSize);
+      const busyMs = programFlashArray(state, state.gba.rom, state.gba.romControl, state.gba.romChip, address, data, bufferSize);
+      return { response: makeAckResponse(), busyMs };
     }
 
     case GBACommand.DIRECT_WRITE: {
@@ -669,6 +991,12 @@ export function executeSimulatedCommand(state: SimulatedDeviceState, payload: Ui
       return { response: makePayloadResponse(readGbaRom(state, address, size)) };
     }
 
+    case GBACommand.READ_RLE: {
+      const address = readUInt32(payload, 3);
+      const size = readUInt16(payload, 7);
+      return { response: makePayloadResponse(packBitsEncode(readGbaRom(state, address, size))) };
+    }
+
     case GBACommand.RAM_WRITE: {
       const address = readUInt32(payload, 3);
       const data = payload.subarray(7);
@@ -726,10 +1054,19 @@ export function executeSimulatedCommand(state: SimulatedDeviceState, payload: Ui
 
     case GBCCommand.ROM_PROGRAM: {
       const address = readUInt32(payload, 3);
-      const data = payload.subarray(9);
+      const bufferSize = readUInt16(payload, 7);
+      const data = programCommandData(payload, 9);
       const romOffset = currentGbcRomOffset(state.gbc, address);
-      writeClamped(state.gbc.rom, romOffset, data);
-      return { response: makeAckResponse() };
+      const busyMs = programFlashArray(
+        state,
+        state.gbc.rom,
+        state.gbc.flashControl,
+        state.gbc.romChip,
+        romOffset,
+        data,
+        bufferSize,
+      );
+      return { response: makeAckResponse(), busyMs };
     }
 
     case GBCCommand.FRAM_WRITE: {
@@ -748,6 +1085,25 @@ export function executeSimulatedCommand(state: SimulatedDeviceState, payload: Ui
       return { response: makePayloadResponse(readGbcMemory(state, address, size)) };
     }
 
+    case DiagnosticCommand.USB_SINK:
+      return { response: makeAckResponse() };
+
+    case DiagnosticCommand.USB_SOURCE: {
+      const seed = payload[3] ?? 0;
+      const size = readUInt16(payload, 7);
+      const data = new Uint8Array(size);
+      for (let i = 0; i < size; i++) {
+        data[i] = (seed + i) & 0xff;
+      }
+      return { response: makePayloadResponse(data) };
+    }
+
+    case DiagnosticCommand.USB_LOOPBACK:
+      return { response: makePayloadResponse(payload.slice(3, Math.max(3, payload.byteLength - 2))) };
+
+    case DiagnosticCommand.DEVICE_INFO:
+      return { response: makePayloadResponse(createSimulatedDeviceInfo(state.firmware)) };
+
     default:
       throw new Error(`Unsupported simulated command: 0x${command.toString(16)}`);
   }
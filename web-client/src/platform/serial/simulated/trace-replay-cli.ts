@@ -0,0 +1,94 @@
+#!/usr/bin/env node
+
+// trace-replay-cli.ts - 会话轨迹回放：在模拟设备上重放轨迹，或逐条比较两段会话的命令耗时
+
+import { Command } from 'commander';
+import { readFileSync } from 'fs';
+
+import { decodeSessionTrace, type SessionTrace } from '@/platform/serial/session-trace';
+
+import { getSimulatedFirmwareModel } from './firmware-model';
+import { compareCommandTimings, extractCommandTimings, replaySessionTrace, type TraceComparison } from './trace-replay';
+
+interface TraceReplayCommandOptions {
+  against?: string;
+  firmware: string;
+  channel?: string;
+  top: string;
+}
+
+function loadTrace(file: string): SessionTrace {
+  return decodeSessionTrace(new Uint8Array(readFileSync(file)));
+}
+
+function formatOpcode(opcode: number): string {
+  return `0x${opcode.toString(16).padStart(2, '0')}`;
+}
+
+function printComparison(comparison: TraceComparison, baselineLabel: string, candidateLabel: string, top: number): void {
+  const totalBaseline = comparison.byOpcode.reduce((sum, entry) => sum + entry.baselineMs, 0);
+  const totalCandidate = comparison.byOpcode.reduce((sum, entry) => sum + entry.candidateMs, 0);
+  console.log(`${comparison.commands.length} commands compared: ${baselineLabel} ${totalBaseline.toFixed(1)} ms, `
+    + `${candidateLabel} ${totalCandidate.toFixed(1)} ms`);
+  if (comparison.opcodeMismatches > 0) {
+    console.warn(`${comparison.opcodeMismatches} commands differ in opcode; the sessions have diverged`);
+  }
+
+  console.log('\nBy opcode:');
+  console.table(comparison.byOpcode.map(entry => ({
+    opcode: formatOpcode(entry.opcode),
+    count: entry.count,
+    [`${baselineLabel} ms`]: entry.baselineMs.toFixed(1),
+    [`${candidateLabel} ms`]: entry.candidateMs.toFixed(1),
+    'delta ms': entry.deltaMs.toFixed(1),
+    'delta/cmd ms': (entry.deltaMs / entry.count).toFixed(3),
+  })));
+
+  console.log(`\nLargest ${top} per-command deltas:`);
+  console.table([...comparison.commands]
+    .sort((a, b) => Math.abs(b.deltaMs) - Math.abs(a.deltaMs))
+    .slice(0, top)
+    .map(entry => ({
+      index: entry.index,
+      opcode: formatOpcode(entry.opcode),
+      [`${baselineLabel} ms`]: entry.baselineMs.toFixed(3),
+      [`${candidateLabel} ms`]: entry.candidateMs.toFixed(3),
+      'delta ms': entry.deltaMs.toFixed(3),
+    })));
+}
+
+const program = new Command();
+
+program
+  .name('trace-replay')
+  .description('Replay a session trace on the simulated device, or compare two traces command by command')
+  .argument('<trace>', 'Session trace recorded by the debug tool (.bstrace)')
+  .option('--against <trace>', 'Compare with another recorded trace instead of the simulated device')
+  .option('--firmware <id>', 'Firmware model used for replay: stm or stc', 'stm')
+  .option('--channel <n>', 'Device channel to analyse (defaults to the first one that sent a command)')
+  .option('--top <n>', 'Number of per-command deltas to print', '20')
+  .action((file: string, options: TraceReplayCommandOptions) => {
+    try {
+      const trace = loadTrace(file);
+      const channel = options.channel === undefined ? undefined : Number(options.channel);
+      const top = Math.max(1, Number(options.top) || 20);
+      const recorded = extractCommandTimings(trace, channel);
+
+      if (options.against) {
+        const other = extractCommandTimings(loadTrace(options.against), channel);
+        printComparison(compareCommandTimings(other, recorded), 'against', 'trace', top);
+        return;
+      }
+
+      if (options.firmware !== 'stm' && options.firmware !== 'stc') {
+        throw new Error(`Unknown firmware model "${options.firmware}", expected stm or stc`);
+      }
+      const replayed = replaySessionTrace(trace, { firmware: getSimulatedFirmwareModel(options.firmware), channel });
+      printComparison(compareCommandTimings(replayed, recorded), 'simulated', 'recorded', top);
+    } catch (error) {
+      console.error(`Error: ${error instanceof Error ? error.message : String(error)}`);
+      process.exit(1);
+    }
+  });
+
+program.parse();
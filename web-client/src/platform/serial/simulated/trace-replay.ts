@@ -0,0 +1,168 @@
+import type { SessionTrace } from '@/platform/serial/session-trace';
+
+import { type SimulatedFirmwareModel, STM_FIRMWARE_MODEL } from './firmware-model';
+import { SimulatedFirmwareStream } from './firmware-stream';
+import { DEFAULT_SIMULATED_CART_FLASH, type SimulatedCartFlash } from './flash-model';
+import { createSimulatedDeviceState } from './runtime';
+
+/**
+ * 轨迹中一条命令的耗时
+ */
+export interface TraceCommandTiming {
+  index: number;
+  opcode: number;
+  length: number;
+  /** 发出时间 (ms) */
+  sentAt: number;
+  /** 发出到最后一段响应到达的耗时 (ms)，无响应为 null */
+  latencyMs: number | null;
+}
+
+export interface TraceCommandDelta {
+  index: number;
+  opcode: number;
+  baselineMs: number;
+  candidateMs: number;
+  deltaMs: number;
+}
+
+export interface TraceOpcodeDelta {
+  opcode: number;
+  count: number;
+  baselineMs: number;
+  candidateMs: number;
+  deltaMs: number;
+}
+
+export interface TraceComparison {
+  commands: TraceCommandDelta[];
+  /** 按总差值绝对值从大到小排列 */
+  byOpcode: TraceOpcodeDelta[];
+  /** 同一序号的命令操作码不同，两段会话已不再对应 */
+  opcodeMismatches: number;
+}
+
+export interface TraceReplayOptions {
+  firmware?: SimulatedFirmwareModel;
+  flash?: SimulatedCartFlash;
+  channel?: number;
+}
+
+function resolveChannel(trace: SessionTrace, channel?: number): number {
+  return channel ?? trace.events.find(event => event.kind === 'tx')?.channel ?? 0;
+}
+
+/**
+ * 从轨迹中提取每条命令的耗时；响应按最近一条命令归属，分多次读取时以最后一段为准
+ */
+export function extractCommandTimings(trace: SessionTrace, channel?: number): TraceCommandTiming[] {
+  const selected = resolveChannel(trace, channel);
+  const timings: TraceCommandTiming[] = [];
+  let current: TraceCommandTiming | null = null;
+
+  for (const event of trace.events) {
+    if (event.channel !== selected) {
+      continue;
+    }
+    if (event.kind === 'tx') {
+      current = { index: timings.length, opcode: event.opcode, length: event.length, sentAt: event.time, latencyMs: null };
+      timings.push(current);
+    } else if (event.kind === 'rx' && current) {
+      current.latencyMs = event.time - current.sentAt;
+    }
+  }
+  return timings;
+}
+
+/**
+ * 将轨迹中的命令依次送入模拟设备，得到按固件与 Flash 模型计算的耗时
+ *
+ * 主机在两条命令之间的间隔（上一条响应到达到下一条发出）沿用轨迹中的记录，
+ * 因此结果与原会话逐条对应。需要以含数据方式记录的轨迹。
+ */
+export function replaySessionTrace(trace: SessionTrace, options: TraceReplayOptions = {}): TraceCommandTiming[] {
+  if (!trace.includesPayloads) {
+    throw new Error('Session trace was recorded without payloads and cannot be replayed');
+  }
+
+  const channel = resolveChannel(trace, options.channel);
+  const stream = new SimulatedFirmwareStream(createSimulatedDeviceState(
+    options.firmware ?? STM_FIRMWARE_MODEL,
+    options.flash ?? DEFAULT_SIMULATED_CART_FLASH,
+  ));
+  const timings: TraceCommandTiming[] = [];
+  let recordedIdleSince = 0;
+  let replayIdleSince = 0;
+
+  for (const event of trace.events) {
+    if (event.channel !== channel) {
+      continue;
+    }
+    if (event.kind === 'signals') {
+      stream.setSignals({ dataTerminalReady: (event.opcode & 1) !== 0, requestToSend: (event.opcode & 2) !== 0 });
+      continue;
+    }
+    if (event.kind === 'rx') {
+      recordedIdleSince = event.time;
+      continue;
+    }
+    if (event.kind !== 'tx' || !event.payload) {
+      continue;
+    }
+
+    const sentAt = replayIdleSince + Math.max(0, event.time - recordedIdleSince);
+    const outputs = stream.receive(event.payload, sentAt);
+    const doneAt = outputs.length > 0 ? outputs[outputs.length - 1].at : null;
+    timings.push({
+      index: timings.length,
+      opcode: event.opcode,
+      length: event.length,
+      sentAt,
+      latencyMs: doneAt === null ? null : doneAt - sentAt,
+    });
+    recordedIdleSince = event.time;
+    replayIdleSince = doneAt ?? sentAt;
+  }
+  return timings;
+}
+
+/**
+ * 逐条比较两段会话的命令耗时，deltaMs 为 candidate 减 baseline
+ */
+export function compareCommandTimings(
+  baseline: readonly TraceCommandTiming[],
+  candidate: readonly TraceCommandTiming[],
+): TraceComparison {
+  const commands: TraceCommandDelta[] = [];
+  const byOpcode = new Map<number, TraceOpcodeDelta>();
+  let opcodeMismatches = 0;
+
+  const count = Math.min(baseline.length, candidate.length);
+  for (let index = 0; index < count; index++) {
+    const base = baseline[index];
+    const next = candidate[index];
+    if (base.opcode !== next.opcode) {
+      opcodeMismatches += 1;
+      continue;
+    }
+    if (base.latencyMs === null || next.latencyMs === null) {
+      continue;
+    }
+
+    const deltaMs = next.latencyMs - base.latencyMs;
+    commands.push({ index, opcode: base.opcode, baselineMs: base.latencyMs, candidateMs: next.latencyMs, deltaMs });
+
+    const summary = byOpcode.get(base.opcode) ?? { opcode: base.opcode, count: 0, baselineMs: 0, candidateMs: 0, deltaMs: 0 };
+    summary.count += 1;
+    summary.baselineMs += base.latencyMs;
+    summary.candidateMs += next.latencyMs;
+    summary.deltaMs += deltaMs;
+    byOpcode.set(base.opcode, summary);
+  }
+
+  return {
+    commands,
+    byOpcode: [...byOpcode.values()].sort((a, b) => Math.abs(b.deltaMs) - Math.abs(a.deltaMs)),
+    opcodeMismatches,
+  };
+}
@@ -1,5 +1,6 @@
 import { Mutex } from '@/platform/serial/mutex';
 import type { Transport, TransportReadMode } from '@/platform/serial/types';
+import { timeout } from '@/utils/async-utils';
 
 import {
   applySimulatedTransferDelay,
@@ -11,9 +12,35 @@ import {
   type SimulatedDeviceState,
 } from './runtime';
 
+/**
+ * 传输统计，供基准测试比较命令数与收发字节数
+ */
+export interface SimulatedTransportStats {
+  commands: number;
+  commandsByOpcode: Record<number, number>;
+  bytesSent: number;
+  bytesReceived: number;
+}
+
+interface PendingResponse {
+  data: Uint8Array;
+  /** 固件开始回包的时间 (ms) */
+  readyAt: number;
+}
+
 export class SimulatedTransport implements Transport {
   private readonly mutex = new Mutex();
-  private readonly pendingResponses: Uint8Array[] = [];
+  private readonly pendingResponses: PendingResponse[] = [];
+  private readonly transferStats: SimulatedTransportStats = {
+    commands: 0,
+    commandsByOpcode: {},
+    bytesSent: 0,
+    bytesReceived: 0,
+  };
+
+  /** USB 总线与固件的空闲时刻 (ms)，仅在配置固件模型时推进 */
+  private busFreeAt = 0;
+  private deviceFreeAt = 0;
 
   constructor(private readonly state: SimulatedDeviceState = createSimulatedDeviceState()) {}
 
@@ -21,18 +48,48 @@ export class SimulatedTransport implements Transport {
     return this.state;
   }
 
+  get stats(): SimulatedTransportStats {
+    return this.transferStats;
+  }
+
   async send(payload: Uint8Array, _timeoutMs?: number): Promise<boolean> {
-    await applySimulatedTransferDelay('write', payload.byteLength);
+    const firmware = this.state.firmware;
+    if (!firmware) {
+      await applySimulatedTransferDelay('write', payload.byteLength);
+    }
     maybeThrowSimulatedTransportError('send');
+
+    // 按固件模型推进时间线：命令包占用总线传输，固件整包收完（或边收边执行）后执行，
+    // 执行完成再过固定开销开始回包。帧协议下多条命令在途时各阶段自然重叠。
+    const now = performance.now();
+    const start = Math.max(now, this.busFreeAt);
+    const arrivedAt = start + this.transferMs(payload.byteLength);
+    this.busFreeAt = arrivedAt;
+    this.state.clockMs = Math.max(firmware?.streamingCommand ? start : arrivedAt, this.deviceFreeAt);
+
     const result = executeSimulatedCommand(this.state, payload);
+    this.recordCommand(result.opcode, payload.byteLength);
+
+    const busyMs = result.busyMs ?? 0;
+    const doneAt = firmware?.streamingCommand
+      ? Math.max(arrivedAt, this.state.clockMs + busyMs)
+      : this.state.clockMs + busyMs;
+    this.deviceFreeAt = doneAt;
+
     if (result.response) {
-      this.pendingResponses.push(result.response);
+      this.pendingResponses.push({ data: result.response, readyAt: doneAt + (firmware?.commandLatencyMs ?? 0) });
+    }
+
+    if (firmware) {
+      await this.sleepUntil(arrivedAt);
     }
     return true;
   }
 
   async read(length: number, _timeoutMs?: number, _mode: TransportReadMode = 'byob'): Promise<{ data: Uint8Array }> {
-    await applySimulatedTransferDelay('read', length);
+    if (!this.state.firmware) {
+      await applySimulatedTransferDelay('read', length);
+    }
     maybeThrowSimulatedTransportError('read');
 
     const response = this.pendingResponses.shift();
@@ -40,9 +97,20 @@ export class SimulatedTransport implements Transport {
       throw new Error('No simulated response queued');
     }
 
-    return {
-      data: response.byteLength === length ? response : response.subarray(0, Math.min(length, response.byteLength)),
-    };
+    // 与真实串口一致，未读完的字节留给下一次读取（v2 帧先读帧头再读数据）
+    const data = response.data.byteLength > length ? response.data.subarray(0, length) : response.data;
+    if (response.data.byteLength > length) {
+      this.pendingResponses.unshift({ data: response.data.subarray(length), readyAt: response.readyAt });
+    }
+    this.transferStats.bytesReceived += data.byteLength;
+
+    if (this.state.firmware) {
+      const start = Math.max(response.readyAt, this.busFreeAt);
+      this.busFreeAt = start + this.transferMs(data.byteLength);
+      await this.sleepUntil(this.busFreeAt);
+    }
+
+    return { data };
   }
 
   async sendAndReceive(
@@ -79,4 +147,27 @@ export class SimulatedTransport implements Transport {
     closeSimulatedDeviceState(this.state);
     return Promise.resolve();
   }
+
+  private transferMs(byteLength: number): number {
+    const bytesPerSecond = this.state.firmware?.usbBytesPerSecond ?? 0;
+    return bytesPerSecond > 0 ? (byteLength / bytesPerSecond) * 1000 : 0;
+  }
+
+  /**
+   * 不足 1 ms 的等待不睡眠，欠下的时间由之后按绝对时刻计算的等待补回
+   */
+  private async sleepUntil(time: number): Promise<void> {
+    const waitMs = time - performance.now();
+    if (waitMs >= 1) {
+      await timeout(waitMs);
+    }
+  }
+
+  private recordCommand(opcode: number | undefined, byteLength: number): void {
+    this.transferStats.commands += 1;
+    this.transferStats.bytesSent += byteLength;
+    if (opcode !== undefined) {
+      this.transferStats.commandsByOpcode[opcode] = (this.transferStats.commandsByOpcode[opcode] ?? 0) + 1;
+    }
+  }
 }
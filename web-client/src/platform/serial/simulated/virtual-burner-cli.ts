@@ -0,0 +1,205 @@
+#!/usr/bin/env node
+
+// virtual-burner-cli.ts - 虚拟烧录器：在 Linux 伪终端上运行模拟固件，供 C# 客户端、Tauri 原生串口与第三方脚本连接
+
+import { type ChildProcess, spawn } from 'child_process';
+import { Command } from 'commander';
+import { readFileSync } from 'fs';
+import { basename } from 'path';
+import { performance } from 'perf_hooks';
+
+import { DebugSettings, SIMULATED_MEMORY_SLOTS } from '@/settings/debug-settings';
+
+import { getSimulatedFirmwareModel, type SimulatedFirmwareModel } from './firmware-model';
+import { type SimulatedFirmwareOutput, SimulatedFirmwareStream } from './firmware-stream';
+import { DEFAULT_SIMULATED_CART_FLASH, type SimulatedCartFlash, type SimulatedFlashChip } from './flash-model';
+import { createSimulatedDeviceState } from './runtime';
+
+interface VirtualBurnerOptions {
+  link: string;
+  firmware: string;
+  usbBytesPerSecond?: string;
+  latencyMs?: string;
+  flash?: string;
+  gbaRom?: string;
+  gbaRam?: string;
+  gbcRom?: string;
+  gbcRam?: string;
+}
+
+const program = new Command();
+
+program
+  .name('virtual-burner')
+  .description('Run a simulated beggar_socket burner on a Linux pseudo-terminal (requires socat)')
+  .option('--link <path>', 'Symlink to the pseudo-terminal slave that clients open', '/tmp/beggar-socket')
+  .option('--firmware <id>', 'Firmware model: stm or stc', 'stm')
+  .option('--usb-bytes-per-second <n>', 'Override the modeled USB throughput (0 disables link timing)')
+  .option('--latency-ms <n>', 'Override the modeled per-command latency')
+  .option('--flash <file>', 'JSON overrides for the cart flash chips: { "gbaRom": {...}, "gbcRom": {...} }')
+  .option('--gba-rom <file>', 'Initial GBA ROM image')
+  .option('--gba-ram <file>', 'Initial GBA save image')
+  .option('--gbc-rom <file>', 'Initial GBC ROM image')
+  .option('--gbc-ram <file>', 'Initial GBC save image')
+  .action((options: VirtualBurnerOptions) => {
+    try {
+      runVirtualBurner(options);
+    } catch (error) {
+      console.error(`Error: ${error instanceof Error ? error.message : String(error)}`);
+      process.exit(1);
+    }
+  });
+
+function runVirtualBurner(options: VirtualBurnerOptions): void {
+  const firmware = createFirmwareModel(options);
+  const flash = loadCartFlash(options.flash);
+  for (const slot of SIMULATED_MEMORY_SLOTS) {
+    const file = options[slot];
+    if (file) {
+      DebugSettings.setSimulatedMemoryImage(slot, readFileSync(file), basename(file));
+    }
+  }
+
+  // 卡带与 Flash 状态跨会话保留，客户端重新打开端口时与插着同一张卡的真实设备一致
+  const stream = new SimulatedFirmwareStream(createSimulatedDeviceState(firmware, flash));
+  let socat: ChildProcess | null = null;
+  let stopping = false;
+
+  const startSession = () => {
+    const outbox = new OutputQueue();
+    let bytesIn = 0;
+    let bytesOut = 0;
+    let openedAt = 0;
+
+    // 伪终端没有调制解调器控制线，客户端打开端口视为一次 DTR 上升沿（与 CDC 主机打开端口时一致）
+    stream.setSignals({ dataTerminalReady: false, requestToSend: false });
+    stream.setSignals({ dataTerminalReady: true, requestToSend: true });
+
+    const child = spawn('socat', [`PTY,link=${options.link},rawer,wait-slave`, 'STDIO'], {
+      stdio: ['pipe', 'pipe', 'inherit'],
+    });
+    socat = child;
+
+    child.stdout.on('data', (chunk: Buffer) => {
+      if (openedAt === 0) {
+        openedAt = performance.now();
+      }
+      bytesIn += chunk.byteLength;
+      outbox.push(stream.receive(new Uint8Array(chunk), performance.now()), (data) => {
+        bytesOut += data.byteLength;
+        child.stdin.write(data);
+      });
+    });
+    // 客户端关闭端口后 socat 退出，写入已关闭的管道不视为错误
+    child.stdin.on('error', () => undefined);
+
+    child.on('error', (error: NodeJS.ErrnoException) => {
+      console.error(error.code === 'ENOENT' ? 'Error: socat is not installed' : `Error: ${error.message}`);
+      process.exit(1);
+    });
+
+    child.on('exit', (code) => {
+      outbox.clear();
+      if (openedAt > 0) {
+        const seconds = (performance.now() - openedAt) / 1000;
+        console.log(`[virtual-burner] session closed: ${bytesIn} bytes in, ${bytesOut} bytes out, ${seconds.toFixed(1)}s`);
+      }
+      if (stopping) {
+        return;
+      }
+      if (code !== 0 && openedAt === 0) {
+        console.error(`Error: socat exited with code ${code}`);
+        process.exit(1);
+      }
+      startSession();
+    });
+  };
+
+  const stop = () => {
+    stopping = true;
+    socat?.kill();
+  };
+  process.on('SIGINT', stop);
+  process.on('SIGTERM', stop);
+
+  console.log(`[virtual-burner] ${firmware.id} firmware, ${firmware.usbBytesPerSecond} B/s, ${firmware.commandLatencyMs} ms/command`);
+  console.log(`[virtual-burner] GBA flash ${flash.gbaRom.name}, GBC flash ${flash.gbcRom.name}`);
+  console.log(`[virtual-burner] listening on ${options.link}`);
+  startSession();
+}
+
+/**
+ * 响应按固件模型计算的发出时刻依次写出；单一定时器保证先后顺序不受定时器精度影响
+ */
+class OutputQueue {
+  private readonly pending: SimulatedFirmwareOutput[] = [];
+  private timer: ReturnType<typeof setTimeout> | null = null;
+  private write: ((data: Uint8Array) => void) | null = null;
+
+  push(outputs: SimulatedFirmwareOutput[], write: (data: Uint8Array) => void): void {
+    this.write = write;
+    this.pending.push(...outputs);
+    this.flush();
+  }
+
+  clear(): void {
+    this.pending.length = 0;
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  private flush = (): void => {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    const now = performance.now();
+    while (this.pending.length > 0 && this.pending[0].at <= now + 0.5) {
+      const output = this.pending.shift();
+      if (output) {
+        this.write?.(output.data);
+      }
+    }
+    if (this.pending.length > 0) {
+      this.timer = setTimeout(this.flush, this.pending[0].at - now);
+    }
+  };
+}
+
+function createFirmwareModel(options: VirtualBurnerOptions): SimulatedFirmwareModel {
+  if (options.firmware !== 'stm' && options.firmware !== 'stc') {
+    throw new Error(`Unknown firmware model "${options.firmware}", expected stm or stc`);
+  }
+  const model = getSimulatedFirmwareModel(options.firmware);
+  return {
+    ...model,
+    usbBytesPerSecond: parseNumberOption('--usb-bytes-per-second', options.usbBytesPerSecond) ?? model.usbBytesPerSecond,
+    commandLatencyMs: parseNumberOption('--latency-ms', options.latencyMs) ?? model.commandLatencyMs,
+  };
+}
+
+function parseNumberOption(name: string, value?: string): number | undefined {
+  if (value === undefined) {
+    return undefined;
+  }
+  const parsed = Number(value);
+  if (!Number.isFinite(parsed) || parsed < 0) {
+    throw new Error(`${name} expects a non-negative number, got "${value}"`);
+  }
+  return parsed;
+}
+
+function loadCartFlash(file?: string): SimulatedCartFlash {
+  if (!file) {
+    return DEFAULT_SIMULATED_CART_FLASH;
+  }
+  const overrides = JSON.parse(readFileSync(file, 'utf-8')) as Partial<Record<keyof SimulatedCartFlash, Partial<SimulatedFlashChip>>>;
+  return {
+    gbaRom: { ...DEFAULT_SIMULATED_CART_FLASH.gbaRom, ...overrides.gbaRom },
+    gbcRom: { ...DEFAULT_SIMULATED_CART_FLASH.gbcRom, ...overrides.gbcRom },
+  };
+}
+
+program.parse();
@@ -1,8 +1,10 @@
 import {
+  cancelNativeSerialJob,
   closeNativeSerial,
   flushNativeSerialInput,
-  readNativeSerial,
+  runNativeSerialJob,
   setNativeSerialSignals,
+  subscribeNativeSerial,
   writeNativeSerial,
 } from '@/platform/native';
 import { AdvancedSettings } from '@/settings/advanced-settings';
@@ -10,13 +12,26 @@ import { withTimeout } from '@/utils/async-utils';
 
 import { Mutex } from '../mutex';
 import { createReadTimeoutError } from '../transport-errors';
-import type { Transport, TransportReadMode } from '../types';
+import type { Transport, TransportJob, TransportJobProgress, TransportJobResult, TransportReadMode } from '../types';
 
+const PACKET_GENERATION_BYTES = 4;
+
+/**
+ * Tauri 原生串口传输
+ *
+ * 后端读取线程把输入主动推送过来，read() 只从本地缓冲取数据，
+ * 不再为每次读取发起一次 IPC 往返。推送包带 generation，清空输入后旧包被丢弃。
+ */
 export class TauriSerialTransport implements Transport {
   private readonly mutex = new Mutex();
+  private readonly bufferedChunks: Uint8Array[] = [];
+  private bufferedLength = 0;
+  private readonly readWaiters = new Set<() => void>();
+  private listenerPromise: Promise<void> | null = null;
+  private rxGeneration = 0;
   private closed = false;
   private totalRxBytes = 0;
-  private totalRxReads = 0;
+  private totalRxPackets = 0;
   private totalTxBytes = 0;
   private totalTxPackets = 0;
   private lastRxAt = 0;
@@ -24,8 +39,16 @@ export class TauriSerialTransport implements Transport {
 
   constructor(private readonly sessionId: number) {}
 
-  async attachListener(): Promise<void> {
-    return Promise.resolve();
+  attachListener(): Promise<void> {
+    this.listenerPromise ??= subscribeNativeSerial(this.sessionId, (packet) => {
+      this.handlePacket(packet);
+    }).then((generation) => {
+      this.adoptGeneration(generation);
+    }).catch((error: unknown) => {
+      this.listenerPromise = null;
+      throw error;
+    });
+    return this.listenerPromise;
   }
 
   async send(payload: Uint8Array, timeoutMs?: number): Promise<boolean> {
@@ -44,33 +67,39 @@ export class TauriSerialTransport implements Transport {
   }
 
   async read(length: number, timeoutMs?: number, _mode: TransportReadMode = 'default'): Promise<{ data: Uint8Array }> {
+    const data = new Uint8Array(length);
+    await this.readInto(data, 0, length, timeoutMs);
+    return { data };
+  }
+
+  async readInto(target: Uint8Array, start: number, length: number, timeoutMs?: number): Promise<void> {
     this.assertOpen();
+    await this.attachListener();
+
     const timeout = timeoutMs ?? AdvancedSettings.packageReceiveTimeout;
     const readId = ++this.readSequence;
     const startedAt = Date.now();
+    const initialBufferedLength = this.bufferedLength;
     const startRxBytes = this.totalRxBytes;
-    const startRxReads = this.totalRxReads;
+    const startRxPackets = this.totalRxPackets;
 
-    const target = new Uint8Array(length);
     let offset = 0;
 
     while (offset < length) {
       this.assertOpen();
-      const elapsed = Date.now() - startedAt;
-      const remainingTimeout = Math.max(1, timeout - elapsed);
+      offset = this.consumeBufferedData(target, start + offset, start + length) - start;
+      if (offset >= length) {
+        break;
+      }
 
-      let chunk: Uint8Array;
+      const elapsed = Date.now() - startedAt;
       try {
-        chunk = await withTimeout(
-          readNativeSerial(this.sessionId, length - offset, remainingTimeout),
-          remainingTimeout,
-          `Read package timeout in ${timeout}ms`,
-        );
+        await this.waitForData(Math.max(1, timeout - elapsed));
       } catch (error) {
         if (error instanceof Error && error.message.includes('Read package timeout')) {
           const sinceLastRx = this.lastRxAt > 0 ? Date.now() - this.lastRxAt : -1;
           const sessionRxBytes = this.totalRxBytes - startRxBytes;
-          const sessionRxReads = this.totalRxReads - startRxReads;
+          const sessionRxPackets = this.totalRxPackets - startRxPackets;
           const sinceLastRxText = sinceLastRx >= 0 ? `, sinceLastRx=${sinceLastRx}ms` : '';
           throw createReadTimeoutError({
             timeout,
@@ -78,33 +107,16 @@ export class TauriSerialTransport implements Transport {
             expectedLength: length,
             receivedLength: offset,
             diagnostics:
-              `sessionRx=${sessionRxBytes}B/${sessionRxReads}reads, `
-              + `totalRx=${this.totalRxBytes}B/${this.totalRxReads}reads, `
+              `buffered=${this.bufferedLength}B, initialBuffered=${initialBufferedLength}B, `
+              + `sessionRx=${sessionRxBytes}B/${sessionRxPackets}packets, `
+              + `totalRx=${this.totalRxBytes}B/${this.totalRxPackets}packets, `
               + `totalTx=${this.totalTxBytes}B/${this.totalTxPackets}packets, `
-              + `elapsed=${elapsed}ms${sinceLastRxText}`,
+              + `elapsed=${Date.now() - startedAt}ms${sinceLastRxText}`,
           });
         }
         throw error;
       }
-
-      if (!(chunk instanceof Uint8Array) || chunk.byteLength === 0) {
-        const sessionRxBytes = this.totalRxBytes - startRxBytes;
-        const sessionRxReads = this.totalRxReads - startRxReads;
-        throw new Error(
-          'Read package returned no data '
-          + `(read#${readId}, expected=${length}B, received=${offset}B, `
-          + `sessionRx=${sessionRxBytes}B/${sessionRxReads}reads)`,
-        );
-      }
-
-      target.set(chunk.subarray(0, Math.min(chunk.byteLength, length - offset)), offset);
-      offset += chunk.byteLength;
-      this.totalRxBytes += chunk.byteLength;
-      this.totalRxReads += 1;
-      this.lastRxAt = Date.now();
     }
-
-    return { data: target };
   }
 
   async sendAndReceive(
@@ -122,6 +134,44 @@ export class TauriSerialTransport implements Transport {
     }
   }
 
+  async sendAndReceiveInto(
+    payload: Uint8Array,
+    target: Uint8Array,
+    offset: number,
+    length: number,
+    skipLength = 0,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<void> {
+    const release = await this.mutex.acquire();
+    try {
+      await this.send(payload, sendTimeoutMs);
+      if (skipLength > 0) {
+        await this.read(skipLength, readTimeoutMs);
+      }
+      await this.readInto(target, offset, length, readTimeoutMs);
+    } finally {
+      release();
+    }
+  }
+
+  async runJob(
+    job: TransportJob,
+    onProgress?: (progress: TransportJobProgress) => void,
+    signal?: AbortSignal,
+  ): Promise<TransportJobResult> {
+    this.assertOpen();
+    const release = await this.mutex.acquire();
+    const cancel = () => { void cancelNativeSerialJob(this.sessionId).catch(() => {}); };
+    signal?.addEventListener('abort', cancel, { once: true });
+    try {
+      return await runNativeSerialJob(this.sessionId, job, onProgress);
+    } finally {
+      signal?.removeEventListener('abort', cancel);
+      release();
+    }
+  }
+
   async setSignals(signals: SerialOutputSignals): Promise<void> {
     this.assertOpen();
 
@@ -137,8 +187,11 @@ export class TauriSerialTransport implements Transport {
     }
   }
 
-  flushInput(): Promise<void> {
-    return flushNativeSerialInput(this.sessionId).catch(() => {});
+  async flushInput(): Promise<void> {
+    this.clearBuffer();
+    try {
+      this.adoptGeneration(await flushNativeSerialInput(this.sessionId));
+    } catch {}
   }
 
   async drainInput(quietMs = 50, _maxWaitMs?: number): Promise<void> {
@@ -155,9 +208,98 @@ export class TauriSerialTransport implements Transport {
     }
 
     this.closed = true;
+    this.clearBuffer();
+    this.notifyReadWaiters();
     await closeNativeSerial(this.sessionId);
   }
 
+  private handlePacket(packet: ArrayBuffer): void {
+    if (this.closed || packet.byteLength < PACKET_GENERATION_BYTES) {
+      return;
+    }
+
+    const generation = new DataView(packet).getUint32(0, true);
+    if (generation < this.rxGeneration) {
+      // 清空输入之前已在途的数据
+      return;
+    }
+    this.adoptGeneration(generation);
+
+    const data = new Uint8Array(packet, PACKET_GENERATION_BYTES);
+    if (data.byteLength === 0) {
+      return;
+    }
+    this.bufferedChunks.push(data);
+    this.bufferedLength += data.byteLength;
+    this.totalRxPackets += 1;
+    this.totalRxBytes += data.byteLength;
+    this.lastRxAt = Date.now();
+    this.notifyReadWaiters();
+  }
+
+  /** 后端 generation 前进时，本地缓冲中的数据都属于已清空的输入 */
+  private adoptGeneration(generation: number): void {
+    if (generation > this.rxGeneration) {
+      this.rxGeneration = generation;
+      this.clearBuffer();
+    }
+  }
+
+  private notifyReadWaiters(): void {
+    const waiters = [...this.readWaiters];
+    this.readWaiters.clear();
+    waiters.forEach((resolve) => {
+      resolve();
+    });
+  }
+
+  private async waitForData(timeoutMs: number): Promise<void> {
+    if (this.bufferedLength > 0 || this.closed) {
+      return;
+    }
+
+    let resolveWaiter: (() => void) | undefined;
+    const waitForPacket = new Promise<void>((resolve) => {
+      resolveWaiter = resolve;
+      this.readWaiters.add(resolve);
+    });
+
+    try {
+      await withTimeout(waitForPacket, timeoutMs, `Read package timeout in ${timeoutMs}ms`);
+    } finally {
+      if (resolveWaiter) {
+        this.readWaiters.delete(resolveWaiter);
+      }
+    }
+  }
+
+  /** 把缓冲数据拷入 target[offset..end)，返回新的写入位置 */
+  private consumeBufferedData(target: Uint8Array, offset: number, end: number): number {
+    let nextOffset = offset;
+
+    while (nextOffset < end && this.bufferedChunks.length > 0) {
+      const chunk = this.bufferedChunks[0];
+      const bytesToCopy = Math.min(chunk.byteLength, end - nextOffset);
+      target.set(chunk.subarray(0, bytesToCopy), nextOffset);
+      nextOffset += bytesToCopy;
+
+      if (bytesToCopy === chunk.byteLength) {
+        this.bufferedChunks.shift();
+      } else {
+        this.bufferedChunks[0] = chunk.subarray(bytesToCopy);
+      }
+
+      this.bufferedLength -= bytesToCopy;
+    }
+
+    return nextOffset;
+  }
+
+  private clearBuffer(): void {
+    this.bufferedChunks.length = 0;
+    this.bufferedLength = 0;
+  }
+
   private assertOpen(): void {
     if (this.closed) {
       throw new Error('Serial transport is closed');
@@ -0,0 +1,357 @@
+import type { Transport, TransportJob, TransportJobProgress, TransportJobResult, TransportReadMode } from './types';
+
+/**
+ * 跨线程传输桥：Worker 内的协议层通过 MessagePort 调用主线程上的传输层
+ *
+ * 每块数据先复制一次为独立缓冲，再以 Transferable 方式移交，不再做结构化克隆拷贝：
+ * 传输层返回的视图可能指向之后仍会复用的缓冲，无法判断时只能复制。
+ * 主线程传输层支持 sendAndReceiveInto 时直接读入新分配的缓冲，省去这次复制。
+ * 请求按 id 配对，错误只保留 name / message / detail 三个字段。
+ */
+
+/** 宿主传输层提供的可选能力，Worker 端据此决定挂载哪些可选方法 */
+export interface TransportBridgeFeatures {
+  flushInput: boolean;
+  drainInput: boolean;
+  runJob: boolean;
+}
+
+export interface SerializedError {
+  name: string;
+  message: string;
+  detail?: string;
+}
+
+type BridgeRequestBody =
+  | { op: 'send'; payload: Uint8Array; timeoutMs?: number }
+  | { op: 'read'; length: number; timeoutMs?: number; mode?: TransportReadMode }
+  | { op: 'sendAndReceive'; payload: Uint8Array; readLength: number; sendTimeoutMs?: number; readTimeoutMs?: number }
+  | {
+    op: 'sendAndReceiveInto';
+    payload: Uint8Array;
+    length: number;
+    skipLength: number;
+    sendTimeoutMs?: number;
+    readTimeoutMs?: number;
+  }
+  | { op: 'setSignals'; signals: SerialOutputSignals }
+  | { op: 'flushInput' }
+  | { op: 'drainInput'; quietMs?: number; maxWaitMs?: number }
+  | { op: 'runJob'; job: TransportJob }
+  | { op: 'cancelJob'; jobId: number };
+
+type BridgeRequest = BridgeRequestBody & { id: number };
+
+type BridgeResponse =
+  | { id: number; kind: 'result'; value?: unknown }
+  | { id: number; kind: 'error'; error: SerializedError }
+  | { id: number; kind: 'progress'; progress: TransportJobProgress };
+
+export function describeTransportFeatures(transport: Transport): TransportBridgeFeatures {
+  return {
+    flushInput: typeof transport.flushInput === 'function',
+    drainInput: typeof transport.drainInput === 'function',
+    runJob: typeof transport.runJob === 'function',
+  };
+}
+
+export function serializeError(error: unknown): SerializedError {
+  if (!(error instanceof Error)) {
+    return { name: 'Error', message: String(error) };
+  }
+  const detail = (error as Error & { detail?: unknown }).detail;
+  return {
+    name: error.name,
+    message: error.message,
+    detail: typeof detail === 'string' ? detail : undefined,
+  };
+}
+
+export function deserializeError(serialized: SerializedError): Error {
+  const error = new Error(serialized.message) as Error & { detail?: string };
+  error.name = serialized.name;
+  if (serialized.detail !== undefined) {
+    error.detail = serialized.detail;
+  }
+  return error;
+}
+
+/**
+ * 复制为独立缓冲后移交：调用方传入的视图可能是更大缓冲的一部分，之后仍会被复用
+ */
+function detachCopy(data: Uint8Array): Uint8Array<ArrayBuffer> {
+  return data.slice();
+}
+
+/**
+ * 在主线程上响应桥请求，返回停止服务的函数：只关闭桥，不关闭传输层本身
+ */
+export function serveTransport(port: MessagePort, transport: Transport): () => void {
+  const jobs = new Map<number, AbortController>();
+
+  const reply = (response: BridgeResponse, transfer: Transferable[] = []) => {
+    port.postMessage(response, transfer);
+  };
+
+  const handle = async (request: BridgeRequest): Promise<void> => {
+    switch (request.op) {
+      case 'send':
+        reply({ id: request.id, kind: 'result', value: await transport.send(request.payload, request.timeoutMs) });
+        return;
+      case 'read': {
+        const { data } = await transport.read(request.length, request.timeoutMs, request.mode);
+        const copy = detachCopy(data);
+        reply({ id: request.id, kind: 'result', value: copy }, [copy.buffer]);
+        return;
+      }
+      case 'sendAndReceive': {
+        const { data } = await transport.sendAndReceive(
+          request.payload,
+          request.readLength,
+          request.sendTimeoutMs,
+          request.readTimeoutMs,
+        );
+        const copy = detachCopy(data);
+        reply({ id: request.id, kind: 'result', value: copy }, [copy.buffer]);
+        return;
+      }
+      case 'sendAndReceiveInto': {
+        const { payload, length, skipLength, sendTimeoutMs, readTimeoutMs } = request;
+        let data: Uint8Array<ArrayBuffer>;
+        if (transport.sendAndReceiveInto) {
+          data = new Uint8Array(length);
+          await transport.sendAndReceiveInto(payload, data, 0, length, skipLength, sendTimeoutMs, readTimeoutMs);
+        } else {
+          const response = await transport.sendAndReceive(payload, skipLength + length, sendTimeoutMs, readTimeoutMs);
+          data = detachCopy(response.data.subarray(skipLength, skipLength + length));
+        }
+        reply({ id: request.id, kind: 'result', value: data }, [data.buffer]);
+        return;
+      }
+      case 'setSignals':
+        await transport.setSignals(request.signals);
+        reply({ id: request.id, kind: 'result' });
+        return;
+      case 'flushInput':
+        await transport.flushInput?.();
+        reply({ id: request.id, kind: 'result' });
+        return;
+      case 'drainInput':
+        await transport.drainInput?.(request.quietMs, request.maxWaitMs);
+        reply({ id: request.id, kind: 'result' });
+        return;
+      case 'runJob': {
+        if (!transport.runJob) {
+          throw new Error('Transport does not support native jobs');
+        }
+        const controller = new AbortController();
+        jobs.set(request.id, controller);
+        try {
+          const result = await transport.runJob(
+            request.job,
+            (progress) => { reply({ id: request.id, kind: 'progress', progress }); },
+            controller.signal,
+          );
+          const data = detachCopy(result.data);
+          reply({ id: request.id, kind: 'result', value: { data, programmedBytes: result.programmedBytes } }, [data.buffer]);
+        } finally {
+          jobs.delete(request.id);
+        }
+        return;
+      }
+      case 'cancelJob':
+        jobs.get(request.jobId)?.abort();
+        return;
+    }
+  };
+
+  port.onmessage = (event: MessageEvent<BridgeRequest>) => {
+    const request = event.data;
+    handle(request).catch((error: unknown) => {
+      reply({ id: request.id, kind: 'error', error: serializeError(error) });
+    });
+  };
+  port.start();
+
+  return () => {
+    port.onmessage = null;
+    port.close();
+    for (const controller of jobs.values()) {
+      controller.abort();
+    }
+    jobs.clear();
+  };
+}
+
+interface PendingRequest {
+  resolve: (value: unknown) => void;
+  reject: (error: Error) => void;
+  onProgress?: (progress: TransportJobProgress) => void;
+}
+
+/**
+ * Worker 端的传输层，每个调用转成一次桥请求，由主线程上的真实传输层执行
+ *
+ * readInto / sendAndReceiveInto 收到移交的缓冲后再复制进调用方的目标，
+ * 因此帧传输层、原地读取等上层路径无需区分是否跨线程。
+ */
+export class BridgedTransport implements Transport {
+  readonly flushInput?: Transport['flushInput'];
+  readonly drainInput?: Transport['drainInput'];
+  readonly runJob?: Transport['runJob'];
+
+  private readonly pending = new Map<number, PendingRequest>();
+  private nextId = 1;
+  private closed = false;
+
+  constructor(private readonly port: MessagePort, features: TransportBridgeFeatures) {
+    port.onmessage = (event: MessageEvent<BridgeResponse>) => {
+      this.dispatch(event.data);
+    };
+    port.start();
+
+    if (features.flushInput) {
+      this.flushInput = async () => {
+        await this.request({ op: 'flushInput' });
+      };
+    }
+    if (features.drainInput) {
+      this.drainInput = async (quietMs, maxWaitMs) => {
+        await this.request({ op: 'drainInput', quietMs, maxWaitMs });
+      };
+    }
+    if (features.runJob) {
+      this.runJob = (job, onProgress, signal) => this.requestJob(job, onProgress, signal);
+    }
+  }
+
+  async send(payload: Uint8Array, timeoutMs?: number): Promise<boolean> {
+    const copy = detachCopy(payload);
+    return await this.request({ op: 'send', payload: copy, timeoutMs }, [copy.buffer]) as boolean;
+  }
+
+  async read(length: number, timeoutMs?: number, mode?: TransportReadMode): Promise<{ data: Uint8Array }> {
+    return { data: await this.request({ op: 'read', length, timeoutMs, mode }) as Uint8Array };
+  }
+
+  async sendAndReceive(
+    payload: Uint8Array,
+    readLength: number,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<{ data: Uint8Array }> {
+    const copy = detachCopy(payload);
+    const data = await this.request({
+      op: 'sendAndReceive',
+      payload: copy,
+      readLength,
+      sendTimeoutMs,
+      readTimeoutMs,
+    }, [copy.buffer]) as Uint8Array;
+    return { data };
+  }
+
+  async readInto(target: Uint8Array, offset: number, length: number, timeoutMs?: number): Promise<void> {
+    const { data } = await this.read(length, timeoutMs);
+    target.set(data, offset);
+  }
+
+  async sendAndReceiveInto(
+    payload: Uint8Array,
+    target: Uint8Array,
+    offset: number,
+    length: number,
+    skipLength = 0,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<void> {
+    const copy = detachCopy(payload);
+    const data = await this.request({
+      op: 'sendAndReceiveInto',
+      payload: copy,
+      length,
+      skipLength,
+      sendTimeoutMs,
+      readTimeoutMs,
+    }, [copy.buffer]) as Uint8Array;
+    target.set(data, offset);
+  }
+
+  async setSignals(signals: SerialOutputSignals): Promise<void> {
+    await this.request({ op: 'setSignals', signals });
+  }
+
+  /**
+   * 只断开桥，串口由主线程管理
+   */
+  close(): Promise<void> {
+    this.closed = true;
+    this.port.onmessage = null;
+    this.port.close();
+    const error = new Error('Transport bridge closed');
+    for (const pending of this.pending.values()) {
+      pending.reject(error);
+    }
+    this.pending.clear();
+    return Promise.resolve();
+  }
+
+  private request(
+    body: BridgeRequestBody,
+    transfer: Transferable[] = [],
+    onProgress?: PendingRequest['onProgress'],
+  ): Promise<unknown> {
+    if (this.closed) {
+      return Promise.reject(new Error('Transport bridge closed'));
+    }
+
+    const id = this.nextId++;
+    const request: BridgeRequest = { ...body, id };
+    return new Promise((resolve, reject) => {
+      this.pending.set(id, { resolve, reject, onProgress });
+      this.port.postMessage(request, transfer);
+    });
+  }
+
+  private async requestJob(
+    job: TransportJob,
+    onProgress?: (progress: TransportJobProgress) => void,
+    signal?: AbortSignal,
+  ): Promise<TransportJobResult> {
+    const jobId = this.nextId;
+    const abort = () => {
+      this.port.postMessage({ op: 'cancelJob', jobId, id: 0 } satisfies BridgeRequest);
+    };
+    signal?.addEventListener('abort', abort, { once: true });
+    try {
+      if (job.kind === 'program') {
+        const data = detachCopy(job.data);
+        return await this.request({ op: 'runJob', job: { ...job, data } }, [data.buffer], onProgress) as TransportJobResult;
+      }
+      return await this.request({ op: 'runJob', job }, [], onProgress) as TransportJobResult;
+    } finally {
+      signal?.removeEventListener('abort', abort);
+    }
+  }
+
+  private dispatch(response: BridgeResponse): void {
+    const pending = this.pending.get(response.id);
+    if (!pending) {
+      return;
+    }
+
+    switch (response.kind) {
+      case 'progress':
+        pending.onProgress?.(response.progress);
+        return;
+      case 'result':
+        this.pending.delete(response.id);
+        pending.resolve(response.value);
+        return;
+      case 'error':
+        this.pending.delete(response.id);
+        pending.reject(deserializeError(response.error));
+        return;
+    }
+  }
+}
@@ -2,6 +2,7 @@ import { AdvancedSettings } from '@/settings/advanced-settings';
 import type { DefaultReader } from '@/types';
 import { withTimeout } from '@/utils/async-utils';
 
+import { ByteRing } from './byte-ring';
 import { Mutex } from './mutex';
 import { createReadTimeoutError } from './transport-errors';
 import type { Transport, TransportReadMode } from './types';
@@ -13,8 +14,7 @@ export class WebSerialTransport implements Transport {
   private writer: WritableStreamDefaultWriter<Uint8Array> | null = null;
   private writerRecoveryPromise: Promise<void> | null = null;
   private pumpPromise: Promise<void> | null = null;
-  private readonly bufferedChunks: Uint8Array[] = [];
-  private bufferedLength = 0;
+  private readonly rxBuffer = new ByteRing();
   private readWaiters = new Set<() => void>();
   private streamDone = false;
   private streamError: unknown = null;
@@ -123,7 +123,18 @@ export class WebSerialTransport implements Transport {
     }
 
     this.ensurePumpStarted();
-    return this.readFromBuffer(length, timeoutMs);
+    const data = new Uint8Array(length);
+    await this.readFromBuffer(data, 0, length, timeoutMs);
+    return { data };
+  }
+
+  async readInto(target: Uint8Array, offset: number, length: number, timeoutMs?: number): Promise<void> {
+    if (!this.port.readable) {
+      throw new Error('Port readable stream is not available');
+    }
+
+    this.ensurePumpStarted();
+    await this.readFromBuffer(target, offset, length, timeoutMs);
   }
 
   async sendAndReceive(
@@ -141,6 +152,27 @@ export class WebSerialTransport implements Transport {
     }
   }
 
+  async sendAndReceiveInto(
+    payload: Uint8Array,
+    target: Uint8Array,
+    offset: number,
+    length: number,
+    skipLength = 0,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<void> {
+    const release = await this.mutex.acquire();
+    try {
+      await this.send(payload, sendTimeoutMs);
+      if (skipLength > 0) {
+        await this.read(skipLength, readTimeoutMs);
+      }
+      await this.readInto(target, offset, length, readTimeoutMs);
+    } finally {
+      release();
+    }
+  }
+
   async setSignals(signals: SerialOutputSignals): Promise<void> {
     await this.port.setSignals(signals);
   }
@@ -192,6 +224,22 @@ export class WebSerialTransport implements Transport {
     await this.port.close();
   }
 
+  /**
+   * 关闭串口但保留传输层对象，把设备暂时交给其他执行上下文（如后台 Worker）独占
+   */
+  async suspend(): Promise<void> {
+    await this.close();
+    this.resetPumpState();
+  }
+
+  /**
+   * 按原配置重新打开 suspend 关闭的串口；控制信号由调用方重新初始化
+   */
+  async resume(options: SerialOptions): Promise<void> {
+    this.resetPumpState();
+    await this.port.open(options);
+  }
+
   private async waitForCloseStage(operation: Promise<unknown>, stage: string): Promise<void> {
     try {
       await withTimeout(
@@ -217,8 +265,7 @@ export class WebSerialTransport implements Transport {
     }
 
     // Reset buffer state when restarting pump after a previous error
-    this.bufferedChunks.length = 0;
-    this.bufferedLength = 0;
+    this.rxBuffer.clear();
     this.streamDone = false;
     this.streamError = null;
     this.reader = this.port.readable.getReader();
@@ -235,8 +282,7 @@ export class WebSerialTransport implements Transport {
       this.reader = null;
     }
     this.pumpPromise = null;
-    this.bufferedChunks.length = 0;
-    this.bufferedLength = 0;
+    this.rxBuffer.clear();
     this.streamDone = false;
     this.streamError = null;
   }
@@ -258,8 +304,7 @@ export class WebSerialTransport implements Transport {
         }
 
         if (value && value.byteLength > 0) {
-          this.bufferedChunks.push(new Uint8Array(value));
-          this.bufferedLength += value.byteLength;
+          this.rxBuffer.write(value);
           this.totalRxChunks += 1;
           this.totalRxBytes += value.byteLength;
           this.lastRxAt = Date.now();
@@ -287,7 +332,7 @@ export class WebSerialTransport implements Transport {
   }
 
   private async waitForData(timeoutMs: number): Promise<void> {
-    if (this.bufferedLength > 0 || this.streamDone || this.streamError) {
+    if (this.rxBuffer.length > 0 || this.streamDone || this.streamError) {
       return;
     }
 
@@ -306,33 +351,8 @@ export class WebSerialTransport implements Transport {
     }
   }
 
-  private consumeBufferedData(
-    target: Uint8Array,
-    offset: number,
-  ): number {
-    let nextOffset = offset;
-
-    while (nextOffset < target.byteLength && this.bufferedChunks.length > 0) {
-      const chunk = this.bufferedChunks[0];
-      const bytesToCopy = Math.min(chunk.byteLength, target.byteLength - nextOffset);
-      target.set(chunk.subarray(0, bytesToCopy), nextOffset);
-      nextOffset += bytesToCopy;
-
-      if (bytesToCopy === chunk.byteLength) {
-        this.bufferedChunks.shift();
-      } else {
-        this.bufferedChunks[0] = chunk.subarray(bytesToCopy);
-      }
-
-      this.bufferedLength -= bytesToCopy;
-    }
-
-    return nextOffset;
-  }
-
   private clearBuffer(): void {
-    this.bufferedChunks.length = 0;
-    this.bufferedLength = 0;
+    this.rxBuffer.clear();
   }
 
   private buildReadTimeoutError(params: {
@@ -367,7 +387,7 @@ export class WebSerialTransport implements Transport {
       expectedLength,
       receivedLength,
       diagnostics:
-        `buffered=${this.bufferedLength}B, initialBuffered=${initialBufferedLength}B, `
+        `buffered=${this.rxBuffer.length}B, initialBuffered=${initialBufferedLength}B, `
         + `sessionRx=${sessionRxBytes}B/${sessionRxChunks}chunks, `
         + `totalRx=${this.totalRxBytes}B/${this.totalRxChunks}chunks, `
         + `totalTx=${this.totalTxBytes}B/${this.totalTxPackets}packets, `
@@ -375,25 +395,29 @@ export class WebSerialTransport implements Transport {
     });
   }
 
+  /**
+   * 从环形缓冲取出恰好 length 字节写入 target[start..]，数据直接落到调用方的缓冲
+   */
   private async readFromBuffer(
+    target: Uint8Array,
+    start: number,
     length: number,
     timeoutMs?: number,
-  ): Promise<{ data: Uint8Array }> {
+  ): Promise<void> {
     const timeout = timeoutMs ?? AdvancedSettings.packageReceiveTimeout;
     const readId = ++this.readSequence;
     const startedAt = Date.now();
-    const initialBufferedLength = this.bufferedLength;
+    const initialBufferedLength = this.rxBuffer.length;
     const startRxBytes = this.totalRxBytes;
     const startRxChunks = this.totalRxChunks;
     let offset = 0;
-    const accumulatedData = new Uint8Array(length);
 
     while (offset < length) {
       if (this.streamError) {
         throw this.streamError instanceof Error ? this.streamError : new Error('Serial read pump failed');
       }
 
-      offset = this.consumeBufferedData(accumulatedData, offset);
+      offset += this.rxBuffer.readInto(target, start + offset, length - offset);
       if (offset >= length) {
         break;
       }
@@ -426,11 +450,9 @@ export class WebSerialTransport implements Transport {
       const sessionRxChunks = this.totalRxChunks - startRxChunks;
       throw new Error(
         `Incomplete package read: expected ${length} bytes, got ${offset} `
-        + `(read#${readId}, buffered=${this.bufferedLength}B, initialBuffered=${initialBufferedLength}B, `
+        + `(read#${readId}, buffered=${this.rxBuffer.length}B, initialBuffered=${initialBufferedLength}B, `
         + `sessionRx=${sessionRxBytes}B/${sessionRxChunks}chunks, streamDone=${this.streamDone})`,
       );
     }
-
-    return { data: accumulatedData };
   }
 }
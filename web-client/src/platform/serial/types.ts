@@ -1,14 +1,56 @@
+import type { DeviceCapabilities } from '@/types/device-capabilities';
 import type { FirmwareProfile } from '@/types/firmware-profile';
 import type { SerialPortInfo } from '@/types/serial';
 import type { PortFilter } from '@/utils/port-filter';
 
 export type TransportReadMode = 'byob' | 'default';
 
+/**
+ * 由传输层整段执行的 v1 命令循环（原生后端），协议层负责填写操作码与超时
+ */
+export type TransportJob =
+  | { kind: 'dump'; opcode: number; address: number; size: number; chunkSize: number; timeoutMs: number }
+  | {
+    kind: 'program';
+    opcode: number;
+    address: number;
+    chunkSize: number;
+    bufferSize: number;
+    timeoutMs: number;
+    timeoutPerByteMs: number;
+    skipErased: boolean;
+    /** 设备上报的单包上限（0xd3），原生端据此校验分块；未上报时只受 16 位长度字段限制 */
+    maxCommandSize?: number;
+    data: Uint8Array;
+  };
+
+export interface TransportJobProgress {
+  processedBytes: number;
+  totalBytes: number;
+}
+
+export interface TransportJobResult {
+  data: Uint8Array;
+  programmedBytes: number;
+}
+
 export interface Transport {
   send: (payload: Uint8Array, timeoutMs?: number) => Promise<boolean>;
   read: (length: number, timeoutMs?: number, mode?: TransportReadMode) => Promise<{ data: Uint8Array }>;
   /** Atomic send-then-read guarded by a mutex so concurrent callers are serialised. */
   sendAndReceive: (payload: Uint8Array, readLength: number, sendTimeoutMs?: number, readTimeoutMs?: number) => Promise<{ data: Uint8Array }>;
+  /** 读取恰好 length 字节直接写入 target[offset..]，不分配中间缓冲 */
+  readInto?: (target: Uint8Array, offset: number, length: number, timeoutMs?: number) => Promise<void>;
+  /** 原子发送后读取：先丢弃 skipLength 字节（如 CRC 占位），其余 length 字节写入 target[offset..] */
+  sendAndReceiveInto?: (
+    payload: Uint8Array,
+    target: Uint8Array,
+    offset: number,
+    length: number,
+    skipLength?: number,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ) => Promise<void>;
   setSignals: (signals: SerialOutputSignals) => Promise<void>;
   flushInput?: () => Promise<void>;
   /**
@@ -19,6 +61,8 @@ export interface Transport {
    */
   drainInput?: (quietMs?: number, maxWaitMs?: number) => Promise<void>;
   close?: () => Promise<void>;
+  /** 整段执行读取/编程循环，仅回报进度与结果；只有原生后端提供 */
+  runJob?: (job: TransportJob, onProgress?: (progress: TransportJobProgress) => void, signal?: AbortSignal) => Promise<TransportJobResult>;
 }
 
 export interface DeviceSelection {
@@ -34,6 +78,7 @@ export interface DeviceHandle {
   connection?: null;
   portInfo?: SerialPortInfo;
   firmwareProfile?: FirmwareProfile;
+  capabilities?: DeviceCapabilities | null;
 }
 
 export interface DeviceGateway {
@@ -0,0 +1,73 @@
+import { DEFAULT_SERIAL_CONFIG } from '../constants';
+import { initDeviceSignals } from '../device-signals';
+import { WebSerialTransport } from '../transports';
+import type { Transport } from '../types';
+
+/**
+ * 把已授权的串口交给其他执行上下文（如后台 Worker）
+ *
+ * SerialPort 对象不能跨线程传递，只能在对方的 navigator.serial.getPorts() 中找到同一个串口：
+ * 同源的已授权串口列表顺序一致，再用 USB VID/PID 核对，对不上时不做租借。
+ */
+export interface SerialPortLease {
+  index: number;
+  usbVendorId?: number;
+  usbProductId?: number;
+}
+
+export async function describeSerialPort(port: SerialPort): Promise<SerialPortLease | null> {
+  const ports = await navigator.serial?.getPorts() ?? [];
+  const index = ports.indexOf(port);
+  if (index < 0) {
+    return null;
+  }
+  const info = port.getInfo();
+  return { index, usbVendorId: info.usbVendorId, usbProductId: info.usbProductId };
+}
+
+/**
+ * 在当前上下文打开租借的串口并初始化控制信号；找不到对应串口时返回 null
+ */
+export async function openLeasedSerialPort(lease: SerialPortLease): Promise<WebSerialTransport | null> {
+  const ports = await navigator.serial?.getPorts() ?? [];
+  const port = ports[lease.index] as SerialPort | undefined;
+  if (!port) {
+    return null;
+  }
+  const info = port.getInfo();
+  if (info.usbVendorId !== lease.usbVendorId || info.usbProductId !== lease.usbProductId) {
+    return null;
+  }
+
+  await port.open(DEFAULT_SERIAL_CONFIG);
+  const transport = new WebSerialTransport(port);
+  try {
+    await initDeviceSignals(transport);
+  } catch (error) {
+    await transport.close();
+    throw error;
+  }
+  return transport;
+}
+
+/**
+ * 沿包装链（帧传输层、会话记录等暴露的 inner）找到底层的 Web Serial 传输
+ */
+export function findWebSerialTransport(transport: Transport | null | undefined): WebSerialTransport | null {
+  let current: unknown = transport;
+  while (current) {
+    if (current instanceof WebSerialTransport) {
+      return current;
+    }
+    current = (current as { inner?: unknown }).inner;
+  }
+  return null;
+}
+
+/**
+ * 租借结束后按原配置重新打开串口
+ */
+export async function reclaimSerialPort(transport: WebSerialTransport, signalTarget: Transport = transport): Promise<void> {
+  await transport.resume(DEFAULT_SERIAL_CONFIG);
+  await initDeviceSignals(signalTarget);
+}
@@ -0,0 +1,469 @@
+import type { Transport } from '@/platform/serial';
+
+import { DiagnosticCommand, GBACommand, GBCCommand } from './command';
+
+/**
+ * 命令耗时剖析：协议层按操作码统计每条命令的三个时间点
+ *
+ * - send：调用开始到命令写完（帧传输层可观测，其余传输层不单独记录）
+ * - firstByte：调用开始到响应首部到达（帧传输层为响应帧头；非帧传输层的一次性收发无法区分，记为完成时间）
+ * - complete：调用开始到响应全部到达
+ *
+ * 直方图采用 HDR 风格的对数-线性分桶，单位 µs，相对误差不超过 1/64；
+ * 同时保留每条命令的起止时间，可导出 Chrome trace-event JSON（chrome://tracing、Perfetto）。
+ * 关闭时各入口直接返回，不分配计时对象也不保留记录。
+ */
+
+export type CommandTimingStage = 'send' | 'firstByte' | 'complete';
+
+export type CommandPhase = 'erase' | 'program' | 'poll' | 'read' | 'other';
+
+/** 百分位统计，单位 ms */
+export interface LatencySummary {
+  count: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  max: number;
+  mean: number;
+}
+
+export interface OpcodeLatencyStats {
+  opcode: number;
+  name: string;
+  count: number;
+  /** 累计完成耗时 (ms) */
+  totalMs: number;
+  send: LatencySummary | null;
+  firstByte: LatencySummary | null;
+  complete: LatencySummary;
+}
+
+export interface ChromeTraceEvent {
+  name: string;
+  cat?: string;
+  ph: 'X' | 'M';
+  ts?: number;
+  dur?: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, unknown>;
+}
+
+export interface ChromeTrace {
+  traceEvents: ChromeTraceEvent[];
+  displayTimeUnit: 'ms';
+  otherData?: Record<string, unknown>;
+}
+
+export interface CommandProfilerOptions {
+  /** 保留的命令与阶段记录条数上限，超出后仅更新直方图 */
+  maxSamples?: number;
+  /** 是否一开始就记录，默认 true */
+  enabled?: boolean;
+}
+
+interface CommandSample {
+  track: number;
+  opcode: number;
+  phase: CommandPhase;
+  /** 由 withPhase 显式划定，不参与相邻命令的阶段合并 */
+  scoped: boolean;
+  startedAt: number;
+  sentAt: number | null;
+  firstByteAt: number | null;
+  endedAt: number;
+  bytesOut: number;
+  bytesIn: number;
+}
+
+interface PhaseSpan {
+  track: number;
+  phase: CommandPhase;
+  label: string;
+  startedAt: number;
+  endedAt: number;
+}
+
+/**
+ * 一条进行中的命令，由 begin 返回，complete/abort 结束
+ */
+export interface CommandTimer {
+  readonly track: number;
+  readonly opcode: number;
+  readonly phase: CommandPhase;
+  readonly scoped: boolean;
+  readonly startedAt: number;
+  readonly bytesOut: number;
+  sentAt: number | null;
+  firstByteAt: number | null;
+}
+
+const SUB_BUCKET_BITS = 6;
+const SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+/** 线性区间 [0, 2 * SUB_BUCKET_COUNT) µs 逐 µs 计数 */
+const LINEAR_LIMIT = SUB_BUCKET_COUNT * 2;
+/** 上限约 35 分钟，超出的值记入最后一个桶 */
+const MAX_VALUE_US = 0x7fffffff;
+const BUCKET_COUNT = bucketIndex(MAX_VALUE_US) + 1;
+
+function bucketIndex(valueUs: number): number {
+  if (valueUs < LINEAR_LIMIT) {
+    return valueUs;
+  }
+  const shift = 31 - Math.clz32(valueUs) - SUB_BUCKET_BITS;
+  return SUB_BUCKET_COUNT * shift + (valueUs >>> shift);
+}
+
+/** 桶的代表值：桶区间的中点 */
+function bucketValue(index: number): number {
+  if (index < LINEAR_LIMIT) {
+    return index;
+  }
+  const shift = Math.floor(index / SUB_BUCKET_COUNT) - 1;
+  const sub = index - SUB_BUCKET_COUNT * shift;
+  return sub * 2 ** shift + 2 ** (shift - 1);
+}
+
+/**
+ * HDR 风格的延迟直方图：每个 2 的幂区间再均分 64 份，记录为 O(1)，内存固定
+ */
+export class LatencyHistogram {
+  private readonly counts = new Uint32Array(BUCKET_COUNT);
+  private total = 0;
+  private sumUs = 0;
+  private maxUs = 0;
+
+  get count(): number {
+    return this.total;
+  }
+
+  record(valueMs: number): void {
+    const valueUs = Math.min(MAX_VALUE_US, Math.max(0, Math.round(valueMs * 1000)));
+    this.counts[bucketIndex(valueUs)] += 1;
+    this.total += 1;
+    this.sumUs += valueUs;
+    this.maxUs = Math.max(this.maxUs, valueUs);
+  }
+
+  /**
+   * @param percentile 0-100
+   * @returns 对应百分位的耗时 (ms)，无记录时为 0
+   */
+  valueAtPercentile(percentile: number): number {
+    if (this.total === 0) {
+      return 0;
+    }
+    const rank = Math.max(1, Math.ceil((Math.min(100, Math.max(0, percentile)) / 100) * this.total));
+    let seen = 0;
+    for (let index = 0; index < BUCKET_COUNT; index++) {
+      seen += this.counts[index];
+      if (seen >= rank) {
+        return Math.min(bucketValue(index), this.maxUs) / 1000;
+      }
+    }
+    return this.maxUs / 1000;
+  }
+
+  summary(): LatencySummary {
+    return {
+      count: this.total,
+      p50: this.valueAtPercentile(50),
+      p90: this.valueAtPercentile(90),
+      p99: this.valueAtPercentile(99),
+      max: this.maxUs / 1000,
+      mean: this.total > 0 ? this.sumUs / this.total / 1000 : 0,
+    };
+  }
+
+  reset(): void {
+    this.counts.fill(0);
+    this.total = 0;
+    this.sumUs = 0;
+    this.maxUs = 0;
+  }
+}
+
+const OPCODE_NAMES = new Map<number, string>([
+  ...Object.entries(GBACommand).filter(([, value]) => typeof value === 'number')
+    .map(([name, value]) => [value as number, `GBA_${name}`] as const),
+  ...Object.entries(GBCCommand).filter(([, value]) => typeof value === 'number')
+    .map(([name, value]) => [value as number, `GBC_${name}`] as const),
+  ...Object.entries(DiagnosticCommand).filter(([, value]) => typeof value === 'number')
+    .map(([name, value]) => [value as number, name] as const),
+]);
+
+const OPCODE_PHASES = new Map<number, CommandPhase>([
+  [GBACommand.ERASE_CHIP, 'erase'],
+  [GBACommand.BLOCK_ERASE, 'erase'],
+  [GBACommand.SECTOR_ERASE, 'erase'],
+  [GBACommand.PROGRAM, 'program'],
+  [GBACommand.PROGRAM_RLE, 'program'],
+  [GBACommand.RAM_WRITE, 'program'],
+  [GBACommand.RAM_WRITE_TO_FLASH, 'program'],
+  [GBACommand.FRAM_WRITE, 'program'],
+  [GBCCommand.ROM_PROGRAM, 'program'],
+  [GBCCommand.FRAM_WRITE, 'program'],
+  [GBACommand.READ, 'read'],
+  [GBACommand.READ_RLE, 'read'],
+  [GBACommand.RAM_READ, 'read'],
+  [GBACommand.FRAM_READ, 'read'],
+  [GBCCommand.READ, 'read'],
+  [GBCCommand.FRAM_READ, 'read'],
+]);
+
+/** 操作码名称，未知操作码以十六进制显示 */
+export function opcodeName(opcode: number): string {
+  return OPCODE_NAMES.get(opcode) ?? `0x${opcode.toString(16).padStart(2, '0')}`;
+}
+
+/** 命令未处于 withPhase 范围内时，按操作码归入的阶段 */
+export function opcodePhase(opcode: number): CommandPhase {
+  return OPCODE_PHASES.get(opcode) ?? 'other';
+}
+
+/** 同一阶段相邻命令的间隔超过该值时另起一段 */
+const PHASE_MERGE_GAP_MS = 50;
+const DEFAULT_MAX_SAMPLES = 1 << 18;
+
+/**
+ * 命令耗时剖析器，协议层各收发入口共用一个实例
+ */
+export class CommandProfiler {
+  private readonly histograms = new Map<number, Record<CommandTimingStage, LatencyHistogram>>();
+  private readonly timers = new WeakMap<Uint8Array, CommandTimer>();
+  private readonly phases = new WeakMap<Transport, CommandPhase>();
+  private readonly tracks = new WeakMap<Transport, number>();
+  private readonly samples: CommandSample[] = [];
+  private readonly spans: PhaseSpan[] = [];
+  private readonly maxSamples: number;
+  private nextTrack = 0;
+  private origin = performance.now();
+  private dropped = 0;
+
+  /** 关闭后新发出的命令不再记录，已有的统计保留到下次 reset */
+  enabled: boolean;
+
+  constructor(options: CommandProfilerOptions = {}) {
+    this.maxSamples = options.maxSamples ?? DEFAULT_MAX_SAMPLES;
+    this.enabled = options.enabled ?? true;
+  }
+
+  /** 因超出上限而未保留的记录条数 */
+  get droppedSamples(): number {
+    return this.dropped;
+  }
+
+  /**
+   * 命令发出前调用；payload 为 v1 命令包，帧传输层凭同一对象补记 send/firstByte
+   * @returns 未开启记录时为 null
+   */
+  begin(input: Transport, payload: Uint8Array, now = performance.now()): CommandTimer | null {
+    if (!this.enabled) {
+      return null;
+    }
+    const opcode = payload[2] ?? 0;
+    const scopedPhase = this.phases.get(input);
+    const timer: CommandTimer = {
+      track: this.trackOf(input),
+      opcode,
+      phase: scopedPhase ?? opcodePhase(opcode),
+      scoped: scopedPhase !== undefined,
+      startedAt: now,
+      bytesOut: payload.byteLength,
+      sentAt: null,
+      firstByteAt: null,
+    };
+    this.timers.set(payload, timer);
+    return timer;
+  }
+
+  /** 命令已写入传输层 */
+  markSent(payload: Uint8Array, now = performance.now()): void {
+    const timer = this.timers.get(payload);
+    if (timer && timer.sentAt === null) {
+      timer.sentAt = now;
+    }
+  }
+
+  /** 响应首部已到达 */
+  markFirstByte(payload: Uint8Array, now = performance.now()): void {
+    const timer = this.timers.get(payload);
+    if (timer && timer.firstByteAt === null) {
+      timer.firstByteAt = now;
+    }
+  }
+
+  complete(timer: CommandTimer | null, bytesIn: number, now = performance.now()): void {
+    if (!timer) {
+      return;
+    }
+    let stages = this.histograms.get(timer.opcode);
+    if (!stages) {
+      stages = { send: new LatencyHistogram(), firstByte: new LatencyHistogram(), complete: new LatencyHistogram() };
+      this.histograms.set(timer.opcode, stages);
+    }
+    if (timer.sentAt !== null) {
+      stages.send.record(timer.sentAt - timer.startedAt);
+    }
+    stages.firstByte.record((timer.firstByteAt ?? now) - timer.startedAt);
+    stages.complete.record(now - timer.startedAt);
+
+    if (this.samples.length < this.maxSamples) {
+      this.samples.push({
+        track: timer.track,
+        opcode: timer.opcode,
+        phase: timer.phase,
+        scoped: timer.scoped,
+        startedAt: timer.startedAt,
+        sentAt: timer.sentAt,
+        firstByteAt: timer.firstByteAt,
+        endedAt: now,
+        bytesOut: timer.bytesOut,
+        bytesIn,
+      });
+    } else {
+      this.dropped += 1;
+    }
+  }
+
+  /**
+   * 将 run 内该传输层发出的命令归入 phase，并记录一段阶段区间；可嵌套，内层优先
+   */
+  async withPhase<T>(input: Transport, phase: CommandPhase, run: () => Promise<T>, label: string = phase): Promise<T> {
+    if (!this.enabled) {
+      return run();
+    }
+    const outer = this.phases.get(input);
+    const startedAt = performance.now();
+    this.phases.set(input, phase);
+    try {
+      return await run();
+    } finally {
+      if (outer === undefined) {
+        this.phases.delete(input);
+      } else {
+        this.phases.set(input, outer);
+      }
+      this.recordSpan(input, phase, startedAt, performance.now(), label);
+    }
+  }
+
+  /** 记录一段不经过协议层逐条收发的区间，例如原生批处理任务 */
+  recordSpan(input: Transport, phase: CommandPhase, startedAt: number, endedAt: number, label: string = phase): void {
+    if (!this.enabled) {
+      return;
+    }
+    if (this.spans.length < this.maxSamples) {
+      this.spans.push({ track: this.trackOf(input), phase, label, startedAt, endedAt });
+    } else {
+      this.dropped += 1;
+    }
+  }
+
+  /** 按累计耗时从大到小排列 */
+  getOpcodeStats(): OpcodeLatencyStats[] {
+    return [...this.histograms.entries()]
+      .map(([opcode, stages]) => {
+        const complete = stages.complete.summary();
+        return {
+          opcode,
+          name: opcodeName(opcode),
+          count: complete.count,
+          totalMs: complete.mean * complete.count,
+          send: stages.send.count > 0 ? stages.send.summary() : null,
+          firstByte: stages.firstByte.count > 0 ? stages.firstByte.summary() : null,
+          complete,
+        };
+      })
+      .sort((a, b) => b.totalMs - a.totalMs);
+  }
+
+  reset(): void {
+    this.histograms.clear();
+    this.samples.length = 0;
+    this.spans.length = 0;
+    this.dropped = 0;
+    this.origin = performance.now();
+  }
+
+  /**
+   * 导出 Chrome trace-event JSON
+   *
+   * 每个连接两条轨道：阶段轨道为 withPhase 区间与按操作码合并的相邻同阶段命令，
+   * 命令轨道为逐条命令。时间戳单位 µs，以上次 reset 为零点。
+   */
+  exportChromeTrace(): ChromeTrace {
+    const events: ChromeTraceEvent[] = [];
+    const toUs = (time: number) => Math.max(0, (time - this.origin) * 1000);
+    const tracks = new Set<number>();
+
+    const pushSpan = (tid: number, name: string, cat: string, startedAt: number, endedAt: number, args?: Record<string, unknown>) => {
+      events.push({ name, cat, ph: 'X', ts: toUs(startedAt), dur: Math.max(0, endedAt - startedAt) * 1000, pid: 1, tid, args });
+    };
+
+    for (const span of this.spans) {
+      tracks.add(span.track);
+      pushSpan(span.track * 2, span.label, span.phase, span.startedAt, span.endedAt);
+    }
+
+    const merging = new Map<number, { phase: CommandPhase; startedAt: number; endedAt: number; commands: number }>();
+    const flush = (track: number) => {
+      const current = merging.get(track);
+      if (current) {
+        pushSpan(track * 2, current.phase, current.phase, current.startedAt, current.endedAt, { commands: current.commands });
+        merging.delete(track);
+      }
+    };
+
+    for (const sample of this.samples) {
+      tracks.add(sample.track);
+      pushSpan(sample.track * 2 + 1, opcodeName(sample.opcode), 'command', sample.startedAt, sample.endedAt, {
+        opcode: sample.opcode,
+        phase: sample.phase,
+        bytesOut: sample.bytesOut,
+        bytesIn: sample.bytesIn,
+        sendMs: sample.sentAt === null ? undefined : sample.sentAt - sample.startedAt,
+        firstByteMs: sample.firstByteAt === null ? undefined : sample.firstByteAt - sample.startedAt,
+      });
+
+      if (sample.scoped) {
+        flush(sample.track);
+        continue;
+      }
+      const current = merging.get(sample.track);
+      if (current?.phase === sample.phase && sample.startedAt - current.endedAt <= PHASE_MERGE_GAP_MS) {
+        current.endedAt = sample.endedAt;
+        current.commands += 1;
+      } else {
+        flush(sample.track);
+        merging.set(sample.track, { phase: sample.phase, startedAt: sample.startedAt, endedAt: sample.endedAt, commands: 1 });
+      }
+    }
+    [...merging.keys()].forEach(flush);
+
+    for (const track of [...tracks].sort((a, b) => a - b)) {
+      events.push({ name: 'thread_name', ph: 'M', pid: 1, tid: track * 2, args: { name: `device ${track} phases` } });
+      events.push({ name: 'thread_name', ph: 'M', pid: 1, tid: track * 2 + 1, args: { name: `device ${track} commands` } });
+    }
+    events.push({ name: 'process_name', ph: 'M', pid: 1, tid: 0, args: { name: 'beggar_socket' } });
+
+    return {
+      traceEvents: events,
+      displayTimeUnit: 'ms',
+      otherData: { droppedSamples: this.dropped },
+    };
+  }
+
+  private trackOf(input: Transport): number {
+    let track = this.tracks.get(input);
+    if (track === undefined) {
+      track = this.nextTrack++;
+      this.tracks.set(input, track);
+    }
+    return track;
+  }
+}
+
+/** 全局剖析器，所有连接共用；默认关闭，由调试模式或调试面板开启 */
+export const commandProfiler = new CommandProfiler({ enabled: false });
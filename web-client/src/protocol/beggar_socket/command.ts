@@ -11,6 +11,8 @@ export enum GBACommand {
   RAM_WRITE_TO_FLASH = 0xf9,
   FRAM_WRITE = 0xe7,
   FRAM_READ = 0xe8,
+  PROGRAM_RLE = 0xe4,
+  READ_RLE = 0xe6,
 }
 
 export enum GBCCommand {
@@ -23,4 +25,14 @@ export enum GBCCommand {
   FRAM_READ = 0xeb,
 }
 
-export type Command = GBACommand | GBCCommand;
+/**
+ * USB 链路自检命令：不访问卡带总线，仅用于测量传输吞吐与往返延迟
+ */
+export enum DiagnosticCommand {
+  USB_SINK = 0xd0,
+  USB_SOURCE = 0xd1,
+  USB_LOOPBACK = 0xd2,
+  DEVICE_INFO = 0xd3,
+}
+
+export type Command = GBACommand | GBCCommand | DiagnosticCommand;
@@ -18,6 +18,8 @@ export const FLASH_CMD_ERASE_SETUP = 0x80;
 export const FLASH_CMD_SECTOR_ERASE = 0x30;
 /** Flash 全片擦除命令 */
 export const FLASH_CMD_CHIP_ERASE = 0x10;
+/** Flash 单字编程命令 */
+export const FLASH_CMD_PROGRAM = 0xa0;
 
 // --- GBA Flash 地址（16-bit 字模式） ---
 /** GBA Flash 解锁地址 1 */
@@ -40,3 +42,19 @@ export const GBC_FLASH_ADDR_2 = 0x555;
 // --- 协议 ACK ---
 /** 协议应答字节 */
 export const PROTOCOL_ACK = 0xaa;
+
+// --- 设备能力描述 ---
+/** 0xd3 设备能力描述符长度（不含 CRC） */
+export const DEVICE_INFO_SIZE = 48;
+
+// --- v2 帧 ---
+/** v2 帧命令码，帧内携带一个完整的 v1 命令 */
+export const FRAME_CODE = 0xc0;
+/** 请求帧头长度：2B 帧大小 + 0xc0 + 1B 序号 + 1B 标志 */
+export const FRAME_HEADER_SIZE = 5;
+/** 响应帧头长度：0xc0 + 1B 序号 + 1B 状态 + 1B 标志 + 2B 数据长度 */
+export const FRAME_RESPONSE_HEADER_SIZE = 6;
+/** 帧 CRC32 长度 */
+export const FRAME_CRC_SIZE = 4;
+/** 帧标志：附带 CRC32 */
+export const FRAME_FLAG_CRC = 0x01;
@@ -1,5 +1,6 @@
 import { timeout } from '@/utils/async-utils';
 
+import { commandProfiler } from './command-profiler';
 import {
   FLASH_CMD_AUTOSELECT,
   FLASH_CMD_ERASE_SETUP,
@@ -42,31 +43,85 @@ export async function flashEraseCommand(
   targetAddress: number,
   targetCommand: number,
 ): Promise<void> {
-  await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_1), cmdSet.unlockAddr1);
-  await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_2), cmdSet.unlockAddr2);
-  await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_ERASE_SETUP), cmdSet.unlockAddr1);
-  await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_1), cmdSet.unlockAddr1);
-  await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_2), cmdSet.unlockAddr2);
-  await cmdSet.write(input, cmdSet.encodeByte(targetCommand), targetAddress);
+  await commandProfiler.withPhase(input, 'erase', async () => {
+    await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_1), cmdSet.unlockAddr1);
+    await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_2), cmdSet.unlockAddr2);
+    await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_ERASE_SETUP), cmdSet.unlockAddr1);
+    await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_1), cmdSet.unlockAddr1);
+    await cmdSet.write(input, cmdSet.encodeByte(FLASH_CMD_UNLOCK_2), cmdSet.unlockAddr2);
+    await cmdSet.write(input, cmdSet.encodeByte(targetCommand), targetAddress);
+  });
+}
+
+/**
+ * Expected duration of a flash operation, taken from the CFI timing fields.
+ */
+export interface FlashWaitSchedule {
+  /** Typical duration in ms */
+  typicalMs: number;
+  /** Maximum duration in ms */
+  maxMs: number;
+}
+
+export interface FlashPollOptions {
+  pollBytes: number;
+  /** Fixed poll interval; with a schedule, the upper bound of the backoff */
+  pollIntervalMs: number;
+  timeoutMs: number;
+  schedule?: FlashWaitSchedule;
 }
 
+/** Wake up before the typical duration so fast sectors are not overslept */
+const SCHEDULE_FIRST_WAKE_RATIO = 0.8;
+const SCHEDULE_MIN_POLL_INTERVAL_MS = 2;
+
 /**
  * Poll a flash address until all read bytes are 0xFF or timeout.
+ *
+ * Without a schedule, polls every pollIntervalMs. With a schedule, sleeps until
+ * shortly before the typical duration, then polls with an interval doubling from
+ * SCHEDULE_MIN_POLL_INTERVAL_MS up to pollIntervalMs; past the CFI maximum it
+ * keeps polling at pollIntervalMs until timeoutMs.
+ * The whole wait, sleeps included, is profiled as one 'poll' span.
+ * @returns elapsed ms until the flash reported ready
  */
-export async function flashPollUntilReady(
+export function flashPollUntilReady(
   input: ProtocolTransportInput,
   cmdSet: FlashCommandSet,
   pollAddress: number,
-  opts: { pollBytes: number; pollIntervalMs: number; timeoutMs: number },
-): Promise<void> {
-  const deadline = Date.now() + opts.timeoutMs;
+  opts: FlashPollOptions,
+): Promise<number> {
+  return commandProfiler.withPhase(input, 'poll', () => pollUntilReady(input, cmdSet, pollAddress, opts));
+}
+
+async function pollUntilReady(
+  input: ProtocolTransportInput,
+  cmdSet: FlashCommandSet,
+  pollAddress: number,
+  opts: FlashPollOptions,
+): Promise<number> {
+  const { schedule } = opts;
+  const start = Date.now();
+  const deadline = start + opts.timeoutMs;
+  let intervalMs = opts.pollIntervalMs;
+  if (schedule) {
+    await timeout(Math.floor(schedule.typicalMs * SCHEDULE_FIRST_WAKE_RATIO));
+    intervalMs = 0;
+  }
   do {
     if (Date.now() > deadline) {
       throw new Error(`erase timeout after ${opts.timeoutMs}ms`);
     }
-    await timeout(opts.pollIntervalMs);
+    if (intervalMs > 0) {
+      await timeout(intervalMs);
+    }
     const status = await cmdSet.read(input, opts.pollBytes, pollAddress);
-    if (status.every(b => b === 0xff)) return;
+    if (status.every(b => b === 0xff)) return Date.now() - start;
+    if (schedule) {
+      intervalMs = Date.now() - start < schedule.maxMs
+        ? Math.min(Math.max(intervalMs * 2, SCHEDULE_MIN_POLL_INTERVAL_MS), opts.pollIntervalMs)
+        : opts.pollIntervalMs;
+    }
   } while (true);
 }
 
@@ -102,7 +157,7 @@ export async function flashEraseSector(
   cmdSet: FlashCommandSet,
   eraseAddress: number,
   pollAddress: number,
-  opts: { pollBytes: number; pollIntervalMs: number; timeoutMs: number },
+  opts: FlashPollOptions,
 ): Promise<boolean> {
   await flashEraseCommand(input, cmdSet, eraseAddress, FLASH_CMD_SECTOR_ERASE);
   await flashPollUntilReady(input, cmdSet, pollAddress, opts);
@@ -0,0 +1,243 @@
+import { Mutex, type Transport, type TransportReadMode } from '@/platform/serial';
+import { AdvancedSettings } from '@/settings/advanced-settings';
+import { stm32CRC32 } from '@/utils/crc-utils';
+
+import { commandProfiler } from './command-profiler';
+import { FRAME_CRC_SIZE, FRAME_FLAG_CRC, FRAME_RESPONSE_HEADER_SIZE } from './constants';
+import { encodeFrame, FrameStatus, parseFrameResponseHeader, toLegacyResponse } from './framing';
+
+const SEQ_SPACE = 256;
+const DEFAULT_WINDOW = 4;
+
+export interface FramedTransportOptions {
+  /** 最多同时在途的帧数 */
+  window?: number;
+  /** 在途帧的总字节上限，应不大于设备命令缓冲区 */
+  maxInFlightBytes?: number;
+  /** 请求与响应是否附带 CRC32 */
+  frameCrc?: boolean;
+}
+
+interface PendingFrame {
+  seq: number;
+  /** 原始 v1 命令，供耗时剖析器补记发送与首字节时间 */
+  payload: Uint8Array;
+  size: number;
+  readTimeoutMs: number;
+  resolve: (data: Uint8Array) => void;
+  reject: (error: Error) => void;
+}
+
+/**
+ * v2 帧传输层
+ *
+ * 包装原始串口传输：sendAndReceive 的 v1 命令被装入带序号的帧，
+ * 多个调用方可同时发出命令，响应按序号分发并还原为 v1 格式，协议函数无需改动。
+ * send/read 保持透传，仅供调试工具在没有在途帧时收发原始 v1 命令。
+ */
+export class FramedTransport implements Transport {
+  private readonly window: number;
+  private readonly maxInFlightBytes: number;
+  private readonly frameCrc: boolean;
+  private readonly sendMutex = new Mutex();
+  private readonly pending = new Map<number, PendingFrame>();
+  private readonly slotWaiters: (() => void)[] = [];
+  private inFlightBytes = 0;
+  private nextSeq = 0;
+  private receiving = false;
+
+  /** 原生批处理任务发送 v1 命令，直接交给内层传输；读写循环串行调用，此时没有在途帧 */
+  readonly runJob?: Transport['runJob'];
+
+  constructor(readonly inner: Transport, options: FramedTransportOptions = {}) {
+    this.window = Math.max(1, Math.min(options.window ?? DEFAULT_WINDOW, SEQ_SPACE - 1));
+    this.maxInFlightBytes = options.maxInFlightBytes ?? Number.MAX_SAFE_INTEGER;
+    this.frameCrc = options.frameCrc ?? false;
+    this.runJob = inner.runJob?.bind(inner);
+  }
+
+  /** 当前在途帧数 */
+  get inFlight(): number {
+    return this.pending.size;
+  }
+
+  send(payload: Uint8Array, timeoutMs?: number): Promise<boolean> {
+    return this.inner.send(payload, timeoutMs);
+  }
+
+  read(length: number, timeoutMs?: number, mode?: TransportReadMode): Promise<{ data: Uint8Array }> {
+    return this.inner.read(length, timeoutMs, mode);
+  }
+
+  async sendAndReceive(
+    payload: Uint8Array,
+    _readLength: number,
+    sendTimeoutMs?: number,
+    readTimeoutMs?: number,
+  ): Promise<{ data: Uint8Array }> {
+    // 帧大小与序号无关，先按序号 0 估算占用的设备缓冲区
+    const size = encodeFrame(payload, 0, this.frameCrc).byteLength;
+    await this.acquireSlot(size);
+
+    const seq = this.allocateSeq();
+    const frame = encodeFrame(payload, seq, this.frameCrc);
+    const response = new Promise<Uint8Array>((resolve, reject) => {
+      this.pending.set(seq, {
+        seq,
+        payload,
+        size,
+        readTimeoutMs: readTimeoutMs ?? AdvancedSettings.packageReceiveTimeout,
+        resolve,
+        reject,
+      });
+    });
+    this.inFlightBytes += size;
+
+    try {
+      const release = await this.sendMutex.acquire();
+      try {
+        await this.inner.send(frame, sendTimeoutMs);
+        commandProfiler.markSent(payload);
+      } finally {
+        release();
+      }
+    } catch (error) {
+      this.failAll(error instanceof Error ? error : new Error(String(error)));
+    }
+
+    this.startReceiving();
+    return { data: await response };
+  }
+
+  async setSignals(signals: SerialOutputSignals): Promise<void> {
+    // DTR/RTS 上升沿会清空设备命令缓冲区，在途帧不会再有响应
+    if (this.pending.size > 0 && (signals.dataTerminalReady || signals.requestToSend)) {
+      this.failAll(new Error('Frame channel reset by control signals'));
+    }
+    await this.inner.setSignals(signals);
+  }
+
+  async flushInput(): Promise<void> {
+    // 响应带序号，无需在 ACK 后清空输入来重新对齐；有在途帧时清空会丢失其它帧的响应
+    if (this.pending.size === 0) {
+      await this.inner.flushInput?.();
+    }
+  }
+
+  async drainInput(quietMs?: number, maxWaitMs?: number): Promise<void> {
+    if (this.inner.drainInput) {
+      await this.inner.drainInput(quietMs, maxWaitMs);
+    } else {
+      await this.inner.flushInput?.();
+    }
+  }
+
+  async close(): Promise<void> {
+    this.failAll(new Error('Frame channel closed'));
+    await this.inner.close?.();
+  }
+
+  private async acquireSlot(size: number): Promise<void> {
+    while (
+      this.pending.size >= this.window
+      || (this.pending.size > 0 && this.inFlightBytes + size > this.maxInFlightBytes)
+    ) {
+      await new Promise<void>((resolve) => {
+        this.slotWaiters.push(resolve);
+      });
+    }
+  }
+
+  private releaseSlot(frame: PendingFrame): void {
+    if (!this.pending.delete(frame.seq)) {
+      return;
+    }
+    this.inFlightBytes -= frame.size;
+    const waiters = this.slotWaiters.splice(0);
+    waiters.forEach((resolve) => {
+      resolve();
+    });
+  }
+
+  private allocateSeq(): number {
+    while (this.pending.has(this.nextSeq)) {
+      this.nextSeq = (this.nextSeq + 1) % SEQ_SPACE;
+    }
+    const seq = this.nextSeq;
+    this.nextSeq = (this.nextSeq + 1) % SEQ_SPACE;
+    return seq;
+  }
+
+  private failAll(error: Error): void {
+    for (const frame of [...this.pending.values()]) {
+      this.releaseSlot(frame);
+      frame.reject(error);
+    }
+  }
+
+  /**
+   * 单一接收循环：有在途帧时持续读取响应帧并按序号分发。
+   * 读超时或帧头错位后无法定位后续响应，所有在途帧一并失败，由上层复位重试。
+   */
+  private startReceiving(): void {
+    if (this.receiving) {
+      return;
+    }
+    this.receiving = true;
+
+    void (async () => {
+      try {
+        while (this.pending.size > 0) {
+          await this.receiveOne();
+        }
+      } catch (error) {
+        this.failAll(error instanceof Error ? error : new Error(String(error)));
+      } finally {
+        this.receiving = false;
+        // 循环退出与新帧登记之间可能交错
+        if (this.pending.size > 0) {
+          this.startReceiving();
+        }
+      }
+    })();
+  }
+
+  private async receiveOne(): Promise<void> {
+    // 设备按接收顺序执行，最早的在途帧决定本次等待时长
+    const oldest = this.pending.values().next().value as PendingFrame;
+    const { data: headerBytes } = await this.inner.read(FRAME_RESPONSE_HEADER_SIZE, oldest.readTimeoutMs);
+    const header = parseFrameResponseHeader(headerBytes);
+    if (!header) {
+      throw new Error(`Invalid frame response header: ${Array.from(headerBytes, b => b.toString(16).padStart(2, '0')).join(' ')}`);
+    }
+    const frame = this.pending.get(header.seq);
+    if (frame) {
+      commandProfiler.markFirstByte(frame.payload);
+    }
+
+    const crcSize = header.flags & FRAME_FLAG_CRC ? FRAME_CRC_SIZE : 0;
+    let data = new Uint8Array(0);
+    if (header.dataSize + crcSize > 0) {
+      const { data: body } = await this.inner.read(header.dataSize + crcSize, oldest.readTimeoutMs);
+      data = body.subarray(0, header.dataSize);
+      if (crcSize) {
+        const view = new DataView(body.buffer, body.byteOffset, body.byteLength);
+        if (view.getUint32(header.dataSize, true) !== stm32CRC32(data)) {
+          throw new Error(`Frame ${header.seq} response CRC mismatch`);
+        }
+      }
+    }
+
+    if (!frame) {
+      throw new Error(`Unexpected frame response (Seq: ${header.seq})`);
+    }
+
+    this.releaseSlot(frame);
+    if (header.status === FrameStatus.OK) {
+      frame.resolve(toLegacyResponse(data));
+    } else {
+      const statusName = header.status in FrameStatus ? FrameStatus[header.status] : `0x${header.status.toString(16)}`;
+      frame.reject(new Error(`Frame ${header.seq} rejected by device: ${statusName}`));
+    }
+  }
+}
@@ -0,0 +1,131 @@
+import { stm32CRC32 } from '@/utils/crc-utils';
+
+import {
+  FRAME_CODE,
+  FRAME_CRC_SIZE,
+  FRAME_FLAG_CRC,
+  FRAME_HEADER_SIZE,
+  FRAME_RESPONSE_HEADER_SIZE,
+  PROTOCOL_ACK,
+} from './constants';
+
+/**
+ * v2 帧响应状态
+ */
+export enum FrameStatus {
+  OK = 0x00,
+  CRC_ERROR = 0x01,
+  UNKNOWN_COMMAND = 0x02,
+  BAD_LENGTH = 0x03,
+}
+
+export interface FrameResponseHeader {
+  seq: number;
+  status: number;
+  flags: number;
+  dataSize: number;
+}
+
+/**
+ * 将一个完整的 v1 命令包装为 v2 帧
+ * 格式：[帧大小:2] 0xc0 [序号:1] [标志:1] [v1命令] [crc32:4 可选]
+ * @param command - createCommandPayload().build() 生成的 v1 命令
+ * @param seq - 序号 0-255
+ * @param withCrc - 是否附带 CRC32（覆盖 v1 命令）
+ */
+export function encodeFrame(command: Uint8Array, seq: number, withCrc = false): Uint8Array {
+  const crcSize = withCrc ? FRAME_CRC_SIZE : 0;
+  const frameSize = FRAME_HEADER_SIZE + command.byteLength + crcSize;
+  const frame = new Uint8Array(frameSize);
+  const view = new DataView(frame.buffer);
+
+  view.setUint16(0, frameSize, true);
+  frame[2] = FRAME_CODE;
+  frame[3] = seq & 0xff;
+  frame[4] = withCrc ? FRAME_FLAG_CRC : 0;
+  frame.set(command, FRAME_HEADER_SIZE);
+  if (withCrc) {
+    view.setUint32(FRAME_HEADER_SIZE + command.byteLength, stm32CRC32(command), true);
+  }
+
+  return frame;
+}
+
+/**
+ * 解析请求帧，返回帧内的 v1 命令；长度或 CRC 不符时返回对应状态
+ */
+export function decodeFrame(frame: Uint8Array): { seq: number; flags: number; status: FrameStatus; command: Uint8Array } {
+  const view = new DataView(frame.buffer, frame.byteOffset, frame.byteLength);
+  const seq = frame[3] ?? 0;
+  const flags = (frame[4] ?? 0) & FRAME_FLAG_CRC;
+  const crcSize = flags & FRAME_FLAG_CRC ? FRAME_CRC_SIZE : 0;
+  const empty = new Uint8Array(0);
+
+  if (frame.byteLength < FRAME_HEADER_SIZE + 5 + crcSize) {
+    return { seq, flags, status: FrameStatus.BAD_LENGTH, command: empty };
+  }
+
+  const frameSize = view.getUint16(0, true);
+  const commandSize = view.getUint16(FRAME_HEADER_SIZE, true);
+  if (frameSize !== frame.byteLength || commandSize !== frameSize - FRAME_HEADER_SIZE - crcSize) {
+    return { seq, flags, status: FrameStatus.BAD_LENGTH, command: empty };
+  }
+
+  const command = frame.subarray(FRAME_HEADER_SIZE, FRAME_HEADER_SIZE + commandSize);
+  if (crcSize && view.getUint32(FRAME_HEADER_SIZE + commandSize, true) !== stm32CRC32(command)) {
+    return { seq, flags, status: FrameStatus.CRC_ERROR, command: empty };
+  }
+
+  return { seq, flags, status: FrameStatus.OK, command };
+}
+
+/**
+ * 构建响应帧
+ * 格式：0xc0 [序号:1] [状态:1] [标志:1] [数据长度:2] [数据] [crc32:4 可选，仅覆盖数据]
+ */
+export function encodeFrameResponse(seq: number, status: FrameStatus, data: Uint8Array, flags = 0): Uint8Array {
+  const crcSize = flags & FRAME_FLAG_CRC ? FRAME_CRC_SIZE : 0;
+  const response = new Uint8Array(FRAME_RESPONSE_HEADER_SIZE + data.byteLength + crcSize);
+  const view = new DataView(response.buffer);
+
+  response[0] = FRAME_CODE;
+  response[1] = seq & 0xff;
+  response[2] = status;
+  response[3] = flags & FRAME_FLAG_CRC;
+  view.setUint16(4, data.byteLength, true);
+  response.set(data, FRAME_RESPONSE_HEADER_SIZE);
+  if (crcSize) {
+    view.setUint32(FRAME_RESPONSE_HEADER_SIZE + data.byteLength, stm32CRC32(data), true);
+  }
+
+  return response;
+}
+
+/**
+ * 解析响应帧头，首字节不是 0xc0 时返回 null（数据流已错位）
+ */
+export function parseFrameResponseHeader(header: Uint8Array): FrameResponseHeader | null {
+  if (header.byteLength < FRAME_RESPONSE_HEADER_SIZE || header[0] !== FRAME_CODE) {
+    return null;
+  }
+
+  return {
+    seq: header[1],
+    status: header[2],
+    flags: header[3],
+    dataSize: header[4] | (header[5] << 8),
+  };
+}
+
+/**
+ * 将响应帧数据还原为 v1 响应：无数据视为 ACK，有数据时补回 2B CRC 占位
+ */
+export function toLegacyResponse(data: Uint8Array): Uint8Array {
+  if (data.byteLength === 0) {
+    return Uint8Array.of(PROTOCOL_ACK);
+  }
+
+  const response = new Uint8Array(data.byteLength + 2);
+  response.set(data, 2);
+  return response;
+}
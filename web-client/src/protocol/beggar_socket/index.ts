@@ -1,12 +1,26 @@
 export type { Command } from './command';
-export { GBACommand, GBCCommand } from './command';
-export { FLASH_CMD_RESET } from './constants';
-export type { FlashCommandSet } from './flash-command-set';
+export { DiagnosticCommand, GBACommand, GBCCommand } from './command';
+export type {
+  ChromeTrace,
+  ChromeTraceEvent,
+  CommandPhase,
+  CommandTimingStage,
+  LatencySummary,
+  OpcodeLatencyStats,
+} from './command-profiler';
+export { CommandProfiler, commandProfiler, LatencyHistogram, opcodeName } from './command-profiler';
+export { DEVICE_INFO_SIZE, FLASH_CMD_RESET, FRAME_CODE } from './constants';
+export type { FlashCommandSet, FlashPollOptions, FlashWaitSchedule } from './flash-command-set';
 export { flashEraseCommand, flashEraseSector, flashGetId, flashPollUntilReady, flashUnlockSequence } from './flash-command-set';
+export type { FramedTransportOptions } from './framed-transport';
+export { FramedTransport } from './framed-transport';
+export type { FrameResponseHeader } from './framing';
+export { decodeFrame, encodeFrame, encodeFrameResponse, FrameStatus, parseFrameResponseHeader } from './framing';
 export { createCommandPayload } from './payload-builder';
-export type { CartPowerMode } from './protocol';
+export type { CartPowerMode, NativeJobOptions } from './protocol';
 export {
   cart_power,
+  device_get_info,
   GBA_RAM_FLASH_CMD_SET,
   GBA_ROM_FLASH_CMD_SET,
   GBC_FLASH_CMD_SET,
@@ -28,8 +42,17 @@ export {
   rom_erase_sector,
   rom_get_id,
   rom_program,
+  rom_program_native,
+  rom_program_rle,
   rom_read,
+  rom_read_into,
+  rom_read_native,
+  rom_read_rle,
   rom_write,
+  supportsNativeJobs,
+  usb_loopback,
+  usb_sink,
+  usb_source,
 } from './protocol';
 export type { FlashType, ProtocolTransportInput } from './protocol-utils';
 export {
@@ -1,5 +1,7 @@
+import { AdvancedSettings } from '@/settings/advanced-settings';
 import { formatHex } from '@/utils/formatter-utils';
 
+import { commandProfiler } from './command-profiler';
 import { getPackage, type ProtocolTransportInput, sendAndReceivePackage } from './protocol-utils';
 
 export type ProtocolPacketReadErrorCode = 'PACKET_TIMEOUT' | 'LENGTH_MISMATCH' | 'TRANSPORT_FAILURE';
@@ -68,32 +70,36 @@ async function executeProtocolPayloadRead(
     const response = await readPacket();
     return readPayloadData(response, expectedLength);
   } catch (error) {
-    const reason = getFailureReason(error);
-    const detail = getFailureDetail(error);
-    const prefix = `${commandName} failed (Address: ${formatHex(baseAddress, 4)})`;
-    if (reason === 'timeout') {
-      throw new ProtocolPacketReadError(
-        'PACKET_TIMEOUT',
-        `${prefix}, Reason: packet read timeout`,
-        detail,
-        { cause: error },
-      );
-    }
-    if (reason === 'length') {
-      throw new ProtocolPacketReadError(
-        'LENGTH_MISMATCH',
-        `${prefix}, Reason: invalid packet length`,
-        detail,
-        { cause: error },
-      );
-    }
-    throw new ProtocolPacketReadError(
-      'TRANSPORT_FAILURE',
-      `${prefix}, Reason: packet read transport error`,
+    throw toPacketReadError(error, commandName, baseAddress);
+  }
+}
+
+function toPacketReadError(error: unknown, commandName: string, baseAddress: number): ProtocolPacketReadError {
+  const reason = getFailureReason(error);
+  const detail = getFailureDetail(error);
+  const prefix = `${commandName} failed (Address: ${formatHex(baseAddress, 4)})`;
+  if (reason === 'timeout') {
+    return new ProtocolPacketReadError(
+      'PACKET_TIMEOUT',
+      `${prefix}, Reason: packet read timeout`,
       detail,
       { cause: error },
     );
   }
+  if (reason === 'length') {
+    return new ProtocolPacketReadError(
+      'LENGTH_MISMATCH',
+      `${prefix}, Reason: invalid packet length`,
+      detail,
+      { cause: error },
+    );
+  }
+  return new ProtocolPacketReadError(
+    'TRANSPORT_FAILURE',
+    `${prefix}, Reason: packet read transport error`,
+    detail,
+    { cause: error },
+  );
 }
 
 export async function readProtocolPayload(
@@ -127,3 +133,39 @@ export async function sendAndReadProtocolPayload(
     baseAddress,
   );
 }
+
+/**
+ * 发送读取命令，响应数据直接写入 target（2B CRC 占位被丢弃）
+ * 传输层不支持 sendAndReceiveInto 时退回 sendAndReceive 并拷贝一次
+ */
+export async function sendAndReadProtocolPayloadInto(
+  input: ProtocolTransportInput,
+  payload: Uint8Array,
+  commandName: string,
+  target: Uint8Array,
+  baseAddress: number,
+  sendTimeoutMs?: number,
+  readTimeoutMs?: number,
+): Promise<void> {
+  if (!input.sendAndReceiveInto) {
+    const data = await sendAndReadProtocolPayload(input, payload, commandName, target.byteLength, baseAddress, sendTimeoutMs, readTimeoutMs);
+    target.set(data);
+    return;
+  }
+
+  const timer = commandProfiler.begin(input, payload);
+  try {
+    await input.sendAndReceiveInto(
+      payload,
+      target,
+      0,
+      target.byteLength,
+      2,
+      sendTimeoutMs ?? AdvancedSettings.packageSendTimeout,
+      readTimeoutMs ?? AdvancedSettings.packageReceiveTimeout,
+    );
+  } catch (error) {
+    throw toPacketReadError(error, commandName, baseAddress);
+  }
+  commandProfiler.complete(timer, target.byteLength + 2);
+}
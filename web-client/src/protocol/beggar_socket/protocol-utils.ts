@@ -1,6 +1,7 @@
 import type { Transport, TransportReadMode } from '@/platform/serial';
 import { AdvancedSettings } from '@/settings/advanced-settings';
 
+import { commandProfiler, type CommandTimer } from './command-profiler';
 import { PROTOCOL_ACK } from './constants';
 
 export type ProtocolTransportInput = Transport;
@@ -23,9 +24,18 @@ export function fromLittleEndian(bytes: Uint8Array): number {
   return value;
 }
 
+/** sendPackage 发出、尚待 getPackage 读取响应的命令 */
+const awaitingResponse = new WeakMap<ProtocolTransportInput, CommandTimer>();
+
 // 使用适配器的统一接口
 export async function sendPackage(input: ProtocolTransportInput, payload: Uint8Array, timeoutMs?: number): Promise<boolean> {
-  return input.send(payload, timeoutMs ?? AdvancedSettings.packageSendTimeout);
+  const timer = commandProfiler.begin(input, payload);
+  const sent = await input.send(payload, timeoutMs ?? AdvancedSettings.packageSendTimeout);
+  if (timer) {
+    timer.sentAt = performance.now();
+    awaitingResponse.set(input, timer);
+  }
+  return sent;
 }
 
 export async function getPackage(
@@ -34,7 +44,13 @@ export async function getPackage(
   timeoutMs?: number,
   mode: TransportReadMode = 'byob',
 ): Promise<{ data: Uint8Array }> {
-  return input.read(length, timeoutMs ?? AdvancedSettings.packageReceiveTimeout, mode);
+  const timer = awaitingResponse.get(input);
+  awaitingResponse.delete(input);
+  const result = await input.read(length, timeoutMs ?? AdvancedSettings.packageReceiveTimeout, mode);
+  if (timer) {
+    commandProfiler.complete(timer, result.data.byteLength);
+  }
+  return result;
 }
 
 export async function getResult(input: ProtocolTransportInput, timeoutMs?: number): Promise<boolean> {
@@ -49,12 +65,15 @@ export async function sendAndReceivePackage(
   sendTimeoutMs?: number,
   readTimeoutMs?: number,
 ): Promise<{ data: Uint8Array }> {
-  return input.sendAndReceive(
+  const timer = commandProfiler.begin(input, payload);
+  const result = await input.sendAndReceive(
     payload,
     readLength,
     sendTimeoutMs ?? AdvancedSettings.packageSendTimeout,
     readTimeoutMs ?? AdvancedSettings.packageReceiveTimeout,
   );
+  commandProfiler.complete(timer, result.data.byteLength);
+  return result;
 }
 
 export async function sendAndExpectAck(
@@ -1,8 +1,12 @@
+import type { TransportJob, TransportJobProgress } from '@/platform/serial';
 import { AdvancedSettings } from '@/settings/advanced-settings';
+import { packBitsDecode } from '@/utils/compression-utils';
 import { formatHex } from '@/utils/formatter-utils';
 
-import { GBACommand, GBCCommand } from './command';
+import { DiagnosticCommand, GBACommand, GBCCommand } from './command';
+import { commandProfiler, opcodeName } from './command-profiler';
 import {
+  DEVICE_INFO_SIZE,
   FLASH_CMD_CHIP_ERASE,
   GBA_FLASH_ADDR_1,
   GBA_FLASH_ADDR_2,
@@ -17,10 +21,17 @@ import {
   flashEraseSector,
   flashGetId,
   flashPollUntilReady,
+  type FlashWaitSchedule,
 } from './flash-command-set';
-import { sendAndReadProtocolPayload } from './packet-read';
+import { sendAndReadProtocolPayload, sendAndReadProtocolPayloadInto } from './packet-read';
 import { createCommandPayload } from './payload-builder';
-import { type ProtocolTransportInput, sendAndExpectAck, sendPackage, toLittleEndian } from './protocol-utils';
+import {
+  type ProtocolTransportInput,
+  sendAndExpectAck,
+  sendAndReceivePackage,
+  sendPackage,
+  toLittleEndian,
+} from './protocol-utils';
 
 const GBA_SECTOR_ERASE_POLL_INTERVAL_MS = 20;
 const GBA_SECTOR_ERASE_TIMEOUT_MS = 60_000;
@@ -118,8 +129,13 @@ export async function rom_erase_chip(input: ProtocolTransportInput): Promise<voi
 
 /**
  * GBA: ROM Sector Erase (0xf3)
+ * @param schedule - 芯片 CFI 标称的扇区擦除耗时，提供时按其安排轮询
  */
-export async function rom_erase_sector(input: ProtocolTransportInput, sectorAddress: number): Promise<boolean> {
+export async function rom_erase_sector(
+  input: ProtocolTransportInput,
+  sectorAddress: number,
+  schedule?: FlashWaitSchedule,
+): Promise<boolean> {
   const alignedSectorAddress = sectorAddress & ~1;
   const sectorWordAddress = alignedSectorAddress >>> 1;
   const errorPrefix = `GBA ROM sector erase failed (Address: ${formatHex(sectorAddress, 4)})`;
@@ -128,6 +144,7 @@ export async function rom_erase_sector(input: ProtocolTransportInput, sectorAddr
       pollBytes: 2,
       pollIntervalMs: GBA_SECTOR_ERASE_POLL_INTERVAL_MS,
       timeoutMs: GBA_SECTOR_ERASE_TIMEOUT_MS,
+      schedule,
     });
   } catch (error) {
     throw new Error(`${errorPrefix}, Reason: ${error instanceof Error ? error.message : String(error)}`);
@@ -173,6 +190,66 @@ export async function rom_read(input: ProtocolTransportInput, size: number, base
   return sendAndReadProtocolPayload(input, payload, 'GBA ROM read', size, baseAddress);
 }
 
+/**
+ * ROM 读取，数据直接写入 target（通常是整个转储缓冲的一段视图）
+ * @param command - GBA READ (0xf6) 或 GBC READ (0xfb)
+ */
+export async function rom_read_into(
+  input: ProtocolTransportInput,
+  command: GBACommand | GBCCommand,
+  target: Uint8Array,
+  baseAddress = 0,
+): Promise<void> {
+  const payload = createCommandPayload(command)
+    .addAddress(baseAddress)
+    .addLength(target.byteLength)
+    .build();
+  const commandName = command === GBACommand.READ ? 'GBA ROM read' : 'GBC read';
+  await sendAndReadProtocolPayloadInto(input, payload, commandName, target, baseAddress);
+}
+
+/**
+ * GBA: ROM Program RLE (0xe4)
+ * 数据以 PackBits 编码发送，设备解码后按 0xf4 流程编程
+ * @param encoded - packBitsEncode() 的输出
+ * @param rawSize - 解码后的字节数
+ */
+export async function rom_program_rle(
+  input: ProtocolTransportInput,
+  encoded: Uint8Array,
+  rawSize: number,
+  baseAddress: number,
+  bufferSize: number,
+): Promise<void> {
+  const payload = createCommandPayload(GBACommand.PROGRAM_RLE, encoded.byteLength + 16)
+    .addAddress(baseAddress)
+    .addLength(bufferSize)
+    .addLength(rawSize)
+    .addBytes(encoded)
+    .build();
+  const timeoutMs = writeCommandTimeoutMs(rawSize);
+  const ack = await sendAndExpectAck(input, payload, timeoutMs, timeoutMs);
+  if (!ack) throw new Error(`GBA ROM RLE programming failed (Address: ${formatHex(baseAddress, 4)})`);
+}
+
+/**
+ * GBA: ROM Read RLE (0xe6)
+ * 设备返回 PackBits 编码数据，响应长度不定，需经 v2 帧传输（FramedTransport）
+ */
+export async function rom_read_rle(input: ProtocolTransportInput, size: number, baseAddress = 0): Promise<Uint8Array> {
+  const payload = createCommandPayload(GBACommand.READ_RLE)
+    .addAddress(baseAddress)
+    .addLength(size)
+    .build();
+  const { data } = await sendAndReceivePackage(input, payload, size + 2);
+  try {
+    return packBitsDecode(data.subarray(2), size);
+  } catch (error) {
+    const reason = error instanceof Error ? error.message : String(error);
+    throw new Error(`GBA ROM RLE read failed (Address: ${formatHex(baseAddress, 4)}), Reason: ${reason}`);
+  }
+}
+
 /**
  * GBA: RAM Write (0xf7)
  */
@@ -333,27 +410,161 @@ export async function gbc_rom_get_id(input: ProtocolTransportInput): Promise<Uin
 }
 
 /**
+ * GBC: Erase whole ROM chip
+ * @param schedule - 芯片 CFI 标称的整片擦除耗时，提供时按其安排轮询
  */
-export async function gbc_rom_erase_chip(input: ProtocolTransportInput) {
+export async function gbc_rom_erase_chip(input: ProtocolTransportInput, schedule?: FlashWaitSchedule) {
   await flashEraseCommand(input, GBC_FLASH_CMD_SET, GBC_FLASH_ADDR_1, FLASH_CMD_CHIP_ERASE);
   await flashPollUntilReady(input, GBC_FLASH_CMD_SET, 0x00, {
     pollBytes: 1,
     pollIntervalMs: GBC_CHIP_ERASE_POLL_INTERVAL_MS,
     timeoutMs: GBC_CHIP_ERASE_TIMEOUT_MS,
+    schedule,
   });
 }
 
 /**
  * GBC: Erase single ROM sector
+ * @param schedule - 芯片 CFI 标称的扇区擦除耗时，提供时按其安排轮询
  */
-export async function gbc_rom_erase_sector(input: ProtocolTransportInput, sectorAddress: number) {
+export async function gbc_rom_erase_sector(input: ProtocolTransportInput, sectorAddress: number, schedule?: FlashWaitSchedule) {
   try {
     return await flashEraseSector(input, GBC_FLASH_CMD_SET, sectorAddress, sectorAddress, {
       pollBytes: 1,
       pollIntervalMs: GBC_SECTOR_ERASE_POLL_INTERVAL_MS,
       timeoutMs: GBC_SECTOR_ERASE_TIMEOUT_MS,
+      schedule,
     });
   } catch (error) {
     throw new Error(`GBC ROM single sector erase failed (Address: ${formatHex(sectorAddress, 4)})`);
   }
 }
+
+/**
+ * DIAG: USB Sink (0xd0)
+ * 设备收完整包后直接丢弃并回 ACK，用于测量 host -> device 吞吐
+ */
+export async function usb_sink(input: ProtocolTransportInput, data: Uint8Array): Promise<void> {
+  const payload = createCommandPayload(DiagnosticCommand.USB_SINK, data.byteLength + 8)
+    .addBytes(data)
+    .build();
+
+  const ack = await sendAndExpectAck(input, payload);
+  if (!ack) throw new Error(`USB sink failed (Size: ${data.byteLength})`);
+}
+
+/**
+ * DIAG: USB Source (0xd1)
+ * 设备返回 `(seed + i) & 0xff` 序列，用于测量 device -> host 吞吐
+ */
+export async function usb_source(input: ProtocolTransportInput, size: number, seed = 0): Promise<Uint8Array> {
+  const payload = createCommandPayload(DiagnosticCommand.USB_SOURCE)
+    .addAddress(seed & 0xff)
+    .addLength(size)
+    .build();
+
+  return sendAndReadProtocolPayload(input, payload, 'USB source', size, 0);
+}
+
+/**
+ * DIAG: USB Loopback (0xd2)
+ * 设备原样回传数据，用于测量往返延迟
+ */
+export async function usb_loopback(input: ProtocolTransportInput, data: Uint8Array): Promise<Uint8Array> {
+  const payload = createCommandPayload(DiagnosticCommand.USB_LOOPBACK, data.byteLength + 8)
+    .addBytes(data)
+    .build();
+
+  return sendAndReadProtocolPayload(input, payload, 'USB loopback', data.byteLength, 0);
+}
+
+/**
+ * DIAG: Device Info (0xd3)
+ * 返回协议版本、缓冲区上限、支持的命令位图等能力描述符；旧固件不响应
+ */
+export async function device_get_info(input: ProtocolTransportInput, timeoutMs?: number): Promise<Uint8Array> {
+  const payload = createCommandPayload(DiagnosticCommand.DEVICE_INFO).build();
+
+  return sendAndReadProtocolPayload(input, payload, 'Device info', DEVICE_INFO_SIZE, 0, timeoutMs, timeoutMs);
+}
+
+// --- Native Jobs ---
+
+export interface NativeJobOptions {
+  onProgress?: (progress: TransportJobProgress) => void;
+  signal?: AbortSignal;
+  /** 编程任务：设备上报的单包上限 */
+  maxCommandSize?: number;
+}
+
+/**
+ * 传输层能否整段执行读取/编程循环（Tauri 原生后端）
+ */
+export function supportsNativeJobs(input: ProtocolTransportInput): boolean {
+  return typeof input.runJob === 'function';
+}
+
+function runNativeJob(input: ProtocolTransportInput, job: TransportJob, options: NativeJobOptions) {
+  if (!input.runJob) {
+    throw new Error('Transport does not support native jobs');
+  }
+  const runJob = input.runJob.bind(input);
+  // 命令循环在后端执行，只能记录整段任务的区间
+  return commandProfiler.withPhase(
+    input,
+    job.kind === 'dump' ? 'read' : 'program',
+    () => runJob(job, options.onProgress, options.signal),
+    `native ${job.kind} ${opcodeName(job.opcode)}`,
+  );
+}
+
+/**
+ * 由原生后端按 chunkSize 连续发出读取命令（0xf6 / 0xfb），结束后一次性回传数据
+ * 调用方需保证 [baseAddress, baseAddress + size) 不跨越 bank 窗口
+ */
+export async function rom_read_native(
+  input: ProtocolTransportInput,
+  command: GBACommand | GBCCommand,
+  size: number,
+  baseAddress: number,
+  chunkSize: number,
+  options: NativeJobOptions = {},
+): Promise<Uint8Array> {
+  const { data } = await runNativeJob(input, {
+    kind: 'dump',
+    opcode: command,
+    address: baseAddress,
+    size,
+    chunkSize,
+    timeoutMs: AdvancedSettings.packageReceiveTimeout,
+  }, options);
+  return data;
+}
+
+/**
+ * 由原生后端按 chunkSize 连续发出编程命令（0xf4 / 0xfc），全 0xFF 的页直接跳过
+ * @returns 实际编程的字节数
+ */
+export async function rom_program_native(
+  input: ProtocolTransportInput,
+  command: GBACommand | GBCCommand,
+  data: Uint8Array,
+  baseAddress: number,
+  chunkSize: number,
+  bufferSize: number,
+  options: NativeJobOptions = {},
+): Promise<number> {
+  const { programmedBytes } = await runNativeJob(input, {
+    kind: 'program',
+    opcode: command,
+    address: baseAddress,
+    chunkSize,
+    bufferSize,
+    timeoutMs: AdvancedSettings.packageReceiveTimeout,
+    timeoutPerByteMs: WRITE_TIMEOUT_PER_BYTE_MS,
+    skipErased: true,
+    maxCommandSize: options.maxCommandSize,
+    data,
+  }, options);
+  return programmedBytes;
+}
@@ -0,0 +1,62 @@
+import { DateTime } from 'luxon';
+
+import {
+  CartridgeProtocolPortAdapter,
+  createCartridgeProtocolSession,
+  DeviceGatewayConnectionPortAdapter,
+} from '@/features/burner/adapters';
+import {
+  BurnerStation,
+  type BurnerStationDevicePort,
+  BurnerUseCaseImpl,
+} from '@/features/burner/application';
+import { type DeviceGateway, getDeviceGateway } from '@/platform/serial';
+import { formatHex } from '@/utils/formatter-utils';
+
+import type { TranslateFunction } from './cartridge-adapter';
+import { deviceConnectionManager } from './device-connection-manager';
+import { GBAAdapter } from './gba-adapter';
+import { MBC5Adapter } from './mbc5-adapter';
+
+/**
+ * 基于设备网关的工位设备端口：每台烧录器独立连接，日志与进度写入各自的会话
+ */
+export function createStationDevicePort(
+  translate: TranslateFunction,
+  gateway: DeviceGateway = getDeviceGateway(),
+): BurnerStationDevicePort {
+  return {
+    createConnectionPort: () => new DeviceGatewayConnectionPortAdapter(gateway),
+    openSession: async (handle, mode, sink) => {
+      const device = await deviceConnectionManager.openHandle(handle);
+      const Adapter = mode === 'gba' ? GBAAdapter : MBC5Adapter;
+      const adapter = new Adapter(
+        device,
+        (message, level) => {
+          sink.addLog(DateTime.now().toLocaleString(DateTime.TIME_24_WITH_SECONDS), message, level);
+        },
+        (info) => { sink.updateProgress(info); },
+        translate,
+      );
+      return createCartridgeProtocolSession(adapter, `${handle.id}:${mode}`);
+    },
+  };
+}
+
+/**
+ * 创建多设备工位
+ *
+ * 生产线上的卡带同型号、Flash ID 相同，断点日志与扇区摘要按 Flash ID 建键会在设备之间串用，
+ * 因此工位的用例不启用这两项
+ */
+export function createBurnerStation(
+  translate: TranslateFunction,
+  gateway: DeviceGateway = getDeviceGateway(),
+): BurnerStation {
+  const useCase = new BurnerUseCaseImpl(
+    new CartridgeProtocolPortAdapter(),
+    translate,
+    value => formatHex(value, 4),
+  );
+  return new BurnerStation(createStationDevicePort(translate, gateway), useCase);
+}
@@ -0,0 +1,327 @@
+import type { BurnerProtocolSession } from '@/features/burner/application';
+import type { Transport } from '@/platform/serial';
+import { deserializeError, describeTransportFeatures, serializeError, serveTransport } from '@/platform/serial/transport-bridge';
+import { describeSerialPort, findWebSerialTransport, reclaimSerialPort } from '@/platform/serial/web/port-lease';
+import { FramedTransport } from '@/protocol';
+import { AdvancedSettings } from '@/settings/advanced-settings';
+import type { CommandOptions } from '@/types/command-options';
+import type { CommandResult } from '@/types/command-result';
+import type { DeviceInfo } from '@/types/device-info';
+import type { CFIInfo, SectorBlock } from '@/utils/parsers/cfi-parser';
+
+import type { LogCallback, ProgressCallback } from '../cartridge-adapter';
+import {
+  type BurnerWorkerEndpoint,
+  type BurnerWorkerMethod,
+  type BurnerWorkerMode,
+  type BurnerWorkerRequest,
+  type BurnerWorkerResponse,
+  toCloneable,
+  type WorkerCallbackTarget,
+} from './messages';
+import { snapshotLocalStorage } from './worker-storage';
+
+export type BurnerWorkerHandle = BurnerWorkerEndpoint & {
+  onerror?: ((event: ErrorEvent) => void) | null;
+  terminate?: () => void;
+};
+
+export interface BurnerWorkerClientOptions {
+  log: LogCallback;
+  progress: ProgressCallback;
+  locale: string;
+  /** 测试时可替换为 MessagePort，默认创建模块 Worker */
+  createWorker?: () => BurnerWorkerHandle;
+}
+
+interface PendingCall {
+  resolve: (value: unknown) => void;
+  reject: (error: Error) => void;
+  callbacks: Partial<Record<WorkerCallbackTarget, object>>;
+}
+
+/** 在 Worker 内执行时需要长时间占用串口的操作，支持时把串口租给 Worker 直接读写 */
+const LEASED_METHODS = new Set<BurnerWorkerMethod>(['eraseSectors', 'writeROM', 'readROM', 'verifyROM']);
+
+export function supportsBurnerWorker(): boolean {
+  return typeof Worker !== 'undefined' && typeof MessageChannel !== 'undefined';
+}
+
+function createBurnerWorker(): BurnerWorkerHandle {
+  return new Worker(new URL('./burner.worker.ts', import.meta.url), { type: 'module', name: 'burner' });
+}
+
+interface BurnerWorkerCaller {
+  call<T>(mode: BurnerWorkerMode, method: BurnerWorkerMethod, args: unknown[], signal?: AbortSignal): Promise<T>;
+}
+
+/**
+ * 把会话调用转发给 Worker 内对应模式的适配器
+ */
+class WorkerProtocolSession implements BurnerProtocolSession {
+  readonly id: string;
+
+  constructor(
+    private readonly client: BurnerWorkerCaller,
+    private readonly mode: BurnerWorkerMode,
+    idSuffix: string,
+    readonly isActive?: () => boolean,
+  ) {
+    this.id = `worker:${idSuffix}`;
+  }
+
+  getCartInfo(enable5V?: boolean, refresh?: boolean): Promise<CFIInfo | false> {
+    return this.client.call(this.mode, 'getCartInfo', [enable5V, refresh]);
+  }
+
+  eraseSectors(sectorInfo: SectorBlock[], options: CommandOptions, signal?: AbortSignal): Promise<CommandResult> {
+    return this.client.call(this.mode, 'eraseSectors', [sectorInfo, options], signal);
+  }
+
+  writeROM(data: Uint8Array, options: CommandOptions, signal?: AbortSignal): Promise<CommandResult> {
+    return this.client.call(this.mode, 'writeROM', [data, options], signal);
+  }
+
+  readROM(size: number, options: CommandOptions, signal?: AbortSignal, showProgress?: boolean): Promise<CommandResult> {
+    return this.client.call(this.mode, 'readROM', [size, options, null, showProgress], signal);
+  }
+
+  verifyROM(data: Uint8Array, options: CommandOptions, signal: AbortSignal): Promise<CommandResult> {
+    return this.client.call(this.mode, 'verifyROM', [data, options], signal);
+  }
+
+  writeRAM(data: Uint8Array, options?: CommandOptions): Promise<CommandResult> {
+    return this.client.call(this.mode, 'writeRAM', [data, options]);
+  }
+
+  readRAM(size: number, options?: CommandOptions): Promise<CommandResult> {
+    return this.client.call(this.mode, 'readRAM', [size, options]);
+  }
+
+  verifyRAM(data: Uint8Array, options?: CommandOptions): Promise<CommandResult> {
+    return this.client.call(this.mode, 'verifyRAM', [data, options]);
+  }
+
+  resetCommandBuffer(): Promise<void> {
+    return this.client.call(this.mode, 'resetCommandBuffer', []);
+  }
+}
+
+/**
+ * 主线程侧的烧录 Worker 客户端
+ *
+ * 每台设备一个 Worker，GBA 与 MBC5 会话共用；主线程只负责串口 I/O（未租借时）、
+ * 转储目标与断点回调，以及把合并后的进度快照交给界面。
+ */
+export class BurnerWorkerClient implements BurnerWorkerCaller {
+  private readonly worker: BurnerWorkerHandle;
+  private readonly stopServing: () => void;
+  private readonly ready: Promise<boolean>;
+  private readonly calls = new Map<number, PendingCall>();
+  private nextCallId = 1;
+  private disposed = false;
+
+  constructor(private readonly device: DeviceInfo, private readonly options: BurnerWorkerClientOptions) {
+    const transport = device.transport ?? device.serialHandle?.transport;
+    if (!transport) {
+      throw new Error('Device transport is not available');
+    }
+    // Worker 按能力描述自行建立帧传输层，桥接的是其下的原始传输
+    const raw: Transport = transport instanceof FramedTransport ? transport.inner : transport;
+
+    this.worker = (options.createWorker ?? createBurnerWorker)();
+    let markReady: (webSerial: boolean) => void = () => undefined;
+    this.ready = new Promise((resolve) => { markReady = resolve; });
+    this.worker.onmessage = (event: MessageEvent<BurnerWorkerResponse>) => {
+      const response = event.data;
+      if (response.type === 'ready') {
+        markReady(response.webSerial);
+        return;
+      }
+      this.dispatch(response);
+    };
+    // 模块加载失败等情况下 Worker 不会回复 ready，直接让等待中的调用失败
+    this.worker.onerror = (event: ErrorEvent) => {
+      this.dispose(new Error(`Burner worker failed: ${event.message}`));
+      markReady(false);
+    };
+
+    const channel = new MessageChannel();
+    this.stopServing = serveTransport(channel.port1, raw);
+    this.post({
+      type: 'init',
+      device: {
+        connectionId: device.connectionId,
+        platform: device.serialHandle?.platform ?? 'web',
+        portInfo: toCloneable(device.portInfo ?? device.serialHandle?.portInfo),
+        firmwareProfile: toCloneable(device.firmwareProfile),
+        capabilities: toCloneable(device.capabilities),
+      },
+      locale: options.locale,
+      storage: snapshotLocalStorage(),
+      bridge: channel.port2,
+      bridgeFeatures: describeTransportFeatures(raw),
+    }, [channel.port2]);
+  }
+
+  createSession(mode: BurnerWorkerMode, idSuffix: string, isActive?: () => boolean): BurnerProtocolSession {
+    return new WorkerProtocolSession(this, mode, idSuffix, isActive);
+  }
+
+  async call<T>(mode: BurnerWorkerMode, method: BurnerWorkerMethod, args: unknown[], signal?: AbortSignal): Promise<T> {
+    const webSerial = await this.ready;
+    if (webSerial && LEASED_METHODS.has(method)) {
+      return await this.withPortLease(() => this.request<T>(mode, method, args, signal));
+    }
+    return await this.request<T>(mode, method, args, signal);
+  }
+
+  dispose(error = new Error('Burner worker terminated')): void {
+    if (this.disposed) {
+      return;
+    }
+    this.disposed = true;
+    this.stopServing();
+    this.worker.onmessage = null;
+    this.worker.terminate?.();
+    for (const call of this.calls.values()) {
+      call.reject(error);
+    }
+    this.calls.clear();
+  }
+
+  private request<T>(mode: BurnerWorkerMode | undefined, method: BurnerWorkerMethod, args: unknown[], signal?: AbortSignal): Promise<T> {
+    if (this.disposed) {
+      return Promise.reject(new Error('Burner worker terminated'));
+    }
+
+    const callId = this.nextCallId++;
+    const callbacks: PendingCall['callbacks'] = {};
+    const outgoing = args.map((arg, index) => {
+      if (index !== 1 || typeof arg !== 'object' || arg === null) {
+        return toCloneable(arg);
+      }
+      // 转储目标与断点记录留在主线程，Worker 通过回调消息调用
+      const { dumpSink, checkpoint, ...rest } = arg as CommandOptions;
+      if (dumpSink) {
+        callbacks.dumpSink = dumpSink;
+      }
+      if (checkpoint) {
+        callbacks.checkpoint = checkpoint;
+      }
+      return toCloneable(rest);
+    });
+
+    const abort = () => {
+      this.post({ type: 'abort', callId });
+    };
+    signal?.addEventListener('abort', abort, { once: true });
+
+    return new Promise<T>((resolve, reject) => {
+      this.calls.set(callId, { resolve: resolve as (value: unknown) => void, reject, callbacks });
+      this.post({
+        type: 'call',
+        callId,
+        mode,
+        method,
+        args: outgoing,
+        settings: AdvancedSettings.getSettings(),
+        callbacks: Object.keys(callbacks) as WorkerCallbackTarget[],
+      });
+    }).finally(() => {
+      signal?.removeEventListener('abort', abort);
+    });
+  }
+
+  /**
+   * 浏览器允许 Worker 使用 Web Serial 时，操作期间关闭主线程的串口，由 Worker 打开同一串口直接读写；
+   * 结束后主线程按原配置重新打开。任何一步失败都退回经传输桥执行
+   */
+  private async withPortLease<T>(run: () => Promise<T>): Promise<T> {
+    const port = this.device.port;
+    const webSerialTransport = findWebSerialTransport(this.device.transport);
+    if (this.device.serialHandle?.platform !== 'web' || !port || !webSerialTransport) {
+      return await run();
+    }
+    const lease = await describeSerialPort(port);
+    if (!lease) {
+      return await run();
+    }
+
+    const signalTarget = this.device.transport ?? webSerialTransport;
+    await webSerialTransport.suspend();
+    let leased = false;
+    try {
+      leased = await this.request<boolean>(undefined, 'leasePort', [lease]);
+    } catch {
+      leased = false;
+    }
+    if (!leased) {
+      await reclaimSerialPort(webSerialTransport, signalTarget);
+      return await run();
+    }
+
+    try {
+      return await run();
+    } finally {
+      try {
+        await this.request(undefined, 'releasePort', []);
+      } finally {
+        await reclaimSerialPort(webSerialTransport, signalTarget);
+      }
+    }
+  }
+
+  private dispatch(response: Exclude<BurnerWorkerResponse, { type: 'ready' }>): void {
+    switch (response.type) {
+      case 'log':
+        this.options.log(response.message, response.level);
+        return;
+      case 'progress':
+        this.options.progress(response.progress);
+        return;
+      case 'storage':
+        try {
+          if (response.value === null) {
+            localStorage.removeItem(response.key);
+          } else {
+            localStorage.setItem(response.key, response.value);
+          }
+        } catch {
+          // localStorage might be unavailable (e.g. private mode). Ignore silently.
+        }
+        return;
+      case 'callback':
+        void this.runCallback(response);
+        return;
+      case 'result': {
+        const call = this.calls.get(response.callId);
+        this.calls.delete(response.callId);
+        if (response.error) {
+          call?.reject(deserializeError(response.error));
+        } else {
+          call?.resolve(response.value);
+        }
+        return;
+      }
+    }
+  }
+
+  private async runCallback(response: Extract<BurnerWorkerResponse, { type: 'callback' }>): Promise<void> {
+    try {
+      const target = this.calls.get(response.callId)?.callbacks[response.target] as Record<string, unknown> | undefined;
+      const method = target?.[response.method];
+      if (typeof method !== 'function') {
+        throw new Error(`Unknown worker callback ${response.target}.${response.method}`);
+      }
+      await (method as (...args: unknown[]) => Promise<void>).apply(target, response.args);
+      this.post({ type: 'callbackResult', callbackId: response.callbackId });
+    } catch (error) {
+      this.post({ type: 'callbackResult', callbackId: response.callbackId, error: serializeError(error) });
+    }
+  }
+
+  private post(request: BurnerWorkerRequest, transfer: Transferable[] = []): void {
+    this.worker.postMessage(request, transfer);
+  }
+}
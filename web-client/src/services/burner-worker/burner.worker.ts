@@ -0,0 +1,4 @@
+import type { BurnerWorkerEndpoint } from './messages';
+import { runBurnerWorker } from './worker-runtime';
+
+runBurnerWorker(self as unknown as BurnerWorkerEndpoint);
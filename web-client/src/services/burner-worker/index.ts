@@ -0,0 +1,2 @@
+export { BurnerWorkerClient, type BurnerWorkerClientOptions, supportsBurnerWorker } from './burner-worker-client';
+export type { BurnerWorkerMode } from './messages';
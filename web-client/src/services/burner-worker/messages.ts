@@ -0,0 +1,114 @@
+import type { SerializedError, TransportBridgeFeatures } from '@/platform/serial/transport-bridge';
+import type { AdvancedSettingsConfig } from '@/settings/advanced-settings';
+import type { DeviceCapabilities } from '@/types/device-capabilities';
+import type { FirmwareProfile } from '@/types/firmware-profile';
+import type { ProgressInfo } from '@/types/progress-info';
+import type { SerialPortInfo } from '@/types/serial';
+import type { BurnerLogInput } from '@/utils/burner-log';
+
+export type BurnerWorkerMode = 'gba' | 'mbc5';
+
+export type BurnerWorkerMethod =
+  | 'getCartInfo'
+  | 'eraseSectors'
+  | 'writeROM'
+  | 'readROM'
+  | 'verifyROM'
+  | 'writeRAM'
+  | 'readRAM'
+  | 'verifyRAM'
+  | 'resetCommandBuffer'
+  | 'leasePort'
+  | 'releasePort';
+
+export type BurnerLogLevel = 'info' | 'success' | 'warn' | 'error';
+
+/** 适配器在 Worker 内需要的设备信息，串口与传输层对象不随之传递 */
+export interface WorkerDeviceSnapshot {
+  connectionId?: string;
+  platform: 'web' | 'tauri' | 'simulated';
+  portInfo?: SerialPortInfo;
+  firmwareProfile?: FirmwareProfile;
+  capabilities?: DeviceCapabilities | null;
+}
+
+/** CommandOptions 中无法跨线程传递的回调对象，由 Worker 回调主线程执行 */
+export type WorkerCallbackTarget = 'dumpSink' | 'checkpoint';
+
+export type BurnerWorkerRequest =
+  | {
+    type: 'init';
+    device: WorkerDeviceSnapshot;
+    locale: string;
+    storage: Record<string, string>;
+    bridge: MessagePort;
+    bridgeFeatures: TransportBridgeFeatures;
+  }
+  | {
+    type: 'call';
+    callId: number;
+    /** 串口租借等与卡带模式无关的调用不带 mode */
+    mode?: BurnerWorkerMode;
+    method: BurnerWorkerMethod;
+    args: unknown[];
+    settings: AdvancedSettingsConfig;
+    callbacks: WorkerCallbackTarget[];
+  }
+  | { type: 'abort'; callId: number }
+  | { type: 'callbackResult'; callbackId: number; error?: SerializedError };
+
+export type BurnerWorkerResponse =
+  | { type: 'ready'; webSerial: boolean }
+  | { type: 'log'; message: BurnerLogInput; level: BurnerLogLevel }
+  | { type: 'progress'; progress: ProgressInfo }
+  | { type: 'storage'; key: string; value: string | null }
+  | {
+    type: 'callback';
+    callId: number;
+    callbackId: number;
+    target: WorkerCallbackTarget;
+    method: string;
+    args: unknown[];
+  }
+  | { type: 'result'; callId: number; value?: unknown; error?: SerializedError };
+
+/** Worker 全局作用域、Worker 对象与 MessagePort 共有的收发接口 */
+export interface BurnerWorkerEndpoint {
+  postMessage(message: unknown, transfer: Transferable[]): void;
+  onmessage: ((event: MessageEvent) => void) | null;
+}
+
+/**
+ * 去掉 Vue 响应式代理等无法结构化克隆的包装：普通对象、数组、Set、Map 逐层复制，
+ * 类型化数组等其余值原样保留
+ */
+export function toCloneable<T>(value: T): T {
+  if (value === null || typeof value !== 'object' || ArrayBuffer.isView(value) || value instanceof ArrayBuffer) {
+    return value;
+  }
+  if (Array.isArray(value)) {
+    return value.map(item => toCloneable(item as unknown)) as T;
+  }
+  if (value instanceof Set) {
+    return new Set([...value].map(item => toCloneable(item as unknown))) as T;
+  }
+  if (value instanceof Map) {
+    return new Map([...value].map(([key, item]) => [key, toCloneable(item as unknown)])) as T;
+  }
+  const copy: Record<string, unknown> = {};
+  for (const [key, item] of Object.entries(value)) {
+    copy[key] = toCloneable(item);
+  }
+  return copy as T;
+}
+
+/**
+ * 结果数据占满独立缓冲时直接移交，否则复制一份再移交
+ */
+export function transferableData(data: Uint8Array): { data: Uint8Array; transfer: Transferable[] } {
+  if (data.byteOffset === 0 && data.byteLength === data.buffer.byteLength && data.buffer instanceof ArrayBuffer) {
+    return { data, transfer: [data.buffer] };
+  }
+  const copy = data.slice();
+  return { data: copy, transfer: [copy.buffer] };
+}
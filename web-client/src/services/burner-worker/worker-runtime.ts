@@ -0,0 +1,301 @@
+import i18n, { normalizeLocale } from '@/i18n';
+import type { Transport } from '@/platform/serial';
+import { BridgedTransport, deserializeError, serializeError } from '@/platform/serial/transport-bridge';
+import { openLeasedSerialPort, type SerialPortLease } from '@/platform/serial/web/port-lease';
+import { AdvancedSettings } from '@/settings/advanced-settings';
+import type { CommandOptions } from '@/types/command-options';
+import type { CommandResult } from '@/types/command-result';
+import type { DeviceInfo } from '@/types/device-info';
+import type { DumpSink } from '@/types/dump-sink';
+import type { ProgressInfo } from '@/types/progress-info';
+import type { TransferCheckpoint } from '@/types/transfer-checkpoint';
+import type { BurnerLogInput } from '@/utils/burner-log';
+import type { SectorBlock } from '@/utils/parsers/cfi-parser';
+
+import type { CartridgeAdapter } from '../cartridge-adapter';
+import { createFramedTransport } from '../device-capabilities';
+import { GBAAdapter } from '../gba-adapter';
+import { MBC5Adapter } from '../mbc5-adapter';
+import {
+  type BurnerLogLevel,
+  type BurnerWorkerEndpoint,
+  type BurnerWorkerMode,
+  type BurnerWorkerRequest,
+  type BurnerWorkerResponse,
+  transferableData,
+  type WorkerCallbackTarget,
+} from './messages';
+import { installWorkerStorage } from './worker-storage';
+
+/** 进度快照的最短发送间隔，期间的部分更新在 Worker 内合并 */
+const PROGRESS_INTERVAL_MS = 50;
+
+type InitRequest = Extract<BurnerWorkerRequest, { type: 'init' }>;
+type CallRequest = Extract<BurnerWorkerRequest, { type: 'call' }>;
+
+interface PendingCallback {
+  resolve: () => void;
+  reject: (error: Error) => void;
+}
+
+function isCommandResult(value: unknown): value is CommandResult {
+  return typeof value === 'object' && value !== null && 'success' in value && 'message' in value;
+}
+
+/**
+ * Worker 内的烧录运行时：适配器、协议层与帧传输层都在这里执行，
+ * 串口 I/O 经传输桥交给主线程，或在租借到串口时由 Worker 直接读写
+ */
+class BurnerWorkerRuntime {
+  private readonly device: DeviceInfo;
+  private readonly bridgedTransport: Transport;
+  private readonly adapters: Record<BurnerWorkerMode, CartridgeAdapter>;
+  private readonly calls = new Map<number, AbortController>();
+  private readonly callbacks = new Map<number, PendingCallback>();
+  private leasedTransport: Transport | null = null;
+  private nextCallbackId = 1;
+  private pendingProgress: ProgressInfo | null = null;
+  private progressTimer: ReturnType<typeof setTimeout> | null = null;
+  private lastProgressAt = Number.NEGATIVE_INFINITY;
+
+  constructor(private readonly endpoint: BurnerWorkerEndpoint, init: InitRequest) {
+    installWorkerStorage(init.storage, (key, value) => {
+      this.post({ type: 'storage', key, value });
+    });
+    AdvancedSettings.init();
+
+    const locale = normalizeLocale(init.locale);
+    if (locale) {
+      i18n.global.locale.value = locale;
+    }
+
+    const capabilities = init.device.capabilities ?? null;
+    this.bridgedTransport = createFramedTransport(new BridgedTransport(init.bridge, init.bridgeFeatures), capabilities);
+    this.device = {
+      port: null,
+      connection: null,
+      connectionId: init.device.connectionId,
+      transport: this.bridgedTransport,
+      portInfo: init.device.portInfo,
+      firmwareProfile: init.device.firmwareProfile,
+      capabilities: init.device.capabilities,
+      serialHandle: {
+        platform: init.device.platform,
+        transport: this.bridgedTransport,
+        port: null,
+        portInfo: init.device.portInfo,
+        firmwareProfile: init.device.firmwareProfile,
+        capabilities: init.device.capabilities,
+      },
+    };
+
+    const log = (message: BurnerLogInput, level: BurnerLogLevel) => {
+      // 日志与进度保持先后顺序
+      this.flushProgress();
+      this.post({ type: 'log', message, level });
+    };
+    const progress = (info: ProgressInfo) => {
+      this.queueProgress(info);
+    };
+    this.adapters = {
+      gba: new GBAAdapter(this.device, log, progress, i18n.global.t),
+      mbc5: new MBC5Adapter(this.device, log, progress, i18n.global.t),
+    };
+
+    const webSerial = typeof navigator !== 'undefined' && navigator.serial !== undefined;
+    this.post({ type: 'ready', webSerial });
+  }
+
+  handle(request: BurnerWorkerRequest): void {
+    switch (request.type) {
+      case 'init':
+        return;
+      case 'call':
+        void this.runCall(request);
+        return;
+      case 'abort':
+        this.calls.get(request.callId)?.abort();
+        return;
+      case 'callbackResult': {
+        const pending = this.callbacks.get(request.callbackId);
+        this.callbacks.delete(request.callbackId);
+        if (request.error) {
+          pending?.reject(deserializeError(request.error));
+        } else {
+          pending?.resolve();
+        }
+        return;
+      }
+    }
+  }
+
+  private async runCall(request: CallRequest): Promise<void> {
+    const controller = new AbortController();
+    this.calls.set(request.callId, controller);
+    try {
+      AdvancedSettings.setSettings(request.settings);
+      const value = await this.invoke(request, controller.signal);
+      this.flushProgress();
+      if (isCommandResult(value) && value.data) {
+        const { data, transfer } = transferableData(value.data);
+        this.post({ type: 'result', callId: request.callId, value: { ...value, data } }, transfer);
+      } else {
+        this.post({ type: 'result', callId: request.callId, value });
+      }
+    } catch (error) {
+      this.flushProgress();
+      this.post({ type: 'result', callId: request.callId, error: serializeError(error) });
+    } finally {
+      this.calls.delete(request.callId);
+    }
+  }
+
+  private invoke(request: CallRequest, signal: AbortSignal): Promise<unknown> {
+    const adapter = this.adapters[request.mode ?? 'gba'];
+    const args = request.args;
+    const options = this.attachCallbacks(request, args[1] as CommandOptions | undefined);
+
+    switch (request.method) {
+      case 'getCartInfo':
+        return adapter.getCartInfo(args[0] as boolean | undefined, args[1] as boolean | undefined);
+      case 'eraseSectors':
+        return adapter.eraseSectors(args[0] as SectorBlock[], options as CommandOptions, signal);
+      case 'writeROM':
+        return adapter.writeROM(args[0] as Uint8Array, options as CommandOptions, signal);
+      case 'readROM':
+        return adapter.readROM(args[0] as number, options as CommandOptions, signal, args[3] as boolean | undefined);
+      case 'verifyROM':
+        return adapter.verifyROM(args[0] as Uint8Array, options as CommandOptions, signal);
+      case 'writeRAM':
+        return adapter.writeRAM(args[0] as Uint8Array, options);
+      case 'readRAM':
+        return adapter.readRAM(args[0] as number, options);
+      case 'verifyRAM':
+        return adapter.verifyRAM(args[0] as Uint8Array, options);
+      case 'resetCommandBuffer':
+        return adapter.resetCommandBuffer();
+      case 'leasePort':
+        return this.leasePort(args[0] as SerialPortLease);
+      case 'releasePort':
+        return this.releasePort();
+    }
+  }
+
+  /**
+   * 把主线程保留的转储目标与断点记录换成回调主线程的代理
+   */
+  private attachCallbacks(request: CallRequest, options: CommandOptions | undefined): CommandOptions | undefined {
+    if (!options || request.callbacks.length === 0) {
+      return options;
+    }
+
+    const callback = (target: WorkerCallbackTarget, method: string) => (...args: unknown[]) =>
+      this.requestCallback(request.callId, target, method, args);
+    const patched: CommandOptions = { ...options };
+    if (request.callbacks.includes('dumpSink')) {
+      patched.dumpSink = {
+        write: callback('dumpSink', 'write'),
+        close: callback('dumpSink', 'close'),
+        abort: callback('dumpSink', 'abort'),
+      } satisfies DumpSink;
+    }
+    if (request.callbacks.includes('checkpoint')) {
+      patched.checkpoint = {
+        commit: callback('checkpoint', 'commit'),
+      } satisfies TransferCheckpoint;
+    }
+    return patched;
+  }
+
+  private requestCallback(callId: number, target: WorkerCallbackTarget, method: string, args: unknown[]): Promise<void> {
+    const callbackId = this.nextCallbackId++;
+    return new Promise((resolve, reject) => {
+      this.callbacks.set(callbackId, { resolve, reject });
+      this.post({ type: 'callback', callId, callbackId, target, method, args });
+    });
+  }
+
+  private async leasePort(lease: SerialPortLease): Promise<boolean> {
+    if (this.leasedTransport) {
+      return true;
+    }
+    let transport: Transport | null;
+    try {
+      transport = await openLeasedSerialPort(lease);
+    } catch {
+      transport = null;
+    }
+    if (!transport) {
+      return false;
+    }
+    this.leasedTransport = transport;
+    this.useTransport(createFramedTransport(transport, this.device.capabilities ?? null));
+    return true;
+  }
+
+  private async releasePort(): Promise<void> {
+    const transport = this.leasedTransport;
+    if (!transport) {
+      return;
+    }
+    this.leasedTransport = null;
+    this.useTransport(this.bridgedTransport);
+    await transport.close?.();
+  }
+
+  private useTransport(transport: Transport): void {
+    this.device.transport = transport;
+    if (this.device.serialHandle) {
+      this.device.serialHandle.transport = transport;
+    }
+  }
+
+  private queueProgress(info: ProgressInfo): void {
+    this.pendingProgress = this.pendingProgress ? { ...this.pendingProgress, ...info } : { ...info };
+    if (this.progressTimer !== null) {
+      return;
+    }
+    const wait = PROGRESS_INTERVAL_MS - (performance.now() - this.lastProgressAt);
+    if (wait <= 0) {
+      this.flushProgress();
+      return;
+    }
+    this.progressTimer = setTimeout(() => {
+      this.progressTimer = null;
+      this.flushProgress();
+    }, wait);
+  }
+
+  private flushProgress(): void {
+    if (this.progressTimer !== null) {
+      clearTimeout(this.progressTimer);
+      this.progressTimer = null;
+    }
+    const progress = this.pendingProgress;
+    if (!progress) {
+      return;
+    }
+    this.pendingProgress = null;
+    this.lastProgressAt = performance.now();
+    this.post({ type: 'progress', progress });
+  }
+
+  private post(response: BurnerWorkerResponse, transfer: Transferable[] = []): void {
+    this.endpoint.postMessage(response, transfer);
+  }
+}
+
+/**
+ * 在给定端点上运行烧录 Worker；收到 init 之前的其他消息会被忽略
+ */
+export function runBurnerWorker(endpoint: BurnerWorkerEndpoint): void {
+  let runtime: BurnerWorkerRuntime | null = null;
+  endpoint.onmessage = (event: MessageEvent<BurnerWorkerRequest>) => {
+    const request = event.data;
+    if (request.type === 'init') {
+      runtime ??= new BurnerWorkerRuntime(endpoint, request);
+      return;
+    }
+    runtime?.handle(request);
+  };
+}
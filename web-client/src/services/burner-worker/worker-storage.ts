@@ -0,0 +1,79 @@
+/**
+ * Worker 内没有 localStorage：用主线程快照填充一个内存版本，
+ * 值有变化的写入再回报主线程持久化（页大小调优、CFI 缓存等）
+ */
+class WorkerStorage {
+  private readonly items: Map<string, string>;
+
+  constructor(snapshot: Record<string, string>, private readonly onChange: (key: string, value: string | null) => void) {
+    this.items = new Map(Object.entries(snapshot));
+  }
+
+  get length(): number {
+    return this.items.size;
+  }
+
+  key(index: number): string | null {
+    return [...this.items.keys()][index] ?? null;
+  }
+
+  getItem(key: string): string | null {
+    return this.items.get(key) ?? null;
+  }
+
+  setItem(key: string, value: string): void {
+    const text = String(value);
+    if (this.items.get(key) === text) {
+      return;
+    }
+    this.items.set(key, text);
+    this.onChange(key, text);
+  }
+
+  removeItem(key: string): void {
+    if (this.items.delete(key)) {
+      this.onChange(key, null);
+    }
+  }
+
+  clear(): void {
+    for (const key of [...this.items.keys()]) {
+      this.removeItem(key);
+    }
+  }
+}
+
+/**
+ * 当前上下文已有 localStorage（主线程、测试环境）时不做替换，返回 false
+ */
+export function installWorkerStorage(
+  snapshot: Record<string, string>,
+  onChange: (key: string, value: string | null) => void,
+): boolean {
+  if (typeof localStorage !== 'undefined') {
+    return false;
+  }
+  Object.defineProperty(globalThis, 'localStorage', {
+    value: new WorkerStorage(snapshot, onChange),
+    configurable: true,
+  });
+  return true;
+}
+
+/**
+ * 主线程侧：收集 localStorage 全部条目作为 Worker 的初始快照
+ */
+export function snapshotLocalStorage(): Record<string, string> {
+  const snapshot: Record<string, string> = {};
+  try {
+    for (let i = 0; i < localStorage.length; i++) {
+      const key = localStorage.key(i);
+      if (key !== null) {
+        snapshot[key] = localStorage.getItem(key) ?? '';
+      }
+    }
+  } catch {
+    // localStorage might be unavailable (e.g. private mode). Ignore silently.
+  }
+  return snapshot;
+}
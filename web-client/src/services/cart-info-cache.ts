@@ -0,0 +1,105 @@
+import type { DeviceInfo } from '@/types/device-info';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+const STORAGE_KEY = 'cfi_table_cache';
+/** 最多记住的芯片数，超出时淘汰最久未使用的 */
+const MAX_TABLES = 32;
+
+interface CachedCfiTable {
+  /** 原始 CFI 查询数据（十六进制） */
+  cfi: string;
+  updatedAt: number;
+}
+
+/**
+ * 本次连接内已识别的卡带信息，按设备与平台（GBA / MBC5）区分。
+ * 设备对象可能经过 Vue 响应式代理，因此以连接标识或串口标识而不是对象本身作为键
+ */
+const sessionCartInfo = new Map<string, CFIInfo>();
+
+function deviceKey(device: DeviceInfo): string {
+  if (device.connectionId) {
+    return device.connectionId;
+  }
+  const portInfo = device.portInfo ?? device.serialHandle?.portInfo;
+  const platform = device.serialHandle?.platform ?? 'web';
+  return `${platform}:${portInfo?.path ?? portInfo?.serialNumber ?? 'default'}`;
+}
+
+/**
+ * 本次连接内识别过的卡带信息；只有刚读到的 Flash ID 与缓存一致时才返回，
+ * 不经复位直接换卡时 ID 不同，回到完整识别
+ */
+export function getSessionCartInfo(device: DeviceInfo, platformId: string, flashId: Uint8Array | undefined): CFIInfo | undefined {
+  const cached = sessionCartInfo.get(`${deviceKey(device)}|${platformId}`);
+  if (!cached?.flashId || !isCacheableFlashId(flashId) || cached.flashId.length !== flashId.length) {
+    return undefined;
+  }
+  return cached.flashId.every((byte, index) => byte === flashId[index]) ? cached : undefined;
+}
+
+export function setSessionCartInfo(device: DeviceInfo, platformId: string, cfiInfo: CFIInfo): void {
+  sessionCartInfo.set(`${deviceKey(device)}|${platformId}`, cfiInfo);
+}
+
+/**
+ * 卡带可能已被更换（重新上电、DTR 复位、断开连接）时丢弃该设备的会话缓存
+ */
+export function invalidateSessionCartInfo(device: DeviceInfo): void {
+  const prefix = `${deviceKey(device)}|`;
+  for (const key of [...sessionCartInfo.keys()]) {
+    if (key.startsWith(prefix)) {
+      sessionCartInfo.delete(key);
+    }
+  }
+}
+
+function loadTables(): Record<string, CachedCfiTable> {
+  try {
+    const raw = localStorage.getItem(STORAGE_KEY);
+    const parsed: unknown = raw ? JSON.parse(raw) : {};
+    return parsed && typeof parsed === 'object' ? parsed as Record<string, CachedCfiTable> : {};
+  } catch {
+    return {};
+  }
+}
+
+/**
+ * 没插卡或读取失败时总线读回全 0xFF / 全 0x00，这样的 ID 不能作为缓存键
+ */
+export function isCacheableFlashId(flashId: Uint8Array | undefined): flashId is Uint8Array {
+  return flashId !== undefined && flashId.length > 0 && flashId.some(byte => byte !== flashId[0]);
+}
+
+function tableKey(platformId: string, flashId: Uint8Array): string {
+  return `${platformId}:${Array.from(flashId, byte => byte.toString(16).padStart(2, '0')).join('')}`;
+}
+
+/**
+ * 按 Flash ID 读取记住的原始 CFI 数据；同一型号芯片的 CFI 表固定不变
+ */
+export function loadCachedCfiTable(platformId: string, flashId: Uint8Array): Uint8Array | null {
+  const table = loadTables()[tableKey(platformId, flashId)];
+  if (!table || typeof table.cfi !== 'string' || !/^(?:[0-9a-f]{2})+$/.test(table.cfi)) {
+    return null;
+  }
+  return Uint8Array.from(table.cfi.match(/../g) ?? [], hex => parseInt(hex, 16));
+}
+
+export function saveCachedCfiTable(platformId: string, flashId: Uint8Array, cfiData: Uint8Array): void {
+  try {
+    const tables = {
+      ...loadTables(),
+      [tableKey(platformId, flashId)]: {
+        cfi: Array.from(cfiData, byte => byte.toString(16).padStart(2, '0')).join(''),
+        updatedAt: Date.now(),
+      },
+    };
+    const kept = Object.entries(tables)
+      .sort(([, a], [, b]) => b.updatedAt - a.updatedAt)
+      .slice(0, MAX_TABLES);
+    localStorage.setItem(STORAGE_KEY, JSON.stringify(Object.fromEntries(kept)));
+  } catch {
+    // localStorage might be unavailable (e.g. private mode). Ignore silently.
+  }
+}
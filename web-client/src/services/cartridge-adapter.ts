@@ -1,6 +1,6 @@
 /* eslint-disable @typescript-eslint/require-await */
 import type { Transport } from '@/platform/serial';
-import { getFlashName } from '@/protocol';
+import { getFlashName, rom_program_native, rom_read_into, rom_read_native, supportsNativeJobs } from '@/protocol';
 import { AdvancedSettings } from '@/settings/advanced-settings';
 import { CommandOptions } from '@/types/command-options';
 import { CommandResult } from '@/types/command-result';
@@ -17,14 +17,27 @@ import { ProgressInfoBuilder } from '@/utils/progress/progress-builder';
 import { ProgressReporter } from '@/utils/progress/progress-reporter';
 import { SpeedCalculator } from '@/utils/progress/speed-calculator';
 import { createSectorProgressInfo } from '@/utils/sector-utils';
-
+import type { VerifyMismatchCollector } from '@/utils/verify-utils';
+
+import {
+  getSessionCartInfo,
+  isCacheableFlashId,
+  loadCachedCfiTable,
+  saveCachedCfiTable,
+  setSessionCartInfo,
+} from './cart-info-cache';
+import type { EraseTimingRecorder } from './erase-timing';
+import { loadTunedPageSize, PageSizeTuner } from './page-size-tuner';
 import type { PlatformOps } from './platform-ops';
+import { RomDumpBuffer } from './rom-dump-buffer';
 
 // 定义日志和进度回调函数类型
 export type LogCallback = (message: BurnerLogInput, type: 'info' | 'success' | 'warn' | 'error' ) => void;
 
 export type ProgressCallback = (progressInfo: ProgressInfo) => void;
 
+export type TransferDirection = 'read' | 'write';
+
 // eslint-disable-next-line @typescript-eslint/no-explicit-any
 export type TranslateFunction = (key: string, params?: any) => string;
 
@@ -36,6 +49,10 @@ export class CartridgeAdapter {
   private static readonly COMMAND_RESET_PULSE_MS = 10;
   private static readonly COMMAND_RESET_SETTLE_MS = 200;
   private static readonly SIMULATED_TRANSFER_CHUNK_SIZE = 0xfffd;
+  // 设备上报上限后自动选取的分块上限：不超过 MBC5 16KB 可切换 bank 窗口
+  private static readonly DEVICE_CHUNK_SIZE_CEILING = 0x4000;
+  // 2B.包大小 1B.命令 4B.地址 2B.buffer大小 2B.CRC
+  private static readonly PROGRAM_COMMAND_OVERHEAD = 11;
 
   // 子类共享时序常量
   protected static readonly ROM_READ_START_SETTLE_MS = 100;
@@ -46,6 +63,10 @@ export class CartridgeAdapter {
   protected static readonly ROM_WRITE_SAMPLE_BYTES = 4;
   protected static readonly RAM_READ_START_SETTLE_MS = 150;
   protected static readonly RAM_READ_RETRY_RESET_MS = 150;
+  // 原生后端单次任务覆盖的字节数：足够摊薄 IPC 往返，又不至于让进度与取消过于迟钝
+  protected static readonly NATIVE_JOB_SPAN = 0x40000;
+  // 校验失败时在日志中逐条列出的差异区间数
+  protected static readonly VERIFY_LOGGED_RANGES = 16;
 
   protected device: DeviceInfo;
   protected log: LogCallback;
@@ -226,6 +247,31 @@ export class CartridgeAdapter {
     return this.currentSectorProgress;
   }
 
+  /**
+   * 校验结束后汇总差异：总字节数、区间数与受影响扇区数，并列出前几个区间
+   */
+  protected logVerifyMismatches(mismatches: VerifyMismatchCollector): void {
+    this.log(this.t('messages.rom.verifyMismatchSummary', {
+      count: mismatches.mismatchCount,
+      ranges: mismatches.rangeCount,
+      sectors: mismatches.failedSectorCount,
+    }), 'error');
+
+    const listed = mismatches.ranges.slice(0, CartridgeAdapter.VERIFY_LOGGED_RANGES);
+    for (const range of listed) {
+      this.log(this.t('messages.rom.verifyMismatchRange', {
+        start: formatHex(range.address, 4),
+        end: formatHex(range.address + range.length - 1, 4),
+        count: range.mismatches,
+      }), 'error');
+    }
+    if (mismatches.rangeCount > listed.length) {
+      this.log(this.t('messages.rom.verifyMismatchMore', {
+        count: mismatches.rangeCount - listed.length,
+      }), 'error');
+    }
+  }
+
   /**
    * 重置所有扇区状态为pending
    */
@@ -275,24 +321,122 @@ export class CartridgeAdapter {
     return this.device.serialHandle?.platform === 'simulated';
   }
 
-  protected resolveRomPageSize(requestedPageSize?: number): number {
-    const configuredPageSize = Math.min(requestedPageSize ?? AdvancedSettings.romPageSize, AdvancedSettings.romPageSize);
+  /**
+   * 固件上报的单包上限（0xd3），按 2 的幂向下取整；未上报时返回 null
+   */
+  protected deviceChunkLimit(direction: TransferDirection): number | null {
+    const capabilities = this.device.capabilities;
+    if (!capabilities) {
+      return null;
+    }
+
+    const ceiling = CartridgeAdapter.DEVICE_CHUNK_SIZE_CEILING;
+    const byteLimit = direction === 'read'
+      ? (capabilities.streamingResponse ? ceiling : capabilities.maxResponsePayload)
+      : capabilities.maxCommandSize - CartridgeAdapter.PROGRAM_COMMAND_OVERHEAD;
+    const limit = Math.min(byteLimit, ceiling);
+    return limit > 0 ? 2 ** Math.floor(Math.log2(limit)) : null;
+  }
+
+  private resolveConfiguredPageSize(requestedPageSize: number | undefined, settingPageSize: number, direction: TransferDirection): number {
+    const configuredPageSize = Math.min(requestedPageSize ?? settingPageSize, settingPageSize);
+    const deviceLimit = this.deviceChunkLimit(direction);
+    if (deviceLimit === null) {
+      return configuredPageSize;
+    }
+
+    // 调用方未指定且高级设置保持最大值时，按设备上限取最大分块；用户调小的设置仍然优先
+    const narrowedByUser = requestedPageSize !== undefined || settingPageSize < AdvancedSettings.getLimits().pageSize.max;
+    return narrowedByUser ? Math.min(configuredPageSize, deviceLimit) : deviceLimit;
+  }
+
+  protected resolveRomPageSize(requestedPageSize?: number, direction: TransferDirection = 'write'): number {
+    const configuredPageSize = this.resolveConfiguredPageSize(requestedPageSize, AdvancedSettings.romPageSize, direction);
+    if (direction === 'read' && this.romReadTunable(requestedPageSize)) {
+      return loadTunedPageSize(this.pageSizeTuningKey(direction), configuredPageSize) ?? configuredPageSize;
+    }
     if (!this.isSimulatedDevice()) {
       return configuredPageSize;
     }
 
     // Simulated transports already execute the full protocol path. Use larger logical chunks so
     // async command overhead does not dwarf the configured throughput controls in debug mode.
-    return Math.max(configuredPageSize, CartridgeAdapter.SIMULATED_TRANSFER_CHUNK_SIZE);
+    return this.simulatedPageSize(configuredPageSize, direction);
   }
 
-  protected resolveRamPageSize(requestedPageSize?: number): number {
-    const configuredPageSize = Math.min(requestedPageSize ?? AdvancedSettings.ramPageSize, AdvancedSettings.ramPageSize);
+  protected resolveRamPageSize(requestedPageSize?: number, direction: TransferDirection = 'write'): number {
+    const configuredPageSize = this.resolveConfiguredPageSize(requestedPageSize, AdvancedSettings.ramPageSize, direction);
     if (!this.isSimulatedDevice()) {
       return configuredPageSize;
     }
 
-    return Math.max(configuredPageSize, CartridgeAdapter.SIMULATED_TRANSFER_CHUNK_SIZE);
+    return this.simulatedPageSize(configuredPageSize, direction);
+  }
+
+  /**
+   * 模拟设备上放大的分块，不超过固件上报的单包上限（帧长度只有 16 位）
+   */
+  private simulatedPageSize(configuredPageSize: number, direction: TransferDirection): number {
+    const deviceLimit = this.deviceChunkLimit(direction) ?? CartridgeAdapter.SIMULATED_TRANSFER_CHUNK_SIZE;
+    return Math.max(configuredPageSize, Math.min(CartridgeAdapter.SIMULATED_TRANSFER_CHUNK_SIZE, deviceLimit));
+  }
+
+  /**
+   * 用户未指定分块且高级设置保持最大值时，ROM 读取分块交给自动调优
+   */
+  private romReadTunable(requestedPageSize?: number): boolean {
+    return requestedPageSize === undefined
+      && AdvancedSettings.romPageSize >= AdvancedSettings.getLimits().pageSize.max
+      && !this.isSimulatedDevice();
+  }
+
+  /**
+   * 调优结果按固件、协议版本、运行环境与是否走原生后端分别记录
+   */
+  private pageSizeTuningKey(direction: TransferDirection): string {
+    const transport = this.device.transport ?? this.device.serialHandle?.transport;
+    const platform = this.device.serialHandle?.platform ?? 'web';
+    const mode = transport && supportsNativeJobs(transport) ? 'native' : 'stream';
+    const protocolVersion = this.device.capabilities?.protocolVersion ?? 0;
+    return `${this.firmwareProfile.id}-v${protocolVersion}:${platform}-${mode}:${direction}`;
+  }
+
+  /**
+   * ROM 读取的分块调优器；用户限定了分块、已有调优结果或任务太小时返回 null
+   */
+  protected createRomReadTuner(requestedPageSize: number | undefined, size: number): PageSizeTuner | null {
+    if (!this.romReadTunable(requestedPageSize)) {
+      return null;
+    }
+
+    const key = this.pageSizeTuningKey('read');
+    const maxPageSize = this.resolveConfiguredPageSize(requestedPageSize, AdvancedSettings.romPageSize, 'read');
+    if (loadTunedPageSize(key, maxPageSize) !== null) {
+      return null;
+    }
+    return PageSizeTuner.start(key, maxPageSize, size);
+  }
+
+  protected logPageSizeTuned(tuner: PageSizeTuner): void {
+    this.log(this.t('messages.rom.pageSizeTuned', {
+      pageSize: tuner.pageSize,
+      speed: formatSpeed(tuner.bestSpeed),
+    }), 'info');
+  }
+
+  /**
+   * 报告擦除明显偏慢的扇区，这些位置的闪存可能已经磨损
+   */
+  protected logEraseOutliers(recorder: EraseTimingRecorder): void {
+    const outliers = recorder.outliers();
+    if (outliers.length === 0) {
+      return;
+    }
+    this.log(this.t('messages.operation.eraseSlowSectors', {
+      count: outliers.length,
+      median: recorder.medianMs,
+      sectors: outliers.map(({ address, elapsedMs }) => `${formatHex(address, 4)} (${elapsedMs} ms)`).join(', '),
+    }), 'warn');
   }
 
   protected summarizeLogMessage(message: BurnerLogInput): string {
@@ -324,6 +468,45 @@ export class CartridgeAdapter {
     return transport;
   }
 
+  /**
+   * 传输层能否整段执行读取/编程循环（Tauri 原生后端）
+   */
+  protected get nativeJobsAvailable(): boolean {
+    return supportsNativeJobs(this.transport);
+  }
+
+  /**
+   * ROM 读写循环每步推进的字节数：原生后端一次任务跨越多个分块，其余传输逐块收发
+   */
+  protected romStepSize(pageSize: number): number {
+    return this.nativeJobsAvailable ? Math.max(pageSize, CartridgeAdapter.NATIVE_JOB_SPAN) : pageSize;
+  }
+
+  /**
+   * 编程一段连续的 ROM 数据（不跨越 bank 窗口）
+   * 超过一个分块时交给原生后端整段执行，全 0xFF 的页由后端跳过
+   * @param onProgress - 原生任务的进度，参数为已处理的字节数
+   * @returns 实际编程的字节数
+   */
+  protected async programROMSpan(
+    data: Uint8Array,
+    cartAddress: number,
+    pageSize: number,
+    bufferSize: number,
+    onProgress?: (processedBytes: number) => void,
+    signal?: AbortSignal,
+  ): Promise<number> {
+    if (data.byteLength > pageSize && this.nativeJobsAvailable) {
+      return rom_program_native(this.transport, this.ops.romCommands.program, data, cartAddress, pageSize, bufferSize, {
+        onProgress: onProgress && ((progress) => { onProgress(progress.processedBytes); }),
+        signal,
+        maxCommandSize: this.device.capabilities?.maxCommandSize,
+      });
+    }
+    await this.ops.romProgram(this.transport, data, cartAddress, bufferSize);
+    return data.byteLength;
+  }
+
   protected async withPowerConfig<T>(_enable5V: boolean, fn: () => Promise<T>): Promise<T> {
     return fn();
   }
@@ -337,6 +520,8 @@ export class CartridgeAdapter {
     _chunkIndex: number,
     _bank: number,
     restoreState?: () => Promise<void>,
+    span?: { pageSize: number; signal?: AbortSignal },
+    target?: Uint8Array,
   ): Promise<Uint8Array> {
     const retries = AdvancedSettings.romReadRetryCount;
     const attempts = retries + 1;
@@ -345,8 +530,24 @@ export class CartridgeAdapter {
 
     for (let attempt = 1; attempt <= attempts; attempt++) {
       try {
-        return await this.ops.flashCmdSet.read(this.transport, chunkSize, cartAddress);
+        // 超过一个分块的跨度由原生后端连续读取
+        if (span && chunkSize > span.pageSize) {
+          const data = await rom_read_native(this.transport, this.ops.romCommands.read, chunkSize, cartAddress, span.pageSize, { signal: span.signal });
+          target?.set(data);
+          return target ?? data;
+        }
+        // 传输层支持时响应直接落到调用方的缓冲
+        if (target && this.transport.sendAndReceiveInto) {
+          await rom_read_into(this.transport, this.ops.romCommands.read, target, cartAddress);
+          return target;
+        }
+        const data = await this.ops.flashCmdSet.read(this.transport, chunkSize, cartAddress);
+        target?.set(data);
+        return target ?? data;
       } catch (error) {
+        if (span?.signal?.aborted) {
+          throw error;
+        }
         lastError = error;
         this.log(
           errorToBurnerLog(
@@ -370,7 +571,8 @@ export class CartridgeAdapter {
   async readROM(size: number, options: CommandOptions, signal?: AbortSignal, showProgress = true): Promise<CommandResult> {
     const ops = this.ops;
     const baseAddress = options.baseAddress ?? 0x00;
-    const pageSize = this.resolveRomPageSize(options.romPageSize);
+    let pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
+    const tuner = this.createRomReadTuner(options.romPageSize, size);
     const readThrottleMs = AdvancedSettings.romReadThrottleMs;
 
     this.log(this.t('messages.operation.startReadROM', { size, baseAddress: formatHex(baseAddress, 4) }), 'info');
@@ -389,7 +591,7 @@ export class CartridgeAdapter {
             await this.stabilizeCommandChannel(CartridgeAdapter.ROM_READ_START_SETTLE_MS);
             this.log(this.t('messages.rom.reading'), 'info');
 
-            const data = new Uint8Array(size);
+            const buffer = new RomDumpBuffer(size, pageSize, options.dumpSink);
             const speedCalculator = new SpeedCalculator();
             const progressReporter = new ProgressReporter('read', size, (pi) => { this.updateProgress(pi); }, (k, p) => this.t(k, p), showProgress);
             progressReporter.reportStart(this.t('messages.rom.reading'));
@@ -418,13 +620,31 @@ export class CartridgeAdapter {
               const restoreState = needsBankSwitch
                 ? async () => { await ops.switchRomBank(this.device, bank, options); }
                 : undefined;
-              const chunk = await this.readROMChunkWithRetry(chunkSize, currentAddress, cartAddress, Math.floor(totalRead / pageSize) + 1, bank, restoreState);
+              const chunk = buffer.chunk(totalRead, chunkSize);
+              await this.readROMChunkWithRetry(
+                chunkSize,
+                currentAddress,
+                cartAddress,
+                Math.floor(totalRead / pageSize) + 1,
+                bank,
+                restoreState,
+                undefined,
+                chunk,
+              );
+              await buffer.commit(chunk);
+              await options.checkpoint?.commit(currentAddress, chunkSize, chunk);
               const chunkEndTime = Date.now();
-              data.set(chunk, totalRead);
               totalRead += chunkSize;
               chunkCount++;
 
               speedCalculator.addDataPoint(chunkSize, chunkEndTime);
+              if (tuner?.tuning) {
+                tuner.record(chunkSize, chunkEndTime);
+                pageSize = tuner.pageSize;
+                if (!tuner.tuning) {
+                  this.logPageSizeTuned(tuner);
+                }
+              }
 
               if (chunkCount % 10 === 0 || totalRead >= size) {
                 const currentSpeed = speedCalculator.getCurrentSpeed();
@@ -446,7 +666,7 @@ export class CartridgeAdapter {
             const avgSpeed = speedCalculator.getAverageSpeed();
             const maxSpeed = speedCalculator.getMaxSpeed();
 
-            this.log(this.t('messages.rom.readSuccess', { size: data.length }), 'success');
+            this.log(this.t('messages.rom.readSuccess', { size }), 'success');
             this.log(this.t('messages.rom.readSummary', {
               totalTime: formatTimeDuration(totalTime),
               avgSpeed: formatSpeed(avgSpeed),
@@ -454,8 +674,8 @@ export class CartridgeAdapter {
               totalSize: formatBytes(size),
             }), 'info');
 
-            progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size: data.length }), avgSpeed);
-            return { success: true, data, message: this.t('messages.rom.readSuccess', { size: data.length }) };
+            progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size }), avgSpeed);
+            return { success: true, data: buffer.data, message: this.t('messages.rom.readSuccess', { size }) };
           });
         } catch (e) {
           const pr = new ProgressReporter('read', size, (pi) => { this.updateProgress(pi); }, (k, p) => this.t(k, p), showProgress);
@@ -469,7 +689,14 @@ export class CartridgeAdapter {
     );
   }
 
-  async getCartInfo(enable5V?: boolean): Promise<CFIInfo | false> {
+  /**
+   * 识别卡带并解析 CFI
+   *
+   * 每次都先读取 Flash ID：与本次连接内识别过的卡带一致时直接返回缓存（重新上电或 DTR 复位后失效），
+   * 否则已记住该型号的 CFI 表则不再查询 CFI
+   * @param refresh - 忽略会话缓存，例如用户手动读取卡带信息
+   */
+  async getCartInfo(enable5V?: boolean, refresh = false): Promise<CFIInfo | false> {
     const ops = this.ops;
     this.log(this.t('messages.operation.startGetCartInfo'), 'info');
 
@@ -478,29 +705,49 @@ export class CartridgeAdapter {
       async () => {
         try {
           return await this.withPowerConfig(enable5V ?? false, async () => {
-            await ops.flashCmdSet.write(this.transport, ops.flashCmdSet.encodeByte(0x98), ops.cfiEntryAddress);
-            const cfiData = await ops.flashCmdSet.read(this.transport, 0x100, 0x00);
-            await ops.flashCmdSet.write(this.transport, ops.flashCmdSet.encodeByte(0xf0), 0x00);
+            let flashId: Uint8Array | undefined;
+            try {
+              flashId = await ops.cfiGetId(this.transport);
+              const idStr = Array.from(flashId).map(x => x.toString(16).padStart(2, '0')).join(' ');
+              const flashName = getFlashName([...flashId]);
+              this.log(`Flash ID: ${idStr} (${flashName})`, 'info');
+            } catch (e) {
+              this.log(errorToBurnerLog(this.t('messages.operation.readIdFailed'), e), 'warn');
+            }
 
-            const cfiInfo = parseCFI(cfiData);
+            const cached = refresh ? undefined : getSessionCartInfo(this.device, ops.platformId, flashId);
+            if (cached) {
+              this.log(this.t('messages.operation.cartInfoCached'), 'info');
+              this.log(cached.info, 'info');
+              return cached;
+            }
+
+            const cachedTable = isCacheableFlashId(flashId) ? loadCachedCfiTable(ops.platformId, flashId) : null;
+            let cfiInfo = cachedTable ? parseCFI(cachedTable) : false;
+            if (cfiInfo) {
+              this.log(this.t('messages.operation.cfiTableCached'), 'info');
+            } else {
+              await ops.flashCmdSet.write(this.transport, ops.flashCmdSet.encodeByte(0x98), ops.cfiEntryAddress);
+              const cfiData = await ops.flashCmdSet.read(this.transport, 0x100, 0x00);
+              await ops.flashCmdSet.write(this.transport, ops.flashCmdSet.encodeByte(0xf0), 0x00);
+
+              cfiInfo = parseCFI(cfiData);
+              if (cfiInfo && isCacheableFlashId(flashId)) {
+                saveCachedCfiTable(ops.platformId, flashId, cfiData);
+              }
+            }
 
             if (!cfiInfo) {
               this.log(this.t('messages.operation.cfiParseFailed'), 'error');
               return false;
             }
-
-            try {
-              const flashId = await ops.cfiGetId(this.transport);
+            if (flashId) {
               cfiInfo.flashId = flashId;
-              const idStr = Array.from(flashId).map(x => x.toString(16).padStart(2, '0')).join(' ');
-              const flashName = getFlashName([...flashId]);
-              this.log(`Flash ID: ${idStr} (${flashName})`, 'info');
-            } catch (e) {
-              this.log(errorToBurnerLog(this.t('messages.operation.readIdFailed'), e), 'warn');
             }
 
             this.log(this.t('messages.operation.cfiParseSuccess'), 'success');
             this.log(cfiInfo.info, 'info');
+            setSessionCartInfo(this.device, ops.platformId, cfiInfo);
             return cfiInfo;
           });
         } catch (e) {
@@ -0,0 +1,48 @@
+import { type ChromeTrace, commandProfiler, type OpcodeLatencyStats } from '@/protocol';
+import { DebugSettings } from '@/settings/debug-settings';
+
+export type { LatencySummary, OpcodeLatencyStats } from '@/protocol';
+
+/** 调试面板打开期间即使未开调试模式也记录 */
+let panelOpen = false;
+
+function syncCommandProfiler(): void {
+  commandProfiler.enabled = panelOpen || DebugSettings.debugMode;
+}
+
+/**
+ * 协议层命令耗时统计，按累计耗时从大到小排列
+ */
+export function getCommandLatencyStats(): OpcodeLatencyStats[] {
+  return commandProfiler.getOpcodeStats();
+}
+
+/**
+ * 清空统计并以当前时刻作为轨迹零点，开始剖析一次新的任务
+ */
+export function resetCommandProfiler(): void {
+  commandProfiler.reset();
+}
+
+/**
+ * 任务开始时调用：按调试模式与面板状态决定是否记录，并清空上一个任务的记录
+ */
+export function beginCommandProfile(): void {
+  syncCommandProfiler();
+  commandProfiler.reset();
+}
+
+/**
+ * 调试面板打开/关闭时调用
+ */
+export function setCommandProfilerPanelOpen(open: boolean): void {
+  panelOpen = open;
+  syncCommandProfiler();
+}
+
+/**
+ * 导出自上次清空以来的全部命令与擦除/编程/轮询/读取阶段，Chrome trace-event JSON 格式
+ */
+export function exportCommandTrace(): ChromeTrace {
+  return commandProfiler.exportChromeTrace();
+}
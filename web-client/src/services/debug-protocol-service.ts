@@ -1,7 +1,7 @@
 import type { Transport } from '@/platform/serial';
-import { Command, createCommandPayload, GBACommand, GBCCommand, getPackage, sendPackage } from '@/protocol';
+import { Command, createCommandPayload, DiagnosticCommand, GBACommand, GBCCommand, getPackage, sendPackage } from '@/protocol';
 
-export type DebugCommandType = 'GBA' | 'GBC';
+export type DebugCommandType = 'GBA' | 'GBC' | 'DIAG';
 
 export interface ExecuteDebugCommandInput {
   transport: Transport;
@@ -33,6 +33,12 @@ export function getAvailableDebugCommands(type: DebugCommandType | ''): Record<s
         commands[key] = GBCCommand[key as keyof typeof GBCCommand];
       }
     });
+  } else if (type === 'DIAG') {
+    Object.keys(DiagnosticCommand).forEach(key => {
+      if (isNaN(Number(key))) {
+        commands[key] = DiagnosticCommand[key as keyof typeof DiagnosticCommand];
+      }
+    });
   }
 
   return commands;
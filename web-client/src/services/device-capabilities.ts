@@ -0,0 +1,45 @@
+import { initDeviceSignals, type Transport } from '@/platform/serial';
+import { device_get_info, FRAME_CODE, FramedTransport } from '@/protocol';
+import { type DeviceCapabilities, supportsOpcode } from '@/types/device-capabilities';
+import { parseDeviceInfo } from '@/utils/parsers/device-info-parser';
+
+const PROBE_TIMEOUT_MS = 300;
+const FRAME_WINDOW = 4;
+
+/**
+ * 通过 0xd3 命令探测固件能力。
+ * 旧固件不认识该命令：丐中丐丢弃命令且不回包，碳酸丐停在未知命令上等待复位，
+ * 因此探测失败时用 DTR/RTS 复位命令缓冲并排空迟到数据，再返回 null。
+ */
+export async function probeDeviceCapabilities(transport: Transport): Promise<DeviceCapabilities | null> {
+  try {
+    return parseDeviceInfo(await device_get_info(transport, PROBE_TIMEOUT_MS));
+  } catch {
+    await initDeviceSignals(transport);
+    if (transport.drainInput) {
+      await transport.drainInput();
+    } else {
+      await transport.flushInput?.();
+    }
+    return null;
+  }
+}
+
+/**
+ * 固件支持 v2 帧时返回帧传输层，否则原样返回。
+ * 支持执行期间排队的固件允许多帧在途，总字节数不超过其命令缓冲区。
+ */
+export function createFramedTransport(transport: Transport, capabilities: DeviceCapabilities | null): Transport {
+  if (transport instanceof FramedTransport) {
+    return transport;
+  }
+  if (!capabilities?.frameProtocol || !supportsOpcode(capabilities, FRAME_CODE)) {
+    return transport;
+  }
+
+  return new FramedTransport(transport, {
+    window: capabilities.frameQueue ? FRAME_WINDOW : 1,
+    maxInFlightBytes: capabilities.maxCommandSize,
+    frameCrc: capabilities.frameCrc,
+  });
+}
@@ -1,14 +1,23 @@
 import { createConnectionOrchestrationUseCase } from '@/features/burner/adapters';
 import type { BurnerConnectionHandle, BurnerConnectionSelection, ConnectionFailure } from '@/features/burner/application';
 import { isTauriRuntime } from '@/platform/runtime';
-import type { DeviceHandle } from '@/platform/serial';
+import { type DeviceHandle, RecordingTransport } from '@/platform/serial';
+import { FramedTransport } from '@/protocol';
 import { AdvancedSettings } from '@/settings/advanced-settings';
 import { DeviceInfo } from '@/types/device-info';
-import { attachFirmwareProfile, getFirmwareProfileById, inferFirmwareProfileFromPort } from '@/types/firmware-profile';
+import {
+  attachFirmwareProfile,
+  createFirmwareProfileFromCapabilities,
+  getFirmwareProfileById,
+  inferFirmwareProfileFromPort,
+} from '@/types/firmware-profile';
 import type { SerialPortInfo } from '@/types/serial';
 import { PortSelectionRequiredError } from '@/utils/errors/PortSelectionRequiredError';
 import { PortFilter } from '@/utils/port-filter';
 
+import { invalidateSessionCartInfo } from './cart-info-cache';
+import { createFramedTransport, probeDeviceCapabilities } from './device-capabilities';
+
 /**
  * 设备连接管理器
  * 统一处理 Web Serial API 和 Tauri 原生串口的设备连接
@@ -83,11 +92,13 @@ export class DeviceConnectionManager {
     const firmwareProfile = ctx.firmwareProfile ?? inferFirmwareProfileFromPort(ctx.portInfo);
     return attachFirmwareProfile({
       port: ctx.port,
+      connectionId: handle.id,
       connection: null,
       transport: ctx.transport,
       serialHandle: ctx,
       portInfo: ctx.portInfo,
       firmwareProfile,
+      capabilities: ctx.capabilities,
     }, getFirmwareProfileById(AdvancedSettings.firmwareProfile));
   }
 
@@ -242,8 +253,10 @@ export class DeviceConnectionManager {
 
   /**
    * 初始化串口状态（设置 DTR/RTS 信号）
+   * DTR 复位后卡带可能已更换，丢弃会话内缓存的卡带信息
    */
   async initializeDevice(device: DeviceInfo): Promise<void> {
+    invalidateSessionCartInfo(device);
     const ensureResult = await this.connectionUseCase.ensureConnected();
     if (!ensureResult.success || !ensureResult.context.handle) {
       console.error('[DeviceConnectionManager] initializeDevice failed', {
@@ -258,12 +271,76 @@ export class DeviceConnectionManager {
     }
 
     const latestDevice = this.toDeviceInfo(ensureResult.context.handle);
+    device.connectionId = latestDevice.connectionId;
     device.connection = latestDevice.connection;
     device.port = latestDevice.port;
     device.transport = latestDevice.transport;
     device.serialHandle = latestDevice.serialHandle;
     device.portInfo = latestDevice.portInfo;
     device.firmwareProfile = latestDevice.firmwareProfile;
+
+    await this.detectCapabilities(device);
+  }
+
+  /**
+   * 将外部连接（如多设备工位中的某一台）转换为设备信息并探测固件能力，
+   * 不改变本管理器自身的连接状态
+   */
+  async openHandle(handle: BurnerConnectionHandle): Promise<DeviceInfo> {
+    const device = this.toDeviceInfo(handle);
+    await this.detectCapabilities(device);
+    return device;
+  }
+
+  /**
+   * 探测固件能力描述；固件支持时以上报结果取代按串口信息推断的 profile
+   */
+  private async detectCapabilities(device: DeviceInfo): Promise<void> {
+    let transport = device.transport ?? device.serialHandle?.transport;
+    if (!transport) {
+      return;
+    }
+    // 会话轨迹记录在帧传输层之下，记录线路上的原始字节；是否记录由记录器开关决定
+    if (!(transport instanceof RecordingTransport) && !(transport instanceof FramedTransport)) {
+      transport = new RecordingTransport(transport);
+      device.transport = transport;
+      if (device.serialHandle) {
+        device.serialHandle.transport = transport;
+      }
+    }
+
+    const capabilities = await probeDeviceCapabilities(transport);
+    device.capabilities = capabilities;
+    if (device.serialHandle) {
+      device.serialHandle.capabilities = capabilities;
+    }
+
+    if (capabilities) {
+      attachFirmwareProfile(device, createFirmwareProfileFromCapabilities(capabilities));
+    }
+
+    const framedTransport = createFramedTransport(transport, capabilities);
+    if (framedTransport !== transport) {
+      device.transport = framedTransport;
+      if (device.serialHandle) {
+        device.serialHandle.transport = framedTransport;
+      }
+    }
+
+    console.info('[DeviceConnectionManager] device capabilities', capabilities
+      ? {
+        protocolVersion: capabilities.protocolVersion,
+        firmwareId: capabilities.firmwareId,
+        maxCommandSize: capabilities.maxCommandSize,
+        maxResponsePayload: capabilities.maxResponsePayload,
+        streamingCommand: capabilities.streamingCommand,
+        streamingResponse: capabilities.streamingResponse,
+        frameProtocol: capabilities.frameProtocol,
+        frameQueue: capabilities.frameQueue,
+        busClockHz: capabilities.busClockHz,
+        opcodes: [...capabilities.opcodes].map(opcode => `0x${opcode.toString(16)}`),
+      }
+      : 'not reported by firmware');
   }
 
   async listAvailablePorts(filter?: PortFilter): Promise<SerialPortInfo[]> {
@@ -303,6 +380,7 @@ export class DeviceConnectionManager {
         });
       }
     } finally {
+      invalidateSessionCartInfo(device);
       device.connection = null;
       device.port = null;
       device.transport = null;
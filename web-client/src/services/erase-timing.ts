@@ -0,0 +1,71 @@
+import type { FlashWaitSchedule } from '@/protocol';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+/** 超过本次擦除耗时中位数的该倍数即视为异常 */
+const OUTLIER_MEDIAN_RATIO = 3;
+/** 至少记录这么多扇区后才按中位数判断 */
+const OUTLIER_MIN_SAMPLES = 4;
+
+/**
+ * 由 CFI 标称的扇区擦除耗时生成轮询安排；CFI 未提供时返回 undefined，沿用固定间隔轮询
+ */
+export function sectorEraseSchedule(cfiInfo: CFIInfo | undefined): FlashWaitSchedule | undefined {
+  const typicalMs = cfiInfo?.sectorEraseTimeAvg;
+  const maxMs = cfiInfo?.sectorEraseTimeMax;
+  return typicalMs && maxMs ? { typicalMs, maxMs } : undefined;
+}
+
+/**
+ * 由 CFI 标称的整片擦除耗时生成轮询安排
+ */
+export function chipEraseSchedule(cfiInfo: CFIInfo | undefined): FlashWaitSchedule | undefined {
+  const typicalMs = cfiInfo?.chipEraseTimeAvg;
+  const maxMs = cfiInfo?.chipEraseTimeMax;
+  return typicalMs && maxMs ? { typicalMs, maxMs } : undefined;
+}
+
+export interface EraseTimingOutlier {
+  address: number;
+  elapsedMs: number;
+}
+
+/**
+ * 记录每个扇区的擦除耗时，找出明显慢于同批扇区或超过 CFI 最大值的扇区（通常是磨损的闪存）
+ */
+export class EraseTimingRecorder {
+  private readonly samples: EraseTimingOutlier[] = [];
+
+  constructor(private readonly cfiSchedule?: FlashWaitSchedule) {}
+
+  /**
+   * 下一个扇区的轮询安排：典型耗时取 CFI 标称值与本次实测中位数中较小者，
+   * 实际擦除比标称快的芯片不会白睡
+   */
+  get schedule(): FlashWaitSchedule | undefined {
+    if (!this.cfiSchedule || this.samples.length === 0) {
+      return this.cfiSchedule;
+    }
+    return { typicalMs: Math.min(this.cfiSchedule.typicalMs, this.medianMs), maxMs: this.cfiSchedule.maxMs };
+  }
+
+  record(address: number, elapsedMs: number): void {
+    this.samples.push({ address, elapsedMs });
+  }
+
+  /** 本次擦除耗时的中位数，ms */
+  get medianMs(): number {
+    if (this.samples.length === 0) {
+      return 0;
+    }
+    const sorted = this.samples.map(sample => sample.elapsedMs).sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+  }
+
+  outliers(): EraseTimingOutlier[] {
+    const medianLimit = this.samples.length >= OUTLIER_MIN_SAMPLES
+      ? this.medianMs * OUTLIER_MEDIAN_RATIO
+      : Infinity;
+    const limit = Math.min(medianLimit, this.cfiSchedule?.maxMs ?? Infinity);
+    return this.samples.filter(sample => sample.elapsedMs > limit);
+  }
+}
@@ -1,7 +1,9 @@
 ﻿import {
   FLASH_CMD_RESET,
+  type FlashWaitSchedule,
+  FramedTransport,
   GBA_ROM_FLASH_CMD_SET,
-  getFlashName,
+  GBACommand,
   ram_erase_flash,
   ram_program_flash,
   ram_read,
@@ -12,26 +14,33 @@
   rom_erase_sector,
   rom_get_id,
   rom_program,
+  rom_program_rle,
   rom_read,
+  rom_read_rle,
   rom_write,
   toLittleEndian,
 } from '@/protocol';
 import { CartridgeAdapter, LogCallback, ProgressCallback, TranslateFunction } from '@/services/cartridge-adapter';
+import { EraseTimingRecorder, sectorEraseSchedule } from '@/services/erase-timing';
 import type { PlatformOps } from '@/services/platform-ops';
+import { RomDumpBuffer } from '@/services/rom-dump-buffer';
 import { AdvancedSettings } from '@/settings/advanced-settings';
 import { CommandOptions } from '@/types/command-options';
 import { CommandResult } from '@/types/command-result';
+import { supportsOpcode } from '@/types/device-capabilities';
 import { DeviceInfo } from '@/types/device-info';
 import { firmwareUnsupportedResult, isRamTypeSupportedByFirmware } from '@/types/firmware-profile';
 import type { SectorProgressInfo } from '@/types/progress-info';
 import { timeout } from '@/utils/async-utils';
 import { errorToBurnerLog } from '@/utils/burner-log';
+import { packBitsEncode } from '@/utils/compression-utils';
 import { formatBytes, formatHex, formatSpeed, formatTimeDuration } from '@/utils/formatter-utils';
 import { PerformanceTracker } from '@/utils/monitoring/sentry-tracker';
-import { CFIInfo, parseCFI, SectorBlock } from '@/utils/parsers/cfi-parser';
+import { SectorBlock } from '@/utils/parsers/cfi-parser';
 import { ProgressReporter } from '@/utils/progress/progress-reporter';
 import { SpeedCalculator } from '@/utils/progress/speed-calculator';
-import { calcSectorUsage } from '@/utils/sector-utils';
+import { calcSectorUsage, createSectorProgressInfo, isErasedData, planSparseWrite } from '@/utils/sector-utils';
+import { VerifyMismatchCollector } from '@/utils/verify-utils';
 
 /**
  * GBA Adapter - 灏佽GBA鍗″甫鐨勫崗璁搷浣?
@@ -40,6 +49,8 @@ export class GBAAdapter extends CartridgeAdapter {
   private static readonly ROM_BANK_SIZE = 1 << 25;
   private static readonly RAM_BANK_SWITCH_SETTLE_MS = 100;
   private static readonly CHIP_ERASE_TIMEOUT_MS = 120_000;
+  // 与固件 RLE_READ_MAX 一致
+  private static readonly RLE_READ_MAX = 4096;
 
   /**
    * 鏋勯€犲嚱鏁?
@@ -62,11 +73,12 @@ export class GBAAdapter extends CartridgeAdapter {
       platformId: 'gba',
       flashCmdSet: {
         ...GBA_ROM_FLASH_CMD_SET,
-        read: (...args: Parameters<typeof rom_read>) => rom_read(...args),
+        read: (_device, size, addr) => this.readRomChunk(size, addr),
         write: (...args: Parameters<typeof rom_write>) => rom_write(...args),
       },
       cfiEntryAddress: 0x55,
-      romProgram: (device, data, addr, buf) => rom_program(device, data, addr, buf),
+      romCommands: { read: GBACommand.READ, program: GBACommand.PROGRAM },
+      romProgram: (_device, data, addr, buf) => this.programRomChunk(data, addr, buf),
       romEraseSector: (device, addr) => rom_erase_sector(device, addr),
       cfiGetId: (device) => rom_get_id(device),
       toRomBank: (address) => {
@@ -80,6 +92,34 @@ export class GBAAdapter extends CartridgeAdapter {
     };
   }
 
+  /**
+   * 编程一个 ROM 分块；固件支持 0xe4 且压缩后更小时以 PackBits 发送
+   */
+  private async programRomChunk(data: Uint8Array, cartAddress: number, bufferSize: number): Promise<void> {
+    if (supportsOpcode(this.device.capabilities, GBACommand.PROGRAM_RLE)) {
+      const encoded = packBitsEncode(data);
+      if (encoded.byteLength < data.byteLength) {
+        await rom_program_rle(this.transport, encoded, data.byteLength, cartAddress, bufferSize);
+        return;
+      }
+    }
+    await rom_program(this.transport, data, cartAddress, bufferSize);
+  }
+
+  /**
+   * 读取一个 ROM 分块；经 v2 帧传输且固件支持 0xe6 时由设备压缩响应
+   */
+  private async readRomChunk(size: number, cartAddress: number): Promise<Uint8Array> {
+    if (
+      size <= GBAAdapter.RLE_READ_MAX
+      && this.transport instanceof FramedTransport
+      && supportsOpcode(this.device.capabilities, GBACommand.READ_RLE)
+    ) {
+      return rom_read_rle(this.transport, size, cartAddress);
+    }
+    return rom_read(this.transport, size, cartAddress);
+  }
+
   private describeError(error: unknown): string {
     return error instanceof Error ? error.message : String(error);
   }
@@ -136,8 +176,9 @@ export class GBAAdapter extends CartridgeAdapter {
     sector: SectorProgressInfo,
     isMultiBank: boolean,
     reason: 'prepare' | 'recover',
+    schedule: FlashWaitSchedule | undefined,
     signal?: AbortSignal,
-  ): Promise<void> {
+  ): Promise<number> {
     const retries = AdvancedSettings.romEraseRetryCount;
     const attempts = retries + 1;
     const retryDelayMs = AdvancedSettings.romEraseRetryDelayMs;
@@ -153,8 +194,9 @@ export class GBAAdapter extends CartridgeAdapter {
         if (isMultiBank) {
           await this.switchROMBank(bank);
         }
-        await rom_erase_sector(this.transport, sector.address);
-        return;
+        const startTime = Date.now();
+        await rom_erase_sector(this.transport, sector.address, schedule);
+        return Date.now() - startTime;
       } catch (error) {
         lastError = error;
         this.log(
@@ -319,6 +361,9 @@ export class GBAAdapter extends CartridgeAdapter {
           // 鎶ュ憡寮€濮嬬姸鎬?
           progressReporter.reportStart(this.t('messages.operation.startEraseSectors'));
 
+          // 按 CFI 标称耗时安排轮询，并记录每个扇区的实际耗时
+          const eraseTiming = new EraseTimingRecorder(sectorEraseSchedule(options.cfiInfo));
+
           // 鎸夌収鍒涘缓鐨勬墖鍖洪『搴忚繘琛屾摝闄わ紙浠庨珮鍦板潃鍒颁綆鍦板潃锛?
           for (const sector of sectors) {
             // 妫€鏌ユ槸鍚﹀凡琚彇娑?
@@ -330,6 +375,13 @@ export class GBAAdapter extends CartridgeAdapter {
               };
             }
 
+            // 内容已与镜像一致的扇区保持原样
+            if (options.unchangedSectors?.has(sector.address)) {
+              progressReporter.markSectorState(sector.address, 'skipped_erase');
+              eraseCount++;
+              continue;
+            }
+
             // 鏇存柊褰撳墠鎵囧尯鐘舵€佷负"姝ｅ湪澶勭悊"
             const currentSpeedBeforeErase = speedCalculator.getCurrentSpeed();
             progressReporter.markSectorState(sector.address, 'erasing');
@@ -373,7 +425,8 @@ export class GBAAdapter extends CartridgeAdapter {
                 from: formatHex(sector.address, 4),
                 to: formatHex(sector.address + sector.size - 1, 4),
               }), 'info');
-              await this.eraseRomSectorWithRetry(sector, isMultiBank, 'prepare', signal);
+              const elapsedMs = await this.eraseRomSectorWithRetry(sector, isMultiBank, 'prepare', eraseTiming.schedule, signal);
+              eraseTiming.record(sector.address, elapsedMs);
             }
             const sectorEndTime = Date.now();
 
@@ -403,6 +456,7 @@ export class GBAAdapter extends CartridgeAdapter {
           const maxSpeed = speedCalculator.getMaxSpeed();
 
           this.log(this.t('messages.operation.eraseSuccess'), 'success');
+          this.logEraseOutliers(eraseTiming);
           this.log(this.t('messages.operation.eraseSummary', {
             totalTime: formatTimeDuration(totalTime),
             avgSpeed: formatSpeed(avgSpeed),
@@ -462,6 +516,7 @@ export class GBAAdapter extends CartridgeAdapter {
   override async writeROM(fileData: Uint8Array, options: CommandOptions, signal?: AbortSignal) : Promise<CommandResult> {
     const baseAddress = options.baseAddress ?? 0x00;
     const pageSize = this.resolveRomPageSize(options.romPageSize);
+    const stepSize = this.romStepSize(pageSize);
     const bufferSize = options.cfiInfo.bufferSize ?? 0;
     const isMultiBank = options.cfiInfo.deviceSize > GBAAdapter.ROM_BANK_SIZE;
 
@@ -479,9 +534,26 @@ export class GBAAdapter extends CartridgeAdapter {
           const total = options.size ?? fileData.byteLength;
           const wallClockStartTime = Date.now();
           let written = 0;
+          let programmed = 0;
           this.log(this.t('messages.rom.writing', { size: total }), 'info');
 
           const sectorInfo = calcSectorUsage(options.cfiInfo.eraseSectorBlocks, total, baseAddress);
+          const sparsePlan = planSparseWrite(
+            fileData,
+            createSectorProgressInfo(sectorInfo),
+            baseAddress,
+            total,
+            pageSize,
+            options.unchangedSectors,
+          );
+          const blankBytes = total - sparsePlan.programBytes - sparsePlan.unchangedBytes;
+          if (blankBytes > 0) {
+            this.log(this.t('messages.rom.sparseWrite', {
+              skipped: formatBytes(blankBytes),
+              blankSectors: sparsePlan.blankSectors,
+              totalSectors: sparsePlan.sectorProgramBytes.length,
+            }), 'info');
+          }
           const eraseStartTime = Date.now();
           const eraseResult = await this.eraseSectors(sectorInfo, options, signal, true);
           const eraseDuration = Date.now() - eraseStartTime;
@@ -489,15 +561,16 @@ export class GBAAdapter extends CartridgeAdapter {
             return eraseResult;
           }
 
-          this.currentSectorProgress = this.currentSectorProgress.map((sector) => ({
+          // 镜像中全为 0xFF 的扇区无需编程
+          this.currentSectorProgress = this.currentSectorProgress.map((sector, index) => ({
             ...sector,
-            state: 'pending' as const,
+            state: sparsePlan.sectorProgramBytes[index] === 0 ? 'skipped_write' as const : 'pending' as const,
           }));
           const sectors = this.currentSectorProgress;
           const speedCalculator = new SpeedCalculator();
           const progressReporter = new ProgressReporter(
             'write',
-            total,
+            sparsePlan.programBytes,
             (progressInfo) => { this.updateProgress(progressInfo); },
             (key, params) => this.t(key, params),
           );
@@ -531,7 +604,7 @@ export class GBAAdapter extends CartridgeAdapter {
             this.log(retryLog, 'warn');
 
             progressReporter.emitProgress(
-              written,
+              programmed,
               speedCalculator.getCurrentSpeed(),
               writeFailureMessage,
               sector.address,
@@ -550,7 +623,7 @@ export class GBAAdapter extends CartridgeAdapter {
             }
             progressReporter.markSectorState(sector.address, 'erasing');
             progressReporter.emitProgress(
-              written,
+              programmed,
               speedCalculator.getCurrentSpeed(),
               this.t('messages.operation.eraseSector', {
                 from: formatHex(sector.address, 4),
@@ -558,9 +631,10 @@ export class GBAAdapter extends CartridgeAdapter {
               }),
               sector.address,
             );
-            await this.eraseRomSectorWithRetry(sector, isMultiBank, 'recover', signal);
+            await this.eraseRomSectorWithRetry(sector, isMultiBank, 'recover', sectorEraseSchedule(options.cfiInfo), signal);
             progressReporter.markSectorState(sector.address, 'pending');
             written = sector.address - baseAddress;
+            programmed = sparsePlan.sectorProgramBytes.slice(0, sectorIndex).reduce((sum, bytes) => sum + bytes, 0);
             chunkCount = 0;
             currentBank = -1;
           };
@@ -581,12 +655,16 @@ export class GBAAdapter extends CartridgeAdapter {
             }
             const currentSector = sectors[currentSectorIndex];
             const sectorWriteEnd = Math.min(writeEndAddressExclusive, currentSector.address + currentSector.size);
+            if (sparsePlan.sectorProgramBytes[currentSectorIndex] === 0) {
+              written = sectorWriteEnd - baseAddress;
+              continue;
+            }
 
             const bankWindowRemaining = isMultiBank
               ? GBAAdapter.ROM_BANK_SIZE - (currentAddress & (GBAAdapter.ROM_BANK_SIZE - 1))
               : total - written;
             const chunkSize = Math.min(
-              pageSize,
+              stepSize,
               total - written,
               sectorWriteEnd - currentAddress,
               bankWindowRemaining,
@@ -596,11 +674,20 @@ export class GBAAdapter extends CartridgeAdapter {
               this.log(this.t('messages.rom.writeNoData'), 'warn');
               break;
             }
+            if (isErasedData(chunk)) {
+              // 扇区已擦除，0xFF 页无需编程
+              written += chunkSize;
+              if (written + baseAddress >= sectorWriteEnd) {
+                progressReporter.markSectorState(currentSector.address, 'completed');
+                await options.checkpoint?.commit(currentSector.address, currentSector.size);
+              }
+              continue;
+            }
 
             const currentSpeedBeforeWrite = speedCalculator.getCurrentSpeed();
             progressReporter.markSectorState(currentSector.address, 'processing');
             progressReporter.emitProgress(
-              written,
+              programmed,
               currentSpeedBeforeWrite,
               this.t('messages.progress.writeSpeed', { speed: formatSpeed(currentSpeedBeforeWrite) }),
               currentAddress,
@@ -614,19 +701,37 @@ export class GBAAdapter extends CartridgeAdapter {
               }
             }
 
+            let programmedBytes: number;
             try {
-              await rom_program(this.transport, chunk, cartAddress, bufferSize);
+              const sectorProgramBytes = sparsePlan.sectorProgramBytes[currentSectorIndex];
+              programmedBytes = await this.programROMSpan(chunk, cartAddress, pageSize, bufferSize, (processedBytes) => {
+                progressReporter.emitProgress(
+                  programmed + Math.round(sectorProgramBytes * processedBytes / chunk.byteLength),
+                  speedCalculator.getCurrentSpeed(),
+                  this.t('messages.progress.writeSpeed', { speed: formatSpeed(speedCalculator.getCurrentSpeed()) }),
+                  currentAddress + processedBytes,
+                );
+              }, signal);
             } catch (error) {
+              if (signal?.aborted) {
+                progressReporter.reportError(this.t('messages.operation.cancelled'));
+                return {
+                  success: false,
+                  message: this.t('messages.operation.cancelled'),
+                };
+              }
               await recoverSectorWrite(currentSectorIndex, error);
               continue;
             }
             const chunkEndTime = Date.now();
 
             written += chunkSize;
+            programmed += programmedBytes;
             chunkCount++;
 
             if (written + baseAddress >= sectorWriteEnd) {
               progressReporter.markSectorState(currentSector.address, 'completed');
+              await options.checkpoint?.commit(currentSector.address, currentSector.size);
             }
 
             speedCalculator.addDataPoint(chunkSize, chunkEndTime);
@@ -634,7 +739,7 @@ export class GBAAdapter extends CartridgeAdapter {
             if (chunkCount % 10 === 0 || written >= total || written + baseAddress >= sectorWriteEnd) {
               const currentSpeed = speedCalculator.getCurrentSpeed();
               progressReporter.emitProgress(
-                written,
+                programmed,
                 currentSpeed,
                 this.t('messages.progress.writeSpeed', { speed: formatSpeed(currentSpeed) }),
                 currentAddress,
@@ -711,7 +816,9 @@ export class GBAAdapter extends CartridgeAdapter {
    */
   override async readROM(size = 0x200000, options: CommandOptions, signal?: AbortSignal, showProgress = true) : Promise<CommandResult> {
     const baseAddress = options.baseAddress ?? 0x00;
-    const pageSize = this.resolveRomPageSize(options.romPageSize);
+    let pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
+    let stepSize = this.romStepSize(pageSize);
+    const tuner = this.createRomReadTuner(options.romPageSize, size);
     const readThrottleMs = AdvancedSettings.romReadThrottleMs;
     const retries = AdvancedSettings.romReadRetryCount;
     const retryDelayMs = AdvancedSettings.romReadRetryDelayMs;
@@ -746,7 +853,7 @@ export class GBAAdapter extends CartridgeAdapter {
           this.log(this.t('messages.rom.reading'), 'info');
           let totalRead = 0;
 
-          const data = new Uint8Array(size);
+          const buffer = new RomDumpBuffer(size, stepSize, options.dumpSink);
 
           // 浣跨敤閫熷害璁＄畻鍣?
           const speedCalculator = new SpeedCalculator();
@@ -778,8 +885,12 @@ export class GBAAdapter extends CartridgeAdapter {
               };
             }
 
-            const chunkSize = Math.min(pageSize, size - totalRead);
             const currentAddress = baseAddress + totalRead;
+            const chunkSize = Math.min(
+              stepSize,
+              size - totalRead,
+              GBAAdapter.ROM_BANK_SIZE - (currentAddress & (GBAAdapter.ROM_BANK_SIZE - 1)),
+            );
 
             // 璁＄畻bank鍜屽湴鍧€
             const { bank, cartAddress } = this.romBankRelevantAddress(currentAddress);
@@ -794,25 +905,37 @@ export class GBAAdapter extends CartridgeAdapter {
             const restoreState = options.cfiInfo.deviceSize > (1 << 25)
               ? async () => { await this.switchROMBank(bank); }
               : undefined;
-            const chunk = await this.readROMChunkWithRetry(
+            const chunk = buffer.chunk(totalRead, chunkSize);
+            await this.readROMChunkWithRetry(
               chunkSize,
               currentAddress,
               cartAddress,
               Math.floor(totalRead / pageSize) + 1,
               bank,
               restoreState,
+              { pageSize, signal },
+              chunk,
             );
+            await buffer.commit(chunk);
+            await options.checkpoint?.commit(currentAddress, chunkSize, chunk);
             const chunkEndTime = Date.now();
-            data.set(chunk, totalRead);
 
             totalRead += chunkSize;
             chunkCount++;
 
             // 娣诲姞鏁版嵁鐐瑰埌閫熷害璁＄畻鍣?
             speedCalculator.addDataPoint(chunkSize, chunkEndTime);
+            if (tuner?.tuning) {
+              tuner.record(chunkSize, chunkEndTime);
+              pageSize = tuner.pageSize;
+              stepSize = this.romStepSize(pageSize);
+              if (!tuner.tuning) {
+                this.logPageSizeTuned(tuner);
+              }
+            }
 
             // 姣?0娆℃搷浣滄垨鏈€鍚庝竴娆℃洿鏂拌繘搴?
-            if (chunkCount % 10 === 0 || totalRead >= size) {
+            if (chunkCount % 10 === 0 || chunkSize > pageSize || totalRead >= size) {
               // 璁＄畻褰撳墠閫熷害
               const currentSpeed = speedCalculator.getCurrentSpeed();
 
@@ -840,7 +963,7 @@ export class GBAAdapter extends CartridgeAdapter {
           const avgSpeed = speedCalculator.getAverageSpeed();
           const maxSpeed = speedCalculator.getMaxSpeed();
 
-          this.log(this.t('messages.rom.readSuccess', { size: data.length }), 'success');
+          this.log(this.t('messages.rom.readSuccess', { size }), 'success');
           this.log(this.t('messages.rom.readSummary', {
             totalTime: formatTimeDuration(totalTime),
             avgSpeed: formatSpeed(avgSpeed),
@@ -849,12 +972,12 @@ export class GBAAdapter extends CartridgeAdapter {
           }), 'info');
 
           // 鎶ュ憡瀹屾垚鐘舵€?
-          progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size: data.length }), avgSpeed);
+          progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size }), avgSpeed);
 
           return {
             success: true,
-            data: data,
-            message: this.t('messages.rom.readSuccess', { size: data.length }),
+            data: buffer.data,
+            message: this.t('messages.rom.readSuccess', { size }),
           };
         } catch (e) {
           const progressReporter = new ProgressReporter(
@@ -864,6 +987,13 @@ export class GBAAdapter extends CartridgeAdapter {
             (key, params) => this.t(key, params),
             showProgress,
           );
+          if (signal?.aborted) {
+            progressReporter.reportError(this.t('messages.operation.cancelled'));
+            return {
+              success: false,
+              message: this.t('messages.operation.cancelled'),
+            };
+          }
           progressReporter.reportError(this.t('messages.rom.readFailed'));
           this.log(errorToBurnerLog(this.t('messages.rom.readFailed'), e), 'error');
           return {
@@ -891,7 +1021,8 @@ export class GBAAdapter extends CartridgeAdapter {
    */
   override async verifyROM(fileData: Uint8Array, options: CommandOptions, signal?: AbortSignal): Promise<CommandResult> {
     const baseAddress = options.baseAddress ?? 0;
-    const pageSize = this.resolveRomPageSize(options.romPageSize);
+    const pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
+    const stepSize = this.romStepSize(pageSize);
     const readThrottleMs = AdvancedSettings.romReadThrottleMs;
 
     this.log(this.t('messages.operation.startVerifyROM', {
@@ -939,8 +1070,6 @@ export class GBAAdapter extends CartridgeAdapter {
             }), 'warn');
           }
           let verified = 0;
-          let success = true;
-          let failedAddress = -1;
           let lastLoggedProgress = -1; // 鍒濆鍖栦负-1锛岀‘淇濈涓€娆?%浼氳璁板綍
           let currentBank = -1;
           let activeSectorIndex = -1;
@@ -950,6 +1079,10 @@ export class GBAAdapter extends CartridgeAdapter {
           // 鍒濆鍖栨墖鍖鸿繘搴︿俊鎭?(鐢ㄤ簬鏄剧ず鏍￠獙杩涘害鍙鍖?
           const sectorInfo = calcSectorUsage(options.cfiInfo.eraseSectorBlocks, total, baseAddress);
           const sectors = this.initializeSectorProgress(sectorInfo);
+          const mismatches = new VerifyMismatchCollector(sectors);
+          // 有差异的扇区保持错误状态
+          const sectorState = (address: number, state: 'processing' | 'completed') =>
+            mismatches.sectorMismatches(address) > 0 ? 'error' as const : state;
 
           // 浣跨敤閫熷害璁＄畻鍣?
           const speedCalculator = new SpeedCalculator();
@@ -968,7 +1101,7 @@ export class GBAAdapter extends CartridgeAdapter {
 
           // 鍒嗗潡鏍￠獙骞舵洿鏂拌繘搴?
           let chunkCount = 0; // 璁板綍宸插鐞嗙殑鍧楁暟
-          while (verified < total && success) {
+          while (verified < total) {
             // 妫€鏌ユ槸鍚﹀凡琚彇娑?
             if (signal?.aborted) {
               progressReporter.reportError(this.t('messages.operation.cancelled'));
@@ -978,7 +1111,6 @@ export class GBAAdapter extends CartridgeAdapter {
               };
             }
 
-            const chunkSize = Math.min(pageSize, total - verified);
             const currentAddress = baseAddress + verified;
 
             while (
@@ -988,8 +1120,22 @@ export class GBAAdapter extends CartridgeAdapter {
               activeSectorIndex++;
             }
 
+            // 跨度不越过当前扇区，校验失败时扇区标记仍然准确
+            const activeSectorEnd = activeSectorIndex >= 0
+              ? sectors[activeSectorIndex].address + sectors[activeSectorIndex].size
+              : baseAddress + total;
+            const chunkSize = Math.min(
+              stepSize,
+              total - verified,
+              Math.max(activeSectorEnd - currentAddress, pageSize),
+              GBAAdapter.ROM_BANK_SIZE - (currentAddress & (GBAAdapter.ROM_BANK_SIZE - 1)),
+            );
+
             const enteredNewSector = activeSectorIndex >= 0
-              && progressReporter.markSectorState(sectors[activeSectorIndex].address, 'processing') >= 0
+              && progressReporter.markSectorState(
+                sectors[activeSectorIndex].address,
+                sectorState(sectors[activeSectorIndex].address, 'processing'),
+              ) >= 0
               && (verified === 0 || verified === sectors[activeSectorIndex].address - baseAddress);
 
             if (enteredNewSector) {
@@ -1021,30 +1167,29 @@ export class GBAAdapter extends CartridgeAdapter {
               Math.floor(verified / pageSize) + 1,
               bank,
               restoreState,
+              { pageSize, signal },
             );
             const chunkEndTime = Date.now();
 
-            // 閫愬瓧鑺傛瘮杈?
-            for (let i = 0; i < chunkSize; i++) {
-              const expectedByte = fileData[verified + i];
-              const actualByte = actualChunk[i];
-              if (expectedByte !== actualByte) {
-                success = false;
-                failedAddress = verified + i;
+            // 按字比较并记录全部差异，不在第一个差异处停止，一次校验得到完整的损坏分布
+            const chunkMismatches = mismatches.compare(
+              fileData.subarray(verified, verified + chunkSize),
+              actualChunk.subarray(0, chunkSize),
+              currentAddress,
+            );
+            if (chunkMismatches > 0) {
+              if (mismatches.first && mismatches.mismatchCount === chunkMismatches) {
                 this.log(this.t('messages.rom.verifyFailedAt', {
-                  address: formatHex(failedAddress, 4),
-                  expected: formatHex(expectedByte, 1),
-                  actual: formatHex(actualByte, 1),
+                  address: formatHex(mismatches.first.address, 4),
+                  expected: formatHex(mismatches.first.expected, 1),
+                  actual: formatHex(mismatches.first.actual, 1),
                 }), 'error');
-                if (activeSectorIndex >= 0) {
-                  progressReporter.markSectorState(sectors[activeSectorIndex].address, 'error');
-                }
-                break;
+              }
+              if (activeSectorIndex >= 0) {
+                progressReporter.markSectorState(sectors[activeSectorIndex].address, 'error');
               }
             }
 
-            if (!success) break;
-
             verified += chunkSize;
             chunkCount++;
 
@@ -1057,14 +1202,14 @@ export class GBAAdapter extends CartridgeAdapter {
               }
 
               completedSectorIndex++;
-              progressReporter.markSectorState(nextSector.address, 'completed');
+              progressReporter.markSectorState(nextSector.address, sectorState(nextSector.address, 'completed'));
             }
 
             // 娣诲姞鏁版嵁鐐瑰埌閫熷害璁＄畻鍣?
             speedCalculator.addDataPoint(chunkSize, chunkEndTime);
 
             // 姣?0娆℃搷浣滄垨鏈€鍚庝竴娆℃洿鏂拌繘搴?
-            if (chunkCount % 10 === 0 || verified >= total) {
+            if (chunkCount % 10 === 0 || chunkSize > pageSize || verified >= total) {
               // 璁＄畻褰撳墠閫熷害
               const currentSpeed = speedCalculator.getCurrentSpeed();
 
@@ -1096,12 +1241,14 @@ export class GBAAdapter extends CartridgeAdapter {
           const avgSpeed = speedCalculator.getAverageSpeed();
           const maxSpeed = speedCalculator.getMaxSpeed();
 
-          if (success) {
-            while (completedSectorIndex + 1 < sectors.length) {
-              completedSectorIndex++;
-              progressReporter.markSectorState(sectors[completedSectorIndex].address, 'completed');
-            }
+          while (completedSectorIndex + 1 < sectors.length) {
+            completedSectorIndex++;
+            const sectorAddress = sectors[completedSectorIndex].address;
+            progressReporter.markSectorState(sectorAddress, sectorState(sectorAddress, 'completed'));
+          }
 
+          const success = mismatches.mismatchCount === 0;
+          if (success) {
             this.log(this.t('messages.rom.verifySuccess'), 'success');
             this.log(this.t('messages.rom.verifySummary', {
               totalTime: formatTimeDuration(totalTime),
@@ -1113,6 +1260,7 @@ export class GBAAdapter extends CartridgeAdapter {
             // 鎶ュ憡瀹屾垚鐘舵€?
             progressReporter.reportCompleted(this.t('messages.rom.verifySuccess'), avgSpeed);
           } else {
+            this.logVerifyMismatches(mismatches);
             this.log(this.t('messages.rom.verifyFailed'), 'error');
             progressReporter.reportError(this.t('messages.rom.verifyFailed'));
           }
@@ -1129,6 +1277,13 @@ export class GBAAdapter extends CartridgeAdapter {
             (progressInfo) => { this.updateProgress(progressInfo); },
             (key, params) => this.t(key, params),
           );
+          if (signal?.aborted) {
+            progressReporter.reportError(this.t('messages.operation.cancelled'));
+            return {
+              success: false,
+              message: this.t('messages.operation.cancelled'),
+            };
+          }
           progressReporter.reportError(this.t('messages.rom.verifyFailed'));
           this.log(errorToBurnerLog(this.t('messages.rom.verifyFailed'), e), 'error');
           return {
@@ -1301,7 +1456,7 @@ export class GBAAdapter extends CartridgeAdapter {
   override async readRAM(size = 0x8000, options: CommandOptions) {
     const baseAddress = options.baseAddress ?? 0x00;
     const ramType = options.ramType ?? 'SRAM';
-    const pageSize = this.resolveRamPageSize(options.ramPageSize);
+    const pageSize = this.resolveRamPageSize(options.ramPageSize, 'read');
     const readThrottleMs = AdvancedSettings.ramReadThrottleMs;
 
     if (!isRamTypeSupportedByFirmware(this.firmwareProfile, 'gba', ramType)) {
@@ -1523,59 +1678,6 @@ export class GBAAdapter extends CartridgeAdapter {
     );
   }
 
-  /**
-   * 鑾峰彇鍗″甫淇℃伅
-   * @returns 鍗″甫瀹归噺鐩稿叧淇℃伅
-   */
-  override async getCartInfo(): Promise<CFIInfo | false> {
-    this.log(this.t('messages.operation.startGetCartInfo'), 'info');
-
-    return PerformanceTracker.trackAsyncOperation(
-      'gba.getCartInfo',
-      async () => {
-        try {
-          // CFI Query
-          await rom_write(this.transport, toLittleEndian(0x98, 2), 0x55);
-          const cfiData = await rom_read(this.transport, 0x100, 0x00);
-          // Reset
-          await rom_write(this.transport, toLittleEndian(0xf0, 2), 0x00);
-
-          const cfiInfo = parseCFI(cfiData);
-
-          if (!cfiInfo) {
-            this.log(this.t('messages.operation.cfiParseFailed'), 'error');
-            return false;
-          }
-
-          // 璇诲彇Flash ID骞舵坊鍔犲埌CFI淇℃伅涓?
-          try {
-            const flashId = await rom_get_id(this.transport);
-            cfiInfo.flashId = flashId;
-            const idStr = Array.from(flashId).map(x => x.toString(16).padStart(2, '0')).join(' ');
-            const flashName = getFlashName([...flashId]);
-            this.log(`Flash ID: ${idStr} (${flashName})`, 'info');
-          } catch (e) {
-            this.log(errorToBurnerLog(this.t('messages.operation.readIdFailed'), e), 'warn');
-            // 鍗充娇Flash ID璇诲彇澶辫触锛屼篃缁х画杩斿洖CFI淇℃伅
-          }
-
-          // 璁板綍CFI瑙ｆ瀽缁撴灉
-          this.log(this.t('messages.operation.cfiParseSuccess'), 'success');
-          this.log(cfiInfo.info, 'info');
-
-          return cfiInfo;
-        } catch (e) {
-          this.log(errorToBurnerLog(this.t('messages.operation.romSizeQueryFailed'), e), 'error');
-          return false;
-        }
-      },
-      {
-        adapter_type: 'gba',
-        operation_type: 'get_cart_info',
-      },
-    );
-  }
-
   /**
    * ROM Bank 鍒囨崲
    */
@@ -1636,7 +1738,7 @@ export class GBAAdapter extends CartridgeAdapter {
   private async readROMChunked(size: number, baseAddress: number, chunkSize: number): Promise<Uint8Array> {
     if (size <= chunkSize) {
       // 鍗曟璇诲彇
-      return await rom_read(this.transport, size, baseAddress);
+      return await this.readRomChunk(size, baseAddress);
     } else {
       // 鍒嗗潡璇诲彇
       const result = new Uint8Array(size);
@@ -1644,7 +1746,7 @@ export class GBAAdapter extends CartridgeAdapter {
 
       while (offset < size) {
         const currentChunkSize = Math.min(chunkSize, size - offset);
-        const chunkData = await rom_read(this.transport, currentChunkSize, baseAddress + offset);
+        const chunkData = await this.readRomChunk(currentChunkSize, baseAddress + offset);
         result.set(chunkData, offset);
         offset += currentChunkSize;
       }
@@ -1827,7 +1929,7 @@ export class GBAAdapter extends CartridgeAdapter {
             }
 
             // 鍐欏叆鏁版嵁
-            await rom_program(this.transport, chunk, currentAddress, cfiInfo.bufferSize ?? 0);
+            await this.programRomChunk(chunk, currentAddress, cfiInfo.bufferSize ?? 0);
             const chunkEndTime = Date.now();
 
             written += chunkSize;
@@ -1919,7 +2021,7 @@ export class GBAAdapter extends CartridgeAdapter {
           const data = new Uint8Array(saveInfo.size);
           let readCount = 0;
           let currentBank = -1;
-          const pageSize = this.resolveRomPageSize(options.romPageSize);
+          const pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
 
           const speedCalculator = new SpeedCalculator();
 
@@ -1942,7 +2044,7 @@ export class GBAAdapter extends CartridgeAdapter {
             }
 
             // 璇诲彇鏁版嵁
-            const chunk = await rom_read(this.transport, chunkSize, currentAddress);
+            const chunk = await this.readRomChunk(chunkSize, currentAddress);
             const chunkEndTime = Date.now();
             data.set(chunk, readCount);
 
@@ -1,6 +1,7 @@
 ﻿import {
   cart_power,
   FLASH_CMD_RESET,
+  type FlashWaitSchedule,
   GBC_FLASH_CMD_SET,
   gbc_read,
   gbc_read_fram,
@@ -10,10 +11,14 @@
   gbc_rom_program,
   gbc_write,
   gbc_write_fram,
-  getFlashName,
+  GBCCommand,
+  rom_read_native,
   setSignals,
 } from '@/protocol';
+import { invalidateSessionCartInfo } from '@/services/cart-info-cache';
 import { CartridgeAdapter, LogCallback, ProgressCallback, TranslateFunction } from '@/services/cartridge-adapter';
+import { chipEraseSchedule, EraseTimingRecorder, sectorEraseSchedule } from '@/services/erase-timing';
+import { RomDumpBuffer } from '@/services/rom-dump-buffer';
 import { AdvancedSettings } from '@/settings/advanced-settings';
 import { CommandOptions, MbcType } from '@/types/command-options';
 import { CommandResult } from '@/types/command-result';
@@ -24,10 +29,11 @@ import { timeout } from '@/utils/async-utils';
 import { errorToBurnerLog } from '@/utils/burner-log';
 import { formatBytes, formatHex, formatSpeed, formatTimeDuration } from '@/utils/formatter-utils';
 import { PerformanceTracker } from '@/utils/monitoring/sentry-tracker';
-import { CFIInfo, parseCFI, SectorBlock } from '@/utils/parsers/cfi-parser';
+import { CFIInfo, SectorBlock } from '@/utils/parsers/cfi-parser';
 import { ProgressReporter } from '@/utils/progress/progress-reporter';
 import { SpeedCalculator } from '@/utils/progress/speed-calculator';
-import { calcSectorUsage } from '@/utils/sector-utils';
+import { calcSectorUsage, createSectorProgressInfo, isErasedData, planSparseWrite } from '@/utils/sector-utils';
+import { VerifyMismatchCollector } from '@/utils/verify-utils';
 
 import type { PlatformOps } from './platform-ops';
 
@@ -62,6 +68,7 @@ export class MBC5Adapter extends CartridgeAdapter {
         write: (...args: Parameters<typeof gbc_write>) => gbc_write(...args),
       },
       cfiEntryAddress: 0xaa,
+      romCommands: { read: GBCCommand.READ, program: GBCCommand.ROM_PROGRAM },
       romProgram: (device, data, addr, buf) => gbc_rom_program(device, data, addr, buf),
       romEraseSector: (device, addr) => gbc_rom_erase_sector(device, addr),
       cfiGetId: (device) => gbc_rom_get_id(device),
@@ -110,6 +117,8 @@ export class MBC5Adapter extends CartridgeAdapter {
 
   private async setCartPower(mode: 0 | 1 | 2): Promise<void> {
     await cart_power(this.transport, mode);
+    // 卡带重新上电后可能已被更换
+    invalidateSessionCartInfo(this.device);
     await this.pulseSignals();
   }
 
@@ -197,8 +206,9 @@ export class MBC5Adapter extends CartridgeAdapter {
     sector: SectorProgressInfo,
     mbcType: MbcType,
     reason: 'prepare' | 'recover',
+    schedule: FlashWaitSchedule | undefined,
     signal?: AbortSignal,
-  ): Promise<void> {
+  ): Promise<number> {
     const retries = AdvancedSettings.romEraseRetryCount;
     const attempts = retries + 1;
     const retryDelayMs = AdvancedSettings.romEraseRetryDelayMs;
@@ -212,8 +222,9 @@ export class MBC5Adapter extends CartridgeAdapter {
       try {
         const { bank, cartAddress } = this.romBankRelevantAddress(sector.address, mbcType);
         await this.switchROMBank(bank, mbcType);
-        await gbc_rom_erase_sector(this.transport, cartAddress);
-        return;
+        const startTime = Date.now();
+        await gbc_rom_erase_sector(this.transport, cartAddress, schedule);
+        return Date.now() - startTime;
       } catch (error) {
         lastError = error;
         this.log(
@@ -459,7 +470,7 @@ export class MBC5Adapter extends CartridgeAdapter {
             // 鑾峰彇鎿﹂櫎瓒呮椂鏃堕棿
             const eraseTimeoutMs = this.calculateEraseTimeout(options.cfiInfo);
 
-            await gbc_rom_erase_chip(this.transport);
+            await gbc_rom_erase_chip(this.transport, chipEraseSchedule(options.cfiInfo));
 
             const startTime = Date.now();
             let elapsedMilliseconds = 0;
@@ -589,6 +600,9 @@ export class MBC5Adapter extends CartridgeAdapter {
             // 鎶ュ憡寮€濮嬬姸鎬?
             progressReporter.reportStart(this.t('messages.operation.startEraseSectors'));
 
+            // 按 CFI 标称耗时安排轮询，并记录每个扇区的实际耗时
+            const eraseTiming = new EraseTimingRecorder(sectorEraseSchedule(options.cfiInfo));
+
             // 鎸夌収鍒涘缓鐨勬墖鍖洪『搴忚繘琛屾摝闄わ紙浠庨珮鍦板潃鍒颁綆鍦板潃锛?
             for (const sector of sectors) {
               // 妫€鏌ユ槸鍚﹀凡琚彇娑?
@@ -600,6 +614,13 @@ export class MBC5Adapter extends CartridgeAdapter {
                 };
               }
 
+              // 内容已与镜像一致的扇区保持原样
+              if (options.unchangedSectors?.has(sector.address)) {
+                progressReporter.markSectorState(sector.address, 'skipped_erase');
+                eraseCount++;
+                continue;
+              }
+
               // 鏇存柊褰撳墠鎵囧尯鐘舵€佷负"姝ｅ湪澶勭悊"
               const currentSpeedBeforeErase = speedCalculator.getCurrentSpeed();
               progressReporter.markSectorState(sector.address, 'erasing');
@@ -637,7 +658,8 @@ export class MBC5Adapter extends CartridgeAdapter {
                   from: formatHex(sector.address, 4),
                   to: formatHex(sector.address + sector.size - 1, 4),
                 }), 'info');
-                await this.eraseRomSectorWithRetry(sector, mbcType, 'prepare', signal);
+                const elapsedMs = await this.eraseRomSectorWithRetry(sector, mbcType, 'prepare', eraseTiming.schedule, signal);
+                eraseTiming.record(sector.address, elapsedMs);
               }
               const sectorEndTime = Date.now();
 
@@ -667,6 +689,7 @@ export class MBC5Adapter extends CartridgeAdapter {
             const maxSpeed = speedCalculator.getMaxSpeed();
 
             this.log(this.t('messages.operation.eraseSuccess'), 'success');
+            this.logEraseOutliers(eraseTiming);
             this.log(this.t('messages.operation.eraseSummary', {
               totalTime: formatTimeDuration(totalTime),
               avgSpeed: formatSpeed(avgSpeed),
@@ -734,6 +757,7 @@ export class MBC5Adapter extends CartridgeAdapter {
     const enable5V = options.enable5V ?? false;
     const baseAddress = options.baseAddress ?? 0x00;
     const pageSize = this.resolveRomPageSize(options.romPageSize);
+    const stepSize = this.romStepSize(pageSize);
     const bufferSize = options.cfiInfo.bufferSize ?? 0;
 
     this.log(this.t('messages.operation.startWriteROM', {
@@ -751,9 +775,26 @@ export class MBC5Adapter extends CartridgeAdapter {
             const total = options.size ?? fileData.byteLength;
             const wallClockStartTime = Date.now();
             let written = 0;
+            let programmed = 0;
             this.log(this.t('messages.rom.writing', { size: total }), 'info');
 
             const sectorInfo = calcSectorUsage(options.cfiInfo.eraseSectorBlocks, total, baseAddress);
+            const sparsePlan = planSparseWrite(
+              fileData,
+              createSectorProgressInfo(sectorInfo),
+              baseAddress,
+              total,
+              pageSize,
+              options.unchangedSectors,
+            );
+            const blankBytes = total - sparsePlan.programBytes - sparsePlan.unchangedBytes;
+            if (blankBytes > 0) {
+              this.log(this.t('messages.rom.sparseWrite', {
+                skipped: formatBytes(blankBytes),
+                blankSectors: sparsePlan.blankSectors,
+                totalSectors: sparsePlan.sectorProgramBytes.length,
+              }), 'info');
+            }
             const eraseStartTime = Date.now();
             const eraseResult = await this.eraseSectors(sectorInfo, options, signal, true);
             const eraseDuration = Date.now() - eraseStartTime;
@@ -761,15 +802,16 @@ export class MBC5Adapter extends CartridgeAdapter {
               return eraseResult;
             }
 
-            this.currentSectorProgress = this.currentSectorProgress.map((sector) => ({
+            // 镜像中全为 0xFF 的扇区无需编程
+            this.currentSectorProgress = this.currentSectorProgress.map((sector, index) => ({
               ...sector,
-              state: 'pending' as const,
+              state: sparsePlan.sectorProgramBytes[index] === 0 ? 'skipped_write' as const : 'pending' as const,
             }));
             const sectors = this.currentSectorProgress;
             const speedCalculator = new SpeedCalculator();
             const progressReporter = new ProgressReporter(
               'write',
-              total,
+              sparsePlan.programBytes,
               (progressInfo) => { this.updateProgress(progressInfo); },
               (key, params) => this.t(key, params),
             );
@@ -803,7 +845,7 @@ export class MBC5Adapter extends CartridgeAdapter {
               this.log(retryLog, 'warn');
 
               progressReporter.emitProgress(
-                written,
+                programmed,
                 speedCalculator.getCurrentSpeed(),
                 writeFailureMessage,
                 sector.address,
@@ -822,7 +864,7 @@ export class MBC5Adapter extends CartridgeAdapter {
               }
               progressReporter.markSectorState(sector.address, 'erasing');
               progressReporter.emitProgress(
-                written,
+                programmed,
                 speedCalculator.getCurrentSpeed(),
                 this.t('messages.operation.eraseSector', {
                   from: formatHex(sector.address, 4),
@@ -830,9 +872,10 @@ export class MBC5Adapter extends CartridgeAdapter {
                 }),
                 sector.address,
               );
-              await this.eraseRomSectorWithRetry(sector, mbcType, 'recover', signal);
+              await this.eraseRomSectorWithRetry(sector, mbcType, 'recover', sectorEraseSchedule(options.cfiInfo), signal);
               progressReporter.markSectorState(sector.address, 'pending');
               written = sector.address - baseAddress;
+              programmed = sparsePlan.sectorProgramBytes.slice(0, sectorIndex).reduce((sum, bytes) => sum + bytes, 0);
               chunkCount = 0;
               currentBank = -1;
             };
@@ -853,10 +896,14 @@ export class MBC5Adapter extends CartridgeAdapter {
               }
               const currentSector = sectors[currentSectorIndex];
               const sectorWriteEnd = Math.min(writeEndAddressExclusive, currentSector.address + currentSector.size);
+              if (sparsePlan.sectorProgramBytes[currentSectorIndex] === 0) {
+                written = sectorWriteEnd - baseAddress;
+                continue;
+              }
 
               const bankWindowRemaining = 0x4000 - (currentAddress & 0x3fff);
               const chunkSize = Math.min(
-                pageSize,
+                stepSize,
                 total - written,
                 sectorWriteEnd - currentAddress,
                 bankWindowRemaining,
@@ -866,11 +913,20 @@ export class MBC5Adapter extends CartridgeAdapter {
                 this.log(this.t('messages.rom.writeNoData'), 'warn');
                 break;
               }
+              if (isErasedData(chunk)) {
+                // 扇区已擦除，0xFF 页无需编程
+                written += chunkSize;
+                if (written + baseAddress >= sectorWriteEnd) {
+                  progressReporter.markSectorState(currentSector.address, 'completed');
+                  await options.checkpoint?.commit(currentSector.address, currentSector.size);
+                }
+                continue;
+              }
 
               const currentSpeedBeforeWrite = speedCalculator.getCurrentSpeed();
               progressReporter.markSectorState(currentSector.address, 'processing');
               progressReporter.emitProgress(
-                written,
+                programmed,
                 currentSpeedBeforeWrite,
                 this.t('messages.progress.writeSpeed', { speed: formatSpeed(currentSpeedBeforeWrite) }),
                 currentAddress,
@@ -882,19 +938,37 @@ export class MBC5Adapter extends CartridgeAdapter {
                 await this.switchROMBank(bank, mbcType);
               }
 
+              let programmedBytes: number;
               try {
-                await gbc_rom_program(this.transport, chunk, cartAddress, bufferSize);
+                const sectorProgramBytes = sparsePlan.sectorProgramBytes[currentSectorIndex];
+                programmedBytes = await this.programROMSpan(chunk, cartAddress, pageSize, bufferSize, (processedBytes) => {
+                  progressReporter.emitProgress(
+                    programmed + Math.round(sectorProgramBytes * processedBytes / chunk.byteLength),
+                    speedCalculator.getCurrentSpeed(),
+                    this.t('messages.progress.writeSpeed', { speed: formatSpeed(speedCalculator.getCurrentSpeed()) }),
+                    currentAddress + processedBytes,
+                  );
+                }, signal);
               } catch (error) {
+                if (signal?.aborted) {
+                  progressReporter.reportError(this.t('messages.operation.cancelled'));
+                  return {
+                    success: false,
+                    message: this.t('messages.operation.cancelled'),
+                  };
+                }
                 await recoverSectorWrite(currentSectorIndex, error);
                 continue;
               }
               const chunkEndTime = Date.now();
 
               written += chunkSize;
+              programmed += programmedBytes;
               chunkCount++;
 
               if (written + baseAddress >= sectorWriteEnd) {
                 progressReporter.markSectorState(currentSector.address, 'completed');
+                await options.checkpoint?.commit(currentSector.address, currentSector.size);
               }
 
               speedCalculator.addDataPoint(chunkSize, chunkEndTime);
@@ -902,7 +976,7 @@ export class MBC5Adapter extends CartridgeAdapter {
               if (chunkCount % 10 === 0 || written >= total || written + baseAddress >= sectorWriteEnd) {
                 const currentSpeed = speedCalculator.getCurrentSpeed();
                 progressReporter.emitProgress(
-                  written,
+                  programmed,
                   currentSpeed,
                   this.t('messages.progress.writeSpeed', { speed: formatSpeed(currentSpeed) }),
                   currentAddress,
@@ -987,7 +1061,9 @@ export class MBC5Adapter extends CartridgeAdapter {
     const mbcType = options.mbcType ?? 'MBC5';
     const enable5V = options.enable5V ?? false;
     const baseAddress = options.baseAddress ?? 0x00;
-    const pageSize = this.resolveRomPageSize(options.romPageSize);
+    let pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
+    let stepSize = this.romStepSize(pageSize);
+    const tuner = this.createRomReadTuner(options.romPageSize, size);
     const retries = AdvancedSettings.romReadRetryCount;
     const retryDelayMs = AdvancedSettings.romReadRetryDelayMs;
     const timeoutMs = AdvancedSettings.packageReceiveTimeout;
@@ -1022,7 +1098,7 @@ export class MBC5Adapter extends CartridgeAdapter {
             this.log(this.t('messages.rom.reading'), 'info');
             let totalRead = 0;
 
-            const data = new Uint8Array(size);
+            const buffer = new RomDumpBuffer(size, stepSize, options.dumpSink);
 
             // 浣跨敤閫熷害璁＄畻鍣?
             const speedCalculator = new SpeedCalculator();
@@ -1054,8 +1130,8 @@ export class MBC5Adapter extends CartridgeAdapter {
                 };
               }
 
-              const chunkSize = Math.min(pageSize, size - totalRead);
               const currentAddress = baseAddress + totalRead;
+              const chunkSize = Math.min(stepSize, size - totalRead, 0x4000 - (currentAddress & 0x3fff));
 
               // 璁＄畻bank鍜屽湴鍧€
               const { bank, cartAddress } = this.romBankRelevantAddress(currentAddress, mbcType);
@@ -1065,22 +1141,34 @@ export class MBC5Adapter extends CartridgeAdapter {
               }
 
               // 璇诲彇鏁版嵁
-              const chunk = await this.readROMChunkWithRetry(
+              const chunk = buffer.chunk(totalRead, chunkSize);
+              await this.readROMChunkWithRetry(
                 chunkSize,
                 currentAddress,
                 cartAddress,
                 Math.floor(totalRead / pageSize) + 1,
                 bank,
                 async () => { await this.switchROMBank(bank, mbcType); },
+                { pageSize, signal },
+                chunk,
               );
+              await buffer.commit(chunk);
+              await options.checkpoint?.commit(currentAddress, chunkSize, chunk);
               const chunkEndTime = Date.now();
-              data.set(chunk, totalRead);
 
               totalRead += chunkSize;
               chunkCount++;
 
               // 娣诲姞鏁版嵁鐐瑰埌閫熷害璁＄畻鍣?
               speedCalculator.addDataPoint(chunkSize, chunkEndTime);
+              if (tuner?.tuning) {
+                tuner.record(chunkSize, chunkEndTime);
+                pageSize = tuner.pageSize;
+                stepSize = this.romStepSize(pageSize);
+                if (!tuner.tuning) {
+                  this.logPageSizeTuned(tuner);
+                }
+              }
 
               // 姣?0娆℃搷浣滄垨鏈€鍚庝竴娆℃洿鏂拌繘搴?
               if (chunkCount % 10 === 0 || totalRead >= size) {
@@ -1107,7 +1195,7 @@ export class MBC5Adapter extends CartridgeAdapter {
             const avgSpeed = speedCalculator.getAverageSpeed();
             const maxSpeed = speedCalculator.getMaxSpeed();
 
-            this.log(this.t('messages.rom.readSuccess', { size: data.length }), 'success');
+            this.log(this.t('messages.rom.readSuccess', { size }), 'success');
             this.log(this.t('messages.rom.readSummary', {
               totalTime: formatTimeDuration(totalTime),
               avgSpeed: formatSpeed(avgSpeed),
@@ -1116,12 +1204,12 @@ export class MBC5Adapter extends CartridgeAdapter {
             }), 'info');
 
             // 鎶ュ憡瀹屾垚鐘舵€?
-            progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size: data.length }), avgSpeed);
+            progressReporter.reportCompleted(this.t('messages.rom.readSuccess', { size }), avgSpeed);
 
             return {
               success: true,
-              data: data,
-              message: this.t('messages.rom.readSuccess', { size: data.length }),
+              data: buffer.data,
+              message: this.t('messages.rom.readSuccess', { size }),
             };
           });
         } catch (e) {
@@ -1132,6 +1220,13 @@ export class MBC5Adapter extends CartridgeAdapter {
             (key, params) => this.t(key, params),
             showProgress,
           );
+          if (signal?.aborted) {
+            progressReporter.reportError(this.t('messages.operation.cancelled'));
+            return {
+              success: false,
+              message: this.t('messages.operation.cancelled'),
+            };
+          }
           progressReporter.reportError(this.t('messages.rom.readFailed'));
           this.log(errorToBurnerLog(this.t('messages.rom.readFailed'), e), 'error');
           return {
@@ -1165,7 +1260,8 @@ export class MBC5Adapter extends CartridgeAdapter {
 
     const mbcType = options.mbcType ?? 'MBC5';
     const baseAddress = options.baseAddress ?? 0;
-    const pageSize = this.resolveRomPageSize(options.romPageSize);
+    const pageSize = this.resolveRomPageSize(options.romPageSize, 'read');
+    const stepSize = this.romStepSize(pageSize);
 
     this.log(this.t('messages.operation.startVerifyROM', {
       fileSize: fileData.byteLength,
@@ -1211,8 +1307,6 @@ export class MBC5Adapter extends CartridgeAdapter {
             }), 'warn');
           }
           let verified = 0;
-          let success = true;
-          let failedAddress = -1;
           let lastLoggedProgress = -1; // 鍒濆鍖栦负-1锛岀‘淇濈涓€娆?%浼氳璁板綍
           let currentBank = -1;
           let activeSectorIndex = -1;
@@ -1221,6 +1315,10 @@ export class MBC5Adapter extends CartridgeAdapter {
           // 鍒濆鍖栨墖鍖鸿繘搴︿俊鎭?(鐢ㄤ簬鏄剧ず鏍￠獙杩涘害鍙鍖?
           const sectorInfo = calcSectorUsage(options.cfiInfo.eraseSectorBlocks, total, baseAddress);
           const sectors = this.initializeSectorProgress(sectorInfo);
+          const mismatches = new VerifyMismatchCollector(sectors);
+          // 有差异的扇区保持错误状态
+          const sectorState = (address: number, state: 'processing' | 'completed') =>
+            mismatches.sectorMismatches(address) > 0 ? 'error' as const : state;
 
           // 浣跨敤閫熷害璁＄畻鍣?
           const speedCalculator = new SpeedCalculator();
@@ -1239,7 +1337,7 @@ export class MBC5Adapter extends CartridgeAdapter {
 
           // 鍒嗗潡鏍￠獙骞舵洿鏂拌繘搴?
           let chunkCount = 0; // 璁板綍宸插鐞嗙殑鍧楁暟
-          while (verified < total && success) {
+          while (verified < total) {
             // 妫€鏌ユ槸鍚﹀凡琚彇娑?
             if (signal?.aborted) {
               progressReporter.reportError(this.t('messages.operation.cancelled'));
@@ -1249,7 +1347,6 @@ export class MBC5Adapter extends CartridgeAdapter {
               };
             }
 
-            const chunkSize = Math.min(pageSize, total - verified);
             const currentAddress = baseAddress + verified;
 
             while (
@@ -1259,8 +1356,21 @@ export class MBC5Adapter extends CartridgeAdapter {
               activeSectorIndex++;
             }
 
+            const activeSectorEnd = activeSectorIndex >= 0
+              ? sectors[activeSectorIndex].address + sectors[activeSectorIndex].size
+              : baseAddress + total;
+            const chunkSize = Math.min(
+              stepSize,
+              total - verified,
+              Math.max(activeSectorEnd - currentAddress, pageSize),
+              0x4000 - (currentAddress & 0x3fff),
+            );
+
             const enteredNewSector = activeSectorIndex >= 0
-              && progressReporter.markSectorState(sectors[activeSectorIndex].address, 'processing') >= 0
+              && progressReporter.markSectorState(
+                sectors[activeSectorIndex].address,
+                sectorState(sectors[activeSectorIndex].address, 'processing'),
+              ) >= 0
               && (verified === 0 || verified === sectors[activeSectorIndex].address - baseAddress);
 
             if (enteredNewSector) {
@@ -1280,30 +1390,30 @@ export class MBC5Adapter extends CartridgeAdapter {
             }
 
             // 璇诲彇鏁版嵁
-            const actualChunk = await gbc_read(this.transport, chunkSize, cartAddress);
+            const actualChunk = chunkSize > pageSize
+              ? await rom_read_native(this.transport, GBCCommand.READ, chunkSize, cartAddress, pageSize, { signal })
+              : await gbc_read(this.transport, chunkSize, cartAddress);
             const chunkEndTime = Date.now();
 
-            // 閫愬瓧鑺傛瘮杈?
-            for (let i = 0; i < chunkSize; i++) {
-              const expectedByte = fileData[verified + i];
-              const actualByte = actualChunk[i];
-              if (expectedByte !== actualByte) {
-                success = false;
-                failedAddress = verified + i;
+            // 按字比较并记录全部差异，不在第一个差异处停止，一次校验得到完整的损坏分布
+            const chunkMismatches = mismatches.compare(
+              fileData.subarray(verified, verified + chunkSize),
+              actualChunk.subarray(0, chunkSize),
+              currentAddress,
+            );
+            if (chunkMismatches > 0) {
+              if (mismatches.first && mismatches.mismatchCount === chunkMismatches) {
                 this.log(this.t('messages.rom.verifyFailedAt', {
-                  address: formatHex(failedAddress, 4),
-                  expected: formatHex(expectedByte, 1),
-                  actual: formatHex(actualByte, 1),
+                  address: formatHex(mismatches.first.address, 4),
+                  expected: formatHex(mismatches.first.expected, 1),
+                  actual: formatHex(mismatches.first.actual, 1),
                 }), 'error');
-                if (activeSectorIndex >= 0) {
-                  progressReporter.markSectorState(sectors[activeSectorIndex].address, 'error');
-                }
-                break;
+              }
+              if (activeSectorIndex >= 0) {
+                progressReporter.markSectorState(sectors[activeSectorIndex].address, 'error');
               }
             }
 
-            if (!success) break;
-
             verified += chunkSize;
             chunkCount++;
 
@@ -1316,7 +1426,7 @@ export class MBC5Adapter extends CartridgeAdapter {
               }
 
               completedSectorIndex++;
-              progressReporter.markSectorState(nextSector.address, 'completed');
+              progressReporter.markSectorState(nextSector.address, sectorState(nextSector.address, 'completed'));
             }
 
             // 娣诲姞鏁版嵁鐐瑰埌閫熷害璁＄畻鍣?
@@ -1351,12 +1461,14 @@ export class MBC5Adapter extends CartridgeAdapter {
           const avgSpeed = speedCalculator.getAverageSpeed();
           const maxSpeed = speedCalculator.getMaxSpeed();
 
-          if (success) {
-            while (completedSectorIndex + 1 < sectors.length) {
-              completedSectorIndex++;
-              progressReporter.markSectorState(sectors[completedSectorIndex].address, 'completed');
-            }
+          while (completedSectorIndex + 1 < sectors.length) {
+            completedSectorIndex++;
+            const sectorAddress = sectors[completedSectorIndex].address;
+            progressReporter.markSectorState(sectorAddress, sectorState(sectorAddress, 'completed'));
+          }
 
+          const success = mismatches.mismatchCount === 0;
+          if (success) {
             this.log(this.t('messages.rom.verifySuccess'), 'success');
             this.log(this.t('messages.rom.verifySummary', {
               totalTime: formatTimeDuration(totalTime),
@@ -1368,6 +1480,7 @@ export class MBC5Adapter extends CartridgeAdapter {
             // 鎶ュ憡瀹屾垚鐘舵€?
             progressReporter.reportCompleted(this.t('messages.rom.verifySuccess'), avgSpeed);
           } else {
+            this.logVerifyMismatches(mismatches);
             this.log(this.t('messages.rom.verifyFailed'), 'error');
             progressReporter.reportError(this.t('messages.rom.verifyFailed'));
           }
@@ -1384,6 +1497,13 @@ export class MBC5Adapter extends CartridgeAdapter {
             (progressInfo) => { this.updateProgress(progressInfo); },
             (key, params) => this.t(key, params),
           );
+          if (signal?.aborted) {
+            progressReporter.reportError(this.t('messages.operation.cancelled'));
+            return {
+              success: false,
+              message: this.t('messages.operation.cancelled'),
+            };
+          }
           progressReporter.reportError(this.t('messages.rom.verifyFailed'));
           this.log(errorToBurnerLog(this.t('messages.rom.verifyFailed'), e), 'error');
           return {
@@ -1453,7 +1573,8 @@ export class MBC5Adapter extends CartridgeAdapter {
               const ramAddress = baseAddress + written;
               // 鍒嗗寘
               const remainingSize = total - written;
-              const chunkSize = Math.min(pageSize, remainingSize);
+              // 卡带 RAM 只有 0xA000-0xBFFF 的 8 KiB 窗口，分块不能跨 bank
+              const chunkSize = Math.min(pageSize, remainingSize, 0x2000 - (ramAddress & 0x1fff));
               const chunk = fileData.subarray(written, written + chunkSize);
 
               // 璁＄畻bank鍜屽湴鍧€
@@ -1544,7 +1665,7 @@ export class MBC5Adapter extends CartridgeAdapter {
     const baseAddress = options.baseAddress ?? 0x00;
     const ramType = options.ramType ?? 'SRAM';
     const effectiveRamType = ramType === 'BATLESS' ? 'SRAM' : ramType;
-    const pageSize = this.resolveRamPageSize(options.ramPageSize);
+    const pageSize = this.resolveRamPageSize(options.ramPageSize, 'read');
     const retries = AdvancedSettings.ramReadRetryCount;
     const retryDelayMs = AdvancedSettings.ramReadRetryDelayMs;
     const timeoutMs = AdvancedSettings.packageReceiveTimeout;
@@ -1590,7 +1711,7 @@ export class MBC5Adapter extends CartridgeAdapter {
 
               // 鍒嗗寘
               const remainingSize = size - read;
-              const chunkSize = Math.min(pageSize, remainingSize);
+              const chunkSize = Math.min(pageSize, remainingSize, 0x2000 - (ramAddress & 0x1fff));
 
               // 璇诲彇鏁版嵁
               const chunk = await this.readRAMChunkWithRetry(
@@ -1732,64 +1853,17 @@ export class MBC5Adapter extends CartridgeAdapter {
   }
 
   /**
-   * 鑾峰彇鍗″甫淇℃伅
-   * @param enable5V - 鏄惁鍚敤 5V 鐢垫簮锛堝彲閫夛紝榛樿 false锛?
-   * @returns 鍗″甫瀹归噺鐩稿叧淇℃伅
+   * 获取卡带信息，5V 供电需要固件支持电源控制
+   * @param enable5V - 是否启用 5V 电源（可选，默认 false）
+   * @param refresh - 忽略会话缓存
    */
-  override async getCartInfo(enable5V = false): Promise<CFIInfo | false> {
+  override async getCartInfo(enable5V = false, refresh = false): Promise<CFIInfo | false> {
     if (enable5V && !this.firmwareProfile.capabilities.cartPowerControl) {
       this.log(firmwareUnsupportedResult('MBC 5V power control', this.firmwareProfile).message, 'error');
       return false;
     }
 
-    this.log(this.t('messages.operation.startGetCartInfo'), 'info');
-
-    return PerformanceTracker.trackAsyncOperation(
-      'mbc5.getCartInfo',
-      async () => {
-        try {
-          return await this.withOptional5v(enable5V, async () => {
-            // CFI Query
-            await gbc_write(this.transport, new Uint8Array([0x98]), 0xaa);
-            const cfiData = await gbc_read(this.transport, 0x100, 0x00);
-            // Reset
-            await gbc_write(this.transport, new Uint8Array([0xf0]), 0x00);
-
-            const cfiInfo = parseCFI(cfiData);
-
-            if (!cfiInfo) {
-              this.log(this.t('messages.operation.cfiParseFailed'), 'error');
-              return false;
-            }
-
-            // 璇诲彇Flash ID骞舵坊鍔犲埌CFI淇℃伅涓?
-            try {
-              const flashId = await gbc_rom_get_id(this.transport);
-              cfiInfo.flashId = flashId;
-              const idStr = Array.from(flashId).map(x => x.toString(16).padStart(2, '0')).join(' ');
-              const flashName = getFlashName([...flashId]);
-              this.log(`Flash ID: ${idStr} (${flashName})`, 'info');
-            } catch (e) {
-              this.log(errorToBurnerLog(this.t('messages.operation.readIdFailed'), e), 'warn');
-              // 鍗充娇Flash ID璇诲彇澶辫触锛屼篃缁х画杩斿洖CFI淇℃伅
-            }
-
-            // 璁板綍CFI瑙ｆ瀽缁撴灉
-            this.log(this.t('messages.operation.cfiParseSuccess'), 'success');
-            this.log(cfiInfo.info, 'info');
-
-            return cfiInfo;
-          });
-        } catch (e) {
-          this.log(errorToBurnerLog(this.t('messages.operation.romSizeQueryFailed'), e), 'error');
-          return false;
-        }
-      },
-      {
-        adapter_type: 'mbc5',
-        operation_type: 'get_cart_info',
-      },
-    );
+    return super.getCartInfo(enable5V, refresh);
   }
 
   /**
@@ -0,0 +1,114 @@
+import { SpeedCalculator } from '@/utils/progress/speed-calculator';
+
+const STORAGE_KEY = 'page_size_tuning';
+/** 每档候选分块至少传输的字节数 */
+const TRIAL_BYTES = 0x10000;
+/** 候选分块档数：从上限起逐档减半 */
+const CANDIDATE_COUNT = 4;
+const MIN_CANDIDATE = 0x200;
+/** 小于该大小的任务（如读取头部）不试探 */
+export const PAGE_SIZE_TUNING_MIN_SIZE = 1 << 20;
+
+function loadTuning(): Record<string, number> {
+  try {
+    const raw = localStorage.getItem(STORAGE_KEY);
+    const parsed: unknown = raw ? JSON.parse(raw) : {};
+    return parsed && typeof parsed === 'object' ? parsed as Record<string, number> : {};
+  } catch {
+    return {};
+  }
+}
+
+/**
+ * 读取已记住的分块大小；没有记录或记录超出 maxPageSize 时返回 null
+ */
+export function loadTunedPageSize(key: string, maxPageSize: number): number | null {
+  const pageSize = loadTuning()[key];
+  return typeof pageSize === 'number' && pageSize > 0 && pageSize <= maxPageSize ? pageSize : null;
+}
+
+function saveTunedPageSize(key: string, pageSize: number): void {
+  try {
+    localStorage.setItem(STORAGE_KEY, JSON.stringify({ ...loadTuning(), [key]: pageSize }));
+  } catch {
+    // localStorage might be unavailable (e.g. private mode). Ignore silently.
+  }
+}
+
+/**
+ * 分块大小自动调优
+ *
+ * 任务开头依次试用从 maxPageSize 起逐档减半的候选分块，每档传输 TRIAL_BYTES 后
+ * 以 SpeedCalculator 的平均速度比较，选出最快的一档并按 key（设备与传输方式）记住。
+ * 第一块包含建立连接等开销，只作预热不计入结果。
+ */
+export class PageSizeTuner {
+  private readonly speeds: number[] = [];
+  private index = 0;
+  private trialBytes = 0;
+  private warmedUp = false;
+  private speedCalculator = new SpeedCalculator();
+  private chosen: number | null = null;
+
+  private constructor(
+    private readonly key: string,
+    private readonly candidates: number[],
+  ) {}
+
+  /**
+   * @returns 任务太小或只有一档候选时返回 null
+   */
+  static start(key: string, maxPageSize: number, jobSize: number): PageSizeTuner | null {
+    const candidates: number[] = [];
+    for (let pageSize = maxPageSize; pageSize >= MIN_CANDIDATE && candidates.length < CANDIDATE_COUNT; pageSize >>= 1) {
+      candidates.push(pageSize);
+    }
+    if (jobSize < PAGE_SIZE_TUNING_MIN_SIZE || candidates.length < 2) {
+      return null;
+    }
+    return new PageSizeTuner(key, candidates);
+  }
+
+  /** 当前应使用的分块大小 */
+  get pageSize(): number {
+    return this.chosen ?? this.candidates[this.index];
+  }
+
+  get tuning(): boolean {
+    return this.chosen === null;
+  }
+
+  /** 选定分块的平均速度，B/s */
+  get bestSpeed(): number {
+    return Math.max(0, ...this.speeds);
+  }
+
+  /** 记录一块传输完成，候选测完后选定最快的一档 */
+  record(bytes: number, timestamp: number = Date.now()): void {
+    if (!this.tuning) {
+      return;
+    }
+    if (!this.warmedUp) {
+      this.warmedUp = true;
+      this.speedCalculator = new SpeedCalculator();
+      return;
+    }
+
+    this.speedCalculator.addDataPoint(bytes, timestamp);
+    this.trialBytes += bytes;
+    if (this.trialBytes < TRIAL_BYTES) {
+      return;
+    }
+
+    this.speeds.push(this.speedCalculator.getAverageSpeed());
+    if (this.speeds.length < this.candidates.length) {
+      this.index++;
+      this.trialBytes = 0;
+      this.speedCalculator = new SpeedCalculator();
+      return;
+    }
+
+    this.chosen = this.candidates[this.speeds.indexOf(this.bestSpeed)];
+    saveTunedPageSize(this.key, this.chosen);
+  }
+}
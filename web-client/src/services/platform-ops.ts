@@ -7,6 +7,8 @@ export interface PlatformOps {
   readonly platformId: 'gba' | 'mbc5';
   readonly flashCmdSet: FlashCommandSet;
   readonly cfiEntryAddress: number;
+  /** 原生批处理任务使用的 ROM 读取/编程操作码 */
+  readonly romCommands: { read: number; program: number };
 
   romProgram(device: ProtocolTransportInput, data: Uint8Array, address: number, bufferSize: number): Promise<void>;
   romEraseSector(device: ProtocolTransportInput, address: number): Promise<boolean>;
@@ -0,0 +1,34 @@
+import type { DumpSink } from '@/types/dump-sink';
+
+/**
+ * ROM 读取的目标缓冲
+ *
+ * 未指定写入目标时整片分配，每块直接读入对应偏移；
+ * 指定写入目标时只保留一个分块大小的缓冲，读完一块写出一块，内存占用与镜像大小无关。
+ */
+export class RomDumpBuffer {
+  private readonly storage: Uint8Array;
+
+  constructor(size: number, maxChunkSize: number, private readonly sink?: DumpSink) {
+    this.storage = new Uint8Array(sink ? Math.min(size, maxChunkSize) : size);
+  }
+
+  /** 完整镜像；写入目标模式下为 undefined */
+  get data(): Uint8Array | undefined {
+    return this.sink ? undefined : this.storage;
+  }
+
+  /** 偏移 offset 处长度为 length 的分块读取目标 */
+  chunk(offset: number, length: number): Uint8Array {
+    return this.sink
+      ? this.storage.subarray(0, length)
+      : this.storage.subarray(offset, offset + length);
+  }
+
+  /** 分块读取完成后调用，写入目标模式下把该块写出 */
+  async commit(chunk: Uint8Array): Promise<void> {
+    if (this.sink) {
+      await this.sink.write(chunk);
+    }
+  }
+}
@@ -0,0 +1,170 @@
+import type { DeviceHandle, Transport } from '@/platform/serial';
+import { FramedTransport, usb_loopback, usb_sink, usb_source } from '@/protocol';
+
+export type TransportBenchmarkPlatform = DeviceHandle['platform'] | 'unknown';
+
+export interface TransportBenchmarkOptions {
+  /** 吞吐测试的单包数据量（字节），需小于固件命令缓冲区 */
+  payloadSize?: number;
+  /** 吞吐测试每个方向的包数 */
+  iterations?: number;
+  /** 延迟测试的单包数据量（字节） */
+  latencyPayloadSize?: number;
+  /** 延迟测试的往返次数 */
+  latencyIterations?: number;
+  /** 吞吐测试同时在途的命令数，默认帧传输层为 4，其它为 1；普通传输层会逐个串行 */
+  inFlight?: number;
+  platform?: TransportBenchmarkPlatform;
+  signal?: AbortSignal;
+  now?: () => number;
+}
+
+export interface LatencyPercentiles {
+  min: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  max: number;
+}
+
+export interface TransportBenchmarkResult {
+  platform: TransportBenchmarkPlatform;
+  payloadSize: number;
+  iterations: number;
+  inFlight: number;
+  /** host -> device 吞吐 (MB/s) */
+  sinkMBps: number;
+  /** device -> host 吞吐 (MB/s) */
+  sourceMBps: number;
+  /** 回环往返延迟 (ms) */
+  latency: LatencyPercentiles;
+}
+
+const DEFAULT_PAYLOAD_SIZE = 4096;
+const DEFAULT_ITERATIONS = 32;
+const DEFAULT_LATENCY_PAYLOAD_SIZE = 16;
+const DEFAULT_LATENCY_ITERATIONS = 64;
+const DEFAULT_FRAMED_IN_FLIGHT = 4;
+const BYTES_PER_MB = 1024 * 1024;
+
+function throwIfAborted(signal?: AbortSignal): void {
+  if (signal?.aborted) {
+    throw new Error('Transport benchmark aborted');
+  }
+}
+
+function toMBps(byteCount: number, elapsedMs: number): number {
+  if (elapsedMs <= 0) {
+    return 0;
+  }
+  return (byteCount / BYTES_PER_MB) / (elapsedMs / 1000);
+}
+
+function createPattern(size: number, seed: number): Uint8Array {
+  const data = new Uint8Array(size);
+  for (let i = 0; i < size; i++) {
+    data[i] = (seed + i) & 0xff;
+  }
+  return data;
+}
+
+function percentile(sorted: number[], ratio: number): number {
+  const index = Math.min(sorted.length - 1, Math.max(0, Math.ceil(ratio * sorted.length) - 1));
+  return sorted[index];
+}
+
+/**
+ * 按 inFlight 分批并发执行，批内命令同时在途
+ */
+async function runBatched(
+  iterations: number,
+  inFlight: number,
+  signal: AbortSignal | undefined,
+  task: (iteration: number) => Promise<void>,
+): Promise<void> {
+  for (let start = 0; start < iterations; start += inFlight) {
+    throwIfAborted(signal);
+    const batch: Promise<void>[] = [];
+    for (let i = start; i < Math.min(start + inFlight, iterations); i++) {
+      batch.push(task(i));
+    }
+    await Promise.all(batch);
+  }
+}
+
+/**
+ * 计算延迟分位数（nearest-rank）
+ */
+export function computeLatencyPercentiles(samples: readonly number[]): LatencyPercentiles {
+  if (samples.length === 0) {
+    return { min: 0, p50: 0, p90: 0, p99: 0, max: 0 };
+  }
+
+  const sorted = [...samples].sort((a, b) => a - b);
+  return {
+    min: sorted[0],
+    p50: percentile(sorted, 0.5),
+    p90: percentile(sorted, 0.9),
+    p99: percentile(sorted, 0.99),
+    max: sorted[sorted.length - 1],
+  };
+}
+
+/**
+ * 使用 USB 自检命令（0xd0/0xd1/0xd2）测量传输层上限。
+ * 三个命令都不访问卡带总线，结果与卡带读写速度对比即可区分瓶颈在 USB 还是总线。
+ */
+export async function runTransportBenchmark(
+  transport: Transport,
+  options: TransportBenchmarkOptions = {},
+): Promise<TransportBenchmarkResult> {
+  const payloadSize = options.payloadSize ?? DEFAULT_PAYLOAD_SIZE;
+  const iterations = options.iterations ?? DEFAULT_ITERATIONS;
+  const latencyPayloadSize = options.latencyPayloadSize ?? DEFAULT_LATENCY_PAYLOAD_SIZE;
+  const latencyIterations = options.latencyIterations ?? DEFAULT_LATENCY_ITERATIONS;
+  const inFlight = Math.max(1, options.inFlight ?? (transport instanceof FramedTransport ? DEFAULT_FRAMED_IN_FLIGHT : 1));
+  const now = options.now ?? (() => performance.now());
+  const { signal } = options;
+
+  // 下行：sink
+  const sinkData = createPattern(payloadSize, 0);
+  let startTime = now();
+  await runBatched(iterations, inFlight, signal, async () => {
+    await usb_sink(transport, sinkData);
+  });
+  const sinkMBps = toMBps(payloadSize * iterations, now() - startTime);
+
+  // 上行：source，同时校验测试数据
+  startTime = now();
+  await runBatched(iterations, inFlight, signal, async (i) => {
+    const seed = i & 0xff;
+    const data = await usb_source(transport, payloadSize, seed);
+    if (data.byteLength !== payloadSize || data[0] !== seed || data[payloadSize - 1] !== ((seed + payloadSize - 1) & 0xff)) {
+      throw new Error(`USB source pattern mismatch (Iteration: ${i})`);
+    }
+  });
+  const sourceMBps = toMBps(payloadSize * iterations, now() - startTime);
+
+  // 往返延迟：loopback
+  const samples: number[] = [];
+  for (let i = 0; i < latencyIterations; i++) {
+    throwIfAborted(signal);
+    const probe = createPattern(latencyPayloadSize, i);
+    const sentAt = now();
+    const echoed = await usb_loopback(transport, probe);
+    samples.push(now() - sentAt);
+    if (echoed.byteLength !== probe.byteLength || echoed[0] !== probe[0]) {
+      throw new Error(`USB loopback echo mismatch (Iteration: ${i})`);
+    }
+  }
+
+  return {
+    platform: options.platform ?? 'unknown',
+    payloadSize,
+    iterations,
+    inFlight,
+    sinkMBps,
+    sourceMBps,
+    latency: computeLatencyPercentiles(samples),
+  };
+}
@@ -83,6 +83,10 @@ const _storage: Record<string, number> = Object.fromEntries(
 );
 let _firmwareProfile: ConfigurableFirmwareProfileId = 'stm';
 
+// 烧录任务是否放到后台 Worker 执行；单独保存，不属于 getSettings 的分组
+const WORKER_EXECUTION_KEY = 'burner_worker_execution';
+let _workerExecution = false;
+
 const LEGACY_DEFAULTS = {
   romPageSize: 0x200,
   ramPageSize: 0x100,
@@ -124,6 +128,14 @@ function formatErrorRange(min: number, max: number, type: ValidatorType): string
   }
 }
 
+function loadWorkerExecution(): boolean {
+  try {
+    return localStorage.getItem(WORKER_EXECUTION_KEY) === 'true';
+  } catch {
+    return false;
+  }
+}
+
 function validateFirmwareProfile(value: unknown): ConfigurableFirmwareProfileId {
   if (value === 'stm' || value === 'stc') {
     return value;
@@ -137,6 +149,7 @@ function validateFirmwareProfile(value: unknown): ConfigurableFirmwareProfileId
 
 export class AdvancedSettings {
   declare static firmwareProfile: ConfigurableFirmwareProfileId;
+  declare static workerExecution: boolean;
   declare static romPageSize: number;
   declare static ramPageSize: number;
   declare static romReadThrottleMs: number;
@@ -241,6 +254,7 @@ export class AdvancedSettings {
 
   static init(): void {
     this.loadSettings();
+    _workerExecution = loadWorkerExecution();
     console.log('Advanced settings initialized:', this.getSettings());
   }
 
@@ -288,6 +302,22 @@ Object.defineProperty(AdvancedSettings, 'firmwareProfile', {
   configurable: true,
 });
 
+Object.defineProperty(AdvancedSettings, 'workerExecution', {
+  get(): boolean {
+    return _workerExecution;
+  },
+  set(value: boolean) {
+    _workerExecution = value;
+    try {
+      localStorage.setItem(WORKER_EXECUTION_KEY, String(value));
+    } catch (error) {
+      console.error('Failed to save worker execution setting:', error);
+    }
+  },
+  enumerable: true,
+  configurable: true,
+});
+
 // Register getter/setter properties from descriptors
 for (const desc of SETTING_DESCRIPTORS) {
   Object.defineProperty(AdvancedSettings, desc.key, {
@@ -1,3 +1,5 @@
+import type { DumpSink } from '@/types/dump-sink';
+import type { TransferCheckpoint } from '@/types/transfer-checkpoint';
 import { CFIInfo } from '@/utils/parsers/cfi-parser';
 
 export type RamType = 'SRAM' | 'FLASH' | 'FRAM' | 'BATLESS';
@@ -14,4 +16,10 @@ export interface CommandOptions {
   framLatency?: number;
   mbcType?: MbcType;
   enable5V?: boolean;
+  /** 设置后 ROM 读取按块写入该目标，结果中不再返回完整数据 */
+  dumpSink?: DumpSink;
+  /** 设置后每完成一个扇区（写入）或分块（读取）都会记录，用于断点续传 */
+  checkpoint?: TransferCheckpoint;
+  /** ROM 写入时内容已与镜像一致的扇区地址，这些扇区既不擦除也不编程 */
+  unchangedSectors?: ReadonlySet<number>;
 }
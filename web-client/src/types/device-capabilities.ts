@@ -0,0 +1,37 @@
+import type { FirmwareProfileId } from '@/types/firmware-profile';
+
+/**
+ * 固件通过 0xd3 命令上报的能力与缓冲区上限
+ */
+export interface DeviceCapabilities {
+  /** 协议版本 */
+  readonly protocolVersion: number;
+  /** 固件类型 */
+  readonly firmwareId: FirmwareProfileId;
+  /** 设备边接收边执行（如碳酸丐的流式编程），命令包无需整包缓存后才开始写卡 */
+  readonly streamingCommand: boolean;
+  /** 响应按 USB 包流式发送，不受设备响应缓冲区限制 */
+  readonly streamingResponse: boolean;
+  /** 是否支持卡带电源控制 */
+  readonly cartPowerControl: boolean;
+  /** 支持 v2 帧（0xc0），响应带序号与状态 */
+  readonly frameProtocol: boolean;
+  /** 执行期间继续接收后续帧，可同时有多个命令在途 */
+  readonly frameQueue: boolean;
+  /** 支持帧 CRC32 */
+  readonly frameCrc: boolean;
+  /** 单个命令包上限（含 2B 长度、1B 命令、2B CRC） */
+  readonly maxCommandSize: number;
+  /** 单次响应数据上限（不含 2B CRC） */
+  readonly maxResponsePayload: number;
+  /** USB 端点包大小 */
+  readonly usbPacketSize: number;
+  /** 主频 (Hz) */
+  readonly busClockHz: number;
+  /** 支持的命令码 */
+  readonly opcodes: ReadonlySet<number>;
+}
+
+export function supportsOpcode(capabilities: DeviceCapabilities | null | undefined, opcode: number): boolean {
+  return capabilities?.opcodes.has(opcode) ?? false;
+}
@@ -1,14 +1,19 @@
 import type { DeviceHandle, Transport } from '@/platform/serial';
+import type { DeviceCapabilities } from '@/types/device-capabilities';
 import type { FirmwareProfile } from '@/types/firmware-profile';
 import type { SerialPortInfo } from '@/types/serial';
 
 export interface DeviceInfo {
   port: SerialPort | null;
+  /** 本次连接的唯一标识；同时连接多台烧录器时用于区分设备 */
+  connectionId?: string;
   connection?: null;
   transport?: Transport | null;
   serialHandle?: DeviceHandle | null;
   portInfo?: SerialPortInfo;
   firmwareProfile?: FirmwareProfile;
+  /** 固件上报的能力描述；undefined 表示尚未探测，null 表示固件不支持 0xd3 */
+  capabilities?: DeviceCapabilities | null;
 }
 
 // Reader types for utility functions
@@ -0,0 +1,23 @@
+/**
+ * ROM 转储写入目标
+ *
+ * 读取过程中按块顺序追加写入，不在内存中保留完整镜像。
+ */
+export interface DumpSink {
+  /** 保存位置（平台能提供时） */
+  path?: string;
+  /** 断点日志中记录的文件标识：Tauri 为路径，浏览器为文件句柄；不能原地续写时为空 */
+  resumeToken?: unknown;
+  write(chunk: Uint8Array): Promise<void>;
+  /**
+   * 第一次写入前调用：token 指向同一文件且已有内容不短于 offset 时截断到 offset，之后从这里续写并返回 true；
+   * 否则返回 false，文件照常从头写入
+   */
+  resumeAt?(token: unknown, offset: number): Promise<boolean>;
+  /** 完成写入并落盘 */
+  close(): Promise<void>;
+  /** 关闭但保留已写入的部分，供下次续写；之后的 abort 不再删除文件 */
+  suspend?(): Promise<void>;
+  /** 放弃写入，丢弃已写入的部分 */
+  abort(): Promise<void>;
+}
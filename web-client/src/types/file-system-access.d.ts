@@ -0,0 +1,15 @@
+/**
+ * File System Access API 中 lib.dom 尚未收录的部分
+ */
+declare global {
+  interface SaveFilePickerOptions {
+    suggestedName?: string;
+    excludeAcceptAllOption?: boolean;
+  }
+
+  interface Window {
+    showSaveFilePicker?: (options?: SaveFilePickerOptions) => Promise<FileSystemFileHandle>;
+  }
+}
+
+export {};
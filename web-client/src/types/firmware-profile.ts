@@ -1,4 +1,5 @@
 import type { RamType } from '@/types/command-options';
+import type { DeviceCapabilities } from '@/types/device-capabilities';
 import type { DeviceInfo } from '@/types/device-info';
 import type { SerialPortInfo } from '@/types/serial';
 
@@ -62,6 +63,25 @@ export function getFirmwareProfileById(id: FirmwareProfileId): FirmwareProfile {
   }
 }
 
+/**
+ * 根据固件上报的能力描述生成 profile，取代按串口信息猜测
+ */
+export function createFirmwareProfileFromCapabilities(capabilities: DeviceCapabilities): FirmwareProfile {
+  const base = getFirmwareProfileById(capabilities.firmwareId);
+  const has = (opcode: number) => capabilities.opcodes.has(opcode);
+
+  return {
+    id: base.id,
+    label: base.label,
+    capabilities: {
+      gbaSectorErase: has(0xf3),
+      gbaFramRam: has(0xe7) && has(0xe8),
+      gbcFramRam: has(0xea) && has(0xeb),
+      cartPowerControl: capabilities.cartPowerControl && has(0xa0),
+    },
+  };
+}
+
 function lower(value?: string): string {
   return value?.toLowerCase() ?? '';
 }
@@ -1,8 +1,11 @@
 export type { BurnerLogEntry, BurnerLogLevel, BurnerLogMessage } from './burner-log';
 export type { CommandOptions, RamType } from './command-options';
 export type { CommandResult } from './command-result';
+export type { DeviceCapabilities } from './device-capabilities';
 export type { BYOBReader, DefaultReader, DeviceInfo } from './device-info';
+export type { DumpSink } from './dump-sink';
 export type { FileInfo } from './file-info';
 export type { ProgressInfo } from './progress-info';
 export type { AssembledRom, RomAssemblyConfig, RomSlot } from './rom-assembly';
 export type { SerialPortInfo } from './serial';
+export type { TransferCheckpoint } from './transfer-checkpoint';
@@ -6,6 +6,7 @@ export type SectorProgressState =
   | 'erasing'
   | 'erased'
   | 'skipped_erase'
+  | 'skipped_write'
   | 'error';
 
 export interface SectorProgressInfo {
@@ -16,8 +17,8 @@ export interface SectorProgressInfo {
 
 export type SectorSizeClass = 'small' | 'medium' | 'large';
 
-export type SectorStateCode = 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7;
-// 0=pending,1=processing,2=completed,3=error,4=pending_erase,5=erasing,6=erased,7=skipped_erase
+export type SectorStateCode = 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8;
+// 0=pending,1=processing,2=completed,3=error,4=pending_erase,5=erasing,6=erased,7=skipped_erase,8=skipped_write
 
 export interface ProgressInfo {
   type?: 'erase' | 'write' | 'read' | 'verify' | 'other'
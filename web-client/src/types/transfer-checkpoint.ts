@@ -0,0 +1,9 @@
+/**
+ * 长时间 ROM 读写的断点记录
+ *
+ * 适配器每完成一段地址范围调用一次：写入时为编程完成的扇区，读取时为已读出的分块（附带数据）。
+ * 调用方据此持久化进度，失败后重新开始时可从第一个未完成的位置继续。
+ */
+export interface TransferCheckpoint {
+  commit(address: number, length: number, data?: Uint8Array): Promise<void>;
+}
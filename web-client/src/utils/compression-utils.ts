@@ -213,3 +213,84 @@ export function processGBALogoData(logoData: Uint8Array): Uint8Array | null {
     return null;
   }
 }
+
+const PACKBITS_MAX_RUN = 128;
+const PACKBITS_MIN_REPEAT = 3;
+const PACKBITS_NOP = 128;
+
+/**
+ * PackBits 编码（与固件 packBitsEncode 一致）
+ * 0-127：其后 n+1 字节原样；129-255：下一字节重复 257-n 次。
+ * 仅 3 字节以上的重复编码为重复段，最坏情况每 128 字节多 1 字节。
+ * @param data - 原始数据
+ * @returns 编码后的数据
+ */
+export function packBitsEncode(data: Uint8Array): Uint8Array {
+  const output = new Uint8Array(data.length + Math.ceil(data.length / PACKBITS_MAX_RUN));
+  let i = 0;
+  let o = 0;
+  let literalHead = 0;
+  let literalLength = 0;
+
+  while (i < data.length) {
+    const value = data[i];
+    let run = 1;
+    while (i + run < data.length && run < PACKBITS_MAX_RUN && data[i + run] === value) {
+      run++;
+    }
+
+    if (run >= PACKBITS_MIN_REPEAT) {
+      literalLength = 0;
+      output[o++] = 257 - run;
+      output[o++] = value;
+      i += run;
+    } else {
+      if (literalLength === 0) {
+        literalHead = o++;
+      }
+      output[o++] = value;
+      output[literalHead] = literalLength;
+      literalLength = (literalLength + 1) % PACKBITS_MAX_RUN;
+      i++;
+    }
+  }
+
+  return output.slice(0, o);
+}
+
+/**
+ * PackBits 解码
+ * @param data - 编码数据
+ * @param expectedSize - 期望的解码长度，超出时抛错
+ * @returns 解码后的数据
+ */
+export function packBitsDecode(data: Uint8Array, expectedSize: number): Uint8Array {
+  const output = new Uint8Array(expectedSize);
+  let i = 0;
+  let o = 0;
+
+  while (i < data.length) {
+    const header = data[i++];
+    if (header < PACKBITS_NOP) {
+      const count = header + 1;
+      if (i + count > data.length || o + count > expectedSize) {
+        throw new Error(`PackBits literal overflow at offset ${i - 1}`);
+      }
+      output.set(data.subarray(i, i + count), o);
+      i += count;
+      o += count;
+    } else if (header > PACKBITS_NOP) {
+      const count = 257 - header;
+      if (i >= data.length || o + count > expectedSize) {
+        throw new Error(`PackBits run overflow at offset ${i - 1}`);
+      }
+      output.fill(data[i++], o, o + count);
+      o += count;
+    }
+  }
+
+  if (o !== expectedSize) {
+    throw new Error(`PackBits size mismatch: expected ${expectedSize}, got ${o}`);
+  }
+  return output;
+}
@@ -48,3 +48,33 @@ export function modbusCRC16_lut(bytes: Uint8Array): number {
   }
   return crc;
 }
+
+const CRC32_MPEG2_TABLE = new Uint32Array(256);
+(function initCRC32Table() {
+  for (let i = 0; i < 256; i++) {
+    let crc = i << 24;
+    for (let j = 0; j < 8; j++) {
+      crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04C11DB7) : (crc << 1);
+    }
+    CRC32_MPEG2_TABLE[i] = crc >>> 0;
+  }
+})();
+
+/**
+ * 计算与 STM32F1 硬件 CRC 单元一致的 CRC32
+ * @param bytes - 要计算CRC的字节数组
+ * @description 多项式 0x04C11DB7、初值 0xFFFFFFFF、不反转不异或；
+ * 数据按小端 32 位字送入（字内高字节先算），末尾不足 4 字节补 0
+ * @returns - 计算得到的CRC32值
+ */
+export function stm32CRC32(bytes: Uint8Array): number {
+  let crc = 0xFFFFFFFF;
+  const paddedLength = (bytes.length + 3) & ~3;
+  for (let i = 0; i < paddedLength; i += 4) {
+    for (let j = 3; j >= 0; j--) {
+      const byte = bytes[i + j] ?? 0;
+      crc = ((crc << 8) ^ CRC32_MPEG2_TABLE[((crc >>> 24) ^ byte) & 0xFF]) >>> 0;
+    }
+  }
+  return crc >>> 0;
+}
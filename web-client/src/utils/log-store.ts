@@ -0,0 +1,249 @@
+import type { BurnerLogEntry, BurnerLogLevel } from '@/types/burner-log';
+import { formatBurnerLogMessage } from '@/utils/burner-log';
+
+/** 导出时每累积这么多字符编码写出一次 */
+const LOG_EXPORT_CHUNK_CHARS = 64 * 1024;
+
+/** 已淘汰的匹配累积到这么多且超过一半时压缩索引数组 */
+const FILTER_COMPACT_THRESHOLD = 1024;
+
+/**
+ * 定长环形缓冲：追加与淘汰都是 O(1)，内存只与容量有关
+ *
+ * 每个条目有单调递增的序号，清空后也不回退；消费方凭序号判断哪些条目是新增的、哪些已被淘汰。
+ */
+export class LogRingBuffer<T> {
+  private readonly items: T[] = [];
+  private head = 0;
+  private count = 0;
+  private next = 0;
+
+  constructor(readonly capacity: number) {
+    if (!Number.isInteger(capacity) || capacity < 1) {
+      throw new RangeError(`Invalid log buffer capacity: ${capacity}`);
+    }
+  }
+
+  get length(): number {
+    return this.count;
+  }
+
+  /** 最早一条保留条目的序号 */
+  get firstSeq(): number {
+    return this.next - this.count;
+  }
+
+  /** 下一条追加条目的序号 */
+  get nextSeq(): number {
+    return this.next;
+  }
+
+  /** 缓冲写满后淘汰过的条目数 */
+  get dropped(): number {
+    return this.firstSeq;
+  }
+
+  push(item: T): void {
+    // 写满前 head 为 0，槽位正好是数组末尾；写满后覆盖最早的条目
+    this.items[(this.head + this.count) % this.capacity] = item;
+    if (this.count < this.capacity) {
+      this.count++;
+    } else {
+      this.head = (this.head + 1) % this.capacity;
+    }
+    this.next++;
+  }
+
+  /** 按保留顺序取条目，0 为最早一条 */
+  at(index: number): T | undefined {
+    if (index < 0 || index >= this.count) {
+      return undefined;
+    }
+    return this.items[(this.head + index) % this.capacity];
+  }
+
+  /** 按序号取条目，已淘汰或尚未写入时返回 undefined */
+  bySeq(seq: number): T | undefined {
+    return this.at(seq - this.firstSeq);
+  }
+
+  clear(): void {
+    this.items.length = 0;
+    this.head = 0;
+    this.count = 0;
+  }
+
+  toArray(): T[] {
+    const result = new Array<T>(this.count);
+    for (let i = 0; i < this.count; i++) {
+      result[i] = this.items[(this.head + i) % this.capacity];
+    }
+    return result;
+  }
+}
+
+export interface LogFilter {
+  /** 不区分大小写，匹配消息、错误与详情 */
+  query: string;
+  /** 为空时不按级别过滤 */
+  levels: readonly BurnerLogLevel[];
+}
+
+function sameLevels(a: ReadonlySet<BurnerLogLevel> | null, b: ReadonlySet<BurnerLogLevel> | null): boolean {
+  if (a === null || b === null) {
+    return a === b;
+  }
+  return a.size === b.size && [...a].every(level => b.has(level));
+}
+
+/**
+ * 日志过滤的增量索引
+ *
+ * 维护匹配条目的序号列表：sync() 只检查上次之后追加的条目，并丢弃已被缓冲淘汰的匹配；
+ * 查询词在原有基础上加长时只复查现有匹配。未设置过滤条件时直接映射到缓冲，不建索引。
+ */
+export class LogFilterIndex {
+  private matches: number[] = [];
+  private matchStart = 0;
+  private indexedSeq: number;
+  private query = '';
+  private levels: ReadonlySet<BurnerLogLevel> | null = null;
+
+  constructor(private readonly buffer: LogRingBuffer<BurnerLogEntry>) {
+    this.indexedSeq = buffer.nextSeq;
+  }
+
+  get active(): boolean {
+    return this.query !== '' || this.levels !== null;
+  }
+
+  /** 当前可见的条目数 */
+  get length(): number {
+    return this.active ? this.matches.length - this.matchStart : this.buffer.length;
+  }
+
+  setFilter(filter: LogFilter): void {
+    const query = filter.query.trim().toLowerCase();
+    const levels = filter.levels.length > 0 ? new Set(filter.levels) : null;
+    if (query === this.query && sameLevels(levels, this.levels)) {
+      return;
+    }
+
+    const narrowing = this.active && sameLevels(levels, this.levels) && query.includes(this.query);
+    this.query = query;
+    this.levels = levels;
+
+    if (narrowing) {
+      this.sync();
+      this.matches = this.matches.slice(this.matchStart).filter((seq) => {
+        const entry = this.buffer.bySeq(seq);
+        return entry !== undefined && this.matchesEntry(entry);
+      });
+      this.matchStart = 0;
+      return;
+    }
+
+    this.matches = [];
+    this.matchStart = 0;
+    this.indexedSeq = this.buffer.firstSeq;
+    this.sync();
+  }
+
+  /** 索引新追加的条目并丢弃已淘汰的匹配 */
+  sync(): void {
+    const firstSeq = this.buffer.firstSeq;
+    const nextSeq = this.buffer.nextSeq;
+    // 两次同步之间追加的条目超过容量（或缓冲被清空）时，跳过已淘汰的部分
+    const start = Math.max(this.indexedSeq, firstSeq);
+
+    if (this.active) {
+      for (let seq = start; seq < nextSeq; seq++) {
+        const entry = this.buffer.bySeq(seq);
+        if (entry && this.matchesEntry(entry)) {
+          this.matches.push(seq);
+        }
+      }
+
+      while (this.matchStart < this.matches.length && this.matches[this.matchStart] < firstSeq) {
+        this.matchStart++;
+      }
+      if (this.matchStart >= FILTER_COMPACT_THRESHOLD && this.matchStart * 2 >= this.matches.length) {
+        this.matches = this.matches.slice(this.matchStart);
+        this.matchStart = 0;
+      }
+    }
+    this.indexedSeq = nextSeq;
+  }
+
+  /** 第 index 条可见条目的序号 */
+  seqAt(index: number): number {
+    return this.active ? this.matches[this.matchStart + index] : this.buffer.firstSeq + index;
+  }
+
+  entryAt(index: number): BurnerLogEntry | undefined {
+    if (index < 0 || index >= this.length) {
+      return undefined;
+    }
+    return this.buffer.bySeq(this.seqAt(index));
+  }
+
+  private matchesEntry(entry: BurnerLogEntry): boolean {
+    if (this.levels !== null && !this.levels.has(entry.level)) {
+      return false;
+    }
+    if (this.query === '') {
+      return true;
+    }
+    return entry.message.toLowerCase().includes(this.query)
+      || (entry.error?.toLowerCase().includes(this.query) ?? false)
+      || (entry.details?.toLowerCase().includes(this.query) ?? false);
+  }
+}
+
+/**
+ * 日志条目的纯文本形式，详情缩进放在后续行
+ */
+export function formatLogEntryLine(entry: BurnerLogEntry): string {
+  let line = `[${entry.time}] [${entry.level.toUpperCase()}] ${formatBurnerLogMessage(entry)}\n`;
+  if (entry.details) {
+    for (const detailLine of entry.details.split('\n')) {
+      line += `    ${detailLine}\n`;
+    }
+  }
+  return line;
+}
+
+/**
+ * 把缓冲中的日志按块编码写出，不拼接完整文本
+ *
+ * 只导出开始时已有的条目；写入期间被淘汰的条目跳过。
+ * @returns 写出的条目数
+ */
+export async function writeLogEntries(
+  buffer: LogRingBuffer<BurnerLogEntry>,
+  write: (chunk: Uint8Array) => Promise<void>,
+): Promise<number> {
+  const encoder = new TextEncoder();
+  const endSeq = buffer.nextSeq;
+  let text = '';
+  let written = 0;
+
+  for (let seq = buffer.firstSeq; seq < endSeq; seq++) {
+    seq = Math.max(seq, buffer.firstSeq);
+    const entry = buffer.bySeq(seq);
+    if (!entry) {
+      continue;
+    }
+    text += formatLogEntryLine(entry);
+    written++;
+    if (text.length >= LOG_EXPORT_CHUNK_CHARS) {
+      await write(encoder.encode(text));
+      text = '';
+    }
+  }
+
+  if (text) {
+    await write(encoder.encode(text));
+  }
+  return written;
+}
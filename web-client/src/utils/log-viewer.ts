@@ -10,3 +10,58 @@ export function resolveAutoScrollEnabled(
 
   return defaultEnabled;
 }
+
+export interface VisibleRowRange {
+  start: number;
+  end: number;
+}
+
+/**
+ * 按行高计算每行顶部位置，offsets[count] 为总高度；容量足够时复用传入的数组
+ */
+export function buildRowOffsets(count: number, rowHeight: (index: number) => number, reuse?: Float64Array): Float64Array {
+  const offsets = reuse && reuse.length >= count + 1 ? reuse : new Float64Array(Math.max(count + 1, (reuse?.length ?? 0) * 2));
+  offsets[0] = 0;
+  for (let i = 0; i < count; i++) {
+    offsets[i + 1] = offsets[i] + rowHeight(i);
+  }
+  return offsets;
+}
+
+/**
+ * 求出与视口相交的行区间 [start, end)，上下各多渲染 overscan 行
+ */
+export function findVisibleRows(
+  offsets: Float64Array,
+  count: number,
+  scrollTop: number,
+  viewportHeight: number,
+  overscan = 8,
+): VisibleRowRange {
+  if (count === 0) {
+    return { start: 0, end: 0 };
+  }
+
+  // 第一个底边超过 scrollTop 的行
+  let low = 0;
+  let high = count - 1;
+  while (low < high) {
+    const mid = (low + high) >>> 1;
+    if (offsets[mid + 1] > scrollTop) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  let end = low;
+  const bottom = scrollTop + viewportHeight;
+  while (end < count && offsets[end] < bottom) {
+    end++;
+  }
+
+  return {
+    start: Math.max(0, low - overscan),
+    end: Math.min(count, Math.max(end, low + 1) + overscan),
+  };
+}
@@ -0,0 +1,78 @@
+import type { DeviceCapabilities } from '@/types/device-capabilities';
+import type { FirmwareProfileId } from '@/types/firmware-profile';
+
+/**
+ * 设备能力描述符偏移量（小端序）
+ */
+const DEVICE_INFO_OFFSETS = {
+  DESC_SIZE: 0,
+  PROTOCOL_VERSION: 1,
+  FIRMWARE_ID: 2,
+  FLAGS: 3,
+  MAX_COMMAND_SIZE: 4,
+  MAX_RESPONSE_PAYLOAD: 6,
+  USB_PACKET_SIZE: 8,
+  BUS_CLOCK: 12,
+  OPCODE_BITMAP: 16,
+} as const;
+
+const DEVICE_INFO_SIZE = 48;
+const OPCODE_BITMAP_SIZE = 32;
+
+const FLAG_STREAMING_COMMAND = 0x01;
+const FLAG_STREAMING_RESPONSE = 0x02;
+const FLAG_CART_POWER = 0x04;
+const FLAG_FRAME = 0x08;
+const FLAG_FRAME_QUEUE = 0x10;
+const FLAG_FRAME_CRC = 0x20;
+
+function toFirmwareId(value: number): FirmwareProfileId {
+  switch (value) {
+    case 1:
+      return 'stm';
+    case 2:
+      return 'stc';
+    default:
+      return 'unknown';
+  }
+}
+
+/**
+ * 解析 0xd3 命令返回的设备能力描述符
+ * @param buffer - 去掉 CRC 后的描述符数据
+ * @returns 解析结果，数据不完整时返回 null
+ */
+export function parseDeviceInfo(buffer: Uint8Array): DeviceCapabilities | null {
+  const descSize = buffer[DEVICE_INFO_OFFSETS.DESC_SIZE] ?? 0;
+  if (descSize < DEVICE_INFO_SIZE || buffer.byteLength < DEVICE_INFO_SIZE) {
+    return null;
+  }
+
+  const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+  const flags = buffer[DEVICE_INFO_OFFSETS.FLAGS];
+  const opcodes = new Set<number>();
+  for (let i = 0; i < OPCODE_BITMAP_SIZE; i++) {
+    const bits = buffer[DEVICE_INFO_OFFSETS.OPCODE_BITMAP + i];
+    for (let bit = 0; bit < 8; bit++) {
+      if (bits & (1 << bit)) {
+        opcodes.add((i << 3) | bit);
+      }
+    }
+  }
+
+  return {
+    protocolVersion: buffer[DEVICE_INFO_OFFSETS.PROTOCOL_VERSION],
+    firmwareId: toFirmwareId(buffer[DEVICE_INFO_OFFSETS.FIRMWARE_ID]),
+    streamingCommand: (flags & FLAG_STREAMING_COMMAND) !== 0,
+    streamingResponse: (flags & FLAG_STREAMING_RESPONSE) !== 0,
+    cartPowerControl: (flags & FLAG_CART_POWER) !== 0,
+    frameProtocol: (flags & FLAG_FRAME) !== 0,
+    frameQueue: (flags & FLAG_FRAME_QUEUE) !== 0,
+    frameCrc: (flags & FLAG_FRAME_CRC) !== 0,
+    maxCommandSize: view.getUint16(DEVICE_INFO_OFFSETS.MAX_COMMAND_SIZE, true),
+    maxResponsePayload: view.getUint16(DEVICE_INFO_OFFSETS.MAX_RESPONSE_PAYLOAD, true),
+    usbPacketSize: view.getUint16(DEVICE_INFO_OFFSETS.USB_PACKET_SIZE, true),
+    busClockHz: view.getUint32(DEVICE_INFO_OFFSETS.BUS_CLOCK, true),
+    opcodes,
+  };
+}
@@ -0,0 +1,52 @@
+type FrameHandle = { kind: 'frame'; id: number } | { kind: 'timer'; id: ReturnType<typeof setTimeout> };
+
+/** 没有 requestAnimationFrame 的环境（测试、Worker）按约 60 Hz 的定时器刷新 */
+const FALLBACK_FRAME_MS = 16;
+
+/**
+ * 把一帧内的多次更新合并为一次刷新
+ *
+ * 生产者只负责写入最新快照并调用 schedule()；flush 在下一动画帧读取快照，
+ * 一帧内无论更新多少次都只刷新一次，界面开销与传输循环的上报频率无关。
+ */
+export class FrameCoalescer {
+  private handle: FrameHandle | null = null;
+
+  constructor(private readonly flush: () => void) {}
+
+  get pending(): boolean {
+    return this.handle !== null;
+  }
+
+  schedule(): void {
+    if (this.handle !== null) {
+      return;
+    }
+    const run = () => {
+      this.handle = null;
+      this.flush();
+    };
+    this.handle = typeof requestAnimationFrame === 'function'
+      ? { kind: 'frame', id: requestAnimationFrame(run) }
+      : { kind: 'timer', id: setTimeout(run, FALLBACK_FRAME_MS) };
+  }
+
+  cancel(): void {
+    const handle = this.handle;
+    if (handle === null) {
+      return;
+    }
+    this.handle = null;
+    if (handle.kind === 'frame') {
+      cancelAnimationFrame(handle.id);
+    } else {
+      clearTimeout(handle.id);
+    }
+  }
+
+  /** 立即刷新，并取消尚未执行的帧 */
+  flushNow(): void {
+    this.cancel();
+    this.flush();
+  }
+}
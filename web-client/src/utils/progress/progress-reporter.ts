@@ -233,6 +233,7 @@ export class ProgressReporter {
     if (state === 'erasing') return 5;
     if (state === 'erased') return 6;
     if (state === 'skipped_erase') return 7;
+    if (state === 'skipped_write') return 8;
     return 0;
   }
 
@@ -254,6 +255,6 @@ export class ProgressReporter {
   }
 
   private isCompletedSectorState(state: SectorProgressInfo['state']): boolean {
-    return state === 'completed' || state === 'erased' || state === 'skipped_erase';
+    return state === 'completed' || state === 'erased' || state === 'skipped_erase' || state === 'skipped_write';
   }
 }
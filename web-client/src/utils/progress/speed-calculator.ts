@@ -1,16 +1,18 @@
-/**
- * 滑动窗口数据点接口
- */
-interface SpeedDataPoint {
-  time: number;
-  bytes: number;
-}
+/** 环形缓冲的初始容量，窗口内数据点更多时按倍数扩容 */
+const INITIAL_WINDOW_CAPACITY = 64;
 
 /**
  * 滑动窗口速度计算器
+ *
+ * 窗口数据点存放在环形缓冲中，并维护窗口内字节总和：每次添加与淘汰都是 O(1)，
+ * 不再随窗口内分块数增长。
  */
 export class SpeedCalculator {
-  private speedWindow: SpeedDataPoint[] = [];
+  private windowTimes = new Float64Array(INITIAL_WINDOW_CAPACITY);
+  private windowBytes = new Float64Array(INITIAL_WINDOW_CAPACITY);
+  private windowHead = 0;
+  private windowCount = 0;
+  private windowByteSum = 0;
   private timeWindow: number; // ms，滑动窗口的时间长度
   private minValidElapsed = 500; // ms，小于此值时，不更新maxSpeed，防止速率虚高
   private currentSpeed = 0;
@@ -48,10 +50,7 @@ export class SpeedCalculator {
     this.lastTimestamp = timestamp;
     this.totalBytes += Math.max(0, bytes);
 
-    this.speedWindow.push({
-      time: timestamp,
-      bytes: bytes,
-    });
+    this.pushDataPoint(timestamp, bytes);
 
     this.calculateCurrentSpeed(timestamp);
   }
@@ -62,30 +61,31 @@ export class SpeedCalculator {
    */
   calculateCurrentSpeed(timestamp: number = Date.now()): number {
     this.trimWindow(timestamp);
-    if (this.speedWindow.length === 0) {
+    if (this.windowCount === 0) {
       this.currentSpeed = 0;
       return this.currentSpeed;
     }
 
     let start: number;
-    if (this.speedWindow.length === 1) {
+    const firstTime = this.windowTimes[this.windowHead];
+    if (this.windowCount === 1) {
       if (this.prevTimestamp === 0) {
         // 第一个数据点：使用构造器时刻（startTime）作为起始，
         // 以便将操作建立阶段的耗时纳入当前速度估算。
-        start = this.startTime ?? this.speedWindow[0].time;
+        start = this.startTime ?? firstTime;
       } else {
         // 窗口因时间间隔过长（如重试）而滑动到只剩一项：
         // 使用上一个数据点的时间戳，确保速度反映重试开销，而非从操作开始算起
         start = this.prevTimestamp;
       }
     } else {
-      start = this.speedWindow[0].time;
+      start = firstTime;
     }
-    const end = Math.max(timestamp, this.speedWindow[this.speedWindow.length - 1].time);
+    const lastTime = this.windowTimes[(this.windowHead + this.windowCount - 1) % this.windowTimes.length];
+    const end = Math.max(timestamp, lastTime);
     const elapsedMs = end - start;
 
-    const windowBytes = this.speedWindow.reduce((sum, item) => sum + item.bytes, 0);
-    const rawSpeed = elapsedMs > 0 ? windowBytes / (elapsedMs / 1000) : 0;
+    const rawSpeed = elapsedMs > 0 ? this.windowByteSum / (elapsedMs / 1000) : 0;
 
     // 平滑：当前速度使用指数移动平均（EMA）
     this.currentSpeed = this.smoothingFactor * rawSpeed + (1 - this.smoothingFactor) * this.currentSpeed;
@@ -151,7 +151,9 @@ export class SpeedCalculator {
    * 重置速度计算器
    */
   reset(): void {
-    this.speedWindow = [];
+    this.windowHead = 0;
+    this.windowCount = 0;
+    this.windowByteSum = 0;
     this.currentSpeed = 0;
     this.peakSpeed = 0;
     this.maxSpeed = 0;
@@ -163,10 +165,41 @@ export class SpeedCalculator {
     this.prevTimestamp = 0;
   }
 
+  private pushDataPoint(time: number, bytes: number): void {
+    if (this.windowCount === this.windowTimes.length) {
+      this.growWindow();
+    }
+    const index = (this.windowHead + this.windowCount) % this.windowTimes.length;
+    this.windowTimes[index] = time;
+    this.windowBytes[index] = bytes;
+    this.windowCount++;
+    this.windowByteSum += bytes;
+  }
+
+  private growWindow(): void {
+    const capacity = this.windowTimes.length;
+    const times = new Float64Array(capacity * 2);
+    const bytes = new Float64Array(capacity * 2);
+    for (let i = 0; i < this.windowCount; i++) {
+      const index = (this.windowHead + i) % capacity;
+      times[i] = this.windowTimes[index];
+      bytes[i] = this.windowBytes[index];
+    }
+    this.windowTimes = times;
+    this.windowBytes = bytes;
+    this.windowHead = 0;
+  }
+
   private trimWindow(timestamp: number): void {
     const cutoff = timestamp - this.timeWindow;
-    while (this.speedWindow.length && this.speedWindow[0].time < cutoff) {
-      this.speedWindow.shift();
+    while (this.windowCount > 0 && this.windowTimes[this.windowHead] < cutoff) {
+      this.windowByteSum -= this.windowBytes[this.windowHead];
+      this.windowHead = (this.windowHead + 1) % this.windowTimes.length;
+      this.windowCount--;
+    }
+    if (this.windowCount === 0) {
+      // 清空时归零，避免浮点累计误差
+      this.windowByteSum = 0;
     }
   }
 }
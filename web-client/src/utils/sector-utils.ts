@@ -77,3 +77,87 @@ export function createSectorProgressInfo(
 
   return sectors;
 }
+
+/**
+ * 判断数据是否全为 0xFF（即擦除后的状态）
+ * 对齐时按 32 位比较，避免逐字节遍历整个扇区
+ */
+export function isErasedData(data: Uint8Array): boolean {
+  let i = 0;
+  if ((data.byteOffset & 3) === 0) {
+    const words = new Uint32Array(data.buffer, data.byteOffset, data.byteLength >>> 2);
+    for (; i < words.length; i++) {
+      if (words[i] !== 0xffffffff) {
+        return false;
+      }
+    }
+    i <<= 2;
+  }
+  for (; i < data.byteLength; i++) {
+    if (data[i] !== 0xff) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * 稀疏写入计划
+ */
+export interface SparseWritePlan {
+  /** 实际需要编程的字节数 */
+  programBytes: number;
+  /** 与扇区列表一一对应，每个扇区内需要编程的字节数 */
+  sectorProgramBytes: number[];
+  /** 镜像数据全为 0xFF、无需编程的扇区数 */
+  blankSectors: number;
+  /** 卡带上已是目标内容、整体跳过的扇区内的镜像字节数 */
+  unchangedBytes: number;
+}
+
+/**
+ * 按扇区分析待写入镜像：以 pageSize 为粒度统计需要编程的字节，
+ * 全 0xFF 的页擦除后即为目标内容，写入时直接跳过
+ * @param data - 镜像数据，下标 0 对应 baseAddress
+ * @param sectors - createSectorProgressInfo() 生成的扇区列表
+ * @param baseAddress - 写入起始地址
+ * @param size - 写入字节数
+ * @param pageSize - 单次编程的字节数
+ * @param unchangedSectors - 卡带上已是目标内容的扇区地址，整个扇区跳过
+ */
+export function planSparseWrite(
+  data: Uint8Array,
+  sectors: SectorProgressInfo[],
+  baseAddress: number,
+  size: number,
+  pageSize: number,
+  unchangedSectors?: ReadonlySet<number>,
+): SparseWritePlan {
+  const writeEnd = baseAddress + size;
+  let unchanged = 0;
+  let unchangedBytes = 0;
+  const sectorProgramBytes = sectors.map(({ address, size: sectorSize }) => {
+    const end = Math.min(writeEnd, address + sectorSize);
+    if (unchangedSectors?.has(address)) {
+      unchanged++;
+      unchangedBytes += end - Math.max(address, baseAddress);
+      return 0;
+    }
+    let bytes = 0;
+    for (let pageAddress = Math.max(address, baseAddress); pageAddress < end; pageAddress += pageSize) {
+      const offset = pageAddress - baseAddress;
+      const page = data.subarray(offset, offset + Math.min(pageSize, end - pageAddress));
+      if (!isErasedData(page)) {
+        bytes += page.byteLength;
+      }
+    }
+    return bytes;
+  });
+
+  return {
+    programBytes: sectorProgramBytes.reduce((sum, bytes) => sum + bytes, 0),
+    sectorProgramBytes,
+    blankSectors: sectorProgramBytes.filter(bytes => bytes === 0).length - unchanged,
+    unchangedBytes,
+  };
+}
@@ -0,0 +1,182 @@
+/**
+ * 校验比较：按 32 位字比较找出差异，收集完整的差异区间与每个扇区的差异字节数
+ */
+
+/** 比较跨度小于此值时逐字节比较，不值得创建字视图 */
+const WORD_COMPARE_MIN_BYTES = 64;
+
+/** 相隔不超过此字节数的差异合并为一个区间，避免损坏区域中偶然相同的字节把区间切碎 */
+const RANGE_MERGE_GAP = 16;
+
+/** 最多保留的差异区间数，超出后只计数 */
+const MAX_MISMATCH_RANGES = 256;
+
+export interface VerifyMismatchRange {
+  /** 区间起始地址（绝对地址） */
+  address: number;
+  /** 区间长度，包含区间内偶然相同的字节 */
+  length: number;
+  /** 区间内不同的字节数 */
+  mismatches: number;
+}
+
+export interface VerifyMismatchByte {
+  address: number;
+  expected: number;
+  actual: number;
+}
+
+interface SectorSpan {
+  address: number;
+  size: number;
+}
+
+/**
+ * 返回 [start, end) 内第一个不同字节的下标，全部相同时返回 -1
+ *
+ * 两段数据相对 4 字节边界的偏移一致时（文件数据与读取缓冲通常如此），
+ * 先逐字节对齐，再用 Uint32Array 视图按字比较，命中后在该字内定位字节。
+ */
+export function findFirstMismatch(
+  expected: Uint8Array,
+  actual: Uint8Array,
+  start = 0,
+  end = Math.min(expected.length, actual.length),
+): number {
+  let index = start;
+
+  if (end - index >= WORD_COMPARE_MIN_BYTES && ((expected.byteOffset + index) & 3) === ((actual.byteOffset + index) & 3)) {
+    while (((expected.byteOffset + index) & 3) !== 0) {
+      if (expected[index] !== actual[index]) {
+        return index;
+      }
+      index++;
+    }
+
+    const wordCount = (end - index) >>> 2;
+    const expectedWords = new Uint32Array(expected.buffer, expected.byteOffset + index, wordCount);
+    const actualWords = new Uint32Array(actual.buffer, actual.byteOffset + index, wordCount);
+    for (let word = 0; word < wordCount; word++) {
+      if (expectedWords[word] !== actualWords[word]) {
+        const wordStart = index + (word << 2);
+        for (let byte = wordStart; byte < wordStart + 4; byte++) {
+          if (expected[byte] !== actual[byte]) {
+            return byte;
+          }
+        }
+      }
+    }
+    index += wordCount << 2;
+  }
+
+  for (; index < end; index++) {
+    if (expected[index] !== actual[index]) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+function findFirstMatch(expected: Uint8Array, actual: Uint8Array, start: number, end: number): number {
+  for (let index = start; index < end; index++) {
+    if (expected[index] === actual[index]) {
+      return index;
+    }
+  }
+  return end;
+}
+
+/**
+ * 在一次校验中累计所有差异：区间（相邻差异合并）、每个扇区的差异字节数与第一个差异字节
+ */
+export class VerifyMismatchCollector {
+  readonly ranges: VerifyMismatchRange[] = [];
+  /** 区间总数，包含超出上限未保留的区间 */
+  rangeCount = 0;
+  mismatchCount = 0;
+  first: VerifyMismatchByte | null = null;
+
+  private readonly sectorMismatchCounts = new Map<number, number>();
+  /** 最后一个区间的结束地址（不含），用于跨分块合并 */
+  private lastRangeEnd = Number.NEGATIVE_INFINITY;
+
+  /**
+   * @param sectors - 按地址升序排列的扇区，用于统计每个扇区的差异字节数
+   * @param maxRanges - 最多保留的区间数
+   */
+  constructor(
+    private readonly sectors: readonly SectorSpan[] = [],
+    private readonly maxRanges = MAX_MISMATCH_RANGES,
+  ) {}
+
+  /**
+   * 比较一个分块，返回该分块内不同的字节数
+   * @param address - 分块第一个字节的绝对地址
+   */
+  compare(expected: Uint8Array, actual: Uint8Array, address: number): number {
+    const end = Math.min(expected.length, actual.length);
+    let chunkMismatches = 0;
+    let index = findFirstMismatch(expected, actual, 0, end);
+
+    while (index >= 0) {
+      const runEnd = findFirstMatch(expected, actual, index + 1, end);
+      if (this.first === null) {
+        this.first = { address: address + index, expected: expected[index], actual: actual[index] };
+      }
+      this.addRun(address + index, runEnd - index);
+      chunkMismatches += runEnd - index;
+      index = runEnd < end ? findFirstMismatch(expected, actual, runEnd, end) : -1;
+    }
+
+    this.mismatchCount += chunkMismatches;
+    return chunkMismatches;
+  }
+
+  sectorMismatches(sectorAddress: number): number {
+    return this.sectorMismatchCounts.get(sectorAddress) ?? 0;
+  }
+
+  get failedSectorCount(): number {
+    return this.sectorMismatchCounts.size;
+  }
+
+  private addRun(address: number, length: number): void {
+    const lastRange = this.ranges.length > 0 ? this.ranges[this.ranges.length - 1] : null;
+    if (address - this.lastRangeEnd <= RANGE_MERGE_GAP) {
+      if (lastRange && lastRange.address + lastRange.length === this.lastRangeEnd) {
+        lastRange.length = address + length - lastRange.address;
+        lastRange.mismatches += length;
+      }
+    } else {
+      this.rangeCount++;
+      if (this.ranges.length < this.maxRanges) {
+        this.ranges.push({ address, length, mismatches: length });
+      }
+    }
+    this.lastRangeEnd = address + length;
+    this.countSectors(address, address + length);
+  }
+
+  private countSectors(start: number, end: number): void {
+    let low = 0;
+    let high = this.sectors.length - 1;
+    let index = -1;
+    while (low <= high) {
+      const mid = (low + high) >>> 1;
+      if (this.sectors[mid].address <= start) {
+        index = mid;
+        low = mid + 1;
+      } else {
+        high = mid - 1;
+      }
+    }
+
+    for (let i = Math.max(index, 0); i < this.sectors.length && this.sectors[i].address < end; i++) {
+      const sector = this.sectors[i];
+      const overlap = Math.min(end, sector.address + sector.size) - Math.max(start, sector.address);
+      if (overlap > 0) {
+        this.sectorMismatchCounts.set(sector.address, this.sectorMismatches(sector.address) + overlap);
+      }
+    }
+  }
+}
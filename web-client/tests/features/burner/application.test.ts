@@ -1,69 +1,10 @@
 import { describe, expect, it, vi } from 'vitest';
 
-import { CartridgeProtocolPortAdapter } from '@/features/burner/adapters';
 import { BurnerSession } from '@/features/burner/application/burner-session';
-import { type BurnerOperationContext, BurnerUseCaseImpl } from '@/features/burner/application/burner-use-case';
-import type { BurnerProtocolSession } from '@/features/burner/application/domain/ports';
 import { runBurnerFlow } from '@/features/burner/application/flow-template';
 import type { CommandResult } from '@/types/command-result';
-import type { CFIInfo } from '@/utils/parsers/cfi-parser';
-
-const t = (key: string) => key;
-const toHex = (value: number) => `0x${value.toString(16)}`;
-
-function createFakeCfi(deviceSize = 0x20000): CFIInfo {
-  return {
-    deviceSize,
-    flashId: new Uint8Array([0x01, 0x02, 0x03, 0x04]),
-    eraseSectorBlocks: [
-      {
-        sectorSize: 0x10000,
-        sectorCount: Math.max(1, deviceSize / 0x10000),
-        totalSize: deviceSize,
-        startAddress: 0,
-        endAddress: deviceSize,
-      },
-    ],
-  } as CFIInfo;
-}
-
-function createSession(overrides: Partial<BurnerProtocolSession> = {}): BurnerProtocolSession {
-  const base: BurnerProtocolSession = {
-    id: 'session-1',
-    isActive: () => true,
-    getCartInfo: () => Promise.resolve(createFakeCfi()),
-    eraseSectors: () => Promise.resolve({ success: true, message: 'erase-ok' }),
-    writeROM: () => Promise.resolve({ success: true, message: 'write-rom-ok' }),
-    readROM: () => Promise.resolve({ success: true, message: 'read-rom-ok', data: new Uint8Array([1, 2, 3]) }),
-    verifyROM: () => Promise.resolve({ success: true, message: 'verify-rom-ok' }),
-    writeRAM: () => Promise.resolve({ success: true, message: 'write-ram-ok' }),
-    readRAM: () => Promise.resolve({ success: true, message: 'read-ram-ok', data: new Uint8Array([4, 5]) }),
-    verifyRAM: () => Promise.resolve({ success: true, message: 'verify-ram-ok' }),
-    resetCommandBuffer: () => Promise.resolve(),
-  };
-
-  return {
-    ...base,
-    ...overrides,
-  };
-}
-
-function createUseCase() {
-  return new BurnerUseCaseImpl(new CartridgeProtocolPortAdapter(), t, toHex);
-}
-
-function createContext(
-  session: BurnerProtocolSession,
-  cfi = createFakeCfi(),
-  extra: Partial<BurnerOperationContext> = {},
-): BurnerOperationContext {
-  return {
-    session,
-    cfiInfo: cfi,
-    options: { cfiInfo: cfi, mbcType: 'MBC5', enable5V: false },
-    ...extra,
-  };
-}
+
+import { createContext, createFakeCfi, createSession, createUseCase } from './use-case-fixtures';
 
 describe('BurnerSession', () => {
   it('should manage cancellable operation lifecycle', () => {
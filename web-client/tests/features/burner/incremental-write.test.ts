@@ -0,0 +1,103 @@
+import { webcrypto } from 'node:crypto';
+
+import { beforeEach, describe, expect, it, vi } from 'vitest';
+
+import type { BurnerOperationContext } from '@/features/burner/application/burner-use-case';
+import type { BurnerDigestCachePort, BurnerProtocolSession } from '@/features/burner/application/domain/ports';
+import type { SectorDigestRecord } from '@/features/burner/application/domain/sector-digest';
+import type { CommandOptions } from '@/types/command-options';
+
+import { createImageContext, createSession, createUseCase, IMAGE_SIZE, SECTOR_SIZE } from './use-case-fixtures';
+
+class MemoryDigestCache implements BurnerDigestCachePort {
+  readonly records = new Map<string, SectorDigestRecord>();
+
+  load(key: string): Promise<SectorDigestRecord | null> {
+    return Promise.resolve(this.records.get(key) ?? null);
+  }
+
+  save(record: SectorDigestRecord): Promise<void> {
+    this.records.set(record.key, record);
+    return Promise.resolve();
+  }
+
+  remove(key: string): Promise<void> {
+    this.records.delete(key);
+    return Promise.resolve();
+  }
+}
+
+/** 模拟卡带：写入成功后内容即为镜像，读取返回当前内容 */
+function createCart(verifyPasses = true) {
+  let contents = new Uint8Array(IMAGE_SIZE).fill(0xff);
+  const writeROM = vi.fn((data: Uint8Array, _options: CommandOptions) => {
+    contents = data.slice();
+    return Promise.resolve({ success: true, message: 'write-rom-ok' });
+  });
+  const readROM = vi.fn((size: number, options: CommandOptions) => {
+    const base = options.baseAddress ?? 0;
+    return Promise.resolve({ success: true, message: 'read-rom-ok', data: contents.slice(base, base + size) });
+  });
+  const verifyROM = vi.fn((_data: Uint8Array, _options: CommandOptions) =>
+    Promise.resolve(verifyPasses ? { success: true, message: 'verify-ok' } : { success: false, message: 'verify-failed' }));
+
+  const session = createSession({ writeROM, readROM, verifyROM });
+  return { session, writeROM, readROM, verifyROM };
+}
+
+function createContext(session: BurnerProtocolSession, data: Uint8Array): BurnerOperationContext & { data: Uint8Array } {
+  return { ...createImageContext(session), data };
+}
+
+function createBuild(revision: number, changedSectors: number[] = []): Uint8Array {
+  const image = Uint8Array.from({ length: IMAGE_SIZE }, (_, index) => (index * 13) & 0x7f);
+  for (const sector of changedSectors) {
+    image.fill(revision, sector * SECTOR_SIZE, sector * SECTOR_SIZE + 0x100);
+  }
+  return image;
+}
+
+describe('incremental ROM writes', () => {
+  let digestCache: MemoryDigestCache;
+
+  beforeEach(() => {
+    vi.stubGlobal('crypto', webcrypto);
+    digestCache = new MemoryDigestCache();
+  });
+
+  it('writes everything the first time and records sector digests', async () => {
+    const { session, writeROM, verifyROM } = createCart();
+
+    await expect(createUseCase({ digestCachePort: digestCache }).writeRom(createContext(session, createBuild(1)))).resolves.toMatchObject({ success: true });
+
+    expect(writeROM.mock.calls[0][1].unchangedSectors?.size).toBe(0);
+    expect(verifyROM).not.toHaveBeenCalled();
+    expect(digestCache.records.size).toBe(1);
+    expect(Object.keys([...digestCache.records.values()][0].sectors)).toHaveLength(IMAGE_SIZE / SECTOR_SIZE);
+  });
+
+  it('only erases and programs sectors that changed since the last write', async () => {
+    const { session, writeROM, verifyROM } = createCart();
+    const useCase = createUseCase({ digestCachePort: digestCache });
+
+    await useCase.writeRom(createContext(session, createBuild(1)));
+    await expect(useCase.writeRom(createContext(session, createBuild(2, [3, 9])))).resolves.toMatchObject({ success: true });
+
+    const unchanged = writeROM.mock.calls[1][1].unchangedSectors;
+    expect(unchanged?.size).toBe(14);
+    expect(unchanged?.has(3 * SECTOR_SIZE)).toBe(false);
+    expect(unchanged?.has(9 * SECTOR_SIZE)).toBe(false);
+    expect(verifyROM.mock.calls.map(([, options]) => options.baseAddress)).toEqual([0, 15 * SECTOR_SIZE]);
+    expect(digestCache.records.size).toBe(1);
+  });
+
+  it('falls back to a full write when the read-back check fails', async () => {
+    const { session, writeROM } = createCart(false);
+    const useCase = createUseCase({ digestCachePort: digestCache });
+
+    await useCase.writeRom(createContext(session, createBuild(1)));
+    await useCase.writeRom(createContext(session, createBuild(2, [3])));
+
+    expect(writeROM.mock.calls[1][1].unchangedSectors?.size).toBe(0);
+  });
+});
@@ -26,7 +26,7 @@ const nativeState = vi.hoisted(() => ({
   ],
   openNativeSerialPort: vi.fn(),
   closeNativeSerial: vi.fn(),
-  readNativeSerial: vi.fn(),
+  subscribeNativeSerial: vi.fn(),
   flushNativeSerialInput: vi.fn(),
   writeNativeSerial: vi.fn(),
   setNativeSerialSignals: vi.fn(),
@@ -37,7 +37,7 @@ vi.mock('@/platform/native', () => {
     listNativeSerialPorts: vi.fn(() => Promise.resolve(nativeState.availablePorts)),
     openNativeSerialPort: nativeState.openNativeSerialPort,
     closeNativeSerial: nativeState.closeNativeSerial,
-    readNativeSerial: nativeState.readNativeSerial,
+    subscribeNativeSerial: nativeState.subscribeNativeSerial,
     flushNativeSerialInput: nativeState.flushNativeSerialInput,
     writeNativeSerial: nativeState.writeNativeSerial,
     setNativeSerialSignals: nativeState.setNativeSerialSignals,
@@ -106,8 +106,8 @@ describe('Burner connection port adapters', () => {
     ];
     nativeState.openNativeSerialPort.mockResolvedValue({ sessionId: 1 });
     nativeState.closeNativeSerial.mockResolvedValue(undefined);
-    nativeState.readNativeSerial.mockResolvedValue(new Uint8Array([0xaa]));
-    nativeState.flushNativeSerialInput.mockResolvedValue(undefined);
+    nativeState.subscribeNativeSerial.mockResolvedValue(0);
+    nativeState.flushNativeSerialInput.mockResolvedValue(0);
     nativeState.writeNativeSerial.mockResolvedValue(undefined);
     nativeState.setNativeSerialSignals.mockResolvedValue(undefined);
   });
@@ -0,0 +1,252 @@
+import { webcrypto } from 'node:crypto';
+
+import { beforeEach, describe, expect, it, vi } from 'vitest';
+
+import type { BurnerOperationContext } from '@/features/burner/application/burner-use-case';
+import type { TransferJournal } from '@/features/burner/application/domain/journal';
+import type { BurnerJournalPort } from '@/features/burner/application/domain/ports';
+import type { CommandOptions } from '@/types/command-options';
+import type { DumpSink } from '@/types/dump-sink';
+
+import { createImageContext, createSession, createUseCase, IMAGE_SIZE, SECTOR_SIZE } from './use-case-fixtures';
+
+class MemoryJournalPort implements BurnerJournalPort {
+  readonly journals = new Map<string, TransferJournal>();
+  readonly data = new Map<string, Uint8Array>();
+
+  load(key: string): Promise<TransferJournal | null> {
+    const journal = this.journals.get(key);
+    return Promise.resolve(journal ? { ...journal, completedSectors: [...journal.completedSectors] } : null);
+  }
+
+  save(journal: TransferJournal): Promise<void> {
+    this.journals.set(journal.key, { ...journal, completedSectors: [...journal.completedSectors] });
+    return Promise.resolve();
+  }
+
+  remove(key: string): Promise<void> {
+    this.journals.delete(key);
+    this.data.delete(key);
+    return Promise.resolve();
+  }
+
+  appendData(key: string, offset: number, data: Uint8Array): Promise<void> {
+    const next = new Uint8Array(offset + data.byteLength);
+    next.set((this.data.get(key) ?? new Uint8Array(0)).subarray(0, offset));
+    next.set(data, offset);
+    this.data.set(key, next);
+    return Promise.resolve();
+  }
+
+  readData(key: string, length: number): Promise<Uint8Array> {
+    return Promise.resolve((this.data.get(key) ?? new Uint8Array(0)).slice(0, length));
+  }
+}
+
+function withDumpSink(context: BurnerOperationContext, dumpSink: DumpSink): BurnerOperationContext {
+  return { ...context, options: { ...context.options, dumpSink } };
+}
+
+interface MemoryFile {
+  data: Uint8Array;
+  length: number;
+}
+
+/** 模拟平台的转储文件：第一次写入前可按标识原地续写，否则从头写入 */
+function createFileSink(file: MemoryFile, token: string) {
+  let started = false;
+  return {
+    resumeToken: token,
+    write: vi.fn((chunk: Uint8Array) => {
+      if (!started) {
+        started = true;
+        file.length = 0;
+      }
+      file.data.set(chunk, file.length);
+      file.length += chunk.byteLength;
+      return Promise.resolve();
+    }),
+    resumeAt: vi.fn((resumeToken: unknown, offset: number) => {
+      if (started || resumeToken !== token || file.length < offset) {
+        return Promise.resolve(false);
+      }
+      started = true;
+      file.length = offset;
+      return Promise.resolve(true);
+    }),
+    close: () => Promise.resolve(),
+    suspend: vi.fn(() => Promise.resolve()),
+    abort: () => Promise.resolve(),
+  } satisfies DumpSink;
+}
+
+const image = Uint8Array.from({ length: IMAGE_SIZE }, (_, index) => (index * 7) & 0x7f);
+
+describe('resumable ROM transfers', () => {
+  let journalPort: MemoryJournalPort;
+  let failAt: number;
+
+  beforeEach(() => {
+    vi.stubGlobal('crypto', webcrypto);
+    journalPort = new MemoryJournalPort();
+    failAt = -1;
+  });
+
+  /** 按扇区写入，到 failAt 时模拟 USB 中断 */
+  const writeROM = vi.fn(async (data: Uint8Array, options: CommandOptions) => {
+    const base = options.baseAddress ?? 0;
+    for (let address = base; address < base + data.byteLength; address += SECTOR_SIZE) {
+      if (address === failAt) {
+        return { success: false, message: 'usb glitch' };
+      }
+      await options.checkpoint?.commit(address, SECTOR_SIZE);
+    }
+    return { success: true, message: 'write-rom-ok' };
+  });
+
+  /** 按扇区读出卡带内容，写入转储文件后提交断点，到 failAt 时模拟超时 */
+  function createReadROM(cart: Uint8Array) {
+    return vi.fn(async (size: number, options: CommandOptions) => {
+      const base = options.baseAddress ?? 0;
+      if (options.checkpoint) {
+        for (let address = base; address < base + size; address += SECTOR_SIZE) {
+          if (address === failAt) {
+            return { success: false, message: 'timeout' };
+          }
+          const chunk = cart.subarray(address, address + SECTOR_SIZE);
+          await options.dumpSink?.write(chunk);
+          await options.checkpoint.commit(address, SECTOR_SIZE, chunk);
+        }
+      }
+      return { success: true, message: 'read-rom-ok', data: options.dumpSink ? undefined : cart.slice(base, base + size) };
+    });
+  }
+
+  it('resumes a failed write from the first unfinished sector after checking finished ones', async () => {
+    writeROM.mockClear();
+    const verifyROM = vi.fn((_data: Uint8Array, _options: CommandOptions) => Promise.resolve({ success: true, message: 'verify-rom-ok' }));
+    const session = createSession({ writeROM, verifyROM });
+    const useCase = createUseCase({ journalPort });
+
+    failAt = 0x30000;
+    await expect(useCase.writeRom({ ...createImageContext(session), data: image })).resolves.toMatchObject({ success: false });
+    expect(journalPort.journals.size).toBe(1);
+
+    failAt = -1;
+    await expect(useCase.writeRom({ ...createImageContext(session), data: image })).resolves.toMatchObject({ success: true });
+
+    expect(verifyROM).toHaveBeenCalledTimes(2);
+    expect(verifyROM.mock.calls.map(([, options]) => options)).toMatchObject([
+      { baseAddress: 0, size: SECTOR_SIZE },
+      { baseAddress: 0x20000, size: SECTOR_SIZE },
+    ]);
+    const [resumedData, resumedOptions] = writeROM.mock.calls[1];
+    expect(resumedOptions).toMatchObject({ baseAddress: 0x30000, size: IMAGE_SIZE - 0x30000 });
+    expect(resumedData.byteLength).toBe(IMAGE_SIZE - 0x30000);
+    expect(journalPort.journals.size).toBe(0);
+  });
+
+  it('starts over when finished sectors no longer match the cartridge', async () => {
+    writeROM.mockClear();
+    const verifyROM = vi.fn((_data: Uint8Array, _options: CommandOptions) => Promise.resolve({ success: false, message: 'verify-failed' }));
+    const session = createSession({ writeROM, verifyROM });
+    const useCase = createUseCase({ journalPort });
+
+    failAt = 0x30000;
+    await useCase.writeRom({ ...createImageContext(session), data: image });
+    failAt = -1;
+    await expect(useCase.writeRom({ ...createImageContext(session), data: image })).resolves.toMatchObject({ success: true });
+
+    expect(verifyROM).toHaveBeenCalledTimes(1);
+    expect(writeROM.mock.calls[1][1]).toMatchObject({ baseAddress: 0, size: IMAGE_SIZE });
+  });
+
+  it('resumes a failed dump from the saved data and returns the whole image', async () => {
+    const readROM = createReadROM(image);
+    const session = createSession({ readROM });
+    const useCase = createUseCase({ journalPort });
+
+    failAt = 0xc0000;
+    await expect(useCase.readRom({ ...createImageContext(session), size: IMAGE_SIZE })).resolves.toMatchObject({ success: false });
+
+    failAt = -1;
+    const result = await useCase.readRom({ ...createImageContext(session), size: IMAGE_SIZE });
+    expect(result.success).toBe(true);
+    expect(result.data).toEqual(image);
+
+    // 每次先读头部指纹，续传前重读断点前 4 KiB
+    expect(readROM.mock.calls.map(([size, options]) => [size, options.baseAddress])).toEqual([
+      [0x150, undefined],
+      [IMAGE_SIZE, 0],
+      [0x150, undefined],
+      [0x1000, 0xbf000],
+      [IMAGE_SIZE - 0xc0000, 0xc0000],
+    ]);
+    expect(journalPort.journals.size).toBe(0);
+  });
+
+  it('does not resume a dump on another cartridge of the same model', async () => {
+    const useCase = createUseCase({ journalPort });
+    failAt = 0xc0000;
+    await useCase.readRom({ ...createImageContext(createSession({ readROM: createReadROM(image) })), size: IMAGE_SIZE });
+
+    failAt = -1;
+    const other = image.map(value => value ^ 0xff);
+    const readOther = createReadROM(other);
+    const result = await useCase.readRom({ ...createImageContext(createSession({ readROM: readOther })), size: IMAGE_SIZE });
+
+    expect(result.data).toEqual(other);
+    expect(readOther.mock.calls.map(([size, options]) => [size, options.baseAddress])).toEqual([
+      [0x150, undefined],
+      [IMAGE_SIZE, 0],
+    ]);
+  });
+
+  it('continues a streamed dump in the same file without copying it into journal storage', async () => {
+    const readROM = createReadROM(image);
+    const session = createSession({ readROM });
+    const useCase = createUseCase({ journalPort });
+    const file: MemoryFile = { data: new Uint8Array(IMAGE_SIZE), length: 0 };
+
+    failAt = 0xc0000;
+    const first = createFileSink(file, 'dump.gba');
+    await expect(useCase.readRom({ ...withDumpSink(createImageContext(session), first), size: IMAGE_SIZE })).resolves.toMatchObject({ success: false });
+    expect(first.suspend).toHaveBeenCalledTimes(1);
+    expect(journalPort.data.size).toBe(0);
+    expect([...journalPort.journals.values()]).toMatchObject([{ completedBytes: 0xc0000, sinkToken: 'dump.gba' }]);
+
+    failAt = -1;
+    const second = createFileSink(file, 'dump.gba');
+    await expect(useCase.readRom({ ...withDumpSink(createImageContext(session), second), size: IMAGE_SIZE })).resolves.toMatchObject({ success: true });
+    expect(second.resumeAt).toHaveBeenCalledWith('dump.gba', 0xc0000);
+    expect(readROM.mock.calls[readROM.mock.calls.length - 1][1]).toMatchObject({ baseAddress: 0xc0000 });
+    expect(file.length).toBe(IMAGE_SIZE);
+    expect(file.data).toEqual(image);
+    expect(journalPort.journals.size).toBe(0);
+  });
+
+  it('starts the file over when a different file is chosen for the resumed dump', async () => {
+    const session = createSession({ readROM: createReadROM(image) });
+    const useCase = createUseCase({ journalPort });
+    const file: MemoryFile = { data: new Uint8Array(IMAGE_SIZE), length: 0 };
+
+    failAt = 0xc0000;
+    await useCase.readRom({ ...withDumpSink(createImageContext(session), createFileSink(file, 'dump.gba')), size: IMAGE_SIZE });
+
+    failAt = -1;
+    const other: MemoryFile = { data: new Uint8Array(IMAGE_SIZE), length: 0 };
+    const sink = createFileSink(other, 'other.gba');
+    await expect(useCase.readRom({ ...withDumpSink(createImageContext(session), sink), size: IMAGE_SIZE })).resolves.toMatchObject({ success: true });
+    expect(sink.resumeAt).toHaveBeenCalledWith('dump.gba', 0xc0000);
+    expect(other.length).toBe(IMAGE_SIZE);
+    expect(other.data).toEqual(image);
+  });
+
+  it('does not journal small reads such as header probes', async () => {
+    const readROM = vi.fn((size: number, _options: CommandOptions) => Promise.resolve({ success: true, message: 'read-rom-ok', data: new Uint8Array(size) }));
+    const useCase = createUseCase({ journalPort });
+
+    await useCase.readRom({ ...createImageContext(createSession({ readROM })), size: 0x150 });
+    expect(readROM.mock.calls[0][1]).not.toHaveProperty('checkpoint');
+  });
+});
@@ -0,0 +1,162 @@
+import { describe, expect, it, vi } from 'vitest';
+
+import { CartridgeProtocolPortAdapter } from '@/features/burner/adapters';
+import {
+  BurnerStation,
+  type BurnerStationSink,
+  BurnerUseCaseImpl,
+} from '@/features/burner/application';
+import type {
+  BurnerConnectionHandle,
+  BurnerConnectionPort,
+  BurnerProtocolSession,
+  BurnerStationDevicePort,
+  BurnerStationMode,
+} from '@/features/burner/application/domain/ports';
+import type { CommandResult } from '@/types/command-result';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+const t = (key: string) => key;
+const toHex = (value: number) => `0x${value.toString(16)}`;
+
+function createFakeCfi(): CFIInfo {
+  return {
+    deviceSize: 0x20000,
+    flashId: new Uint8Array([0x01, 0x02, 0x03, 0x04]),
+    eraseSectorBlocks: [],
+  } as unknown as CFIInfo;
+}
+
+function deferred<T>() {
+  let resolve!: (value: T) => void;
+  const promise = new Promise<T>((resolvePromise) => {
+    resolve = resolvePromise;
+  });
+  return { promise, resolve };
+}
+
+function createConnectionPort(): BurnerConnectionPort {
+  return {
+    list: () => Promise.resolve({ ok: true, data: [{ path: '/dev/a' }, { path: '/dev/b' }] }),
+    select: () => Promise.resolve({ ok: true, data: { portInfo: { path: '/dev/auto' }, context: null } }),
+    connect: selection => Promise.resolve({
+      ok: true,
+      data: {
+        id: `mock:${selection?.portInfo?.path ?? 'auto'}`,
+        platform: 'web',
+        portInfo: selection?.portInfo,
+        context: null,
+      },
+    }),
+    init: () => Promise.resolve({ ok: true, data: undefined }),
+    disconnect: () => Promise.resolve({ ok: true, data: undefined }),
+  };
+}
+
+/**
+ * 每个端口路径对应一个假协议会话，writeROM 的行为由测试按路径指定
+ */
+function createDevicePort(writeROM: (path: string, sink: BurnerStationSink) => Promise<CommandResult>) {
+  const verifyROM = vi.fn(() => Promise.resolve({ success: true, message: 'verify-rom-ok' }));
+  const openSession = vi.fn((
+    handle: BurnerConnectionHandle,
+    mode: BurnerStationMode,
+    sink: BurnerStationSink,
+  ): Promise<BurnerProtocolSession> => {
+    const path = handle.portInfo?.path ?? 'auto';
+    return Promise.resolve({
+      id: `${handle.id}:${mode}`,
+      getCartInfo: () => Promise.resolve(createFakeCfi()),
+      eraseSectors: () => Promise.resolve({ success: true, message: 'erase-ok' }),
+      writeROM: () => writeROM(path, sink),
+      readROM: () => Promise.resolve({ success: true, message: 'read-rom-ok' }),
+      verifyROM,
+      writeRAM: () => Promise.resolve({ success: true, message: 'write-ram-ok' }),
+      readRAM: () => Promise.resolve({ success: true, message: 'read-ram-ok' }),
+      verifyRAM: () => Promise.resolve({ success: true, message: 'verify-ram-ok' }),
+      resetCommandBuffer: () => Promise.resolve(),
+    });
+  });
+  const port: BurnerStationDevicePort = { createConnectionPort, openSession };
+  return { port, openSession, verifyROM };
+}
+
+function createStation(devicePort: BurnerStationDevicePort) {
+  return new BurnerStation(devicePort, new BurnerUseCaseImpl(new CartridgeProtocolPortAdapter(), t, toHex));
+}
+
+describe('BurnerStation', () => {
+  it('flashes every connected burner concurrently and isolates failures', async () => {
+    const pending = new Map<string, ReturnType<typeof deferred<CommandResult>>>();
+    const { port } = createDevicePort((path) => {
+      const write = deferred<CommandResult>();
+      pending.set(path, write);
+      return write.promise;
+    });
+    const station = createStation(port);
+
+    const connected = await station.connectAll([
+      { portInfo: { path: '/dev/a' }, context: null },
+      { portInfo: { path: '/dev/b' }, context: null },
+    ]);
+    expect(connected.map(result => result.deviceId)).toEqual(['burner-1', 'burner-2']);
+
+    const run = station.runOnAll('gba', BurnerStation.romWriteJob(new Uint8Array(16)));
+    await vi.waitFor(() => {
+      expect([...pending.keys()].sort()).toEqual(['/dev/a', '/dev/b']);
+    });
+
+    pending.get('/dev/b')?.resolve({ success: false, message: 'program failed' });
+    pending.get('/dev/a')?.resolve({ success: true, message: 'write-rom-ok' });
+    const summary = await run;
+
+    expect(summary.succeeded).toBe(1);
+    expect(summary.failed).toBe(1);
+    expect(summary.results).toEqual([
+      expect.objectContaining({ deviceId: 'burner-1', portPath: '/dev/a', success: true }),
+      expect.objectContaining({ deviceId: 'burner-2', portPath: '/dev/b', success: false }),
+    ]);
+    expect(station.devices.every(device => !device.session.snapshot.busy)).toBe(true);
+  });
+
+  it('runs jobs for the same burner in order and keeps progress per burner', async () => {
+    const order: string[] = [];
+    const { port, openSession, verifyROM } = createDevicePort((path, sink) => {
+      order.push(`write:${path}`);
+      sink.updateProgress({ type: 'write', progress: path === '/dev/a' ? 50 : 100 });
+      return Promise.resolve({ success: true, message: 'write-rom-ok' });
+    });
+    const station = createStation(port);
+    await station.connect({ portInfo: { path: '/dev/a' }, context: null });
+    await station.connect({ portInfo: { path: '/dev/b' }, context: null });
+
+    const step = (name: string) => () => {
+      order.push(name);
+      return Promise.resolve({ success: true, message: name });
+    };
+    const summary = await station.run([
+      { deviceId: 'burner-1', mode: 'gba', run: BurnerStation.romWriteJob(new Uint8Array(16), { verify: true }) },
+      { deviceId: 'burner-1', mode: 'gba', run: step('after-write') },
+      { deviceId: 'burner-2', mode: 'mbc5', run: BurnerStation.romWriteJob(new Uint8Array(16)) },
+      { deviceId: 'burner-3', mode: 'gba', run: step('missing') },
+    ]);
+
+    expect(summary.results.map(result => result.message)).toEqual([
+      'verify-rom-ok',
+      'after-write',
+      'write-rom-ok',
+      'Unknown station device: burner-3',
+    ]);
+    expect(order.indexOf('write:/dev/a')).toBeLessThan(order.indexOf('after-write'));
+    expect(order).not.toContain('missing');
+    expect(verifyROM).toHaveBeenCalledTimes(1);
+    expect(openSession).toHaveBeenCalledTimes(2);
+
+    const [first, second] = station.devices;
+    expect(first.session.snapshot.progress.progress).toBe(50);
+    expect(second.session.snapshot.progress.progress).toBe(100);
+
+    await station.disconnectAll();
+    expect(station.devices).toEqual([]);
+  });
+});
@@ -0,0 +1,76 @@
+import { CartridgeProtocolPortAdapter } from '@/features/burner/adapters';
+import { type BurnerOperationContext, BurnerUseCaseImpl, type BurnerUseCaseServices } from '@/features/burner/application/burner-use-case';
+import type { BurnerProtocolSession } from '@/features/burner/application/domain/ports';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+/**
+ * 烧录用例测试共用的卡带、会话与用例构造
+ */
+
+export const SECTOR_SIZE = 0x10000;
+/** 断点续传与增量写入的测试镜像，正好达到记录断点的下限 */
+export const IMAGE_SIZE = 0x100000;
+
+export function createFakeCfi(deviceSize = 0x20000): CFIInfo {
+  return {
+    deviceSize,
+    flashId: new Uint8Array([0x01, 0x02, 0x03, 0x04]),
+    eraseSectorBlocks: [
+      {
+        sectorSize: SECTOR_SIZE,
+        sectorCount: Math.max(1, deviceSize / SECTOR_SIZE),
+        totalSize: deviceSize,
+        startAddress: 0,
+        endAddress: deviceSize,
+      },
+    ],
+  } as CFIInfo;
+}
+
+export function createSession(overrides: Partial<BurnerProtocolSession> = {}): BurnerProtocolSession {
+  const base: BurnerProtocolSession = {
+    id: 'session-1',
+    isActive: () => true,
+    getCartInfo: () => Promise.resolve(createFakeCfi()),
+    eraseSectors: () => Promise.resolve({ success: true, message: 'erase-ok' }),
+    writeROM: () => Promise.resolve({ success: true, message: 'write-rom-ok' }),
+    readROM: () => Promise.resolve({ success: true, message: 'read-rom-ok', data: new Uint8Array([1, 2, 3]) }),
+    verifyROM: () => Promise.resolve({ success: true, message: 'verify-rom-ok' }),
+    writeRAM: () => Promise.resolve({ success: true, message: 'write-ram-ok' }),
+    readRAM: () => Promise.resolve({ success: true, message: 'read-ram-ok', data: new Uint8Array([4, 5]) }),
+    verifyRAM: () => Promise.resolve({ success: true, message: 'verify-ram-ok' }),
+    resetCommandBuffer: () => Promise.resolve(),
+  };
+
+  return {
+    ...base,
+    ...overrides,
+  };
+}
+
+export function createUseCase(services: BurnerUseCaseServices = {}) {
+  return new BurnerUseCaseImpl(
+    new CartridgeProtocolPortAdapter(),
+    key => key,
+    value => `0x${value.toString(16)}`,
+    services,
+  );
+}
+
+export function createContext(
+  session: BurnerProtocolSession,
+  cfi = createFakeCfi(),
+  extra: Partial<BurnerOperationContext> = {},
+): BurnerOperationContext {
+  return {
+    session,
+    cfiInfo: cfi,
+    options: { cfiInfo: cfi, mbcType: 'MBC5', enable5V: false },
+    ...extra,
+  };
+}
+
+/** 容量为 IMAGE_SIZE 的卡带上的操作上下文 */
+export function createImageContext(session: BurnerProtocolSession): BurnerOperationContext {
+  return createContext(session, createFakeCfi(IMAGE_SIZE));
+}
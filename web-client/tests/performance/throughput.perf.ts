@@ -0,0 +1,286 @@
+import fs from 'fs';
+import path from 'path';
+import { fileURLToPath } from 'url';
+import { afterAll, beforeAll, describe, expect, it } from 'vitest';
+
+import { SimulatedDeviceGateway } from '@/platform/serial/simulated/device-gateway';
+import {
+  type SimulatedFirmwareModel,
+  STC_FIRMWARE_MODEL,
+  STM_FIRMWARE_MODEL,
+} from '@/platform/serial/simulated/firmware-model';
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import { GBACommand } from '@/protocol/beggar_socket/command';
+import { type CartridgeAdapter, GBAAdapter, MBC5Adapter } from '@/services';
+import { deviceConnectionManager } from '@/services/device-connection-manager';
+import { DebugSettings } from '@/settings/debug-settings';
+import type { CommandOptions } from '@/types/command-options';
+import type { CommandResult } from '@/types/command-result';
+import type { ProgressInfo } from '@/types/progress-info';
+
+/**
+ * 端到端吞吐基准：在按 STM / STC 固件建模的模拟设备上运行完整的适配器任务
+ *
+ * npm run bench          与基准数据比较，命令数增加或吞吐下降超过容差时失败；缺少基准也失败
+ * npm run bench:update   以本次结果覆盖基准数据
+ *
+ * 命令数与主机无关，提交在 throughput-baseline.json；模拟时间线按主机时钟推进，
+ * MB/s 只写入本机的 throughput-baseline.local.json（不提交），存在时才比较。
+ * 容差默认 15%，可用环境变量 BENCH_TOLERANCE（如 0.1）调整。
+ */
+
+const BENCH_DIR = path.dirname(fileURLToPath(import.meta.url));
+const BASELINE_FILE = path.join(BENCH_DIR, 'throughput-baseline.json');
+const LOCAL_BASELINE_FILE = path.join(BENCH_DIR, 'throughput-baseline.local.json');
+const UPDATE_BASELINE = import.meta.env.MODE === 'update-baseline';
+const TOLERANCE = Number(process.env.BENCH_TOLERANCE ?? 0.15);
+
+const GBA_IMAGE_SIZE = 512 * 1024;
+const MBC5_IMAGE_SIZE = 256 * 1024;
+
+type BenchPlatform = 'gba' | 'mbc5';
+type BenchOperation = 'write' | 'read' | 'verify';
+
+interface BenchResult {
+  name: string;
+  bytes: number;
+  elapsedMs: number;
+  mbPerSecond: number;
+  commands: number;
+  commandsByOpcode: Record<number, number>;
+  phases: Record<string, number>;
+}
+
+interface BaselineEntry {
+  commands: number;
+}
+
+interface LocalBaselineEntry {
+  mbPerSecond: number;
+}
+
+/**
+ * 按进度回调的类型切换统计各阶段耗时，首个进度之前的时间记为 setup
+ */
+class PhaseClock {
+  readonly phases: Record<string, number> = {};
+  private current = 'setup';
+  private since = performance.now();
+
+  mark(phase: string): void {
+    if (phase === this.current) {
+      return;
+    }
+    const now = performance.now();
+    this.phases[this.current] = (this.phases[this.current] ?? 0) + now - this.since;
+    this.current = phase;
+    this.since = now;
+  }
+
+  finish(): Record<string, number> {
+    this.mark('done');
+    return this.phases;
+  }
+}
+
+function createImage(size: number, seed: number): Uint8Array {
+  const data = new Uint8Array(size);
+  let value = seed >>> 0;
+  for (let index = 0; index < size; index++) {
+    value = (value * 1664525 + 1013904223) >>> 0;
+    data[index] = value >>> 24;
+  }
+  return data;
+}
+
+async function openBench(firmware: SimulatedFirmwareModel, platform: BenchPlatform) {
+  const gateway = new SimulatedDeviceGateway(firmware);
+  const handle = await gateway.connect();
+  await gateway.init(handle);
+  const transport = handle.transport;
+  if (!(transport instanceof SimulatedTransport)) {
+    throw new Error('Expected a simulated transport');
+  }
+
+  const device = await deviceConnectionManager.openHandle({
+    id: `bench:${firmware.id}:${platform}`,
+    platform: handle.platform,
+    portInfo: handle.portInfo,
+    context: handle,
+  });
+
+  let clock: PhaseClock | null = null;
+  const onProgress = (info: ProgressInfo) => {
+    if (info.type) {
+      clock?.mark(info.type);
+    }
+  };
+  const t = (key: string) => key;
+  const adapter: CartridgeAdapter = platform === 'gba'
+    ? new GBAAdapter(device, null, onProgress, t)
+    : new MBC5Adapter(device, null, onProgress, t);
+
+  const cfiInfo = await adapter.getCartInfo();
+  if (!cfiInfo) {
+    throw new Error(`${firmware.id}/${platform}: cart not detected`);
+  }
+  const options: CommandOptions = { cfiInfo, baseAddress: 0, mbcType: 'MBC5', enable5V: false };
+
+  const measure = async (
+    operation: BenchOperation,
+    bytes: number,
+    run: () => Promise<CommandResult>,
+  ): Promise<BenchResult> => {
+    const name = `${firmware.id}/${platform}/${operation}`;
+    const before = { ...transport.stats, commandsByOpcode: { ...transport.stats.commandsByOpcode } };
+    const phaseClock = new PhaseClock();
+    clock = phaseClock;
+    const startedAt = performance.now();
+    const result = await run();
+    const elapsedMs = performance.now() - startedAt;
+    const phases = phaseClock.finish();
+    clock = null;
+    if (!result.success) {
+      throw new Error(`${name} failed: ${result.message}`);
+    }
+
+    const commandsByOpcode: Record<number, number> = {};
+    for (const [opcode, count] of Object.entries(transport.stats.commandsByOpcode)) {
+      const delta = count - (before.commandsByOpcode[Number(opcode)] ?? 0);
+      if (delta > 0) {
+        commandsByOpcode[Number(opcode)] = delta;
+      }
+    }
+    return {
+      name,
+      bytes,
+      elapsedMs,
+      mbPerSecond: bytes / 1024 / 1024 / (elapsedMs / 1000),
+      commands: transport.stats.commands - before.commands,
+      commandsByOpcode,
+      phases,
+    };
+  };
+
+  return { transport, adapter, options, measure, close: () => gateway.disconnect(handle) };
+}
+
+function loadBaseline<T>(file: string): Record<string, T> | null {
+  if (!fs.existsSync(file)) {
+    return null;
+  }
+  return JSON.parse(fs.readFileSync(file, 'utf-8')) as Record<string, T>;
+}
+
+function writeBaseline(file: string, entries: Record<string, unknown>): void {
+  fs.writeFileSync(file, `${JSON.stringify(entries, null, 2)}\n`);
+  console.info(`[bench] baseline written to ${file}`);
+}
+
+function formatOpcodes(commandsByOpcode: Record<number, number>): string {
+  return Object.entries(commandsByOpcode)
+    .map(([opcode, count]) => `${Number(opcode).toString(16)}:${count}`)
+    .join(' ');
+}
+
+function formatPhases(phases: Record<string, number>): string {
+  return Object.entries(phases)
+    .filter(([, ms]) => ms >= 1)
+    .map(([phase, ms]) => `${phase} ${Math.round(ms)}ms`)
+    .join(', ');
+}
+
+describe('simulated end-to-end throughput', () => {
+  const results: BenchResult[] = [];
+
+  beforeAll(() => {
+    DebugSettings.debugMode = true;
+    DebugSettings.simulateErrors = false;
+    localStorage.clear();
+  });
+
+  afterAll(() => {
+    const baseline = loadBaseline<BaselineEntry>(BASELINE_FILE);
+    const localBaseline = loadBaseline<LocalBaselineEntry>(LOCAL_BASELINE_FILE);
+    console.table(results.map(result => ({
+      scenario: result.name,
+      KiB: result.bytes / 1024,
+      ms: Math.round(result.elapsedMs),
+      'MB/s': result.mbPerSecond.toFixed(3),
+      'baseline MB/s': localBaseline?.[result.name]?.mbPerSecond.toFixed(3) ?? '-',
+      commands: result.commands,
+      'baseline commands': baseline?.[result.name]?.commands ?? '-',
+      opcodes: formatOpcodes(result.commandsByOpcode),
+      phases: formatPhases(result.phases),
+    })));
+  });
+
+  const cases: { firmware: SimulatedFirmwareModel; platform: BenchPlatform; size: number }[] = [
+    { firmware: STM_FIRMWARE_MODEL, platform: 'gba', size: GBA_IMAGE_SIZE },
+    { firmware: STM_FIRMWARE_MODEL, platform: 'mbc5', size: MBC5_IMAGE_SIZE },
+    { firmware: STC_FIRMWARE_MODEL, platform: 'gba', size: GBA_IMAGE_SIZE },
+    { firmware: STC_FIRMWARE_MODEL, platform: 'mbc5', size: MBC5_IMAGE_SIZE },
+  ];
+
+  it.each(cases)('$firmware.id $platform write / read / verify', async ({ firmware, platform, size }) => {
+    const bench = await openBench(firmware, platform);
+    const image = createImage(size, size ^ firmware.descriptor.firmwareId);
+    const signal = new AbortController().signal;
+    const options = { ...bench.options, size };
+
+    // 碳酸丐不支持 GBA 扇区擦除，生产中先整片擦除；这里直接从空白卡带开始
+    if (platform === 'gba' && !firmware.descriptor.opcodes.includes(GBACommand.SECTOR_ERASE)) {
+      bench.transport.deviceState.gba.rom.fill(0xff);
+    }
+
+    try {
+      results.push(await bench.measure('write', size, () => bench.adapter.writeROM(image, options, signal)));
+      results.push(await bench.measure('read', size, async () => {
+        const result = await bench.adapter.readROM(size, options, signal);
+        expect(result.data).toEqual(image);
+        return result;
+      }));
+      results.push(await bench.measure('verify', size, () => bench.adapter.verifyROM(image, options, signal)));
+    } finally {
+      await bench.close();
+    }
+  }, 120_000);
+
+  it('stays within tolerance of the stored baseline', () => {
+    const current = Object.fromEntries(results.map(result => [result.name, { commands: result.commands }]));
+    const currentLocal = Object.fromEntries(results.map(result => [result.name, {
+      mbPerSecond: Number(result.mbPerSecond.toFixed(4)),
+    }]));
+
+    if (UPDATE_BASELINE) {
+      writeBaseline(BASELINE_FILE, current);
+      writeBaseline(LOCAL_BASELINE_FILE, currentLocal);
+      return;
+    }
+
+    const baseline = loadBaseline<BaselineEntry>(BASELINE_FILE);
+    if (!baseline) {
+      throw new Error(`Missing ${BASELINE_FILE}; run npm run bench:update and commit it`);
+    }
+    const localBaseline = loadBaseline<LocalBaselineEntry>(LOCAL_BASELINE_FILE);
+
+    const regressions: string[] = [];
+    for (const [name, entry] of Object.entries(current)) {
+      const expected = baseline[name];
+      if (!expected) {
+        regressions.push(`${name}: no baseline entry, run npm run bench:update`);
+        continue;
+      }
+      if (entry.commands > expected.commands * (1 + TOLERANCE)) {
+        regressions.push(`${name}: ${entry.commands} commands > baseline ${expected.commands}`);
+      }
+
+      const expectedLocal = localBaseline?.[name];
+      const { mbPerSecond } = currentLocal[name];
+      if (expectedLocal && mbPerSecond < expectedLocal.mbPerSecond * (1 - TOLERANCE)) {
+        regressions.push(`${name}: ${mbPerSecond} MB/s < local baseline ${expectedLocal.mbPerSecond} MB/s`);
+      }
+    }
+    expect(regressions).toEqual([]);
+  });
+});
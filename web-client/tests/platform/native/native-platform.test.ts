@@ -3,13 +3,24 @@ import { beforeEach, describe, expect, it, vi } from 'vitest';
 import {
   getNativeRuntimeMetadata,
   listNativeSerialPorts,
+  openDumpSink,
+  readNativeSerial,
+  runNativeSerialJob,
   saveBinaryFile,
+  writeNativeSerial,
 } from '@/platform/native';
 
 const invokeMock = vi.hoisted(() => vi.fn());
 
 vi.mock('@tauri-apps/api/core', () => ({
   invoke: invokeMock,
+  Channel: class {
+    id = 7;
+    onmessage: (message: unknown) => void = () => {};
+    toJSON(): string {
+      return `__CHANNEL__:${this.id}`;
+    }
+  },
 }));
 
 describe('native platform facade', () => {
@@ -58,6 +69,49 @@ describe('native platform facade', () => {
     }
   });
 
+  it('streams dump chunks to a Rust file handle and discards on abort', async () => {
+    (window as Window & { __TAURI_INTERNALS__?: unknown }).__TAURI_INTERNALS__ = {};
+    invokeMock.mockResolvedValueOnce({ sinkId: 3, path: '/tmp/game.gba' });
+
+    const { supported, sink } = await openDumpSink('game.gba');
+    expect(supported).toBe(true);
+    expect(sink?.path).toBe('/tmp/game.gba');
+    expect(invokeMock).toHaveBeenCalledWith('native_open_dump_sink', { suggestedFilename: 'game.gba' });
+
+    const chunk = new Uint8Array([1, 2, 3]);
+    await sink?.write(chunk);
+    expect(invokeMock).toHaveBeenCalledWith('native_dump_sink_write', chunk, { headers: { 'x-sink-id': '3' } });
+
+    await sink?.abort();
+    expect(invokeMock).toHaveBeenLastCalledWith('native_dump_sink_close', { sinkId: 3, discard: true });
+  });
+
+  it('resumes the same dump file in place and keeps it after suspending', async () => {
+    (window as Window & { __TAURI_INTERNALS__?: unknown }).__TAURI_INTERNALS__ = {};
+    invokeMock.mockResolvedValueOnce({ sinkId: 4, path: '/tmp/game.gba' });
+
+    const { sink } = await openDumpSink('game.gba');
+    expect(sink?.resumeToken).toBe('/tmp/game.gba');
+
+    await expect(sink?.resumeAt?.('/tmp/other.gba', 0x1000)).resolves.toBe(false);
+    expect(invokeMock).not.toHaveBeenCalledWith('native_dump_sink_resume', expect.anything());
+
+    invokeMock.mockResolvedValueOnce(true);
+    await expect(sink?.resumeAt?.('/tmp/game.gba', 0x1000)).resolves.toBe(true);
+    expect(invokeMock).toHaveBeenLastCalledWith('native_dump_sink_resume', { sinkId: 4, offset: 0x1000 });
+
+    await sink?.suspend?.();
+    expect(invokeMock).toHaveBeenLastCalledWith('native_dump_sink_close', { sinkId: 4, discard: false });
+    invokeMock.mockClear();
+    await sink?.abort();
+    expect(invokeMock).not.toHaveBeenCalled();
+  });
+
+  it('reports dump streaming as unsupported without a save file picker', async () => {
+    await expect(openDumpSink('game.gba')).resolves.toEqual({ supported: false });
+    expect(invokeMock).not.toHaveBeenCalled();
+  });
+
   it('loads runtime metadata from Rust in Tauri', async () => {
     (window as Window & { __TAURI_INTERNALS__?: unknown }).__TAURI_INTERNALS__ = {};
     invokeMock.mockResolvedValueOnce({
@@ -102,4 +156,65 @@ describe('native platform facade', () => {
       },
     ]);
   });
+
+  it('sends serial writes as a raw body with session headers', async () => {
+    invokeMock.mockResolvedValueOnce(undefined);
+    const bytes = new Uint8Array([1, 2, 3]);
+
+    await writeNativeSerial(4, bytes, 12.5);
+    expect(invokeMock).toHaveBeenCalledWith('native_serial_write', bytes, {
+      headers: { 'x-session-id': '4', 'x-timeout-ms': '13' },
+    });
+  });
+
+  it('wraps raw serial read responses without copying through JSON', async () => {
+    invokeMock.mockResolvedValueOnce(Uint8Array.from([0xaa, 0xbb]).buffer);
+
+    await expect(readNativeSerial(4, 2, 20)).resolves.toEqual(new Uint8Array([0xaa, 0xbb]));
+    expect(invokeMock).toHaveBeenCalledWith('native_serial_read', { sessionId: 4, length: 2, timeoutMs: 20 });
+  });
+
+  it('passes job descriptors in headers and decodes binary job results', async () => {
+    const data = new Uint8Array(8).fill(0x11);
+    invokeMock.mockResolvedValueOnce(Uint32Array.of(8).buffer);
+
+    await expect(runNativeSerialJob(4, {
+      kind: 'program',
+      opcode: 0xf4,
+      address: 0x100,
+      chunkSize: 4,
+      bufferSize: 4,
+      timeoutMs: 100,
+      timeoutPerByteMs: 2,
+      skipErased: true,
+      maxCommandSize: 5500,
+      data,
+    })).resolves.toEqual({ data: new Uint8Array(0), programmedBytes: 8 });
+
+    const [command, body, options] = invokeMock.mock.calls[0] as [string, Uint8Array, { headers: Record<string, string> }];
+    expect(command).toBe('native_serial_run_job');
+    expect(body).toBe(data);
+    expect(options.headers['x-progress-channel']).toBe('__CHANNEL__:7');
+    expect(JSON.parse(options.headers['x-native-job'])).toEqual({
+      kind: 'program',
+      opcode: 0xf4,
+      address: 0x100,
+      chunkSize: 4,
+      bufferSize: 4,
+      timeoutMs: 100,
+      timeoutPerByteMs: 2,
+      skipErased: true,
+      maxCommandSize: 5500,
+    });
+
+    invokeMock.mockResolvedValueOnce(Uint8Array.from([5, 6]).buffer);
+    await expect(runNativeSerialJob(4, {
+      kind: 'dump',
+      opcode: 0xf6,
+      address: 0,
+      size: 2,
+      chunkSize: 2,
+      timeoutMs: 100,
+    })).resolves.toEqual({ data: new Uint8Array([5, 6]), programmedBytes: 0 });
+  });
 });
@@ -0,0 +1,32 @@
+import { describe, expect, it } from 'vitest';
+
+import { ByteRing } from '@/platform/serial/byte-ring';
+
+describe('ByteRing', () => {
+  it('reads across the wrap point into a destination offset', () => {
+    const ring = new ByteRing(4);
+    const target = new Uint8Array(6);
+
+    ring.write(Uint8Array.of(1, 2, 3));
+    expect(ring.readInto(target, 0, 2)).toBe(2);
+    ring.write(Uint8Array.of(4, 5, 6));
+    expect(ring.length).toBe(4);
+    expect(ring.capacity).toBe(4);
+
+    expect(ring.readInto(target, 2, 10)).toBe(4);
+    expect(Array.from(target)).toEqual([1, 2, 3, 4, 5, 6]);
+    expect(ring.length).toBe(0);
+  });
+
+  it('grows while preserving byte order', () => {
+    const ring = new ByteRing(4);
+    ring.write(Uint8Array.of(1, 2, 3));
+    ring.skip(2);
+    ring.write(Uint8Array.of(4, 5, 6, 7, 8));
+
+    const target = new Uint8Array(6);
+    expect(ring.readInto(target, 0, 6)).toBe(6);
+    expect(Array.from(target)).toEqual([3, 4, 5, 6, 7, 8]);
+    expect(ring.capacity).toBe(8);
+  });
+});
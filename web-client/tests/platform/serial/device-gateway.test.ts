@@ -20,7 +20,7 @@ interface NativeState {
   availablePorts: MockAvailablePort[];
   openNativeSerialPort: ReturnType<typeof vi.fn>;
   closeNativeSerial: ReturnType<typeof vi.fn>;
-  readNativeSerial: ReturnType<typeof vi.fn>;
+  subscribeNativeSerial: ReturnType<typeof vi.fn>;
   flushNativeSerialInput: ReturnType<typeof vi.fn>;
   writeNativeSerial: ReturnType<typeof vi.fn>;
   setNativeSerialSignals: ReturnType<typeof vi.fn>;
@@ -48,7 +48,7 @@ const nativeState = vi.hoisted<NativeState>(() => ({
   ],
   openNativeSerialPort: vi.fn(),
   closeNativeSerial: vi.fn(),
-  readNativeSerial: vi.fn(),
+  subscribeNativeSerial: vi.fn(),
   flushNativeSerialInput: vi.fn(),
   writeNativeSerial: vi.fn(),
   setNativeSerialSignals: vi.fn(),
@@ -59,7 +59,7 @@ vi.mock('@/platform/native', () => {
     listNativeSerialPorts: vi.fn(() => Promise.resolve(nativeState.availablePorts)),
     openNativeSerialPort: nativeState.openNativeSerialPort,
     closeNativeSerial: nativeState.closeNativeSerial,
-    readNativeSerial: nativeState.readNativeSerial,
+    subscribeNativeSerial: nativeState.subscribeNativeSerial,
     flushNativeSerialInput: nativeState.flushNativeSerialInput,
     writeNativeSerial: nativeState.writeNativeSerial,
     setNativeSerialSignals: nativeState.setNativeSerialSignals,
@@ -82,8 +82,8 @@ describe('Device gateway integration', () => {
       },
     ];
     nativeState.openNativeSerialPort.mockResolvedValue({ sessionId: 1 });
-    nativeState.readNativeSerial.mockResolvedValue(new Uint8Array([0xaa]));
-    nativeState.flushNativeSerialInput.mockResolvedValue(undefined);
+    nativeState.subscribeNativeSerial.mockResolvedValue(0);
+    nativeState.flushNativeSerialInput.mockResolvedValue(0);
     nativeState.closeNativeSerial.mockResolvedValue(undefined);
     nativeState.writeNativeSerial.mockResolvedValue(undefined);
     nativeState.setNativeSerialSignals.mockResolvedValue(undefined);
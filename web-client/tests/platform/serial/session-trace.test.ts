@@ -0,0 +1,104 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { RecordingTransport } from '@/platform/serial/recording-transport';
+import { decodeSessionTrace, SessionTraceRecorder } from '@/platform/serial/session-trace';
+import { type SimulatedFirmwareModel, STM_FIRMWARE_MODEL } from '@/platform/serial/simulated/firmware-model';
+import { DEFAULT_SIMULATED_CART_FLASH, MX29LV_FLASH_CHIP } from '@/platform/serial/simulated/flash-model';
+import { createSimulatedDeviceState } from '@/platform/serial/simulated/runtime';
+import {
+  compareCommandTimings,
+  extractCommandTimings,
+  replaySessionTrace,
+} from '@/platform/serial/simulated/trace-replay';
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import { createCommandPayload, DiagnosticCommand, encodeFrame, GBCCommand } from '@/protocol';
+import { stm32CRC32 } from '@/utils/crc-utils';
+
+describe('session trace', () => {
+  /** 链路不计时，回包立即可读 */
+  const instantModel: SimulatedFirmwareModel = { ...STM_FIRMWARE_MODEL, usbBytesPerSecond: 0, commandLatencyMs: 0 };
+  const deviceInfo = createCommandPayload(DiagnosticCommand.DEVICE_INFO).build();
+
+  const finish = (recorder: SessionTraceRecorder) => decodeSessionTrace(recorder.stop() ?? new Uint8Array(0));
+
+  beforeEach(() => {
+    vi.spyOn(performance, 'now').mockReturnValue(0);
+  });
+
+  afterEach(() => {
+    vi.restoreAllMocks();
+  });
+
+  it('records signals, commands and responses with opcode, length and hash', async () => {
+    const recorder = new SessionTraceRecorder();
+    const transport = new RecordingTransport(new SimulatedTransport(createSimulatedDeviceState(instantModel)), recorder);
+
+    recorder.start({ includePayloads: true });
+    await transport.setSignals({ dataTerminalReady: true, requestToSend: true });
+    const response = await transport.sendAndReceive(deviceInfo, 64);
+    const trace = finish(recorder);
+
+    expect(trace.includesPayloads).toBe(true);
+    expect(trace.events.map(event => [event.kind, event.opcode])).toEqual([
+      ['signals', 3],
+      ['tx', DiagnosticCommand.DEVICE_INFO],
+      ['rx', DiagnosticCommand.DEVICE_INFO],
+    ]);
+    expect(trace.events[1].payload).toEqual(deviceInfo);
+    expect(trace.events[2]).toMatchObject({ length: response.data.byteLength, hash: stm32CRC32(response.data) });
+  });
+
+  it('keeps only hashes by default, unwraps frames and records nothing while stopped', async () => {
+    const recorder = new SessionTraceRecorder();
+    const transport = new RecordingTransport(new SimulatedTransport(createSimulatedDeviceState(instantModel)), recorder);
+
+    await transport.sendAndReceive(deviceInfo, 64);
+    expect(recorder.stop()).toBeNull();
+
+    recorder.start();
+    const frame = encodeFrame(deviceInfo, 7);
+    await transport.sendAndReceive(frame, 64);
+    const trace = finish(recorder);
+
+    expect(trace.events).toHaveLength(2);
+    expect(trace.events[0]).toMatchObject({ kind: 'tx', opcode: DiagnosticCommand.DEVICE_INFO, length: frame.byteLength });
+    expect(trace.events[0].payload).toBeUndefined();
+    expect(() => replaySessionTrace(trace)).toThrow(/without payloads/);
+  });
+
+  it('replays commands on the simulated device and reports per-command latency deltas', () => {
+    const program = createCommandPayload(GBCCommand.ROM_PROGRAM)
+      .addAddress(0)
+      .addLittleEndian(4, 2)
+      .addBytes(new Uint8Array([1, 2, 3, 4]))
+      .build();
+    const ack = new Uint8Array([0xaa]);
+    const recorder = new SessionTraceRecorder();
+
+    recorder.start({ includePayloads: true });
+    recorder.recordTx(0, program, 1000);
+    recorder.recordRx(0, ack, 1100);
+    recorder.recordTx(0, program, 1200);
+    recorder.recordRx(0, ack, 1210);
+    const trace = finish(recorder);
+
+    const recorded = extractCommandTimings(trace);
+    expect(recorded.map(timing => timing.latencyMs)).toEqual([100, 10]);
+
+    // 1 字节/ms 的链路、固定开销 2 ms、写缓冲编程 4 ms
+    const replayed = replaySessionTrace(trace, {
+      firmware: { ...STM_FIRMWARE_MODEL, usbBytesPerSecond: 1000, commandLatencyMs: 2 },
+      flash: {
+        ...DEFAULT_SIMULATED_CART_FLASH,
+        gbcRom: { ...MX29LV_FLASH_CHIP, writeBufferSize: 4, bufferProgramUs: { typical: 4000, max: 4000 } },
+      },
+    });
+    const expected = program.byteLength + 4 + 2 + 1;
+    expect(replayed.map(timing => timing.latencyMs)).toEqual([expected, expected].map(value => expect.closeTo(value)));
+
+    const comparison = compareCommandTimings(replayed, recorded);
+    expect(comparison.opcodeMismatches).toBe(0);
+    expect(comparison.commands.map(entry => entry.deltaMs)).toEqual([100 - expected, 10 - expected].map(value => expect.closeTo(value)));
+    expect(comparison.byOpcode).toEqual([expect.objectContaining({ opcode: GBCCommand.ROM_PROGRAM, count: 2 })]);
+  });
+});
@@ -0,0 +1,114 @@
+import { describe, expect, it } from 'vitest';
+
+import {
+  type SimulatedFirmwareModel,
+  STC_FIRMWARE_MODEL,
+  STM_FIRMWARE_MODEL,
+} from '@/platform/serial/simulated/firmware-model';
+import { SimulatedFirmwareStream } from '@/platform/serial/simulated/firmware-stream';
+import { DEFAULT_SIMULATED_CART_FLASH, MX29LV_FLASH_CHIP } from '@/platform/serial/simulated/flash-model';
+import { createSimulatedDeviceState } from '@/platform/serial/simulated/runtime';
+import {
+  createCommandPayload,
+  DiagnosticCommand,
+  encodeFrame,
+  GBCCommand,
+  parseFrameResponseHeader,
+} from '@/protocol';
+import { parseDeviceInfo } from '@/utils/parsers/device-info-parser';
+
+describe('SimulatedFirmwareStream', () => {
+  /** 1 字节/ms 的链路，固定开销 2 ms */
+  const model: SimulatedFirmwareModel = {
+    ...STM_FIRMWARE_MODEL,
+    usbBytesPerSecond: 1000,
+    commandLatencyMs: 2,
+  };
+
+  /** 4 字节写缓冲编程 4 ms */
+  const createStream = (firmware: SimulatedFirmwareModel = model) => new SimulatedFirmwareStream(
+    createSimulatedDeviceState(firmware, {
+      ...DEFAULT_SIMULATED_CART_FLASH,
+      gbcRom: { ...MX29LV_FLASH_CHIP, writeBufferSize: 4, bufferProgramUs: { typical: 4000, max: 4000 } },
+    }),
+  );
+
+  const directWrite = createCommandPayload(GBCCommand.DIRECT_WRITE)
+    .addAddress(0x2000)
+    .addBytes(new Uint8Array([1]))
+    .build();
+  const deviceInfo = createCommandPayload(DiagnosticCommand.DEVICE_INFO).build();
+  const createProgram = (data: number[]) => createCommandPayload(GBCCommand.ROM_PROGRAM)
+    .addAddress(0)
+    .addLittleEndian(4, 2)
+    .addBytes(new Uint8Array(data))
+    .build();
+  const program = createProgram([1, 2, 3, 4]);
+
+  const concat = (...chunks: Uint8Array[]) => {
+    const merged = new Uint8Array(chunks.reduce((size, chunk) => size + chunk.byteLength, 0));
+    let offset = 0;
+    for (const chunk of chunks) {
+      merged.set(chunk, offset);
+      offset += chunk.byteLength;
+    }
+    return merged;
+  };
+
+  it('reassembles a command split across chunks by its length prefix', () => {
+    const stream = createStream();
+
+    expect(stream.receive(deviceInfo.subarray(0, 2), 0)).toEqual([]);
+    const [output] = stream.receive(deviceInfo.subarray(2), 0);
+
+    expect(parseDeviceInfo(output.data.subarray(2))).toMatchObject({ firmwareId: 'stm', frameProtocol: true });
+  });
+
+  it('times responses by link throughput, flash busy time and command latency', () => {
+    const stream = createStream();
+    stream.deviceState.gbc.rom.fill(0xff, 0, 4);
+
+    const [output] = stream.receive(program, 0);
+
+    // 传输 + 编程 4 ms + 固定开销 2 ms + 1 字节 ACK
+    expect(output.at).toBeCloseTo(program.byteLength + 4 + 2 + 1);
+    expect(stream.deviceState.gbc.rom.subarray(0, 4)).toEqual(new Uint8Array([1, 2, 3, 4]));
+  });
+
+  it('drops v1 data received while busy and clears the buffer after each command', () => {
+    const stream = createStream();
+
+    expect(stream.receive(concat(directWrite, directWrite), 0)).toHaveLength(1);
+    // 分 4 块编程共 16 ms，完成前到达的命令被丢弃
+    stream.receive(createProgram(new Array(16).fill(0)), 100);
+    expect(stream.receive(directWrite, 100)).toEqual([]);
+    expect(stream.receive(directWrite, 200)).toHaveLength(1);
+  });
+
+  it('queues v2 frames received back to back', () => {
+    const stream = createStream();
+
+    const outputs = stream.receive(concat(encodeFrame(directWrite, 1), encodeFrame(directWrite, 2)), 0);
+
+    expect(outputs.map(output => parseFrameResponseHeader(output.data)?.seq)).toEqual([1, 2]);
+    expect(outputs[1].at).toBeGreaterThan(outputs[0].at);
+  });
+
+  it('discards a partial command on a DTR rising edge', () => {
+    const stream = createStream();
+    stream.setSignals({ dataTerminalReady: true, requestToSend: true });
+
+    expect(stream.receive(directWrite.subarray(0, 4), 0)).toEqual([]);
+    stream.setSignals({ dataTerminalReady: false });
+    stream.setSignals({ dataTerminalReady: true });
+
+    expect(stream.receive(deviceInfo, 10)).toHaveLength(1);
+  });
+
+  it('does not answer commands the firmware does not implement', () => {
+    const stream = createStream({ ...STC_FIRMWARE_MODEL, usbBytesPerSecond: 0 });
+
+    expect(stream.receive(encodeFrame(directWrite, 1), 0)).toEqual([]);
+    expect(stream.receive(directWrite, 0)).toHaveLength(1);
+  });
+});
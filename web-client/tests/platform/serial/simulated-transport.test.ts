@@ -1,7 +1,15 @@
-import { beforeEach, describe, expect, it, vi } from 'vitest';
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
 
+import { type SimulatedFirmwareModel, STM_FIRMWARE_MODEL } from '@/platform/serial/simulated/firmware-model';
+import {
+  DEFAULT_SIMULATED_CART_FLASH,
+  MX29LV_FLASH_CHIP,
+  type SimulatedCartFlash,
+} from '@/platform/serial/simulated/flash-model';
+import { createSimulatedDeviceState } from '@/platform/serial/simulated/runtime';
 import { SimulatedTransport } from '@/platform/serial/simulated/transport';
-import { createCommandPayload, GBCCommand } from '@/protocol';
+import { createCommandPayload, DiagnosticCommand, GBCCommand } from '@/protocol';
+import { parseDeviceInfo } from '@/utils/parsers/device-info-parser';
 import { DebugSettings } from '@/settings/debug-settings';
 
 const timeoutMock = vi.hoisted(() => vi.fn().mockResolvedValue(undefined));
@@ -39,3 +47,148 @@ describe('SimulatedTransport speed control', () => {
     expect(timeoutMock).toHaveBeenNthCalledWith(2, 100 + Math.ceil((1 / (2 * 1024)) * 1000));
   });
 });
+
+describe('SimulatedTransport firmware model', () => {
+  let now = 0;
+
+  /** 1 字节/ms 的链路，固定开销 2 ms */
+  const model: SimulatedFirmwareModel = {
+    ...STM_FIRMWARE_MODEL,
+    usbBytesPerSecond: 1000,
+    commandLatencyMs: 2,
+  };
+
+  /** 4 字节写缓冲编程 4 ms，扇区擦除 50 ms，擦除窗口 20 ms */
+  const flash: SimulatedCartFlash = {
+    ...DEFAULT_SIMULATED_CART_FLASH,
+    gbcRom: {
+      ...MX29LV_FLASH_CHIP,
+      writeBufferSize: 4,
+      bufferProgramUs: { typical: 4000, max: 4000 },
+      sectorEraseMs: { typical: 50, max: 50 },
+      sectorEraseWindowUs: 20_000,
+      spread: 0,
+    },
+  };
+
+  const createTransport = (firmware = model) => new SimulatedTransport(createSimulatedDeviceState(firmware, flash));
+
+  beforeEach(() => {
+    now = 0;
+    vi.spyOn(performance, 'now').mockImplementation(() => now);
+    timeoutMock.mockReset();
+    timeoutMock.mockImplementation((ms: number) => {
+      now += ms;
+      return Promise.resolve();
+    });
+  });
+
+  afterEach(() => {
+    vi.restoreAllMocks();
+  });
+
+  const createProgram = (data: number[], bufferSize = 4) => createCommandPayload(GBCCommand.ROM_PROGRAM)
+    .addAddress(0)
+    .addLittleEndian(bufferSize, 2)
+    .addBytes(new Uint8Array(data))
+    .build();
+  const program = createProgram([1, 2, 3, 4]);
+
+  const createGbcAccess = (transport: SimulatedTransport) => ({
+    write: (address: number, value: number) => transport.sendAndReceive(
+      createCommandPayload(GBCCommand.DIRECT_WRITE).addAddress(address).addBytes(new Uint8Array([value])).build(),
+      1,
+    ),
+    read: async (address = 0) => Array.from((await transport.sendAndReceive(
+      createCommandPayload(GBCCommand.READ).addAddress(address).addLength(2).build(),
+      4,
+    )).data.subarray(2)),
+  });
+
+  const SECTOR_ERASE_SEQUENCE = [[0xaaa, 0xaa], [0x555, 0x55], [0xaaa, 0x80], [0xaaa, 0xaa], [0x555, 0x55]];
+
+  it('waits for the whole packet before programming on buffered firmware', async () => {
+    const transport = createTransport();
+
+    await transport.sendAndReceive(program, 1);
+
+    // 传输 + 编程 4 ms + 固定开销 2 ms + 1 字节 ACK
+    expect(now).toBeCloseTo(program.byteLength + 4 + 2 + 1);
+    expect(transport.stats).toMatchObject({ commands: 1, commandsByOpcode: { [GBCCommand.ROM_PROGRAM]: 1 } });
+  });
+
+  it('overlaps programming with the transfer on streaming firmware', async () => {
+    const transport = createTransport({ ...model, streamingCommand: true });
+
+    await transport.sendAndReceive(program, 1);
+
+    expect(now).toBeCloseTo(program.byteLength + 2 + 1);
+  });
+
+  it('reads DQ7/DQ6 status instead of data until a sector erase completes', async () => {
+    const { write, read } = createGbcAccess(createTransport());
+
+    for (const [address, value] of [...SECTOR_ERASE_SEQUENCE, [0x0000, 0x30]]) {
+      await write(address, value);
+    }
+    now += 20;
+
+    // 擦除窗口已过。DQ7 = 0，DQ6 每次读取翻转，DQ3 表示擦除已开始，DQ2 在被擦除的扇区内翻转
+    expect(await read()).toEqual([0x08, 0x4c]);
+    expect(await read()).toEqual([0x08, 0x4c]);
+    now += 50;
+    expect(await read()).toEqual([0xff, 0xff]);
+  });
+
+  it('merges sector addresses written inside the erase window into one erase', async () => {
+    const { write, read } = createGbcAccess(createTransport());
+
+    await write(0x2000, 4);
+    for (const [address, value] of [...SECTOR_ERASE_SEQUENCE, [0x0000, 0x30]]) {
+      await write(address, value);
+    }
+    // bank 4 的 0x4000 对应第二个扇区，窗口内只需再写一次 0x30
+    await write(0x4000, 0x30);
+
+    // 单个扇区此时早已擦完，两个扇区排队时仍在忙
+    now += 60;
+    expect((await read(0x4000))[0] & 0x80).toBe(0);
+    now += 60;
+    expect(await read(0x4000)).toEqual([0xff, 0xff]);
+    expect(await read(0x0000)).toEqual([0xff, 0xff]);
+  });
+
+  it('only clears bits when programming and aborts blocks larger than the write buffer', async () => {
+    const transport = createTransport();
+    const rom = transport.deviceState.gbc.rom;
+    rom.fill(0xff, 0, 4);
+
+    await transport.sendAndReceive(createProgram([0x0f, 0xf0, 0x33, 0xff]), 1);
+    await transport.sendAndReceive(createProgram([0xff, 0x0f, 0x0f, 0x01]), 1);
+    expect(Array.from(rom.subarray(0, 4))).toEqual([0x0f, 0x00, 0x03, 0x01]);
+
+    await transport.sendAndReceive(createProgram([0, 0, 0, 0], 8), 1);
+    expect(Array.from(rom.subarray(0, 4))).toEqual([0x0f, 0x00, 0x03, 0x01]);
+  });
+
+  it('does not program the CRC placeholder after the data', async () => {
+    const transport = createTransport();
+    const rom = transport.deviceState.gbc.rom;
+    rom.fill(0xff, 0, 8);
+
+    await transport.sendAndReceive(createProgram([1, 2, 3, 4]), 1);
+    expect(Array.from(rom.subarray(0, 8))).toEqual([1, 2, 3, 4, 0xff, 0xff, 0xff, 0xff]);
+  });
+
+  it('reports the modeled firmware descriptor', async () => {
+    const transport = createTransport();
+    const response = await transport.sendAndReceive(createCommandPayload(DiagnosticCommand.DEVICE_INFO).build(), 50);
+
+    expect(parseDeviceInfo(response.data.subarray(2))).toMatchObject({
+      firmwareId: 'stm',
+      frameProtocol: true,
+      streamingCommand: false,
+      maxCommandSize: 5500,
+    });
+  });
+});
@@ -3,39 +3,58 @@ import { beforeEach, describe, expect, it, vi } from 'vitest';
 import { TauriSerialTransport } from '@/platform/serial/tauri/tauri-serial-transport';
 
 const nativeState = vi.hoisted(() => ({
-  readNativeSerial: vi.fn(),
+  subscribeNativeSerial: vi.fn(),
   writeNativeSerial: vi.fn(),
   setNativeSerialSignals: vi.fn(),
   flushNativeSerialInput: vi.fn(),
   closeNativeSerial: vi.fn(),
+  runNativeSerialJob: vi.fn(),
+  cancelNativeSerialJob: vi.fn(),
+  onPacket: (_packet: ArrayBuffer) => {},
 }));
 
 vi.mock('@/platform/native', () => ({
-  readNativeSerial: nativeState.readNativeSerial,
+  subscribeNativeSerial: nativeState.subscribeNativeSerial,
   writeNativeSerial: nativeState.writeNativeSerial,
   setNativeSerialSignals: nativeState.setNativeSerialSignals,
   flushNativeSerialInput: nativeState.flushNativeSerialInput,
   closeNativeSerial: nativeState.closeNativeSerial,
+  runNativeSerialJob: nativeState.runNativeSerialJob,
+  cancelNativeSerialJob: nativeState.cancelNativeSerialJob,
 }));
 
+/** 模拟后端读取线程推送的 `[generation:4 LE] data` 包 */
+function push(bytes: number[], generation = 0): void {
+  const packet = new Uint8Array(4 + bytes.length);
+  new DataView(packet.buffer).setUint32(0, generation, true);
+  packet.set(bytes, 4);
+  nativeState.onPacket(packet.buffer);
+}
+
 describe('TauriSerialTransport', () => {
   beforeEach(() => {
     vi.restoreAllMocks();
-    nativeState.readNativeSerial.mockResolvedValue(new Uint8Array([0xaa]));
+    nativeState.subscribeNativeSerial.mockImplementation((_sessionId: number, onPacket: (packet: ArrayBuffer) => void) => {
+      nativeState.onPacket = onPacket;
+      return Promise.resolve(0);
+    });
     nativeState.writeNativeSerial.mockResolvedValue(undefined);
     nativeState.setNativeSerialSignals.mockResolvedValue(undefined);
-    nativeState.flushNativeSerialInput.mockResolvedValue(undefined);
+    nativeState.flushNativeSerialInput.mockResolvedValue(1);
     nativeState.closeNativeSerial.mockResolvedValue(undefined);
+    nativeState.cancelNativeSerialJob.mockResolvedValue(undefined);
   });
 
-  it('supports send and exact direct reads', async () => {
+  it('serves exact reads from pushed packets', async () => {
     const transport = new TauriSerialTransport(1);
     await transport.attachListener();
+    expect(nativeState.subscribeNativeSerial).toHaveBeenCalledWith(1, expect.any(Function));
 
     await expect(transport.send(new Uint8Array([1, 2, 3]), 20)).resolves.toBe(true);
-    nativeState.readNativeSerial.mockResolvedValueOnce(new Uint8Array([0xaa, 0xbb]));
-    nativeState.readNativeSerial.mockResolvedValueOnce(new Uint8Array([0xcc]));
-    await expect(transport.read(2, 20)).resolves.toEqual({ data: new Uint8Array([0xaa, 0xbb]) });
+    push([0xaa]);
+    const pending = transport.read(2, 20);
+    push([0xbb, 0xcc]);
+    await expect(pending).resolves.toEqual({ data: new Uint8Array([0xaa, 0xbb]) });
     await expect(transport.read(1, 20)).resolves.toEqual({ data: new Uint8Array([0xcc]) });
   });
 
@@ -43,8 +62,7 @@ describe('TauriSerialTransport', () => {
     const transport = new TauriSerialTransport(1);
     await transport.attachListener();
 
-    nativeState.readNativeSerial.mockResolvedValueOnce(new Uint8Array([0xaa]));
-    nativeState.readNativeSerial.mockRejectedValueOnce(new Error('Read package timeout in 5ms'));
+    push([0xaa]);
     await expect(transport.read(2, 5)).rejects.toThrow('Read package timeout in 5ms');
   });
 
@@ -55,11 +73,10 @@ describe('TauriSerialTransport', () => {
     const writes: number[] = [];
     nativeState.writeNativeSerial.mockImplementation((_sessionId: number, payload: Uint8Array) => {
       writes.push(payload[0] ?? 0);
+      // 设备回显命令首字节
+      queueMicrotask(() => { push([payload[0] ?? 0]); });
       return Promise.resolve();
     });
-    nativeState.readNativeSerial
-      .mockResolvedValueOnce(new Uint8Array([0x01]))
-      .mockResolvedValueOnce(new Uint8Array([0x02]));
 
     const first = transport.sendAndReceive(new Uint8Array([0x01]), 1, 20, 20);
     const second = transport.sendAndReceive(new Uint8Array([0x02]), 1, 20, 20);
@@ -82,14 +99,49 @@ describe('TauriSerialTransport', () => {
     await expect(transport.send(new Uint8Array([0x01]), 20)).rejects.toThrow('Serial transport is closed');
   });
 
-  it('flushInput clears the native input buffer before a retry', async () => {
+  it('flushInput drops buffered bytes and packets from older generations', async () => {
     const transport = new TauriSerialTransport(1);
     await transport.attachListener();
 
+    push([0x11, 0x22]);
     await transport.flushInput();
     expect(nativeState.flushNativeSerialInput).toHaveBeenCalledWith(1);
 
-    nativeState.readNativeSerial.mockResolvedValueOnce(new Uint8Array([0xdd]));
+    // 清空之前已在途的推送
+    push([0x33], 0);
+    push([0xdd], 1);
     await expect(transport.read(1, 20)).resolves.toEqual({ data: new Uint8Array([0xdd]) });
   });
+
+  it('runs native jobs and cancels them when the signal aborts', async () => {
+    const transport = new TauriSerialTransport(1);
+    await transport.attachListener();
+
+    nativeState.writeNativeSerial.mockImplementation(() => {
+      queueMicrotask(() => { push([0xaa]); });
+      return Promise.resolve();
+    });
+    let finishJob: () => void = () => {};
+    nativeState.runNativeSerialJob.mockImplementation(() => new Promise((resolve) => {
+      finishJob = () => { resolve({ data: new Uint8Array([1, 2]), programmedBytes: 0 }); };
+    }));
+
+    const controller = new AbortController();
+    const job = { kind: 'dump' as const, opcode: 0xf6, address: 0, size: 2, chunkSize: 1, timeoutMs: 20 };
+    const pending = transport.runJob(job, undefined, controller.signal);
+    await vi.waitFor(() => {
+      expect(nativeState.runNativeSerialJob).toHaveBeenCalledWith(1, job, undefined);
+    });
+
+    // 任务执行期间其它命令需等待会话锁
+    const queuedSend = transport.sendAndReceive(new Uint8Array([0x01]), 1, 20, 20);
+    expect(nativeState.writeNativeSerial).not.toHaveBeenCalled();
+
+    controller.abort();
+    expect(nativeState.cancelNativeSerialJob).toHaveBeenCalledWith(1);
+
+    finishJob();
+    await expect(pending).resolves.toEqual({ data: new Uint8Array([1, 2]), programmedBytes: 0 });
+    await expect(queuedSend).resolves.toEqual({ data: new Uint8Array([0xaa]) });
+  });
 });
@@ -0,0 +1,104 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { type SimulatedFirmwareModel, STM_FIRMWARE_MODEL } from '@/platform/serial/simulated/firmware-model';
+import { createSimulatedDeviceState } from '@/platform/serial/simulated/runtime';
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import type { Transport } from '@/platform/serial/types';
+import {
+  CommandProfiler,
+  commandProfiler,
+  createCommandPayload,
+  DiagnosticCommand,
+  FramedTransport,
+  GBACommand,
+  LatencyHistogram,
+  usb_loopback,
+} from '@/protocol';
+
+describe('command profiler', () => {
+  const instantModel: SimulatedFirmwareModel = { ...STM_FIRMWARE_MODEL, usbBytesPerSecond: 0, commandLatencyMs: 0 };
+
+  beforeEach(() => {
+    commandProfiler.enabled = true;
+    commandProfiler.reset();
+  });
+
+  afterEach(() => {
+    commandProfiler.enabled = false;
+    vi.restoreAllMocks();
+  });
+
+  it('reports percentiles within the histogram resolution', () => {
+    const histogram = new LatencyHistogram();
+    for (let ms = 1; ms <= 1000; ms++) {
+      histogram.record(ms);
+    }
+    histogram.record(0.003);
+
+    const summary = histogram.summary();
+    expect(summary.count).toBe(1001);
+    expect(summary.p50).toBeCloseTo(500, -1);
+    expect(Math.abs(summary.p99 - 990) / 990).toBeLessThan(1 / 64);
+    expect(summary.max).toBe(1000);
+    expect(histogram.valueAtPercentile(0)).toBe(0.003);
+  });
+
+  it('times framed commands by opcode with send, first byte and completion', async () => {
+    const transport = new FramedTransport(new SimulatedTransport(createSimulatedDeviceState(instantModel)));
+
+    await usb_loopback(transport, new Uint8Array([1, 2, 3, 4]));
+    await usb_loopback(transport, new Uint8Array([5, 6, 7, 8]));
+
+    const [stats] = commandProfiler.getOpcodeStats();
+    expect(stats).toMatchObject({ opcode: DiagnosticCommand.USB_LOOPBACK, name: 'USB_LOOPBACK', count: 2 });
+    expect(stats.send?.count).toBe(2);
+    expect(stats.firstByte?.count).toBe(2);
+    expect(stats.firstByte?.p50).toBeLessThanOrEqual(stats.complete.p50);
+  });
+
+  it('records nothing while disabled', async () => {
+    const profiler = new CommandProfiler({ enabled: false });
+    const input = {} as Transport;
+
+    expect(profiler.begin(input, createCommandPayload(GBACommand.READ).build())).toBeNull();
+    await profiler.withPhase(input, 'poll', () => Promise.resolve());
+    profiler.recordSpan(input, 'read', 0, 1);
+
+    expect(profiler.getOpcodeStats()).toEqual([]);
+    expect(profiler.exportChromeTrace().traceEvents.filter(event => event.ph === 'X')).toEqual([]);
+  });
+
+  it('exports phase spans and per-command events as a Chrome trace', async () => {
+    let now = 0;
+    vi.spyOn(performance, 'now').mockImplementation(() => now);
+    const profiler = new CommandProfiler();
+    const input = {} as Transport;
+    const run = (opcode: number, durationMs: number) => {
+      const timer = profiler.begin(input, createCommandPayload(opcode).build());
+      now += durationMs;
+      profiler.complete(timer, 1);
+    };
+
+    run(GBACommand.PROGRAM, 2);
+    run(GBACommand.PROGRAM, 2);
+    await profiler.withPhase(input, 'poll', () => {
+      run(GBACommand.READ, 1);
+      now += 5;
+      return Promise.resolve();
+    });
+    run(GBACommand.READ, 4);
+
+    const trace = profiler.exportChromeTrace();
+    const spans = trace.traceEvents.filter(event => event.ph === 'X');
+    const phases = spans.filter(event => event.tid === 0).sort((a, b) => (a.ts ?? 0) - (b.ts ?? 0));
+    expect(phases.map(event => [event.name, event.ts, event.dur])).toEqual([
+      ['program', 0, 4000],
+      ['poll', 4000, 6000],
+      ['read', 10000, 4000],
+    ]);
+    expect(spans.filter(event => event.tid === 1).map(event => event.name))
+      .toEqual(['GBA_PROGRAM', 'GBA_PROGRAM', 'GBA_READ', 'GBA_READ']);
+    expect(spans.find(event => event.tid === 1 && event.ts === 4000)?.args).toMatchObject({ phase: 'poll' });
+    expect(profiler.getOpcodeStats().map(stats => stats.name)).toEqual(['GBA_READ', 'GBA_PROGRAM']);
+  });
+});
@@ -0,0 +1,82 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import type { FlashCommandSet, FlashPollOptions } from '@/protocol';
+import { flashPollUntilReady } from '@/protocol';
+
+/** 在 readyAfterMs 之后读回 0xFF 的假闪存 */
+function createFlash(readyAfterMs: number) {
+  const start = Date.now();
+  const readTimes: number[] = [];
+  const cmdSet: FlashCommandSet = {
+    unlockAddr1: 0xaaa,
+    unlockAddr2: 0x555,
+    encodeByte: value => new Uint8Array([value]),
+    write: () => Promise.resolve(),
+    read: () => {
+      const elapsed = Date.now() - start;
+      readTimes.push(elapsed);
+      return Promise.resolve(new Uint8Array([elapsed >= readyAfterMs ? 0xff : 0x00]));
+    },
+  };
+  return { cmdSet, readTimes };
+}
+
+async function poll(cmdSet: FlashCommandSet, opts: FlashPollOptions): Promise<number> {
+  const promise = flashPollUntilReady({} as never, cmdSet, 0x00, opts);
+  await vi.runAllTimersAsync();
+  return promise;
+}
+
+describe('flashPollUntilReady', () => {
+  beforeEach(() => {
+    vi.useFakeTimers();
+  });
+
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('polls at the fixed interval without a schedule', async () => {
+    const { cmdSet, readTimes } = createFlash(85);
+
+    await expect(poll(cmdSet, { pollBytes: 1, pollIntervalMs: 20, timeoutMs: 1000 })).resolves.toBe(100);
+    expect(readTimes).toEqual([20, 40, 60, 80, 100]);
+  });
+
+  it('sleeps until near the CFI typical time, then polls densely with backoff', async () => {
+    const { cmdSet, readTimes } = createFlash(85);
+
+    await expect(poll(cmdSet, {
+      pollBytes: 1,
+      pollIntervalMs: 20,
+      timeoutMs: 1000,
+      schedule: { typicalMs: 100, maxMs: 400 },
+    })).resolves.toBe(86);
+    expect(readTimes).toEqual([80, 82, 86]);
+  });
+
+  it('keeps polling past the CFI maximum until the timeout', async () => {
+    const { cmdSet, readTimes } = createFlash(300);
+
+    const elapsed = await poll(cmdSet, {
+      pollBytes: 1,
+      pollIntervalMs: 20,
+      timeoutMs: 1000,
+      schedule: { typicalMs: 50, maxMs: 100 },
+    });
+    expect(elapsed).toBeGreaterThanOrEqual(300);
+    expect(elapsed).toBeLessThan(320);
+    expect(readTimes.slice(0, 6)).toEqual([40, 42, 46, 54, 70, 90]);
+
+    const { cmdSet: stuck } = createFlash(Infinity);
+    const promise = flashPollUntilReady({} as never, stuck, 0x00, {
+      pollBytes: 1,
+      pollIntervalMs: 20,
+      timeoutMs: 200,
+      schedule: { typicalMs: 50, maxMs: 100 },
+    });
+    const assertion = expect(promise).rejects.toThrow('erase timeout after 200ms');
+    await vi.runAllTimersAsync();
+    await assertion;
+  });
+});
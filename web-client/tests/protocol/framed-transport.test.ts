@@ -0,0 +1,162 @@
+import { describe, expect, it, vi } from 'vitest';
+
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import type { Transport } from '@/platform/serial/types';
+import {
+  createCommandPayload,
+  decodeFrame,
+  DiagnosticCommand,
+  encodeFrame,
+  encodeFrameResponse,
+  FramedTransport,
+  FrameStatus,
+  rom_program_rle,
+  rom_read_rle,
+  usb_loopback,
+  usb_sink,
+} from '@/protocol';
+import { packBitsEncode } from '@/utils/compression-utils';
+import { stm32CRC32 } from '@/utils/crc-utils';
+
+vi.mock('@/utils/async-utils', async (importOriginal) => {
+  const actual = await importOriginal<typeof import('@/utils/async-utils')>();
+
+  return {
+    ...actual,
+    timeout: vi.fn().mockResolvedValue(undefined),
+  };
+});
+
+/**
+ * 字节流形式的假设备：记录发出的帧，由测试决定响应的顺序
+ */
+class StreamTransport implements Transport {
+  readonly sent: Uint8Array[] = [];
+  private readonly buffer: number[] = [];
+  private readonly waiters: (() => void)[] = [];
+
+  send = vi.fn((payload: Uint8Array) => {
+    this.sent.push(payload);
+    return Promise.resolve(true);
+  });
+
+  sendAndReceive = vi.fn();
+  setSignals = vi.fn().mockResolvedValue(undefined);
+
+  async read(length: number): Promise<{ data: Uint8Array }> {
+    while (this.buffer.length < length) {
+      await new Promise<void>((resolve) => {
+        this.waiters.push(resolve);
+      });
+    }
+    return { data: Uint8Array.from(this.buffer.splice(0, length)) };
+  }
+
+  push(bytes: Uint8Array): void {
+    this.buffer.push(...bytes);
+    this.waiters.splice(0).forEach((resolve) => {
+      resolve();
+    });
+  }
+}
+
+function loopbackCommand(data: number[]): Uint8Array {
+  return createCommandPayload(DiagnosticCommand.USB_LOOPBACK).addBytes(Uint8Array.from(data)).build();
+}
+
+describe('protocol v2 framing', () => {
+  it('matches the STM32 hardware CRC unit', () => {
+    // 单个字 0x12345678 的参考值
+    expect(stm32CRC32(Uint8Array.from([0x78, 0x56, 0x34, 0x12]))).toBe(0xdf8a8a2b);
+    expect(stm32CRC32(new Uint8Array(0))).toBe(0xffffffff);
+  });
+
+  it('round-trips frames and rejects corrupted CRC', () => {
+    const command = loopbackCommand([1, 2, 3]);
+    const frame = encodeFrame(command, 7, true);
+
+    const decoded = decodeFrame(frame);
+    expect(decoded.status).toBe(FrameStatus.OK);
+    expect(decoded.seq).toBe(7);
+    expect(Array.from(decoded.command)).toEqual(Array.from(command));
+
+    frame[frame.byteLength - 1] ^= 0xff;
+    expect(decodeFrame(frame).status).toBe(FrameStatus.CRC_ERROR);
+    expect(decodeFrame(frame.subarray(0, 6)).status).toBe(FrameStatus.BAD_LENGTH);
+  });
+
+  it('runs unchanged protocol helpers over the simulated device', async () => {
+    const transport = new FramedTransport(new SimulatedTransport(), { frameCrc: true });
+
+    await expect(usb_sink(transport, new Uint8Array(32))).resolves.toBeUndefined();
+    const echoes = await Promise.all([
+      usb_loopback(transport, Uint8Array.from([1, 2])),
+      usb_loopback(transport, Uint8Array.from([3, 4, 5])),
+    ]);
+    expect(echoes.map(echo => Array.from(echo))).toEqual([[1, 2], [3, 4, 5]]);
+  });
+
+  it('programs and reads ROM with PackBits-compressed payloads', async () => {
+    const transport = new FramedTransport(new SimulatedTransport());
+    const data = new Uint8Array(512).fill(0xff);
+    data.set([0x12, 0x34, 0x56], 40);
+
+    await rom_program_rle(transport, packBitsEncode(data), data.byteLength, 0x1000, 512);
+    await expect(rom_read_rle(transport, data.byteLength, 0x1000)).resolves.toEqual(data);
+  });
+
+  it('matches completions out of order by sequence number', async () => {
+    const stream = new StreamTransport();
+    const transport = new FramedTransport(stream, { window: 4 });
+
+    const first = usb_loopback(transport, Uint8Array.from([0x11]));
+    const second = usb_loopback(transport, Uint8Array.from([0x22]));
+    await vi.waitFor(() => {
+      expect(stream.sent).toHaveLength(2);
+    });
+
+    const [seqA, seqB] = stream.sent.map(frame => decodeFrame(frame).seq);
+    expect(seqA).not.toBe(seqB);
+
+    stream.push(encodeFrameResponse(seqB, FrameStatus.OK, Uint8Array.from([0x22])));
+    stream.push(encodeFrameResponse(seqA, FrameStatus.OK, Uint8Array.from([0x11])));
+
+    await expect(first).resolves.toEqual(Uint8Array.from([0x11]));
+    await expect(second).resolves.toEqual(Uint8Array.from([0x22]));
+  });
+
+  it('holds commands beyond the window until a slot frees', async () => {
+    const stream = new StreamTransport();
+    const transport = new FramedTransport(stream, { window: 1 });
+
+    const first = transport.sendAndReceive(loopbackCommand([1]), 3);
+    const second = transport.sendAndReceive(loopbackCommand([2]), 3);
+    await vi.waitFor(() => {
+      expect(stream.sent).toHaveLength(1);
+    });
+    expect(transport.inFlight).toBe(1);
+
+    stream.push(encodeFrameResponse(decodeFrame(stream.sent[0]).seq, FrameStatus.OK, Uint8Array.from([1])));
+    await first;
+    await vi.waitFor(() => {
+      expect(stream.sent).toHaveLength(2);
+    });
+
+    stream.push(encodeFrameResponse(decodeFrame(stream.sent[1]).seq, FrameStatus.OK, Uint8Array.from([2])));
+    await expect(second).resolves.toEqual({ data: Uint8Array.from([0, 0, 2]) });
+  });
+
+  it('surfaces device status codes as errors', async () => {
+    const stream = new StreamTransport();
+    const transport = new FramedTransport(stream);
+
+    const pending = transport.sendAndReceive(loopbackCommand([1]), 3);
+    await vi.waitFor(() => {
+      expect(stream.sent).toHaveLength(1);
+    });
+    stream.push(encodeFrameResponse(decodeFrame(stream.sent[0]).seq, FrameStatus.UNKNOWN_COMMAND, new Uint8Array(0)));
+
+    await expect(pending).rejects.toThrow('UNKNOWN_COMMAND');
+    expect(transport.inFlight).toBe(0);
+  });
+});
@@ -2,7 +2,19 @@
 
 import { WebSerialTransport } from '@/platform/serial/transports';
 import type { Transport } from '@/platform/serial/types';
-import { gbc_read, gbc_write, getPackage, getResult, ram_read, rom_erase_sector, rom_read, sendPackage, setSignals } from '@/protocol';
+import {
+  GBACommand,
+  gbc_read,
+  gbc_write,
+  getPackage,
+  getResult,
+  ram_read,
+  rom_erase_sector,
+  rom_read,
+  rom_read_into,
+  sendPackage,
+  setSignals,
+} from '@/protocol';
 import { readProtocolPayload } from '@/protocol/beggar_socket/packet-read';
 
 describe('Protocol transport abstraction', () => {
@@ -223,6 +235,25 @@ describe('Protocol transport abstraction', () => {
     expect(releaseLock).toHaveBeenCalled();
   });
 
+  it('WebSerialTransport reads ROM payloads straight into the destination buffer', async () => {
+    const read = vi.fn()
+      .mockResolvedValueOnce({ value: new Uint8Array([0x00, 0x00, 0x11]), done: false })
+      .mockResolvedValueOnce({ value: new Uint8Array([0x22, 0x33]), done: false })
+      .mockImplementation(() => new Promise(() => {}));
+    const write = vi.fn().mockResolvedValue(undefined);
+    const port = {
+      readable: { getReader: vi.fn().mockReturnValue({ read, releaseLock: vi.fn() }) },
+      writable: { getWriter: vi.fn().mockReturnValue({ write, releaseLock: vi.fn() }) },
+    } as unknown as SerialPort;
+
+    const transport = new WebSerialTransport(port);
+    const dump = new Uint8Array(6).fill(0xee);
+    await rom_read_into(transport, GBACommand.READ, dump.subarray(2, 5), 0x100);
+
+    expect(Array.from(dump)).toEqual([0xee, 0xee, 0x11, 0x22, 0x33, 0xee]);
+    expect(write).toHaveBeenCalledTimes(1);
+  });
+
   it('clears transport timers after successful operations', async () => {
     vi.useFakeTimers();
 
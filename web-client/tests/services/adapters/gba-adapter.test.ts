@@ -200,6 +200,50 @@ describe('GBAAdapter.writeROM recovery', () => {
     ]);
   });
 
+  it('skips programming 0xFF pages and blank sectors', async () => {
+    const adapter = new GBAAdapter(createMockDevice());
+    vi.spyOn(adapter, 'switchROMBank').mockResolvedValue(undefined);
+    mockRomProgram.mockResolvedValue(undefined);
+
+    const fileData = new Uint8Array(0x8000).fill(0xff);
+    fileData.set([0x11, 0x22], 0x1000);
+    const result = await adapter.writeROM(fileData, createOptions({ romPageSize: 0x1000, size: 0x8000 }));
+
+    expect(result.success).toBe(true);
+    expect(mockRomProgram).toHaveBeenCalledTimes(1);
+    expect(mockRomProgram.mock.calls[0][2]).toBe(0x1000);
+  });
+
+  it('programs whole sectors through native jobs when the transport runs them', async () => {
+    const runJob = vi.fn().mockResolvedValue({ data: new Uint8Array(0), programmedBytes: 0x1000 });
+    const adapter = new GBAAdapter(createMockDevice({
+      transport: {
+        send: vi.fn(),
+        read: vi.fn(),
+        sendAndReceive: vi.fn(),
+        setSignals: vi.fn(),
+        flushInput: vi.fn(),
+        runJob,
+      },
+    }));
+    vi.spyOn(adapter, 'switchROMBank').mockResolvedValue(undefined);
+
+    const fileData = new Uint8Array(0x8000).fill(0xff);
+    fileData.set([0x11, 0x22], 0x1000);
+    const result = await adapter.writeROM(fileData, createOptions({ romPageSize: 0x1000, size: 0x8000 }));
+
+    expect(result.success).toBe(true);
+    expect(mockRomProgram).not.toHaveBeenCalled();
+    expect(runJob).toHaveBeenCalledTimes(1);
+    expect(runJob.mock.calls[0][0]).toMatchObject({
+      kind: 'program',
+      address: 0,
+      chunkSize: 0x1000,
+      skipErased: true,
+    });
+    expect((runJob.mock.calls[0][0] as { data: Uint8Array }).data.byteLength).toBe(0x4000);
+  });
+
   it('fails deterministically when erase retries are exhausted', async () => {
     const adapter = new GBAAdapter(createMockDevice());
     vi.spyOn(adapter, 'switchROMBank').mockResolvedValue(undefined);
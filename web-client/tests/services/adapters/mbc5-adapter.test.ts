@@ -1,4 +1,4 @@
-import { beforeEach, describe, expect, it, vi } from 'vitest';
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
 
 import { MBC5Adapter } from '@/services/mbc5-adapter';
 import { AdvancedSettings } from '@/settings/advanced-settings';
@@ -6,20 +6,25 @@ import type { CommandOptions, MbcType } from '@/types/command-options';
 import type { DeviceInfo } from '@/types/device-info';
 import { STC_FIRMWARE_PROFILE, STM_FIRMWARE_PROFILE } from '@/types/firmware-profile';
 import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+import { parseDeviceInfo } from '@/utils/parsers/device-info-parser';
 
-const { mockCartPower, mockGbcRead, mockGbcRomProgram, mockGbcRomEraseSector } = vi.hoisted(() => ({
+const { mockCartPower, mockGbcRead, mockGbcWrite, mockGbcRomProgram, mockGbcRomEraseSector } = vi.hoisted(() => ({
   mockCartPower: vi.fn(),
   mockGbcRead: vi.fn(),
+  mockGbcWrite: vi.fn(),
   mockGbcRomProgram: vi.fn(),
   mockGbcRomEraseSector: vi.fn(),
 }));
 
 vi.mock('@/protocol', async () => {
   const actual = await vi.importActual<typeof import('@/protocol')>('@/protocol');
+  // 只有 RAM 分块测试替换写入，其余用例保持真实协议路径
+  mockGbcWrite.mockImplementation(actual.gbc_write);
   return {
     ...actual,
     cart_power: mockCartPower,
     gbc_read: mockGbcRead,
+    gbc_write: mockGbcWrite,
     gbc_rom_program: mockGbcRomProgram,
     gbc_rom_erase_sector: mockGbcRomEraseSector,
   };
@@ -303,3 +308,91 @@ describe('MBC5Adapter firmware capability gates', () => {
     expect(mockCartPower).toHaveBeenCalledWith(expect.anything(), 1);
   });
 });
+
+// 与碳酸丐固件 deviceInfo() 的输出一致：响应流式发送，读取分块不受响应缓冲限制
+function createStcCapabilities() {
+  const desc = new Uint8Array(48);
+  desc[0] = 48;
+  desc[1] = 1;
+  desc[2] = 2;
+  desc[3] = 0x07;
+  desc[4] = 5500 & 0xff;
+  desc[5] = 5500 >> 8;
+  desc[6] = 0xff;
+  desc[7] = 0xff;
+  desc[8] = 64;
+  for (const opcode of [0xf0, 0xf1, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xea, 0xeb, 0xd0, 0xd1, 0xd2, 0xd3]) {
+    desc[16 + (opcode >> 3)] |= 1 << (opcode & 0x07);
+  }
+  const capabilities = parseDeviceInfo(desc);
+  if (!capabilities) {
+    throw new Error('Expected descriptor to parse');
+  }
+  return capabilities;
+}
+
+describe('MBC5Adapter RAM bank window', () => {
+  beforeEach(() => {
+    vi.restoreAllMocks();
+    mockGbcRead.mockReset();
+    mockGbcRead.mockImplementation((_transport: unknown, size: number, address: number) => {
+      return Promise.resolve(new Uint8Array(size).fill(address >> 8));
+    });
+    mockGbcWrite.mockClear();
+    mockGbcWrite.mockResolvedValue(undefined);
+    AdvancedSettings.resetToDefaults();
+  });
+
+  afterEach(async () => {
+    const actual = await vi.importActual<typeof import('@/protocol')>('@/protocol');
+    mockGbcWrite.mockImplementation(actual.gbc_write);
+  });
+
+  function createStcAdapter() {
+    const adapter = new MBC5Adapter(createMockDevice({
+      firmwareProfile: STC_FIRMWARE_PROFILE,
+      capabilities: createStcCapabilities(),
+    }));
+    const bankSpy = vi.spyOn(adapter, 'switchRAMBank').mockResolvedValue(undefined);
+    vi.spyOn(adapter as unknown as { stabilizeCommandChannel: () => Promise<void> }, 'stabilizeCommandChannel')
+      .mockResolvedValue(undefined);
+    return { adapter, bankSpy };
+  }
+
+  it('keeps every RAM read chunk inside the 8 KiB bank window', async () => {
+    const { adapter, bankSpy } = createStcAdapter();
+
+    const result = await adapter.readRAM(0x8000, { mbcType: 'MBC5', ramType: 'SRAM', baseAddress: 0x1000 });
+
+    expect(result.success).toBe(true);
+    expect(result.data).toHaveLength(0x8000);
+    const reads = mockGbcRead.mock.calls.map(([, size, address]) => ({ size: size as number, address: address as number }));
+    expect(reads.some(read => read.size === 0x2000)).toBe(true);
+    for (const read of reads) {
+      expect(read.address).toBeGreaterThanOrEqual(0xa000);
+      expect(read.address + read.size).toBeLessThanOrEqual(0xc000);
+    }
+    expect(reads.reduce((total, read) => total + read.size, 0)).toBe(0x8000);
+    expect(bankSpy.mock.calls.map(([bank]) => bank)).toEqual([0, 1, 2, 3, 4]);
+  });
+
+  it('keeps every RAM write chunk inside the 8 KiB bank window', async () => {
+    const { adapter, bankSpy } = createStcAdapter();
+
+    const result = await adapter.writeRAM(new Uint8Array(0x3000), { mbcType: 'MBC5', ramType: 'SRAM', baseAddress: 0x1800 });
+
+    expect(result.success).toBe(true);
+    // 第一条写入是开启 RAM 访问的 0x0000 寄存器
+    const writes = mockGbcWrite.mock.calls.slice(1).map(([, data, address]) => ({
+      size: (data as Uint8Array).length,
+      address: address as number,
+    }));
+    for (const write of writes) {
+      expect(write.address).toBeGreaterThanOrEqual(0xa000);
+      expect(write.address + write.size).toBeLessThanOrEqual(0xc000);
+    }
+    expect(writes[0]).toEqual({ size: 0x800, address: 0xb800 });
+    expect(writes.reduce((total, write) => total + write.size, 0)).toBe(0x3000);
+    expect(bankSpy.mock.calls.map(([bank]) => bank)).toEqual([0, 1, 2]);
+  });
+});
@@ -0,0 +1,122 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { SimulatedDeviceGateway } from '@/platform/serial/simulated/device-gateway';
+import { createSimulatedDeviceState } from '@/platform/serial/simulated/runtime';
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import { BridgedTransport, describeTransportFeatures, serveTransport } from '@/platform/serial/transport-bridge';
+import type { Transport } from '@/platform/serial/types';
+import { createCommandPayload, DiagnosticCommand } from '@/protocol';
+import { BurnerWorkerClient } from '@/services/burner-worker';
+import { runBurnerWorker } from '@/services/burner-worker/worker-runtime';
+import { DebugSettings } from '@/settings/debug-settings';
+import type { DeviceInfo } from '@/types/device-info';
+
+vi.mock('@/utils/async-utils', async (importOriginal) => {
+  const actual = await importOriginal<typeof import('@/utils/async-utils')>();
+
+  return {
+    ...actual,
+    timeout: vi.fn().mockResolvedValue(undefined),
+  };
+});
+
+function createTestData(size: number, seed: number): Uint8Array {
+  const data = new Uint8Array(size);
+  for (let index = 0; index < size; index += 1) {
+    data[index] = (seed + (index * 13)) & 0xff;
+  }
+  return data;
+}
+
+describe('burner worker', () => {
+  const channels: MessageChannel[] = [];
+
+  const openChannel = () => {
+    const channel = new MessageChannel();
+    channels.push(channel);
+    return channel;
+  };
+
+  beforeEach(() => {
+    DebugSettings.debugMode = true;
+    DebugSettings.simulatedDelay = 0;
+    DebugSettings.simulateErrors = false;
+    DebugSettings.errorProbability = 0;
+    DebugSettings.clearAllSimulatedMemoryImages();
+  });
+
+  afterEach(() => {
+    channels.splice(0).forEach((channel) => {
+      channel.port1.close();
+      channel.port2.close();
+    });
+  });
+
+  it('bridges transport calls across a message port and rethrows host errors', async () => {
+    const host: Transport = new SimulatedTransport(createSimulatedDeviceState());
+    const { port1, port2 } = openChannel();
+    serveTransport(port1, host);
+    const bridged = new BridgedTransport(port2, describeTransportFeatures(host));
+
+    // 回环命令的响应为 2 字节头 + 原样回传的数据
+    const payload = createCommandPayload(DiagnosticCommand.USB_LOOPBACK).addBytes(new Uint8Array([9, 8, 7, 6])).build();
+    const { data } = await bridged.sendAndReceive(payload, 6);
+    expect(Array.from(data)).toEqual([0, 0, 9, 8, 7, 6]);
+
+    const target = new Uint8Array(10).fill(0xee);
+    await bridged.sendAndReceiveInto(payload, target, 4, 4, 2);
+    expect(Array.from(target)).toEqual([0xee, 0xee, 0xee, 0xee, 9, 8, 7, 6, 0xee, 0xee]);
+
+    await expect(bridged.read(4)).rejects.toThrow('No simulated response queued');
+    await bridged.close();
+    await expect(bridged.send(payload)).rejects.toThrow('Transport bridge closed');
+  });
+
+  it('runs adapter calls in the worker runtime with progress and checkpoint callbacks on the main side', async () => {
+    const gateway = new SimulatedDeviceGateway();
+    const handle = await gateway.connect();
+    await gateway.init(handle);
+    const device: DeviceInfo = {
+      port: null,
+      connection: null,
+      transport: handle.transport,
+      serialHandle: handle,
+      portInfo: handle.portInfo,
+      firmwareProfile: handle.firmwareProfile,
+    };
+
+    const { port1, port2 } = openChannel();
+    runBurnerWorker(port2);
+    const log = vi.fn();
+    const progress = vi.fn();
+    const client = new BurnerWorkerClient(device, { log, progress, locale: 'en-US', createWorker: () => port1 });
+    const session = client.createSession('gba', 'gba');
+
+    const cfiInfo = await session.getCartInfo();
+    expect(cfiInfo).not.toBe(false);
+    if (!cfiInfo) {
+      throw new Error('Expected simulated GBA CFI info');
+    }
+    expect(cfiInfo.deviceSize).toBe(32 * 1024 * 1024);
+
+    const payload = createTestData(512, 0x42);
+    const writeResult = await session.writeROM(payload, { cfiInfo, baseAddress: 0, size: payload.length });
+    expect(writeResult.success).toBe(true);
+
+    const commit = vi.fn().mockResolvedValue(undefined);
+    const readResult = await session.readROM(
+      payload.length,
+      { cfiInfo, baseAddress: 0, size: payload.length, checkpoint: { commit } },
+      new AbortController().signal,
+    );
+    expect(readResult.success).toBe(true);
+    expect(readResult.data).toEqual(payload);
+    expect(commit).toHaveBeenCalled();
+    expect(commit.mock.calls[0][0]).toBe(0);
+    expect(progress).toHaveBeenCalledWith(expect.objectContaining({ type: 'read' }));
+    expect(log).toHaveBeenCalled();
+
+    client.dispose();
+    await expect(session.resetCommandBuffer()).rejects.toThrow(/terminated/);
+  });
+});
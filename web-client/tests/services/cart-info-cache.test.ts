@@ -0,0 +1,130 @@
+import { beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { SimulatedDeviceGateway } from '@/platform/serial/simulated/device-gateway';
+import { invalidateSessionCartInfo, isCacheableFlashId } from '@/services/cart-info-cache';
+import { GBAAdapter } from '@/services/gba-adapter';
+import { MBC5Adapter } from '@/services/mbc5-adapter';
+import { DebugSettings } from '@/settings/debug-settings';
+import type { DeviceInfo } from '@/types/device-info';
+
+vi.mock('@/utils/async-utils', async (importOriginal) => {
+  const actual = await importOriginal<typeof import('@/utils/async-utils')>();
+
+  return {
+    ...actual,
+    timeout: vi.fn().mockResolvedValue(undefined),
+  };
+});
+
+const t = (key: string) => key;
+
+async function connectSimulated() {
+  const gateway = new SimulatedDeviceGateway();
+  const handle = await gateway.connect();
+  await gateway.init(handle);
+  const send = vi.spyOn(handle.transport, 'send');
+  const sendAndReceive = vi.spyOn(handle.transport, 'sendAndReceive');
+  const device: DeviceInfo = {
+    port: handle.port,
+    connection: null,
+    transport: handle.transport,
+    serialHandle: handle,
+    portInfo: handle.portInfo,
+    firmwareProfile: handle.firmwareProfile,
+  };
+  const commandCount = () => send.mock.calls.length + sendAndReceive.mock.calls.length;
+  return { device, commandCount };
+}
+
+describe('cart info cache', () => {
+  beforeEach(() => {
+    DebugSettings.debugMode = true;
+    DebugSettings.simulatedDelay = 0;
+    DebugSettings.simulateErrors = false;
+    localStorage.clear();
+  });
+
+  it('reuses the session cart info after reading a matching flash ID until the session is reset', async () => {
+    const { device, commandCount } = await connectSimulated();
+    invalidateSessionCartInfo(device);
+    const adapter = new GBAAdapter(device, null, null, t);
+
+    const first = await adapter.getCartInfo();
+    expect(first).not.toBe(false);
+    const afterFirst = commandCount();
+    expect(afterFirst).toBeGreaterThan(0);
+
+    await expect(adapter.getCartInfo()).resolves.toBe(first);
+    const idOnly = commandCount() - afterFirst;
+    expect(idOnly).toBeGreaterThan(0);
+    expect(idOnly).toBeLessThan(afterFirst);
+
+    invalidateSessionCartInfo(device);
+    const refreshed = await adapter.getCartInfo();
+    expect(refreshed).not.toBe(first);
+    expect(refreshed).toMatchObject({ deviceSize: first ? first.deviceSize : 0 });
+  });
+
+  it('identifies the cart again when the flash ID no longer matches the session cache', async () => {
+    const { device } = await connectSimulated();
+    invalidateSessionCartInfo(device);
+    const adapter = new GBAAdapter(device, null, null, t);
+
+    const first = await adapter.getCartInfo();
+    expect(first).not.toBe(false);
+    if (!first) {
+      return;
+    }
+    const actualId = first.flashId;
+    // 模拟未经复位换上另一张卡：缓存记录的是上一张卡的 ID
+    first.flashId = new Uint8Array([0x12, 0x34, 0x56, 0x78]);
+
+    const second = await adapter.getCartInfo();
+    expect(second).not.toBe(first);
+    expect(second).toMatchObject({ flashId: actualId });
+  });
+
+  it('skips the CFI query when the CFI table for the flash ID is remembered', async () => {
+    const { device, commandCount } = await connectSimulated();
+    invalidateSessionCartInfo(device);
+    const adapter = new GBAAdapter(device, null, null, t);
+
+    await adapter.getCartInfo(false, true);
+    const coldCommands = commandCount();
+
+    await adapter.getCartInfo(false, true);
+    const warmCommands = commandCount() - coldCommands;
+    expect(warmCommands).toBeGreaterThan(0);
+    expect(warmCommands).toBeLessThan(coldCommands);
+  });
+
+  it('reuses the session cart info for MBC5 carts as well', async () => {
+    const { device, commandCount } = await connectSimulated();
+    invalidateSessionCartInfo(device);
+    const adapter = new MBC5Adapter(device, null, null, t);
+
+    const first = await adapter.getCartInfo();
+    expect(first).not.toBe(false);
+    if (!first) {
+      return;
+    }
+    const afterFirst = commandCount();
+
+    await expect(adapter.getCartInfo()).resolves.toBe(first);
+    const idOnly = commandCount() - afterFirst;
+    expect(idOnly).toBeGreaterThan(0);
+    expect(idOnly).toBeLessThan(afterFirst);
+
+    const actualId = first.flashId;
+    first.flashId = new Uint8Array([0x12, 0x34, 0x56, 0x78]);
+    const second = await adapter.getCartInfo();
+    expect(second).not.toBe(first);
+    expect(second).toMatchObject({ flashId: actualId });
+  });
+
+  it('does not key the cache on blank bus reads', () => {
+    expect(isCacheableFlashId(undefined)).toBe(false);
+    expect(isCacheableFlashId(new Uint8Array([0xff, 0xff, 0xff, 0xff]))).toBe(false);
+    expect(isCacheableFlashId(new Uint8Array([0x01, 0x00, 0x7e, 0x22]))).toBe(true);
+  });
+});
@@ -0,0 +1,47 @@
+import { afterEach, describe, expect, it } from 'vitest';
+
+import type { Transport } from '@/platform/serial/types';
+import { commandProfiler, createCommandPayload, GBACommand } from '@/protocol';
+import { beginCommandProfile, setCommandProfilerPanelOpen } from '@/services/command-profiling';
+import { DebugSettings } from '@/settings/debug-settings';
+
+describe('command profiling service', () => {
+  const input = {} as Transport;
+  const recordRead = () => {
+    commandProfiler.complete(commandProfiler.begin(input, createCommandPayload(GBACommand.READ).build()), 1);
+  };
+
+  afterEach(() => {
+    setCommandProfilerPanelOpen(false);
+    DebugSettings.debugMode = false;
+    commandProfiler.reset();
+  });
+
+  it('only records while debug mode is on or the debug panel is open', () => {
+    DebugSettings.debugMode = false;
+    beginCommandProfile();
+    recordRead();
+    expect(commandProfiler.getOpcodeStats()).toEqual([]);
+
+    setCommandProfilerPanelOpen(true);
+    recordRead();
+    expect(commandProfiler.getOpcodeStats()[0]?.count).toBe(1);
+
+    setCommandProfilerPanelOpen(false);
+    DebugSettings.debugMode = true;
+    beginCommandProfile();
+    recordRead();
+    expect(commandProfiler.getOpcodeStats()[0]?.count).toBe(1);
+  });
+
+  it('clears the previous job when a new job starts', () => {
+    setCommandProfilerPanelOpen(true);
+    recordRead();
+    recordRead();
+
+    beginCommandProfile();
+    recordRead();
+
+    expect(commandProfiler.getOpcodeStats()[0]?.count).toBe(1);
+  });
+});
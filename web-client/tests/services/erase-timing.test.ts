@@ -0,0 +1,43 @@
+import { describe, expect, it } from 'vitest';
+
+import { EraseTimingRecorder, sectorEraseSchedule } from '@/services/erase-timing';
+import type { CFIInfo } from '@/utils/parsers/cfi-parser';
+
+describe('erase timing', () => {
+  it('derives the poll schedule from the CFI sector erase times', () => {
+    expect(sectorEraseSchedule({ sectorEraseTimeAvg: 512, sectorEraseTimeMax: 4096 } as CFIInfo))
+      .toEqual({ typicalMs: 512, maxMs: 4096 });
+    expect(sectorEraseSchedule({} as CFIInfo)).toBeUndefined();
+  });
+
+  it('reports sectors far slower than their peers or beyond the CFI maximum', () => {
+    const recorder = new EraseTimingRecorder({ typicalMs: 100, maxMs: 1000 });
+    [110, 105, 98, 400, 102, 1200].forEach((elapsedMs, index) => {
+      recorder.record(index * 0x10000, elapsedMs);
+    });
+
+    expect(recorder.medianMs).toBe(110);
+    expect(recorder.schedule).toEqual({ typicalMs: 100, maxMs: 1000 });
+    expect(recorder.outliers()).toEqual([
+      { address: 0x30000, elapsedMs: 400 },
+      { address: 0x50000, elapsedMs: 1200 },
+    ]);
+  });
+
+  it('sleeps for the measured median when the chip erases faster than its CFI typical time', () => {
+    const recorder = new EraseTimingRecorder({ typicalMs: 500, maxMs: 4000 });
+    expect(recorder.schedule).toEqual({ typicalMs: 500, maxMs: 4000 });
+
+    recorder.record(0x0000, 210);
+    recorder.record(0x10000, 190);
+    expect(recorder.schedule).toEqual({ typicalMs: 210, maxMs: 4000 });
+  });
+
+  it('only applies the CFI maximum when there are too few samples', () => {
+    const recorder = new EraseTimingRecorder({ typicalMs: 100, maxMs: 1000 });
+    recorder.record(0x0000, 100);
+    recorder.record(0x10000, 900);
+
+    expect(recorder.outliers()).toEqual([]);
+  });
+});
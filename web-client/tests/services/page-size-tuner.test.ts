@@ -0,0 +1,59 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { loadTunedPageSize, PageSizeTuner } from '@/services/page-size-tuner';
+
+const KEY = 'stm-v2:web-stream:read';
+
+/** 按每档分块的单块耗时模拟传输，直到调优结束 */
+function runTrials(tuner: PageSizeTuner, chunkCostMs: Record<number, number>): number[] {
+  const used: number[] = [];
+  let now = Date.now();
+  for (let i = 0; i < 1000 && tuner.tuning; i++) {
+    const pageSize = tuner.pageSize;
+    used.push(pageSize);
+    now += chunkCostMs[pageSize];
+    vi.setSystemTime(now);
+    tuner.record(pageSize, now);
+  }
+  return used;
+}
+
+describe('PageSizeTuner', () => {
+  beforeEach(() => {
+    vi.useFakeTimers();
+    vi.setSystemTime(1_000_000);
+    localStorage.clear();
+  });
+
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('tries halving candidates from the limit and remembers the fastest', () => {
+    const tuner = PageSizeTuner.start(KEY, 0x4000, 8 << 20);
+    expect(tuner).not.toBeNull();
+    if (!tuner) return;
+
+    const used = runTrials(tuner, { 0x4000: 40, 0x2000: 12, 0x1000: 8, 0x800: 6 });
+
+    expect([...new Set(used)]).toEqual([0x4000, 0x2000, 0x1000, 0x800]);
+    expect(tuner.tuning).toBe(false);
+    expect(tuner.pageSize).toBe(0x2000);
+    expect(loadTunedPageSize(KEY, 0x4000)).toBe(0x2000);
+  });
+
+  it('ignores remembered sizes above the current device limit', () => {
+    const tuner = PageSizeTuner.start(KEY, 0x4000, 8 << 20);
+    if (!tuner) throw new Error('tuner expected');
+    runTrials(tuner, { 0x4000: 10, 0x2000: 20, 0x1000: 20, 0x800: 20 });
+
+    expect(loadTunedPageSize(KEY, 0x4000)).toBe(0x4000);
+    expect(loadTunedPageSize(KEY, 0x1000)).toBeNull();
+    expect(loadTunedPageSize('stc-v1:tauri-native:read', 0x4000)).toBeNull();
+  });
+
+  it('skips small jobs and single-candidate limits', () => {
+    expect(PageSizeTuner.start(KEY, 0x4000, 0x150)).toBeNull();
+    expect(PageSizeTuner.start(KEY, 0x200, 8 << 20)).toBeNull();
+  });
+});
@@ -0,0 +1,42 @@
+import { describe, expect, it, vi } from 'vitest';
+
+import { RomDumpBuffer } from '@/services/rom-dump-buffer';
+import type { DumpSink } from '@/types/dump-sink';
+
+describe('RomDumpBuffer', () => {
+  it('reads chunks in place when no sink is given', async () => {
+    const buffer = new RomDumpBuffer(8, 4);
+
+    const chunk = buffer.chunk(4, 4);
+    chunk.set([5, 6, 7, 8]);
+    await buffer.commit(chunk);
+
+    expect(buffer.data).toEqual(new Uint8Array([0, 0, 0, 0, 5, 6, 7, 8]));
+  });
+
+  it('reuses one chunk-sized buffer and writes every chunk to the sink', async () => {
+    const written: number[][] = [];
+    const sink: DumpSink = {
+      write: vi.fn((chunk: Uint8Array) => {
+        written.push(Array.from(chunk));
+        return Promise.resolve();
+      }),
+      close: vi.fn(() => Promise.resolve()),
+      abort: vi.fn(() => Promise.resolve()),
+    };
+    const buffer = new RomDumpBuffer(6, 4, sink);
+
+    const first = buffer.chunk(0, 4);
+    first.set([1, 2, 3, 4]);
+    await buffer.commit(first);
+
+    const second = buffer.chunk(4, 2);
+    second.set([5, 6]);
+    await buffer.commit(second);
+
+    expect(second.buffer).toBe(first.buffer);
+    expect(first.buffer.byteLength).toBe(4);
+    expect(written).toEqual([[1, 2, 3, 4], [5, 6]]);
+    expect(buffer.data).toBeUndefined();
+  });
+});
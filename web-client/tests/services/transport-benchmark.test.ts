@@ -0,0 +1,64 @@
+import { beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import { usb_loopback, usb_source } from '@/protocol';
+import { computeLatencyPercentiles, runTransportBenchmark } from '@/services/transport-benchmark';
+import { DebugSettings } from '@/settings/debug-settings';
+
+vi.mock('@/utils/async-utils', async (importOriginal) => {
+  const actual = await importOriginal<typeof import('@/utils/async-utils')>();
+
+  return {
+    ...actual,
+    timeout: vi.fn().mockResolvedValue(undefined),
+  };
+});
+
+describe('transport benchmark', () => {
+  beforeEach(() => {
+    DebugSettings.simulatedDelay = 0;
+    DebugSettings.simulateErrors = false;
+    DebugSettings.errorProbability = 0;
+  });
+
+  it('computes nearest-rank latency percentiles', () => {
+    const samples = Array.from({ length: 100 }, (_, index) => 100 - index);
+
+    expect(computeLatencyPercentiles(samples)).toEqual({
+      min: 1,
+      p50: 50,
+      p90: 90,
+      p99: 99,
+      max: 100,
+    });
+    expect(computeLatencyPercentiles([])).toEqual({ min: 0, p50: 0, p90: 0, p99: 0, max: 0 });
+  });
+
+  it('serves USB self-test commands from the simulated device', async () => {
+    const transport = new SimulatedTransport();
+
+    const source = await usb_source(transport, 300, 0xfe);
+    expect(source.byteLength).toBe(300);
+    expect(Array.from(source.subarray(0, 4))).toEqual([0xfe, 0xff, 0x00, 0x01]);
+
+    const probe = Uint8Array.from([1, 2, 3, 4, 5]);
+    expect(Array.from(await usb_loopback(transport, probe))).toEqual([1, 2, 3, 4, 5]);
+  });
+
+  it('reports throughput and latency for the given transport', async () => {
+    let tick = 0;
+    const result = await runTransportBenchmark(new SimulatedTransport(), {
+      payloadSize: 1024,
+      iterations: 4,
+      latencyIterations: 8,
+      platform: 'simulated',
+      now: () => (tick += 1),
+    });
+
+    expect(result.platform).toBe('simulated');
+    expect(result.sinkMBps).toBeGreaterThan(0);
+    expect(result.sourceMBps).toBeGreaterThan(0);
+    expect(result.latency.p50).toBe(1);
+    expect(result.latency.p99).toBe(1);
+  });
+});
@@ -1,6 +1,6 @@
 import { describe, expect, it } from 'vitest';
 
-import { diff16BitUnFilter, huffUnComp } from '@/utils/compression-utils';
+import { diff16BitUnFilter, huffUnComp, packBitsDecode, packBitsEncode } from '@/utils/compression-utils';
 import { GBA_NINTENDO_LOGO } from '@/utils/parsers/rom-parser';
 
 describe('GBA Logo数据处理校验', () => {
@@ -41,3 +41,29 @@ describe('GBA Logo数据处理校验', () => {
     expect(finalData).toEqual(diffBytes);
   });
 });
+
+describe('PackBits 编解码', () => {
+  it('压缩长段填充并可还原', () => {
+    const data = new Uint8Array(4096).fill(0xff);
+    data.set([1, 2, 3, 4], 100);
+    data.set([5, 5], 2000);
+
+    const encoded = packBitsEncode(data);
+    expect(encoded.byteLength).toBeLessThan(100);
+    expect(packBitsDecode(encoded, data.byteLength)).toEqual(data);
+  });
+
+  it('不可压缩数据的膨胀有上限', () => {
+    const data = Uint8Array.from({ length: 1000 }, (_, index) => index & 0xff);
+    const encoded = packBitsEncode(data);
+
+    expect(encoded.byteLength).toBeLessThanOrEqual(data.byteLength + Math.ceil(data.byteLength / 128));
+    expect(packBitsDecode(encoded, data.byteLength)).toEqual(data);
+  });
+
+  it('长度不符时报错', () => {
+    const encoded = packBitsEncode(new Uint8Array(64));
+    expect(() => packBitsDecode(encoded, 32)).toThrow();
+    expect(() => packBitsDecode(encoded, 128)).toThrow();
+  });
+});
@@ -0,0 +1,147 @@
+import { describe, expect, it } from 'vitest';
+
+import type { BurnerLogEntry, BurnerLogLevel } from '@/types/burner-log';
+import { formatLogEntryLine, LogFilterIndex, LogRingBuffer, writeLogEntries } from '@/utils/log-store';
+
+function entry(message: string, level: BurnerLogLevel = 'info', extra: Partial<BurnerLogEntry> = {}): BurnerLogEntry {
+  return { time: '10:00:00', level, message, ...extra };
+}
+
+function visibleMessages(index: LogFilterIndex): string[] {
+  const messages: string[] = [];
+  for (let i = 0; i < index.length; i++) {
+    messages.push(index.entryAt(i)?.message ?? '');
+  }
+  return messages;
+}
+
+describe('log-store', () => {
+  describe('LogRingBuffer', () => {
+    it('写满后淘汰最早的条目，序号持续递增', () => {
+      const buffer = new LogRingBuffer<number>(3);
+      for (let i = 0; i < 5; i++) {
+        buffer.push(i);
+      }
+
+      expect(buffer.length).toBe(3);
+      expect(buffer.toArray()).toEqual([2, 3, 4]);
+      expect(buffer.firstSeq).toBe(2);
+      expect(buffer.nextSeq).toBe(5);
+      expect(buffer.dropped).toBe(2);
+      expect(buffer.at(0)).toBe(2);
+      expect(buffer.bySeq(4)).toBe(4);
+      expect(buffer.bySeq(1)).toBeUndefined();
+    });
+
+    it('清空后序号不回退', () => {
+      const buffer = new LogRingBuffer<number>(2);
+      buffer.push(1);
+      buffer.push(2);
+      buffer.push(3);
+      buffer.clear();
+      buffer.push(4);
+
+      expect(buffer.toArray()).toEqual([4]);
+      expect(buffer.firstSeq).toBe(3);
+      expect(buffer.bySeq(3)).toBe(4);
+    });
+
+    it('拒绝无效容量', () => {
+      expect(() => new LogRingBuffer(0)).toThrow(RangeError);
+    });
+  });
+
+  describe('LogFilterIndex', () => {
+    it('增量索引新条目并丢弃已淘汰的匹配', () => {
+      const buffer = new LogRingBuffer<BurnerLogEntry>(4);
+      const index = new LogFilterIndex(buffer);
+      buffer.push(entry('write ok', 'success'));
+      buffer.push(entry('retry 1', 'warn', { error: 'Read timeout' }));
+
+      index.setFilter({ query: 'TIMEOUT', levels: [] });
+      expect(visibleMessages(index)).toEqual(['retry 1']);
+
+      buffer.push(entry('retry 2', 'warn', { details: 'read#2 timeout' }));
+      buffer.push(entry('done', 'success'));
+      buffer.push(entry('retry 3', 'warn', { error: 'timeout' }));
+      buffer.push(entry('idle'));
+      index.sync();
+
+      // retry 1 已被淘汰
+      expect(visibleMessages(index)).toEqual(['retry 2', 'retry 3']);
+      expect(index.seqAt(0)).toBe(2);
+    });
+
+    it('按级别过滤，清除条件后直接映射缓冲', () => {
+      const buffer = new LogRingBuffer<BurnerLogEntry>(10);
+      const index = new LogFilterIndex(buffer);
+      buffer.push(entry('a', 'info'));
+      buffer.push(entry('b', 'error'));
+      buffer.push(entry('c', 'warn'));
+
+      index.setFilter({ query: '', levels: ['error', 'warn'] });
+      expect(visibleMessages(index)).toEqual(['b', 'c']);
+
+      index.setFilter({ query: '', levels: [] });
+      index.sync();
+      expect(index.active).toBe(false);
+      expect(visibleMessages(index)).toEqual(['a', 'b', 'c']);
+    });
+
+    it('查询词加长与改换时结果一致', () => {
+      const buffer = new LogRingBuffer<BurnerLogEntry>(10);
+      const index = new LogFilterIndex(buffer);
+      for (const message of ['sector 0x1000', 'sector 0x2000', 'erase 0x1000', 'verify']) {
+        buffer.push(entry(message));
+      }
+
+      index.setFilter({ query: 'sec', levels: [] });
+      expect(visibleMessages(index)).toEqual(['sector 0x1000', 'sector 0x2000']);
+      index.setFilter({ query: 'sector 0x1', levels: [] });
+      expect(visibleMessages(index)).toEqual(['sector 0x1000']);
+      index.setFilter({ query: '0x1000', levels: [] });
+      expect(visibleMessages(index)).toEqual(['sector 0x1000', 'erase 0x1000']);
+    });
+
+    it('两次同步之间缓冲被清空时不保留旧匹配', () => {
+      const buffer = new LogRingBuffer<BurnerLogEntry>(10);
+      const index = new LogFilterIndex(buffer);
+      buffer.push(entry('error 1', 'error'));
+      index.setFilter({ query: 'error', levels: [] });
+      expect(index.length).toBe(1);
+
+      buffer.clear();
+      buffer.push(entry('error 2', 'error'));
+      index.sync();
+      expect(visibleMessages(index)).toEqual(['error 2']);
+    });
+  });
+
+  describe('writeLogEntries', () => {
+    it('格式化条目，详情缩进到后续行', () => {
+      expect(formatLogEntryLine(entry('retry', 'warn', { error: 'timeout', details: 'a\nb' })))
+        .toBe('[10:00:00] [WARN] retry: timeout\n    a\n    b\n');
+    });
+
+    it('按块写出全部保留条目', async () => {
+      const buffer = new LogRingBuffer<BurnerLogEntry>(3000);
+      for (let i = 0; i < 3500; i++) {
+        buffer.push(entry(`message-${i} ${'x'.repeat(40)}`));
+      }
+
+      const chunks: Uint8Array[] = [];
+      const count = await writeLogEntries(buffer, (chunk) => {
+        chunks.push(chunk);
+        return Promise.resolve();
+      });
+
+      expect(count).toBe(3000);
+      expect(chunks.length).toBeGreaterThan(1);
+      const text = new TextDecoder().decode(new Uint8Array(chunks.flatMap(chunk => Array.from(chunk))));
+      const lines = text.trimEnd().split('\n');
+      expect(lines).toHaveLength(3000);
+      expect(lines[0]).toContain('message-500 ');
+      expect(lines[lines.length - 1]).toContain('message-3499 ');
+    });
+  });
+});
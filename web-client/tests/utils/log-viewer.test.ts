@@ -1,6 +1,6 @@
 import { describe, expect, it } from 'vitest';
 
-import { resolveAutoScrollEnabled } from '@/utils/log-viewer';
+import { buildRowOffsets, findVisibleRows, resolveAutoScrollEnabled } from '@/utils/log-viewer';
 
 describe('resolveAutoScrollEnabled', () => {
   it('在用户未覆盖时，日志较少默认启用自动滚动', () => {
@@ -20,3 +20,28 @@ describe('resolveAutoScrollEnabled', () => {
     expect(resolveAutoScrollEnabled(false, 10, true)).toBe(false);
   });
 });
+
+describe('virtual rows', () => {
+  it('按行高累计每行顶部位置', () => {
+    const offsets = buildRowOffsets(4, index => (index === 2 ? 60 : 20));
+    expect(Array.from(offsets.subarray(0, 5))).toEqual([0, 20, 40, 100, 120]);
+
+    const reused = buildRowOffsets(2, () => 10, offsets);
+    expect(reused).toBe(offsets);
+    expect(reused[2]).toBe(20);
+  });
+
+  it('只返回与视口相交的行及上下缓冲行', () => {
+    const offsets = buildRowOffsets(1000, () => 20);
+    expect(findVisibleRows(offsets, 1000, 0, 100, 2)).toEqual({ start: 0, end: 7 });
+    expect(findVisibleRows(offsets, 1000, 2010, 100, 2)).toEqual({ start: 98, end: 108 });
+    expect(findVisibleRows(offsets, 1000, 19900, 100, 2)).toEqual({ start: 993, end: 1000 });
+  });
+
+  it('处理空列表与变高行', () => {
+    expect(findVisibleRows(new Float64Array(1), 0, 0, 100)).toEqual({ start: 0, end: 0 });
+
+    const offsets = buildRowOffsets(3, index => (index === 1 ? 500 : 20));
+    expect(findVisibleRows(offsets, 3, 100, 50, 0)).toEqual({ start: 1, end: 2 });
+  });
+});
@@ -0,0 +1,98 @@
+import { describe, expect, it, vi } from 'vitest';
+
+import type { Transport } from '@/platform/serial';
+import { SimulatedTransport } from '@/platform/serial/simulated/transport';
+import { device_get_info } from '@/protocol';
+import { probeDeviceCapabilities } from '@/services/device-capabilities';
+import { createFirmwareProfileFromCapabilities } from '@/types/firmware-profile';
+import { parseDeviceInfo } from '@/utils/parsers/device-info-parser';
+
+vi.mock('@/utils/async-utils', async (importOriginal) => {
+  const actual = await importOriginal<typeof import('@/utils/async-utils')>();
+
+  return {
+    ...actual,
+    timeout: vi.fn().mockResolvedValue(undefined),
+  };
+});
+
+// 与碳酸丐固件 deviceInfo() 的输出保持一致
+function createStcDescriptor(): Uint8Array {
+  const desc = new Uint8Array(48);
+  desc[0] = 48;
+  desc[1] = 1;
+  desc[2] = 2;
+  desc[3] = 0x07;
+  desc[4] = 5500 & 0xff;
+  desc[5] = 5500 >> 8;
+  desc[6] = 0xff;
+  desc[7] = 0xff;
+  desc[8] = 64;
+  const opcodes = [0xf0, 0xf1, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xea, 0xeb, 0xa0, 0xa1, 0xd0, 0xd1, 0xd2, 0xd3];
+  for (const opcode of opcodes) {
+    desc[16 + (opcode >> 3)] |= 1 << (opcode & 0x07);
+  }
+  return desc;
+}
+
+describe('device info parser', () => {
+  it('parses limits, flags and the opcode bitmap', () => {
+    const capabilities = parseDeviceInfo(createStcDescriptor());
+
+    expect(capabilities).toMatchObject({
+      protocolVersion: 1,
+      firmwareId: 'stc',
+      streamingCommand: true,
+      streamingResponse: true,
+      cartPowerControl: true,
+      maxCommandSize: 5500,
+      maxResponsePayload: 0xffff,
+      usbPacketSize: 64,
+    });
+    expect(capabilities?.opcodes.has(0xf4)).toBe(true);
+    expect(capabilities?.opcodes.has(0xf3)).toBe(false);
+  });
+
+  it('rejects truncated descriptors', () => {
+    expect(parseDeviceInfo(new Uint8Array(16))).toBeNull();
+  });
+
+  it('derives firmware capabilities from reported opcodes', () => {
+    const capabilities = parseDeviceInfo(createStcDescriptor());
+    if (!capabilities) {
+      throw new Error('Expected descriptor to parse');
+    }
+
+    const profile = createFirmwareProfileFromCapabilities(capabilities);
+    expect(profile.id).toBe('stc');
+    expect(profile.capabilities).toEqual({
+      gbaSectorErase: false,
+      gbaFramRam: false,
+      gbcFramRam: true,
+      cartPowerControl: true,
+    });
+  });
+
+  it('reads the descriptor from the simulated device', async () => {
+    const capabilities = parseDeviceInfo(await device_get_info(new SimulatedTransport()));
+
+    expect(capabilities?.firmwareId).toBe('stm');
+    expect(capabilities?.opcodes.has(0xd3)).toBe(true);
+  });
+
+  it('resets the command channel when firmware does not answer the probe', async () => {
+    const setSignals = vi.fn().mockResolvedValue(undefined);
+    const drainInput = vi.fn().mockResolvedValue(undefined);
+    const transport: Transport = {
+      send: vi.fn().mockResolvedValue(true),
+      read: vi.fn().mockRejectedValue(new Error('Read timeout')),
+      sendAndReceive: vi.fn().mockRejectedValue(new Error('Read timeout')),
+      setSignals,
+      drainInput,
+    };
+
+    await expect(probeDeviceCapabilities(transport)).resolves.toBeNull();
+    expect(setSignals).toHaveBeenCalledWith({ dataTerminalReady: true, requestToSend: true });
+    expect(drainInput).toHaveBeenCalled();
+  });
+});
@@ -0,0 +1,65 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+
+import { FrameCoalescer } from '@/utils/progress/frame-coalescer';
+
+describe('FrameCoalescer', () => {
+  let frames: Map<number, FrameRequestCallback>;
+  let nextFrameId: number;
+
+  const runFrames = () => {
+    const callbacks = [...frames.values()];
+    frames.clear();
+    callbacks.forEach((callback) => { callback(performance.now()); });
+  };
+
+  beforeEach(() => {
+    frames = new Map();
+    nextFrameId = 1;
+    vi.stubGlobal('requestAnimationFrame', (callback: FrameRequestCallback) => {
+      const id = nextFrameId++;
+      frames.set(id, callback);
+      return id;
+    });
+    vi.stubGlobal('cancelAnimationFrame', (id: number) => {
+      frames.delete(id);
+    });
+  });
+
+  afterEach(() => {
+    vi.unstubAllGlobals();
+  });
+
+  it('flushes once per frame no matter how many updates were scheduled', () => {
+    const flush = vi.fn();
+    const coalescer = new FrameCoalescer(flush);
+
+    coalescer.schedule();
+    coalescer.schedule();
+    coalescer.schedule();
+    expect(frames.size).toBe(1);
+    expect(flush).not.toHaveBeenCalled();
+
+    runFrames();
+    expect(flush).toHaveBeenCalledTimes(1);
+    expect(coalescer.pending).toBe(false);
+
+    coalescer.schedule();
+    runFrames();
+    expect(flush).toHaveBeenCalledTimes(2);
+  });
+
+  it('cancels the pending frame when flushed immediately or cancelled', () => {
+    const flush = vi.fn();
+    const coalescer = new FrameCoalescer(flush);
+
+    coalescer.schedule();
+    coalescer.flushNow();
+    expect(flush).toHaveBeenCalledTimes(1);
+    expect(frames.size).toBe(0);
+
+    coalescer.schedule();
+    coalescer.cancel();
+    runFrames();
+    expect(flush).toHaveBeenCalledTimes(1);
+  });
+});
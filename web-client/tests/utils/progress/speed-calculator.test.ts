@@ -246,4 +246,21 @@ describe('SpeedCalculator', () => {
       expect(isFinite(calculator.getCurrentSpeed())).toBe(true);
     });
   });
+
+  describe('sliding window', () => {
+    it('keeps the window sum exact across ring buffer growth and trimming', () => {
+      const calc = new SpeedCalculator(1000);
+      let timestamp = mockTime;
+      // 400 个数据点远超环形缓冲初始容量，窗口内稳定保留 101 个点
+      for (let i = 0; i < 400; i++) {
+        timestamp = mockTime + i * 10;
+        calc.addDataPoint(100, timestamp);
+      }
+      expect(calc.getCurrentSpeed(timestamp)).toBeCloseTo(10100, 0);
+
+      // 长时间间隔后窗口只剩新点，窗口字节数不能残留已淘汰的数据
+      calc.addDataPoint(100, timestamp + 5000);
+      expect(calc.getCurrentSpeed(timestamp + 5000)).toBeCloseTo(0.3 * 20 + 0.7 * 10100, 0);
+    });
+  });
 });
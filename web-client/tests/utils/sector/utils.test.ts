@@ -1,7 +1,7 @@
 import { describe, expect, it } from 'vitest';
 
 import { SectorBlock } from '@/utils/parsers/cfi-parser';
-import { calcSectorUsage } from '@/utils/sector-utils';
+import { calcSectorUsage, createSectorProgressInfo, isErasedData, planSparseWrite } from '@/utils/sector-utils';
 
 // 辅助函数：将旧的数组格式转换为新的EraseSectorBlock格式
 function createEraseSectorBlocks(blocks: [number, number, number][]): SectorBlock[] {
@@ -596,4 +596,43 @@ describe('sector-utils', () => {
       }).toThrow('Insufficient sector space: need 1024 bytes, but only 0 bytes available');
     });
   });
+
+  describe('planSparseWrite', () => {
+    it('识别任意对齐的全 0xFF 数据', () => {
+      const data = new Uint8Array(11).fill(0xff);
+      expect(isErasedData(data)).toBe(true);
+      expect(isErasedData(data.subarray(1))).toBe(true);
+
+      data[10] = 0xfe;
+      expect(isErasedData(data)).toBe(false);
+      expect(isErasedData(data.subarray(1))).toBe(false);
+      expect(isErasedData(new Uint8Array(0))).toBe(true);
+    });
+
+    it('按页统计需要编程的字节并标出空白扇区', () => {
+      const sectors = createSectorProgressInfo(calcSectorUsage(createEraseSectorBlocks([[0x1000, 4, 0x4000]]), 0x3800));
+      const data = new Uint8Array(0x3800).fill(0xff);
+      data[0x0200] = 0x00;
+      data[0x37ff] = 0x00;
+
+      const plan = planSparseWrite(data, sectors, 0, data.byteLength, 0x400);
+
+      expect(plan.sectorProgramBytes).toEqual([0x400, 0, 0, 0x400]);
+      expect(plan.programBytes).toBe(0x800);
+      expect(plan.blankSectors).toBe(2);
+    });
+
+    it('整体跳过内容未变化的扇区', () => {
+      const sectors = createSectorProgressInfo(calcSectorUsage(createEraseSectorBlocks([[0x1000, 4, 0x4000]]), 0x4000));
+      const data = new Uint8Array(0x4000).fill(0x5a);
+      data.fill(0xff, 0x2000, 0x3000);
+
+      const plan = planSparseWrite(data, sectors, 0, data.byteLength, 0x400, new Set([0x1000, 0x3000]));
+
+      expect(plan.sectorProgramBytes).toEqual([0x1000, 0, 0, 0]);
+      expect(plan.programBytes).toBe(0x1000);
+      expect(plan.blankSectors).toBe(1);
+      expect(plan.unchangedBytes).toBe(0x2000);
+    });
+  });
 });
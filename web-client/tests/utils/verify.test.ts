@@ -0,0 +1,100 @@
+import { describe, expect, it } from 'vitest';
+
+import { findFirstMismatch, VerifyMismatchCollector } from '@/utils/verify-utils';
+
+function pattern(size: number): Uint8Array {
+  const data = new Uint8Array(size);
+  for (let i = 0; i < size; i++) {
+    data[i] = (i * 31 + 7) & 0xff;
+  }
+  return data;
+}
+
+describe('verify-utils', () => {
+  describe('findFirstMismatch', () => {
+    it('相同数据返回 -1', () => {
+      const data = pattern(1000);
+      expect(findFirstMismatch(data, data.slice())).toBe(-1);
+    });
+
+    it('在字比较、未对齐头部与尾部中都能定位到差异字节', () => {
+      const expected = pattern(1000);
+      for (const index of [0, 2, 5, 64, 513, 997, 999]) {
+        const actual = expected.slice();
+        actual[index] ^= 0x01;
+        expect(findFirstMismatch(expected, actual)).toBe(index);
+        // 子视图起点不在 4 字节边界上
+        expect(findFirstMismatch(expected.subarray(1), actual.subarray(1))).toBe(index === 0 ? -1 : index - 1);
+      }
+    });
+
+    it('两段数据对齐不一致时退回逐字节比较', () => {
+      const buffer = new Uint8Array(1001);
+      const expected = pattern(1000);
+      buffer.set(expected, 1);
+      const actual = buffer.subarray(1);
+      actual[700] = ~actual[700] & 0xff;
+      expect(findFirstMismatch(expected, actual)).toBe(700);
+      expect(findFirstMismatch(expected, actual, 701)).toBe(-1);
+    });
+  });
+
+  describe('VerifyMismatchCollector', () => {
+    const sectors = [
+      { address: 0x1000, size: 0x100 },
+      { address: 0x1100, size: 0x100 },
+      { address: 0x1200, size: 0x100 },
+      { address: 0x1300, size: 0x100 },
+    ];
+
+    it('收集全部差异区间并按扇区统计', () => {
+      const expected = pattern(0x400);
+      const actual = expected.slice();
+      // 跨扇区边界的一段连续差异
+      for (let i = 0xf8; i < 0x108; i++) actual[i] ^= 0xff;
+      // 相隔很近的两个字节合并为一个区间
+      actual[0x300] ^= 0x10;
+      actual[0x304] ^= 0x10;
+
+      const collector = new VerifyMismatchCollector(sectors);
+      expect(collector.compare(expected, actual, 0x1000)).toBe(18);
+
+      expect(collector.mismatchCount).toBe(18);
+      expect(collector.ranges).toEqual([
+        { address: 0x10f8, length: 16, mismatches: 16 },
+        { address: 0x1300, length: 5, mismatches: 2 },
+      ]);
+      expect(collector.first).toEqual({ address: 0x10f8, expected: expected[0xf8], actual: actual[0xf8] });
+      expect(collector.sectorMismatches(0x1000)).toBe(8);
+      expect(collector.sectorMismatches(0x1100)).toBe(8);
+      expect(collector.sectorMismatches(0x1200)).toBe(0);
+      expect(collector.sectorMismatches(0x1300)).toBe(2);
+      expect(collector.failedSectorCount).toBe(3);
+    });
+
+    it('相邻分块的差异合并为同一区间', () => {
+      const expected = new Uint8Array(0x200);
+      const actual = new Uint8Array(0x200).fill(0xff);
+      const collector = new VerifyMismatchCollector(sectors);
+
+      collector.compare(expected.subarray(0, 0x100), actual.subarray(0, 0x100), 0x1000);
+      collector.compare(expected.subarray(0x100), actual.subarray(0x100), 0x1100);
+
+      expect(collector.ranges).toEqual([{ address: 0x1000, length: 0x200, mismatches: 0x200 }]);
+      expect(collector.rangeCount).toBe(1);
+    });
+
+    it('超出区间上限后只计数', () => {
+      const expected = new Uint8Array(0x400);
+      const actual = expected.slice();
+      for (let i = 0; i < 0x400; i += 0x40) actual[i] = 1;
+
+      const collector = new VerifyMismatchCollector([], 4);
+      collector.compare(expected, actual, 0);
+
+      expect(collector.ranges).toHaveLength(4);
+      expect(collector.rangeCount).toBe(16);
+      expect(collector.mismatchCount).toBe(16);
+    });
+  });
+});
@@ -68,6 +68,10 @@ export default defineConfig({
       buffer: 'buffer',
     },
   },
+  // 烧录 Worker 以 type: 'module' 创建，构建产物需为 ES 格式
+  worker: {
+    format: 'es',
+  },
   css: {
     preprocessorOptions: {
       scss: {}
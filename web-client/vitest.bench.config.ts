@@ -0,0 +1,18 @@
+/// <reference types="vitest" />
+import { defineConfig } from 'vite';
+
+import baseConfig from './vitest.config';
+
+/**
+ * 端到端吞吐基准（npm run bench），与单元测试分开运行
+ */
+export default defineConfig({
+  ...baseConfig,
+  test: {
+    ...baseConfig.test,
+    include: ['tests/performance/**/*.perf.ts'],
+    exclude: [],
+    fileParallelism: false,
+    testTimeout: 120_000,
+  },
+});